@@ -383,7 +383,9 @@ struct OutputContext
     {
         None,
         ExpandValueComponents = 0x1,
-        DesignStudioWorkarounds = ExpandValueComponents | 0x2
+        DesignStudioWorkarounds = ExpandValueComponents | 0x2,
+        CompressMeshes = 0x4,
+        QuantizeMeshAttributes = 0x8
     };
     QTextStream &stream;
     QDir outdir;
@@ -805,7 +807,7 @@ QString asString(QSSGSceneDesc::Animation::Channel::TargetProperty prop)
     return QStringLiteral("unknown");
 }
 
-static std::pair<QString, QString> meshAssetName(const QSSGSceneDesc::Scene &scene, const QSSGSceneDesc::Mesh &meshNode, const QDir &outdir)
+static std::pair<QString, QString> meshAssetName(const QSSGSceneDesc::Scene &scene, const QSSGSceneDesc::Mesh &meshNode, const QDir &outdir, quint8 outputOptions)
 {
     // Returns {name, notValidReason}
 
@@ -827,7 +829,13 @@ static std::pair<QString, QString> meshAssetName(const QSSGSceneDesc::Scene &sce
         return {QString(), QStringLiteral("Failed to find mesh at ") + path};
     }
 
-    if (mesh.save(&file) == 0) {
+    QSSGMesh::Mesh::SaveOptions saveOptions;
+    if (outputOptions & OutputContext::Options::CompressMeshes)
+        saveOptions |= QSSGMesh::Mesh::CompressBuffers;
+    if (outputOptions & OutputContext::Options::QuantizeMeshAttributes)
+        saveOptions |= QSSGMesh::Mesh::QuantizeAttributes;
+
+    if (mesh.save(&file, 0, saveOptions) == 0) {
         return {};
     }
 
@@ -1062,7 +1070,7 @@ static ValueToQmlResult valueToQml(const QSSGSceneDesc::Node &target, const QSSG
             Q_ASSERT(meshNode->nodeType == QSSGSceneDesc::Node::Type::Mesh);
             Q_ASSERT(meshNode->scene);
             const auto &scene = *meshNode->scene;
-            const auto& [meshSourceName, notValidReason] = meshAssetName(scene, *meshNode, output.outdir);
+            const auto& [meshSourceName, notValidReason] = meshAssetName(scene, *meshNode, output.outdir, output.options);
             result.notValidReason = notValidReason;
             if (!meshSourceName.isEmpty()) {
                 result.value = toQuotedString(meshSourceName);
@@ -1596,6 +1604,11 @@ void writeQml(const QSSGSceneDesc::Scene &scene, QTextStream &stream, const QDir
     if (checkBooleanOption(QLatin1String("designStudioWorkarounds"), options))
         outputOptions |= OutputContext::Options::DesignStudioWorkarounds;
 
+    if (checkBooleanOption(QLatin1String("compressMeshes"), options))
+        outputOptions |= OutputContext::Options::CompressMeshes;
+    if (checkBooleanOption(QLatin1String("quantizeMeshAttributes"), options))
+        outputOptions |= OutputContext::Options::QuantizeMeshAttributes;
+
     const bool useBinaryKeyframes = checkBooleanOption("useBinaryKeyframes"_L1, options);
     const bool generateTimelineAnimations = !checkBooleanOption("manualAnimations"_L1, options);
 
@@ -811,9 +811,14 @@ QSSGMesh::Mesh AssimpUtils::generateMeshData(const aiScene &scene,
         return num;
     };
 
-    return QSSGMesh::Mesh::fromAssetData(entries, indexBufferData, indexType,
-                                         subsets, requirments.numMorphTargets,
-                                         numTargetComponents(requirments));
+    QSSGMesh::Mesh mesh = QSSGMesh::Mesh::fromAssetData(entries, indexBufferData, indexType,
+                                                        subsets, requirments.numMorphTargets,
+                                                        numTargetComponents(requirments));
+    // Lets the runtime keep only the coarser levels resident, see QT_QUICK3D_MESH_LOD_STREAMING
+    if (generateLevelsOfDetail)
+        mesh.arrangeLevelsOfDetailCoarsestFirst();
+
+    return mesh;
 }
 
 QT_END_NAMESPACE
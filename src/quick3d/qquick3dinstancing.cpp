@@ -328,12 +328,50 @@ void QQuick3DInstancing::setDepthSortingEnabled(bool enabled)
 /*!
   Mark that the instance data has changed and must be uploaded again.
 
-  \sa getInstanceBuffer, instanceCountOverride
+  \sa getInstanceBuffer, instanceCountOverride, markRangeDirty
   */
 
 void QQuick3DInstancing::markDirty()
 {
     Q_D(QQuick3DInstancing);
+    d->dirty(QQuick3DObjectPrivate::DirtyType::Content);
+    d->m_instanceDataChanged = true;
+    d->m_dirtyRanges.clear();
+    emit instanceTableChanged();
+}
+
+/*!
+  \since 6.9
+
+  Mark that the \a count instances starting at \a index have changed. Only the changed
+  instances will be uploaded again, as long as the size of the instance table stays the same.
+  This is useful for large tables where only a few instances are updated each frame.
+
+  Use markDirty() to mark the whole table as dirty.
+
+  \sa getInstanceBuffer
+  */
+
+void QQuick3DInstancing::markRangeDirty(int index, int count)
+{
+    Q_D(QQuick3DInstancing);
+    if (count <= 0)
+        return;
+
+    // Already fully dirty, nothing to track
+    if (d->m_instanceDataChanged && d->m_dirtyRanges.isEmpty())
+        return;
+
+    // Keep the number of tracked ranges bounded. If there are still too many after merging,
+    // uploading the whole table is likely cheaper anyway.
+    constexpr qsizetype maxDirtyRanges = 1024;
+    d->m_dirtyRanges.push_back({ index, count });
+    if (d->m_dirtyRanges.size() > maxDirtyRanges) {
+        QSSGRenderInstanceTable::mergeDirtyRanges(d->m_dirtyRanges);
+        if (d->m_dirtyRanges.size() > maxDirtyRanges / 2)
+            d->m_dirtyRanges.clear();
+    }
+
     d->dirty(QQuick3DObjectPrivate::DirtyType::Content);
     d->m_instanceDataChanged = true;
     emit instanceTableChanged();
@@ -347,6 +385,7 @@ QSSGRenderGraphObject *QQuick3DInstancing::updateSpatialNode(QSSGRenderGraphObje
         node = new QSSGRenderInstanceTable();
         emit instanceNodeDirty();
         d->m_instanceDataChanged = true;
+        d->m_dirtyRanges.clear();
     }
     QQuick3DObject::updateSpatialNode(node);
     auto effectiveInstanceCount = [d]() {
@@ -357,7 +396,11 @@ QSSGRenderGraphObject *QQuick3DInstancing::updateSpatialNode(QSSGRenderGraphObje
     auto *instanceTable = static_cast<QSSGRenderInstanceTable *>(node);
     if (d->m_instanceDataChanged) {
         QByteArray buffer = getInstanceBuffer(&d->m_instanceCount);
-        instanceTable->setData(buffer, effectiveInstanceCount(), sizeof(InstanceTableEntry));
+        if (d->m_dirtyRanges.isEmpty())
+            instanceTable->setData(buffer, effectiveInstanceCount(), sizeof(InstanceTableEntry));
+        else
+            instanceTable->setPartialData(buffer, effectiveInstanceCount(), sizeof(InstanceTableEntry), d->m_dirtyRanges);
+        d->m_dirtyRanges.clear();
         d->m_instanceDataChanged = false;
     } else if (d->m_instanceCountOverrideChanged) {
         instanceTable->setInstanceCountOverride(effectiveInstanceCount());
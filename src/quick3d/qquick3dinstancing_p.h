@@ -20,6 +20,8 @@
 
 #include <QtGui/qvector3d.h>
 
+#include <QtQuick3DRuntimeRender/private/qssgrenderinstancetable_p.h>
+
 QT_BEGIN_NAMESPACE
 
 class QQuick3DInstancingPrivate : public QQuick3DObjectPrivate
@@ -32,6 +34,8 @@ public:
     bool m_instanceDataChanged = true;
     bool m_instanceCountOverrideChanged = false;
     bool m_depthSortingEnabled = false;
+    // Instances changed since the last sync. Empty means the whole table is dirty.
+    QSSGRenderInstanceTable::DirtyRanges m_dirtyRanges;
 };
 
 class Q_QUICK3D_EXPORT QQuick3DInstanceListEntry : public QQuick3DObject
@@ -762,8 +762,10 @@ QSSGRenderGraphObject *QQuick3DModel::updateSpatialNode(QSSGRenderGraphObject *n
     int dirtyAttribute = 0;
 
     auto modelNode = static_cast<QSSGRenderModel *>(node);
-    if (m_dirtyAttributes & SourceDirty)
+    if (m_dirtyAttributes & SourceDirty) {
         modelNode->meshPath = QSSGRenderPath(translateMeshSource(m_source, this));
+        modelNode->asyncMeshLoading = m_asynchronous;
+    }
     if (m_dirtyAttributes & PickingDirty)
         modelNode->setState(QSSGRenderModel::LocalState::Pickable, m_pickable);
 
@@ -1166,4 +1168,63 @@ void QQuick3DModel::setLevelOfDetailBias(float newLevelOfDetailBias)
     markDirty(QQuick3DModel::PropertyDirty);
 }
 
+/*!
+    \qmlproperty bool Model::asynchronous
+    \since 6.9
+
+    When this property is \c true, the mesh file given by \l source is read and
+    processed on a worker thread instead of blocking the frame that first uses it.
+    The model is not rendered until its mesh data is ready, use \l status to find
+    out when that is the case.
+
+    Built-in primitives and meshes created from a \l geometry are always loaded
+    synchronously.
+
+    The default value is \c false
+
+    \sa status
+*/
+
+bool QQuick3DModel::asynchronous() const
+{
+    return m_asynchronous;
+}
+
+void QQuick3DModel::setAsynchronous(bool asynchronous)
+{
+    if (m_asynchronous == asynchronous)
+        return;
+    m_asynchronous = asynchronous;
+    emit asynchronousChanged();
+    markDirty(SourceDirty);
+}
+
+/*!
+    \qmlproperty enumeration Model::status
+    \since 6.9
+    \readonly
+
+    This property holds the loading status of the model's mesh.
+
+    \value Model.Null No mesh has been set.
+    \value Model.Ready The mesh has been loaded.
+    \value Model.Loading The mesh is being loaded, see \l asynchronous.
+    \value Model.Error An error occurred while loading the mesh.
+
+    \sa asynchronous
+*/
+
+QQuick3DModel::Status QQuick3DModel::status() const
+{
+    return m_status;
+}
+
+void QQuick3DModel::setStatus(Status status)
+{
+    if (m_status == status)
+        return;
+    m_status = status;
+    emit statusChanged();
+}
+
 QT_END_NAMESPACE
@@ -82,10 +82,20 @@ class Q_QUICK3D_EXPORT QQuick3DModel : public QQuick3DNode
     Q_PROPERTY(float instancingLodMin READ instancingLodMin WRITE setInstancingLodMin NOTIFY instancingLodMinChanged REVISION(6, 5))
     Q_PROPERTY(float instancingLodMax READ instancingLodMax WRITE setInstancingLodMax NOTIFY instancingLodMaxChanged REVISION(6, 5))
     Q_PROPERTY(float levelOfDetailBias READ levelOfDetailBias WRITE setLevelOfDetailBias NOTIFY levelOfDetailBiasChanged REVISION(6, 5))
+    Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous NOTIFY asynchronousChanged REVISION(6, 9))
+    Q_PROPERTY(Status status READ status NOTIFY statusChanged REVISION(6, 9))
 
     QML_NAMED_ELEMENT(Model)
 
 public:
+    enum Status {
+        Null,
+        Ready,
+        Loading,
+        Error
+    };
+    Q_ENUM(Status)
+
     explicit QQuick3DModel(QQuick3DNode *parent = nullptr);
     ~QQuick3DModel() override;
 
@@ -119,6 +129,9 @@ public:
     Q_REVISION(6, 5) float instancingLodMax() const;
     Q_REVISION(6, 5) float levelOfDetailBias() const;
 
+    Q_REVISION(6, 9) bool asynchronous() const;
+    Q_REVISION(6, 9) Status status() const;
+
 public Q_SLOTS:
     void setSource(const QUrl &source);
     void setCastsShadows(bool castsShadows);
@@ -142,6 +155,8 @@ public Q_SLOTS:
     Q_REVISION(6, 5) void setInstancingLodMax(float maxDistance);
     Q_REVISION(6, 5) void setLevelOfDetailBias(float newLevelOfDetailBias);
 
+    Q_REVISION(6, 9) void setAsynchronous(bool asynchronous);
+
 Q_SIGNALS:
     void sourceChanged();
     void castsShadowsChanged();
@@ -166,6 +181,9 @@ Q_SIGNALS:
     Q_REVISION(6, 5) void instancingLodMaxChanged();
     Q_REVISION(6, 5) void levelOfDetailBiasChanged();
 
+    Q_REVISION(6, 9) void asynchronousChanged();
+    Q_REVISION(6, 9) void statusChanged();
+
 protected:
     QSSGRenderGraphObject *updateSpatialNode(QSSGRenderGraphObject *node) override;
     void markAllDirty() override;
@@ -176,6 +194,8 @@ private Q_SLOTS:
     void onMorphTargetDestroyed(QObject *object);
 
 private:
+    friend class QQuick3DSceneManager;
+
     enum QSSGModelDirtyType {
         SourceDirty =            0x00000001,
         MaterialsDirty =         0x00000002,
@@ -198,6 +218,7 @@ private:
     quint32 m_dirtyAttributes = 0xffffffff; // all dirty by default
     void markDirty(QSSGModelDirtyType type);
     void updateSceneManager(QQuick3DSceneManager *sceneManager);
+    void setStatus(Status status);
 
     static void qmlAppendMaterial(QQmlListProperty<QQuick3DMaterial> *list, QQuick3DMaterial *material);
     static QQuick3DMaterial *qmlMaterialAt(QQmlListProperty<QQuick3DMaterial> *list, qsizetype index);
@@ -238,6 +259,8 @@ private:
     float m_instancingLodMin = -1;
     float m_instancingLodMax = -1;
     float m_levelOfDetailBias = 1.0f;
+    bool m_asynchronous = false;
+    Status m_status = Null;
 };
 
 QT_END_NAMESPACE
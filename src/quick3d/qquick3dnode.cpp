@@ -56,6 +56,7 @@ void QQuick3DNodePrivate::setLocalTransform(const QMatrix4x4 &transform)
     // We'd likely want some way to notify about this, but for now the transform
     // can potentially change silently.
     m_localTransform = transform;
+    m_localTransformDirty = false;
     // Note: If any of the transform properties are set before the update
     // the explicit local transform should be ignored by setting this value to false.
     m_hasExplicitLocalTransform = true;
@@ -379,11 +380,28 @@ QMatrix4x4 QQuick3DNode::sceneTransform() const
     return d->m_sceneTransform;
 }
 
+QMatrix4x4 QQuick3DNodePrivate::calculateLocalTransform()
+{
+    // The same matrix is used for sceneTransform() and handed to the backend node
+    // on sync, so it's only calculated once per change.
+    if (m_localTransformDirty && !m_hasExplicitLocalTransform)
+        m_localTransform = QSSGRenderNode::calculateTransformMatrix(m_position, m_scale, m_pivot, m_rotation);
+    m_localTransformDirty = false;
+    return m_localTransform;
+}
+
+void QQuick3DNodePrivate::markLocalTransformDirty()
+{
+    m_localTransformDirty = true;
+    m_localTransformSyncDirty = true;
+    markSceneTransformDirty();
+}
+
 void QQuick3DNodePrivate::calculateGlobalVariables()
 {
     Q_Q(QQuick3DNode);
     m_sceneTransformDirty = false;
-    QMatrix4x4 localTransform = QSSGRenderNode::calculateTransformMatrix(m_position, m_scale, m_pivot, m_rotation);
+    const QMatrix4x4 localTransform = calculateLocalTransform();
     QQuick3DNode *parent = q->parentNode();
     if (!parent) {
         m_sceneTransform = localTransform;
@@ -588,7 +606,7 @@ void QQuick3DNode::setX(float x)
         return;
 
     d->m_position.setX(x);
-    d->markSceneTransformDirty();
+    d->markLocalTransformDirty();
     emit positionChanged();
     emit xChanged();
     update();
@@ -601,7 +619,7 @@ void QQuick3DNode::setY(float y)
         return;
 
     d->m_position.setY(y);
-    d->markSceneTransformDirty();
+    d->markLocalTransformDirty();
     emit positionChanged();
     emit yChanged();
     update();
@@ -614,7 +632,7 @@ void QQuick3DNode::setZ(float z)
         return;
 
     d->m_position.setZ(z);
-    d->markSceneTransformDirty();
+    d->markLocalTransformDirty();
     emit positionChanged();
     emit zChanged();
     update();
@@ -628,7 +646,7 @@ void QQuick3DNode::setRotation(const QQuaternion &rotation)
 
     d->m_hasExplicitLocalTransform = false;
     d->m_rotation = rotation;
-    d->markSceneTransformDirty();
+    d->markLocalTransformDirty();
     emit rotationChanged();
     emit eulerRotationChanged();
 
@@ -646,7 +664,7 @@ void QQuick3DNode::setPosition(const QVector3D &position)
     const bool zUnchanged = qFuzzyCompare(position.z(), d->m_position.z());
 
     d->m_position = position;
-    d->markSceneTransformDirty();
+    d->markLocalTransformDirty();
     emit positionChanged();
 
     if (!xUnchanged)
@@ -669,7 +687,7 @@ void QQuick3DNode::setScale(const QVector3D &scale)
 
     d->m_hasExplicitLocalTransform = false;
     d->m_scale = scale;
-    d->markSceneTransformDirty();
+    d->markLocalTransformDirty();
     emit scaleChanged();
     update();
 }
@@ -682,7 +700,7 @@ void QQuick3DNode::setPivot(const QVector3D &pivot)
 
     d->m_hasExplicitLocalTransform = false;
     d->m_pivot = pivot;
-    d->markSceneTransformDirty();
+    d->markLocalTransformDirty();
     emit pivotChanged();
     update();
 }
@@ -730,7 +748,7 @@ void QQuick3DNode::setEulerRotation(const QVector3D &eulerRotation) {
     d->m_rotation = eulerRotation;
 
     emit rotationChanged();
-    d->markSceneTransformDirty();
+    d->markLocalTransformDirty();
     emit eulerRotationChanged();
     update();
 }
@@ -783,7 +801,7 @@ void QQuick3DNode::rotate(qreal degrees, const QVector3D &axis, TransformSpace s
 
     d->m_hasExplicitLocalTransform = false;
     d->m_rotation = newRotationQuaternion;
-    d->markSceneTransformDirty();
+    d->markLocalTransformDirty();
 
     emit rotationChanged();
     emit eulerRotationChanged();
@@ -812,23 +830,16 @@ QSSGRenderGraphObject *QQuick3DNode::updateSpatialNode(QSSGRenderGraphObject *no
         spacialNode->markDirty(QSSGRenderNode::DirtyFlag::OpacityDirty);
     }
 
-    if (d->m_hasExplicitLocalTransform) {
-        spacialNode->localTransform = d->m_localTransform;
+    // The local transform is tracked on the frontend, no need to decompose the
+    // backend's matrix to find out if it changed.
+    if (transformIsDirty || d->m_localTransformSyncDirty || d->m_hasExplicitLocalTransform) {
+        spacialNode->localTransform = d->calculateLocalTransform();
         spacialNode->markDirty(QSSGRenderNode::DirtyFlag::TransformDirty);
-        d->m_hasExplicitLocalTransform = false;
-    } else {
-        if (!transformIsDirty && !qFuzzyCompare(d->m_position, QSSGUtils::mat44::getPosition(spacialNode->localTransform)))
-            transformIsDirty = true;
-
-        if (!transformIsDirty && !qFuzzyCompare(d->m_scale, QSSGUtils::mat44::getScale(spacialNode->localTransform)))
-            transformIsDirty = true;
-
-        if (!transformIsDirty && !qFuzzyCompare(d->m_rotation, QQuaternion::fromRotationMatrix(QSSGUtils::mat44::getUpper3x3(spacialNode->localTransform))))
-            transformIsDirty = true;
-
-        if (transformIsDirty) {
-            spacialNode->localTransform = QSSGRenderNode::calculateTransformMatrix(d->m_position, d->m_scale, d->m_pivot, d->m_rotation);;
-            spacialNode->markDirty(QSSGRenderNode::DirtyFlag::TransformDirty);
+        d->m_localTransformSyncDirty = false;
+        if (d->m_hasExplicitLocalTransform) {
+            d->m_hasExplicitLocalTransform = false;
+            // Properties might not represent the explicit transform exactly
+            d->m_localTransformDirty = true;
         }
     }
 
@@ -988,6 +999,7 @@ void QQuick3DNode::markAllDirty()
 {
     Q_D(QQuick3DNode);
 
+    d->m_localTransformSyncDirty = true;
     d->markSceneTransformDirty();
     QQuick3DObject::markAllDirty();
 }
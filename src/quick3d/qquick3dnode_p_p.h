@@ -43,6 +43,7 @@ public:
 
     QMatrix4x4 calculateLocalTransform();
     void calculateGlobalVariables();
+    void markLocalTransformDirty();
     void markSceneTransformDirty();
 
     inline QMatrix4x4 localRotationMatrix() const;
@@ -68,6 +69,8 @@ public:
     QMatrix4x4 m_sceneTransform; // Right handed
     QMatrix4x4 m_localTransform; // Right handed
     bool m_sceneTransformDirty = true;
+    bool m_localTransformDirty = true;
+    bool m_localTransformSyncDirty = true; // changed since the last updateSpatialNode()
     int m_sceneTransformConnectionCount = 0;
     int m_directionConnectionCount = 0;
     bool m_isHiddenInEditor = false;
@@ -397,12 +397,15 @@ static const char *textureFormatStr(QRhiTexture::Format format)
 
 static inline void printRenderPassDetails(QString *dst, const QSSGRhiContextStats::RenderPassInfo &rp)
 {
-    *dst += QString::asprintf("| %s | %dx%d | %llu | %llu |\n",
+    // Passes without culling of their own leave the column empty
+    const QString culled = rp.culling ? QString::number(rp.culledObjectCount) : QString();
+    *dst += QString::asprintf("| %s | %dx%d | %llu | %llu | %s |\n",
                               rp.rtName.constData(),
                               rp.pixelSize.width(),
                               rp.pixelSize.height(),
                               QSSGRhiContextStats::totalVertexCountForPass(rp),
-                              QSSGRhiContextStats::totalDrawCallCountForPass(rp));
+                              QSSGRhiContextStats::totalDrawCallCountForPass(rp),
+                              qPrintable(culled));
 }
 
 static inline QByteArray nameForRenderMesh(const QSSGRenderMesh *mesh)
@@ -448,8 +451,8 @@ void QQuick3DRenderStats::processRhiContextStats()
             + (data.externalRenderPass.pixelSize.isEmpty() ? 0 : 1);
 
     QString renderPassDetails = QLatin1String(R"(
-| Name | Size | Vertices | Draw calls |
-| ---- | ---- | -------- | ---------- |
+| Name | Size | Vertices | Draw calls | Culled |
+| ---- | ---- | -------- | ---------- | ------ |
 )");
 
     if (!data.externalRenderPass.pixelSize.isEmpty())
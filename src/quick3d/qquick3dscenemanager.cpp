@@ -5,6 +5,7 @@
 #include "qquick3dobject_p.h"
 #include "qquick3dviewport_p.h"
 #include "qquick3dmodel_p.h"
+#include "qquick3dtexture_p.h"
 
 #include <QtQuick/QQuickWindow>
 
@@ -13,6 +14,7 @@
 #include <QtQuick3DRuntimeRender/private/qssgrendermodel_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgrenderer_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgrenderimage_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderbuffermanager_p.h>
 
 #include <QtQuick3DUtils/private/qssgassert_p.h>
 
@@ -141,13 +143,78 @@ void QQuick3DSceneManager::updateBoundingBoxes(QSSGBufferManager &mgr)
             continue;
         auto model = static_cast<QSSGRenderModel *>(itemPriv->spatialNode);
         if (model) {
-            QSSGBounds3 bounds = mgr.getModelBounds(model);
-            static_cast<QQuick3DModel *>(object)->setBounds(bounds.minimum, bounds.maximum);
+            auto quickModel = static_cast<QQuick3DModel *>(object);
+            if (QSSGBufferManager::canLoadMeshAsync(*model)) {
+                // Keep the model in the list until its mesh has been loaded in the background. The
+                // load is started from here as well, as hidden models are never prepared for rendering.
+                mgr.requestMeshLoad(*model);
+                const auto loadStatus = mgr.meshLoadStatus(*model);
+                if (loadStatus == QSSGBufferManager::LoadStatus::Loading) {
+                    quickModel->setStatus(QQuick3DModel::Loading);
+                    continue;
+                }
+                QSSGBounds3 bounds = mgr.getModelBounds(model);
+                quickModel->setBounds(bounds.minimum, bounds.maximum);
+                if (loadStatus == QSSGBufferManager::LoadStatus::Null)
+                    quickModel->setStatus(QQuick3DModel::Null);
+                else if (loadStatus == QSSGBufferManager::LoadStatus::Error)
+                    quickModel->setStatus(QQuick3DModel::Error);
+                else
+                    quickModel->setStatus(QQuick3DModel::Ready);
+            } else {
+                QSSGBounds3 bounds = mgr.getModelBounds(model);
+                quickModel->setBounds(bounds.minimum, bounds.maximum);
+                if (model->meshPath.isNull() && !model->geometry)
+                    quickModel->setStatus(QQuick3DModel::Null);
+                else
+                    quickModel->setStatus(bounds.isEmpty() ? QQuick3DModel::Error : QQuick3DModel::Ready);
+            }
         }
         dirtyBoundingBoxList.removeOne(object);
     }
 }
 
+void QQuick3DSceneManager::updateTextureStatuses(QSSGBufferManager &mgr)
+{
+    const QList<QQuick3DObject *> dirtyList = dirtyTextureStatusList;
+    for (auto object : dirtyList) {
+        QQuick3DObjectPrivate *itemPriv = QQuick3DObjectPrivate::get(object);
+        if (itemPriv->sceneManager == nullptr)
+            continue;
+        auto image = static_cast<QSSGRenderImage *>(itemPriv->spatialNode);
+        if (image) {
+            auto quickTexture = static_cast<QQuick3DTexture *>(object);
+            if (quickTexture->source().isEmpty()) {
+                const bool hasContent = quickTexture->hasSourceData() || quickTexture->textureProvider();
+                quickTexture->setStatus(hasContent ? QQuick3DTexture::Ready : QQuick3DTexture::Null);
+            } else {
+                // Keep the texture in the list until its image has been loaded. Images are
+                // loaded by the prepare pass of the materials that use them, for textures that
+                // no material samples the image is loaded in the background instead. For
+                // synchronous textures that is only done once a frame has been prepared without
+                // them, so that the image isn't loaded twice.
+                if (image->m_asyncLoading || unusedTextures.contains(object))
+                    mgr.requestImageLoad(*image);
+                const auto loadStatus = mgr.imageLoadStatus(*image);
+                if (loadStatus == QSSGBufferManager::LoadStatus::Loading) {
+                    quickTexture->setStatus(QQuick3DTexture::Loading);
+                    if (!image->m_asyncLoading && !unusedTextures.contains(object)) {
+                        unusedTextures.insert(object);
+                        requestUpdate();
+                    }
+                    continue;
+                }
+                if (loadStatus == QSSGBufferManager::LoadStatus::Error)
+                    quickTexture->setStatus(QQuick3DTexture::Error);
+                else
+                    quickTexture->setStatus(QQuick3DTexture::Ready);
+            }
+        }
+        dirtyTextureStatusList.removeOne(object);
+        unusedTextures.remove(object);
+    }
+}
+
 QQuick3DSceneManager::SyncResult QQuick3DSceneManager::updateDirtyResourceNodes()
 {
     SyncResult ret = SyncResultFlag::None;
@@ -665,6 +732,9 @@ QQuick3DWindowAttachment::SyncResult QQuick3DWindowAttachment::synchronize(QSet<
     // Bounding Boxes
     for (auto &sceneManager : std::as_const(sceneManagers))
         sceneManager->updateBoundingBoxes(*m_rci->bufferManager());
+    // Texture Status
+    for (auto &sceneManager : std::as_const(sceneManagers))
+        sceneManager->updateTextureStatuses(*m_rci->bufferManager());
     // Resource Loaders
     for (auto &sceneManager : std::as_const(sceneManagers))
         resourceLoaders.unite(sceneManager->resourceLoaders);
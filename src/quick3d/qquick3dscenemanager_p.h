@@ -113,6 +113,7 @@ public:
     void updateDirtyResource(QQuick3DObject *resourceObject);
     void updateDirtySpatialNode(QQuick3DNode *spatialNode);
     void updateBoundingBoxes(QSSGBufferManager &mgr);
+    void updateTextureStatuses(QSSGBufferManager &mgr);
 
     QQuick3DObject *lookUpNode(const QSSGRenderGraphObject *node) const;
 
@@ -171,6 +172,9 @@ public:
     QSet<QQuick3DObject *> dirtySecondPassResources;
 
     QList<QQuick3DObject *> dirtyBoundingBoxList;
+    QList<QQuick3DObject *> dirtyTextureStatusList;
+    // Textures that were not used by the last frame's prepare pass (see updateTextureStatuses())
+    QSet<QQuick3DObject *> unusedTextures;
     QSet<QSSGRenderGraphObject *> cleanupNodeList;
     QList<QSSGRenderGraphObject *> resourceCleanupQueue;
 
@@ -18,6 +18,7 @@
 
 #include <QtQuick3DRuntimeRender/private/qssgrendererutil_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgrenderer_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgpicksnapshot_p.h>
 
 #include <QtQuick/private/qquickwindow_p.h>
 #include <QtQuick/private/qsgdefaultrendercontext_p.h>
@@ -40,6 +41,8 @@
 #include <QtCore/QObject>
 #include <QtCore/qqueue.h>
 
+#include <atomic>
+
 QT_BEGIN_NAMESPACE
 
 Q_TRACE_PREFIX(qtquick3d,
@@ -59,6 +62,11 @@ Q_TRACE_POINT(qtquick3d, QSSG_renderPass_exit);
 
 static bool dumpRenderTimes = false;
 
+// Bumped on every synchronize() of any View3D. Resources can be shared between the
+// View3Ds (and windows), so a layer is only considered unchanged when nothing at all
+// was synchronized since its previous frame.
+static std::atomic<quint64> s_sceneRevision { 1 };
+
 #if QT_CONFIG(qml_debug)
 
 static inline quint64 statDrawCallCount(const QSSGRhiContextStats &stats)
@@ -511,12 +519,19 @@ QRhiTexture *QQuick3DSceneRenderer::renderToRhiTexture(QQuickWindow *qw)
 
 void QQuick3DSceneRenderer::beginFrame()
 {
+    m_layer->sceneRevision = s_sceneRevision.load(std::memory_order_relaxed);
     m_sgContext->renderer()->beginFrame(*m_layer);
 }
 
 void QQuick3DSceneRenderer::endFrame()
 {
     m_sgContext->renderer()->endFrame(*m_layer);
+
+    // Keep rendering until meshes and images that are loaded in the background, and
+    // mesh levels of detail that are streamed in, have been picked up
+    const auto &bufferManager = m_sgContext->bufferManager();
+    if (bufferManager->hasPendingMeshLoads() || bufferManager->hasPendingImageLoads() || bufferManager->hasPendingMeshLodRequests())
+        requestedFramesCount = qMax(requestedFramesCount, 1);
 }
 
 void QQuick3DSceneRenderer::rhiPrepare(const QRect &viewport, qreal displayPixelRatio)
@@ -605,6 +620,8 @@ void QQuick3DSceneRenderer::synchronize(QQuick3DViewport *view3D, const QSize &s
 
     Q_QUICK3D_PROFILE_START(QQuick3DProfiler::Quick3DSynchronizeFrame);
 
+    ++s_sceneRevision;
+
     m_sgContext->renderer()->setDpr(dpr);
     bool layerSizeIsDirty = m_surfaceSize != size;
     m_surfaceSize = size;
@@ -831,6 +848,11 @@ void QQuick3DSceneRenderer::synchronize(QQuick3DViewport *view3D, const QSize &s
         }
     }
 
+    if (view3D->pipelineWarmupRequested()) {
+        m_layer->renderData->pipelineWarmupRequested = true;
+        view3D->clearPipelineWarmupRequested();
+    }
+
     const bool progressiveAA = m_layer->antialiasingMode == QSSGRenderLayer::AAMode::ProgressiveAA;
     const bool multiSamplingAA = m_layer->antialiasingMode == QSSGRenderLayer::AAMode::MSAA;
     const bool temporalAA = m_layer->temporalAAEnabled && !multiSamplingAA;
@@ -1160,6 +1182,14 @@ QQuick3DSceneRenderer::PickResultList QQuick3DSceneRenderer::syncPickAll(const Q
                                             ray);
 }
 
+std::shared_ptr<const QSSGPickSnapshot> QQuick3DSceneRenderer::pickSnapshot()
+{
+    if (!m_layer)
+        return {};
+
+    return QSSGPickSnapshot::create(*m_sgContext, *m_layer);
+}
+
 void QQuick3DSceneRenderer::setGlobalPickingEnabled(bool isEnabled)
 {
     QSSGRendererPrivate::setGlobalPickingEnabled(*m_sgContext->renderer(), isEnabled);
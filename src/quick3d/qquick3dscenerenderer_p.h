@@ -28,6 +28,7 @@
 
 #include <QtCore/qpointer.h>
 
+#include <memory>
 #include <optional>
 
 #include "qquick3dsceneenvironment_p.h"
@@ -38,6 +39,7 @@ QT_BEGIN_NAMESPACE
 class QQuick3DSceneManager;
 class QQuick3DViewport;
 struct QSSGRenderLayer;
+class QSSGPickSnapshot;
 
 class QQuick3DSceneRenderer
 {
@@ -72,6 +74,8 @@ protected:
     PickResultList syncPickOne(const QSSGRenderRay &ray, QSSGRenderNode *node);
     PickResultList syncPickSubset(const QSSGRenderRay &ray, QVarLengthArray<QSSGRenderNode *> subset);
     PickResultList syncPickAll(const QSSGRenderRay &ray);
+    // Copy of the pickable state of the layer that can be queried from any thread
+    std::shared_ptr<const QSSGPickSnapshot> pickSnapshot();
 
     void setGlobalPickingEnabled(bool isEnabled);
 
@@ -671,6 +671,64 @@ QQuick3DRenderExtension *QQuick3DTexture::textureProvider() const
     return m_renderExtension;
 }
 
+/*!
+    \qmlproperty bool QtQuick3D::Texture::asynchronous
+    \since 6.9
+
+    When this property is \c true, the image file given by \l source is
+    decoded, and scanned for transparency, on a worker thread instead of
+    blocking the frame that first uses it. Until the image data has been
+    uploaded, materials sample a placeholder texture instead: a flat normal for
+    normal maps, black for emissive maps and opaque white otherwise. Use \l
+    status to find out when the image is ready. Lightmap baking always waits
+    for the image.
+
+    Textures used as a light probe or as a cube map are always loaded
+    synchronously, as is texture content provided by \l sourceItem,
+    \l textureData or \l textureProvider.
+
+    The default value is \c false.
+
+    \sa status
+*/
+
+bool QQuick3DTexture::asynchronous() const
+{
+    return m_asynchronous;
+}
+
+/*!
+    \qmlproperty enumeration QtQuick3D::Texture::status
+    \since 6.9
+    \readonly
+
+    This property holds the loading status of the texture's image.
+
+    \value Texture.Null No texture content has been set.
+    \value Texture.Ready The texture content has been loaded.
+    \value Texture.Loading The image is being loaded, see \l asynchronous.
+    \value Texture.Error An error occurred while loading the image.
+
+    \note An image set with \l source is loaded by the first material that
+    uses the Texture. The image of a Texture that no material uses is loaded in
+    the background, for the status only.
+
+    \sa asynchronous
+*/
+
+QQuick3DTexture::Status QQuick3DTexture::status() const
+{
+    return m_status;
+}
+
+void QQuick3DTexture::setStatus(Status status)
+{
+    if (m_status == status)
+        return;
+    m_status = status;
+    emit statusChanged();
+}
+
 void QQuick3DTexture::setSource(const QUrl &source)
 {
     if (m_source == source)
@@ -956,6 +1014,17 @@ void QQuick3DTexture::setGenerateMipmaps(bool generateMipmaps)
     update();
 }
 
+void QQuick3DTexture::setAsynchronous(bool asynchronous)
+{
+    if (m_asynchronous == asynchronous)
+        return;
+
+    m_asynchronous = asynchronous;
+    m_dirtyFlags.setFlag(DirtyFlag::SourceDirty);
+    emit asynchronousChanged();
+    update();
+}
+
 void QQuick3DTexture::setAutoOrientation(bool autoOrientation)
 {
     if (m_autoOrientation == autoOrientation)
@@ -1099,6 +1168,11 @@ QSSGRenderGraphObject *QQuick3DTexture::updateSpatialNode(QSSGRenderGraphObject
         } else {
             imageNode->m_imagePath = QSSGRenderPath();
         }
+        imageNode->m_asyncLoading = m_asynchronous;
+        if (auto *sceneManager = QQuick3DObjectPrivate::get(this)->sceneManager) {
+            if (!sceneManager->dirtyTextureStatusList.contains(this))
+                sceneManager->dirtyTextureStatusList.append(this);
+        }
         nodeChanged = true;
     }
     if (m_dirtyFlags.testFlag(DirtyFlag::IndexUVDirty)) {
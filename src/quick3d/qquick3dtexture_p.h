@@ -56,6 +56,8 @@ class Q_QUICK3D_EXPORT QQuick3DTexture : public QQuick3DObject, public QQuickIte
     Q_PROPERTY(Filter mipFilter READ mipFilter WRITE setMipFilter NOTIFY mipFilterChanged)
     Q_PROPERTY(bool generateMipmaps READ generateMipmaps WRITE setGenerateMipmaps NOTIFY generateMipmapsChanged)
     Q_PROPERTY(bool autoOrientation READ autoOrientation WRITE setAutoOrientation NOTIFY autoOrientationChanged REVISION(6, 2))
+    Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous NOTIFY asynchronousChanged REVISION(6, 9))
+    Q_PROPERTY(Status status READ status NOTIFY statusChanged REVISION(6, 9))
 
     QML_NAMED_ELEMENT(Texture)
 
@@ -83,6 +85,14 @@ public:
     };
     Q_ENUM(Filter)
 
+    enum Status {
+        Null,
+        Ready,
+        Loading,
+        Error
+    };
+    Q_ENUM(Status)
+
     explicit QQuick3DTexture(QQuick3DObject *parent = nullptr);
     ~QQuick3DTexture() override;
 
@@ -108,6 +118,8 @@ public:
     QQuick3DTextureData *textureData() const;
     bool generateMipmaps() const;
     bool autoOrientation() const;
+    Q_REVISION(6, 9) bool asynchronous() const;
+    Q_REVISION(6, 9) Status status() const;
 
     QSSGRenderImage *getRenderImage();
 
@@ -144,6 +156,7 @@ public Q_SLOTS:
     void setTextureData(QQuick3DTextureData * textureData);
     void setGenerateMipmaps(bool generateMipmaps);
     void setAutoOrientation(bool autoOrientation);
+    Q_REVISION(6, 9) void setAsynchronous(bool asynchronous);
 
 Q_SIGNALS:
     void sourceChanged();
@@ -169,6 +182,8 @@ Q_SIGNALS:
     void generateMipmapsChanged();
     void autoOrientationChanged();
     Q_REVISION(6, 7) void textureProviderChanged();
+    Q_REVISION(6, 9) void asynchronousChanged();
+    Q_REVISION(6, 9) void statusChanged();
 
 protected:
     QSSGRenderGraphObject *updateSpatialNode(QSSGRenderGraphObject *node) override;
@@ -183,6 +198,8 @@ private Q_SLOTS:
     void sourceItemDestroyed(QObject *item);
 
 private:
+    friend class QQuick3DSceneManager;
+
     enum class DirtyFlag {
         TransformDirty = (1 << 0),
         SourceDirty = (1 << 1),
@@ -196,6 +213,7 @@ private:
     Q_DECLARE_FLAGS(DirtyFlags, DirtyFlag)
     void markDirty(DirtyFlag type);
     void trySetSourceParent();
+    void setStatus(Status status);
     bool effectiveFlipV(const QSSGRenderImage &imageNode) const;
 
     QUrl m_source;
@@ -235,6 +253,8 @@ private:
     QQuick3DTextureData *m_textureData = nullptr;
     bool m_generateMipmaps = false;
     bool m_autoOrientation = true;
+    bool m_asynchronous = false;
+    Status m_status = Null;
     QMetaMethod m_updateSlot;
     QQuick3DRenderExtension *m_renderExtension = nullptr;
 };
@@ -19,6 +19,8 @@
 #include <QtQuick3DRuntimeRender/private/qssgrenderlayer_p.h>
 #include <QtQuick3DRuntimeRender/private/qssglayerrenderdata_p.h>
 
+#include <QtQuick3DRuntimeRender/private/qssgpicksnapshot_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderray_p.h>
 #include <QtQuick3DUtils/private/qssgassert_p.h>
 
 #include <qsgtextureprovider.h>
@@ -48,6 +50,9 @@ static bool isforceInputHandlingSet()
     return v;
 }
 
+// Rays tested by each of the worker tasks of a batched pick
+static constexpr qsizetype PICK_BATCH_CHUNK_SIZE = 64;
+
 struct ViewportTransformHelper : public QQuickDeliveryAgent::Transform
 {
     static void removeAll() {
@@ -1227,6 +1232,180 @@ QList<QQuick3DPickResult> QQuick3DViewport::rayPickAll(const QVector3D &origin,
     return processedResultList;
 }
 
+/*!
+    \qmlmethod int View3D::requestPickBatch(list<point> positions)
+
+    This method will "shoot" a ray into the scene from each of the view coordinates
+    in \a positions, like pick() does, without blocking the caller. The rays are tested
+    on worker threads against a copy of the scene taken when the method is called, so
+    later changes to the scene do not affect the results. The exception is objects that
+    are destroyed or removed from the scene before the results are delivered: they are
+    left out, and the ray reports the nearest remaining hit instead.
+
+    Returns an id for the request. Once all the rays have been tested, the
+    pickBatchFinished() signal is emitted with this id and a list holding the nearest
+    intersection for each position, in the same order as \a positions. Positions that
+    don't hit anything get a result with the hitType \c PickResult.Null.
+
+    This can, for instance, be used when a large number of points has to be picked at
+    once, where calling pick() for each of them would stall the user interface.
+
+    \since 6.9
+*/
+int QQuick3DViewport::requestPickBatch(const QList<QPointF> &positions)
+{
+    const int requestId = ++m_pickBatchRequestId;
+    pickBatch(positions).then(this, [this, requestId](QList<QQuick3DPickResult> results) {
+        emit pickBatchFinished(requestId, results);
+    });
+    return requestId;
+}
+
+/*!
+    \qmlmethod int View3D::requestRayPickBatch(list<vector3d> origins, list<vector3d> directions)
+
+    This method will "shoot" a ray into the scene for each pair of \a origins and
+    \a directions, like rayPick() does, without blocking the caller. The two lists
+    must have the same length.
+
+    Returns an id for the request. Once all the rays have been tested, the
+    pickBatchFinished() signal is emitted with this id and a list holding the nearest
+    intersection for each ray, in the same order as \a origins. Rays that don't hit
+    anything get a result with the hitType \c PickResult.Null.
+
+    \sa requestPickBatch()
+    \since 6.9
+*/
+int QQuick3DViewport::requestRayPickBatch(const QList<QVector3D> &origins, const QList<QVector3D> &directions)
+{
+    const int requestId = ++m_pickBatchRequestId;
+    rayPickBatch(origins, directions).then(this, [this, requestId](QList<QQuick3DPickResult> results) {
+        emit pickBatchFinished(requestId, results);
+    });
+    return requestId;
+}
+
+/*!
+    \qmlsignal QtQuick3D::View3D::pickBatchFinished(int requestId, list<pickResult> results)
+
+    This signal is emitted when the rays of the request with the id \a requestId, as
+    returned by requestPickBatch() or requestRayPickBatch(), have been tested.
+    \a results holds the nearest intersection for each ray of the request.
+
+    The corresponding handler is \c onPickBatchFinished.
+
+    \since 6.9
+*/
+
+QFuture<QList<QQuick3DPickResult>> QQuick3DViewport::pickBatch(const QList<QPointF> &positions)
+{
+    QQuick3DSceneRenderer *renderer = getRenderer();
+    if (!renderer)
+        return QtFuture::makeReadyValueFuture(QList<QQuick3DPickResult>(positions.size()));
+
+    const qreal xScale = window()->effectiveDevicePixelRatio() * m_widthMultiplier;
+    const qreal yScale = window()->effectiveDevicePixelRatio() * m_heightMultiplier;
+    QList<std::optional<QSSGRenderRay>> rays;
+    rays.reserve(positions.size());
+    for (const QPointF &position : positions)
+        rays.append(renderer->getRayFromViewportPos(QPointF(position.x() * xScale, position.y() * yScale)));
+
+    return pickRays(std::move(rays));
+}
+
+QFuture<QList<QQuick3DPickResult>> QQuick3DViewport::rayPickBatch(const QList<QVector3D> &origins, const QList<QVector3D> &directions)
+{
+    if (origins.size() != directions.size()) {
+        qmlWarning(this) << "The number of origins and directions passed for picking differ.";
+        return QtFuture::makeReadyValueFuture(QList<QQuick3DPickResult>());
+    }
+
+    QList<std::optional<QSSGRenderRay>> rays;
+    rays.reserve(origins.size());
+    for (qsizetype i = 0, end = origins.size(); i != end; ++i)
+        rays.append(QSSGRenderRay(origins.at(i), directions.at(i)));
+
+    return pickRays(std::move(rays));
+}
+
+QFuture<QList<QQuick3DPickResult>> QQuick3DViewport::pickRays(QList<std::optional<QSSGRenderRay>> &&rays)
+{
+    const qsizetype rayCount = rays.size();
+    QQuick3DSceneRenderer *renderer = getRenderer();
+    std::shared_ptr<const QSSGPickSnapshot> snapshot = renderer ? renderer->pickSnapshot() : nullptr;
+    if (!snapshot || rayCount == 0)
+        return QtFuture::makeReadyValueFuture(QList<QQuick3DPickResult>(rayCount));
+
+    // The backend nodes in the snapshot may be gone, and their addresses reused, by the
+    // time the hits come back. Remember which object each of them belongs to now, while
+    // they are known to be alive.
+    QHash<const QSSGRenderGraphObject *, QPointer<QQuick3DObject>> frontendNodes;
+    frontendNodes.reserve(snapshot->itemCount());
+    for (qsizetype i = 0, end = snapshot->itemCount(); i != end; ++i) {
+        const QSSGRenderNode *node = snapshot->itemNode(i);
+        frontendNodes.insert(node, findFrontendNode(node));
+    }
+
+    // All hits of each ray, the hits are turned into pick results on this thread as the
+    // frontend objects can't be looked up on the worker threads.
+    using RayHits = std::vector<QList<QSSGRenderPickResult>>;
+    struct PickBatch
+    {
+        std::shared_ptr<const QSSGPickSnapshot> snapshot;
+        QList<std::optional<QSSGRenderRay>> rays;
+        RayHits hits;
+        QAtomicInteger<qsizetype> remainingChunks;
+        QPromise<RayHits> promise;
+    };
+
+    const qsizetype chunkCount = (rayCount + PICK_BATCH_CHUNK_SIZE - 1) / PICK_BATCH_CHUNK_SIZE;
+    auto batch = std::make_shared<PickBatch>();
+    batch->snapshot = std::move(snapshot);
+    batch->rays = std::move(rays);
+    batch->hits.resize(rayCount);
+    batch->remainingChunks.storeRelaxed(chunkCount);
+    batch->promise.start();
+    QFuture<RayHits> future = batch->promise.future();
+
+    for (qsizetype chunk = 0; chunk != chunkCount; ++chunk) {
+        QThreadPool::globalInstance()->start([batch, chunk]() {
+            const qsizetype begin = chunk * PICK_BATCH_CHUNK_SIZE;
+            const qsizetype end = qMin(begin + PICK_BATCH_CHUNK_SIZE, batch->rays.size());
+            for (qsizetype i = begin; i != end; ++i) {
+                if (const auto &ray = batch->rays.at(i)) {
+                    const auto hits = batch->snapshot->pick(*ray);
+                    batch->hits[i] = QList<QSSGRenderPickResult>(hits.cbegin(), hits.cend());
+                }
+            }
+            // The last chunk to finish hands the hits over
+            if (batch->remainingChunks.fetchAndSubOrdered(1) == 1) {
+                batch->promise.addResult(std::move(batch->hits));
+                batch->promise.finish();
+            }
+        });
+    }
+
+    return future.then(this, [this, frontendNodes = std::move(frontendNodes)](RayHits rayHits) {
+        QList<QQuick3DPickResult> results;
+        results.reserve(qsizetype(rayHits.size()));
+        for (const auto &hits : rayHits) {
+            QQuick3DPickResult nearest;
+            for (const auto &hit : hits) {
+                // Hits on objects that were deleted or removed from the scene in the
+                // meantime are dropped
+                QQuick3DObject *frontendObject = frontendNodes.value(hit.m_hitObject);
+                if (!frontendObject || findFrontendNode(hit.m_hitObject) != frontendObject)
+                    continue;
+                nearest = processPickResult(hit, frontendObject);
+                if (nearest.hitType() != QQuick3DPickResultEnums::HitType::Null)
+                    break;
+            }
+            results.append(nearest);
+        }
+        return results;
+    });
+}
+
 void QQuick3DViewport::processPointerEventFromRay(const QVector3D &origin, const QVector3D &direction, QPointerEvent *event)
 {
     internalPick(event, origin, direction);
@@ -1984,8 +2163,11 @@ QQuick3DPickResult QQuick3DViewport::processPickResult(const QSSGRenderPickResul
     if (!pickResult.m_hitObject)
         return QQuick3DPickResult();
 
-    QQuick3DObject *frontendObject = findFrontendNode(pickResult.m_hitObject);
+    return processPickResult(pickResult, findFrontendNode(pickResult.m_hitObject));
+}
 
+QQuick3DPickResult QQuick3DViewport::processPickResult(const QSSGRenderPickResult &pickResult, QQuick3DObject *frontendObject) const
+{
     QQuick3DModel *model = qobject_cast<QQuick3DModel *>(frontendObject);
     if (model)
         return QQuick3DPickResult(model,
@@ -2074,4 +2256,35 @@ void QQuick3DViewport::rebuildExtensionList()
     update();
 }
 
+/*!
+    \qmlmethod void View3D::warmupPipelines()
+
+    Creates the graphics pipelines that were recorded for this application in
+    earlier runs, before the next frame is rendered.
+
+    Pipelines for the materials used in the scene are normally created when a
+    material is first rendered, which can cause a visible stutter. When the
+    automatic shader disk cache is enabled, the pipeline states used in the
+    main render pass are recorded and stored next to the cached shaders. Calling
+    this function, for example while a splash screen is shown, creates those
+    pipelines up front. Setting the environment variable
+    \c QT_QUICK3D_PIPELINE_WARMUP to \c 1 does the same on the first frame of
+    every View3D.
+
+    Only pipelines for the built-in materials in the main render pass are
+    recorded, and only pipelines whose render target format matches the
+    current one are created. Custom materials, effects, and the shadow,
+    reflection and other additional passes are not covered. Recorded states
+    whose shaders are no longer in the shader disk cache are skipped; the
+    number of skipped entries is reported in the debug output of the
+    \c QSSG.perf_info logging category.
+
+    \since 6.9
+*/
+void QQuick3DViewport::warmupPipelines()
+{
+    m_pipelineWarmupRequested = true;
+    update();
+}
+
 QT_END_NAMESPACE
@@ -17,6 +17,7 @@
 
 #include <QtQuick/QQuickItem>
 #include <QtCore/qurl.h>
+#include <QtCore/qfuture.h>
 
 #include <QtQuick3D/qtquick3dglobal.h>
 #include <QtQuick3D/private/qquick3dpickresult_p.h>
@@ -30,6 +31,8 @@
 #include "qquick3drenderstats_p.h"
 #include "qquick3dlightmapbaker_p.h"
 
+#include <optional>
+
 QT_BEGIN_NAMESPACE
 
 class QSSGView3DPrivate;
@@ -40,6 +43,7 @@ class QQuick3DSceneRootNode;
 class QQuick3DSceneRenderer;
 class QQuick3DRenderStats;
 class QQuick3DSceneManager;
+struct QSSGRenderRay;
 
 class SGFramebufferObjectNode;
 class QQuick3DSGRenderNode;
@@ -105,6 +109,13 @@ public:
     Q_REVISION(6, 2) Q_INVOKABLE QList<QQuick3DPickResult> pickAll(float x, float y) const;
     Q_REVISION(6, 2) Q_INVOKABLE QQuick3DPickResult rayPick(const QVector3D &origin, const QVector3D &direction) const;
     Q_REVISION(6, 2) Q_INVOKABLE QList<QQuick3DPickResult> rayPickAll(const QVector3D &origin, const QVector3D &direction) const;
+    Q_REVISION(6, 9) Q_INVOKABLE int requestPickBatch(const QList<QPointF> &positions);
+    Q_REVISION(6, 9) Q_INVOKABLE int requestRayPickBatch(const QList<QVector3D> &origins, const QList<QVector3D> &directions);
+
+    // Nearest hit for each of the positions (or rays), the rays are tested on worker threads
+    // against a snapshot of the scene taken when the function is called.
+    QFuture<QList<QQuick3DPickResult>> pickBatch(const QList<QPointF> &positions);
+    QFuture<QList<QQuick3DPickResult>> rayPickBatch(const QList<QVector3D> &origins, const QList<QVector3D> &directions);
 
     void processPointerEventFromRay(const QVector3D &origin, const QVector3D &direction, QPointerEvent *event);
     bool singlePointPick(QSinglePointEvent *event, const QVector3D &origin, const QVector3D &direction);
@@ -129,6 +140,10 @@ public:
 
     Q_REVISION(6, 7) Q_INVOKABLE void rebuildExtensionList();
 
+    Q_REVISION(6, 9) Q_INVOKABLE void warmupPipelines();
+    [[nodiscard]] bool pipelineWarmupRequested() const { return m_pipelineWarmupRequested; }
+    void clearPipelineWarmupRequested() { m_pipelineWarmupRequested = false; }
+
 protected:
     void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
     QSGNode *updatePaintNode(QSGNode *, UpdatePaintNodeData *) override;
@@ -168,6 +183,7 @@ Q_SIGNALS:
     Q_REVISION(6, 7) void explicitTextureWidthChanged();
     Q_REVISION(6, 7) void explicitTextureHeightChanged();
     Q_REVISION(6, 7) void effectiveTextureSizeChanged();
+    Q_REVISION(6, 9) void pickBatchFinished(int requestId, const QList<QQuick3DPickResult> &results);
 
 private:
     void setMultiViewCameras(QQuick3DCamera **firstCamera, int count);
@@ -210,6 +226,8 @@ private:
     QQuickItem *getSubSceneRootItem(QQuick3DMaterial *material) const;
     QQuick3DPickResult getNearestPickResult(const QVarLengthArray<QSSGRenderPickResult, 20> &pickResults) const;
     QQuick3DPickResult processPickResult(const QSSGRenderPickResult &pickResult) const;
+    QQuick3DPickResult processPickResult(const QSSGRenderPickResult &pickResult, QQuick3DObject *frontendObject) const;
+    QFuture<QList<QQuick3DPickResult>> pickRays(QList<std::optional<QSSGRenderRay>> &&rays);
     QQuick3DObject *findFrontendNode(const QSSGRenderGraphObject *backendObject) const;
     QQuick3DSceneManager *findChildSceneManager(QQuick3DObject *inObject, QQuick3DSceneManager *manager = nullptr);
     QQuick3DCamera *m_camera = nullptr;
@@ -235,6 +253,8 @@ private:
     QQuick3DLightmapBaker *m_lightmapBaker = nullptr;
     QList<QQuick3DObject *> m_extensions;
     bool m_extensionListDirty = false;
+    bool m_pipelineWarmupRequested = false;
+    int m_pickBatchRequestId = 0;
 
     struct TouchState {
         QQuickItem *target = nullptr;
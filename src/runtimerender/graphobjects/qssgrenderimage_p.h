@@ -77,6 +77,7 @@ struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGRenderImage : public QSSGRenderGraphObj
     QSSGRenderTextureFilterOp m_mipFilterType = QSSGRenderTextureFilterOp::Linear;
     QSSGRenderTextureFormat m_format = QSSGRenderTextureFormat::Unknown;
     bool m_generateMipmaps = false;
+    bool m_asyncLoading = false;
 
     // Changing any of the above variables is covered by the Dirty flag, while
     // the texture transform is covered by TransformDirty.
@@ -3,11 +3,19 @@
 
 #include "qssgrenderinstancetable_p.h"
 
+#include <algorithm>
+
 QMatrix4x4 QSSGRenderInstanceTable::getTransform(int index) const
 {
     Q_ASSERT(index < instanceCount);
     Q_ASSERT(table.size() == instanceStride * instanceCount);
-    auto *entry = reinterpret_cast<const QSSGRenderInstanceTableEntry*>(table.constData() + index * instanceStride);
+    return getTransform(table, instanceStride, index);
+}
+
+QMatrix4x4 QSSGRenderInstanceTable::getTransform(const QByteArray &data, int stride, int index)
+{
+    Q_ASSERT(qsizetype(index + 1) * stride <= data.size());
+    auto *entry = reinterpret_cast<const QSSGRenderInstanceTableEntry*>(data.constData() + index * stride);
 
     QMatrix4x4 res;
     res.setRow(0, entry->row0);
@@ -16,3 +24,44 @@ QMatrix4x4 QSSGRenderInstanceTable::getTransform(int index) const
     res.setRow(3, { 0, 0, 0, 1 });
     return res;
 }
+
+void QSSGRenderInstanceTable::setPartialData(const QByteArray &data, int count, int stride, const DirtyRanges &dirtyRanges)
+{
+    // Partial updates only make sense if the layout of the table is unchanged
+    const bool sameLayout = (data.size() == table.size()) && (stride == instanceStride) && stride > 0;
+    setData(data, count, stride);
+    if (!sameLayout || dirtyRanges.isEmpty())
+        return;
+
+    const int entryCount = int(data.size() / stride);
+    changedRanges.reserve(dirtyRanges.size());
+    for (const auto &range : dirtyRanges) {
+        const int offset = qBound(0, range.offset, entryCount);
+        const int end = qBound(offset, range.offset + range.count, entryCount);
+        if (end > offset)
+            changedRanges.push_back({ offset, end - offset });
+    }
+    mergeDirtyRanges(changedRanges);
+
+    // Everything changed, or nothing inside the table did. Either way, treat it as a full update.
+    if (changedRanges.size() == 1 && changedRanges.first().offset == 0 && changedRanges.first().count == entryCount)
+        changedRanges.clear();
+}
+
+void QSSGRenderInstanceTable::mergeDirtyRanges(DirtyRanges &ranges)
+{
+    if (ranges.size() < 2)
+        return;
+
+    std::sort(ranges.begin(), ranges.end(), [](const DirtyRange &a, const DirtyRange &b) { return a.offset < b.offset; });
+    qsizetype last = 0;
+    for (qsizetype i = 1, end = ranges.size(); i != end; ++i) {
+        auto &current = ranges[last];
+        const auto &next = ranges.at(i);
+        if (next.offset <= current.offset + current.count)
+            current.count = qMax(current.count, next.offset + next.count - current.offset);
+        else
+            ranges[++last] = next;
+    }
+    ranges.resize(last + 1);
+}
@@ -22,6 +22,8 @@
 #include <QtGui/qvectornd.h>
 #include <QtGui/qmatrix4x4.h>
 
+#include <QtCore/qvector.h>
+
 QT_BEGIN_NAMESPACE
 
 struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGRenderInstanceTableEntry {
@@ -34,12 +36,27 @@ struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGRenderInstanceTableEntry {
 
 struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGRenderInstanceTable : public QSSGRenderGraphObject
 {
+    // A range of instances, [offset, offset + count)
+    struct DirtyRange
+    {
+        int offset;
+        int count;
+    };
+    using DirtyRanges = QVector<DirtyRange>;
+
     QSSGRenderInstanceTable() : QSSGRenderGraphObject(QSSGRenderGraphObject::Type::ModelInstance, FlagT(Flags::HasGraphicsResources)) {}
 
     int count() const { return instanceCount; }
     qsizetype dataSize() const { return table.size(); }
     const void *constData() const { return table.constData(); }
-    void setData(const QByteArray &data, int count, int stride) { table = data; instanceCount = count; instanceStride = stride; ++instanceSerial; }
+    const QByteArray &data() const { return table; }
+    void setData(const QByteArray &data, int count, int stride) { table = data; instanceCount = count; instanceStride = stride; ++instanceSerial; changedRanges.clear(); }
+    // Same as setData(), but only the instances in dirtyRanges differ from the previous data.
+    void setPartialData(const QByteArray &data, int count, int stride, const DirtyRanges &dirtyRanges);
+    // The instances that changed between serial() - 1 and serial(). When empty, all data should be considered changed.
+    const DirtyRanges &dirtyRanges() const { return changedRanges; }
+    // Sorts and merges overlapping or adjacent ranges
+    static void mergeDirtyRanges(DirtyRanges &ranges);
     void setInstanceCountOverride(int count) { instanceCount = count; }
     int serial() const { return instanceSerial; }
     int stride() const { return instanceStride; }
@@ -48,6 +65,8 @@ struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGRenderInstanceTable : public QSSGRender
     void setDepthSorting(bool enable) { depthSorting = enable; }
     bool isDepthSortingEnabled() { return depthSorting; }
     QMatrix4x4 getTransform(int index) const;
+    // Same as above, for a copy of the table data
+    static QMatrix4x4 getTransform(const QByteArray &data, int stride, int index);
 
 private:
     int instanceCount = 0;
@@ -56,6 +75,7 @@ private:
     bool transparency = false;
     bool depthSorting = false;
     QByteArray table;
+    DirtyRanges changedRanges;
 };
 
 QT_END_NAMESPACE
@@ -6,6 +6,7 @@
 #include <QtQuick3DRuntimeRender/private/qssgrenderlayer_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgrendereffect_p.h>
 #include <QtQuick3DRuntimeRender/private/qssglayerrenderdata_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgpickaccelerationstructure_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -30,6 +31,7 @@ QSSGRenderLayer::~QSSGRenderLayer()
     delete importSceneNode;
     importSceneNode = nullptr;
     delete renderData;
+    delete pickAccelerationStructure;
 }
 
 void QSSGRenderLayer::setProbeOrientation(const QVector3D &angles)
@@ -73,13 +75,16 @@ void QSSGRenderLayer::setImportScene(QSSGRenderNode &rootNode)
     Q_ASSERT(importChildren.isEmpty());
     // We don't want the list to modify our node, so we set the tail and head manually.
     importChildren.m_head = importChildren.m_tail = &rootNode;
+    incrementHierarchyGeneration();
 }
 
 void QSSGRenderLayer::removeImportScene(QSSGRenderNode &rootNode)
 {
     if (importSceneNode && !importSceneNode->children.isEmpty()) {
-        if (&importSceneNode->children.back() == &rootNode)
+        if (&importSceneNode->children.back() == &rootNode) {
             importSceneNode->children.clear();
+            incrementHierarchyGeneration();
+        }
     }
 }
 
@@ -28,6 +28,7 @@ struct QSSGRenderPresentation;
 struct QSSGRenderEffect;
 struct QSSGRenderImage;
 class QSSGLayerRenderData;
+class QSSGPickAccelerationStructure;
 struct QSSGRenderResourceLoader;
 
 class QQuick3DObject;
@@ -124,6 +125,12 @@ struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGRenderLayer : public QSSGRenderNode
     // First effect in a list of effects.
     QSSGRenderEffect *firstEffect;
     QSSGLayerRenderData *renderData = nullptr;
+    // Maintained by the picking code (see QT_QUICK3D_PICKING_ACCELERATION).
+    mutable QSSGPickAccelerationStructure *pickAccelerationStructure = nullptr;
+    // Set by the owner of the layer before each frame. Must change whenever anything in the
+    // scene might have changed, frames prepared with the same non-zero revision can reuse the
+    // renderables of the previous frame (see QT_QUICK3D_REUSE_STATIC_FRAMES).
+    quint64 sceneRevision = 0;
     enum class RenderExtensionStage { Underlay, Overlay, Count };
     QList<QSSGRenderExtension *> renderExtensions[size_t(RenderExtensionStage::Count)];
 
@@ -26,11 +26,14 @@
 #include <QtQuick3DUtils/private/qssgbounds3_p.h>
 #include <QtCore/QVector>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 struct QSSGRenderDefaultMaterial;
 struct QSSGParticleBuffer;
 class QSSGBufferManager;
+class QSSGInstancePickAccelerationStructure;
 class QRhiTexture;
 
 struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGRenderModel : public QSSGRenderNode
@@ -51,6 +54,9 @@ struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGRenderModel : public QSSGRenderNode
     QSSGRenderInstanceTable *instanceTable = nullptr;
     int instanceCount() const { return instanceTable ? instanceTable->count() : 0; }
     bool instancing() const { return instanceTable;}
+    // Maintained by the picking code (see QT_QUICK3D_PICKING_ACCELERATION), shared with the
+    // pick snapshots.
+    mutable std::shared_ptr<const QSSGInstancePickAccelerationStructure> instancePickAccelerationStructure;
 
     QSSGParticleBuffer *particleBuffer = nullptr;
     QMatrix4x4 particleMatrix;
@@ -70,6 +76,9 @@ struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGRenderModel : public QSSGRenderNode
 
     float levelOfDetailBias = 1.0f; // values < 1.0 will decrease usage of LODs, values > 1.0 will increase usage of LODs
 
+    // Load the mesh file on a worker thread, the model is not rendered until the data is ready
+    bool asyncMeshLoading = false;
+
     QSSGRenderModel();
 };
 QT_END_NAMESPACE
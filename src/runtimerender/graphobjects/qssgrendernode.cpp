@@ -13,6 +13,8 @@
 
 #include <QtQuick3DUtils/private/qssgplane_p.h>
 
+#include <atomic>
+
 QT_BEGIN_NAMESPACE
 
 QSSGRenderNode::QSSGRenderNode()
@@ -69,7 +71,7 @@ void QSSGRenderNode::setState(LocalState state, bool on)
 // Walks up the graph ensure all parents are not dirty so they have
 // valid global transforms.
 
-bool QSSGRenderNode::calculateGlobalVariables()
+bool QSSGRenderNode::calculateGlobalVariables(InstanceRootResolution instanceRootResolution)
 {
     bool retval = isDirty(DirtyFlag::GlobalValuesDirty);
     if (retval) {
@@ -77,7 +79,7 @@ bool QSSGRenderNode::calculateGlobalVariables()
         globalTransform = localTransform;
 
         if (parent) {
-            retval = parent->calculateGlobalVariables() || retval;
+            retval = parent->calculateGlobalVariables(instanceRootResolution) || retval;
             const bool globallyActive = getLocalState(LocalState::Active) && parent->getGlobalState(GlobalState::Active);
             flags = globallyActive ? (flags | FlagT(GlobalState::Active)) : (flags & ~FlagT(GlobalState::Active));
             const bool globallyPickable = getLocalState(LocalState::Pickable) || parent->getGlobalState(GlobalState::Pickable);
@@ -90,19 +92,10 @@ bool QSSGRenderNode::calculateGlobalVariables()
                     globalInstanceTransform = parent->globalTransform;
                     localInstanceTransform = localTransform;
                 } else if (instanceRoot) {
-                    globalInstanceTransform = instanceRoot->globalInstanceTransform;
-                    //### technically O(n^2) -- we could cache localInstanceTransform if every node in the
-                    // tree is guaranteed to have the same instance root. That would require an API change.
-                    localInstanceTransform = localTransform;
-                    auto *p = parent;
-                    while (p) {
-                        if (p == instanceRoot) {
-                            localInstanceTransform = p->localInstanceTransform * localInstanceTransform;
-                            break;
-                        }
-                        localInstanceTransform = p->localTransform * localInstanceTransform;
-                        p = p->parent;
-                    }
+                    // The instance root can be anywhere in the graph, when the graph is
+                    // traversed in parallel it might not be up-to-date yet.
+                    if (instanceRootResolution == InstanceRootResolution::Immediate)
+                        calculateGlobalInstanceTransform();
                 } else {
                     // By default, we do magic: translation is applied to the global instance transform,
                     // while scale/rotation is local
@@ -125,6 +118,7 @@ bool QSSGRenderNode::calculateGlobalVariables()
             localInstanceTransform = localTransform;
             globalInstanceTransform = {};
         }
+        ++globalTransformRevision;
         // Clear dirty flags
         clearDirty(DirtyFlag::GlobalValuesDirty);
     }
@@ -133,6 +127,24 @@ bool QSSGRenderNode::calculateGlobalVariables()
     return retval && getLocalState(LocalState::Active);
 }
 
+void QSSGRenderNode::calculateGlobalInstanceTransform()
+{
+    Q_ASSERT(hasForeignInstanceRoot());
+    globalInstanceTransform = instanceRoot->globalInstanceTransform;
+    //### technically O(n^2) -- we could cache localInstanceTransform if every node in the
+    // tree is guaranteed to have the same instance root. That would require an API change.
+    localInstanceTransform = localTransform;
+    auto *p = parent;
+    while (p) {
+        if (p == instanceRoot) {
+            localInstanceTransform = p->localInstanceTransform * localInstanceTransform;
+            break;
+        }
+        localInstanceTransform = p->localTransform * localInstanceTransform;
+        p = p->parent;
+    }
+}
+
 QMatrix4x4 QSSGRenderNode::calculateTransformMatrix(QVector3D position, QVector3D scale, QVector3D pivot, QQuaternion rotation)
 {
     QMatrix4x4 transform;
@@ -161,6 +173,18 @@ QMatrix4x4 QSSGRenderNode::calculateTransformMatrix(QVector3D position, QVector3
     return transform;
 }
 
+static std::atomic<quint32> s_hierarchyGeneration { 0 };
+
+quint32 QSSGRenderNode::hierarchyGeneration()
+{
+    return s_hierarchyGeneration.load(std::memory_order_relaxed);
+}
+
+void QSSGRenderNode::incrementHierarchyGeneration()
+{
+    ++s_hierarchyGeneration;
+}
+
 void QSSGRenderNode::addChild(QSSGRenderNode &inChild)
 {
     // Adding children to a layer does not reset parent
@@ -172,6 +196,7 @@ void QSSGRenderNode::addChild(QSSGRenderNode &inChild)
     }
     children.push_back(inChild);
     inChild.markDirty(DirtyFlag::GlobalValuesDirty);
+    ++s_hierarchyGeneration;
 }
 
 void QSSGRenderNode::removeChild(QSSGRenderNode &inChild)
@@ -184,6 +209,7 @@ void QSSGRenderNode::removeChild(QSSGRenderNode &inChild)
     inChild.parent = nullptr;
     children.remove(inChild);
     inChild.markDirty(DirtyFlag::GlobalValuesDirty);
+    ++s_hierarchyGeneration;
 }
 
 void QSSGRenderNode::removeFromGraph()
@@ -197,6 +223,7 @@ void QSSGRenderNode::removeFromGraph()
         children.remove(removedChild);
         removedChild.parent = nullptr;
     }
+    ++s_hierarchyGeneration;
 }
 
 QSSGBounds3 QSSGRenderNode::getBounds(QSSGBufferManager &inManager,
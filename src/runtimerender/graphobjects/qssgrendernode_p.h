@@ -88,6 +88,8 @@ struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGRenderNode : public QSSGRenderGraphObje
     // Property maintained solely by the render system.
     // Depth-first-search index assigned and maintained by render system.
     quint32 dfsIndex = 0;
+    // Incremented whenever the global values (transform) are recalculated.
+    quint32 globalTransformRevision = 0;
 
     using ChildList = QSSGInvasiveLinkedList<QSSGRenderNode, &QSSGRenderNode::previousSibling, &QSSGRenderNode::nextSibling>;
     ChildList children;
@@ -116,10 +118,26 @@ struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGRenderNode : public QSSGRenderGraphObje
     // finally they are no longer siblings of each other.
     void removeFromGraph();
 
+    // Incremented whenever a node is added to or removed from a parent. Can be used
+    // to find out if a cached traversal order of the graph is still valid.
+    [[nodiscard]] static quint32 hierarchyGeneration();
+    // Needs to be called when the child lists are modified directly
+    static void incrementHierarchyGeneration();
+
+    enum class InstanceRootResolution : quint8
+    {
+        Immediate,
+        Deferred // Left to calculateGlobalInstanceTransform() for nodes with another node as instance root
+    };
+
     // Calculate global transform and opacity
     // Walks up the graph ensure all parents are not dirty so they have
     // valid global transforms.
-    bool calculateGlobalVariables();
+    bool calculateGlobalVariables(InstanceRootResolution instanceRootResolution = InstanceRootResolution::Immediate);
+    // Global and local instance transform of a node whose instance root is another node.
+    // The instance root and the parents of the node need to be up-to-date.
+    void calculateGlobalInstanceTransform();
+    [[nodiscard]] bool hasForeignInstanceRoot() const { return instanceRoot && instanceRoot != this; }
 
     // Calculates a tranform matrix based on the position, scale, pivot and rotation arguments.
     // NOTE!!!: This function does not update or mark any nodes as dirty, if the returned matrix is set on a node then
@@ -6,6 +6,14 @@
 
 #include <QtQuick3DUtils/private/qssgutils_p.h>
 
+#include <QtCore/private/qsimd_p.h>
+
+#include <algorithm>
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 QSSGClippingFrustum::QSSGClippingFrustum(const QMatrix4x4 &modelviewprojection, const QSSGClipPlane &nearPlane)
@@ -43,4 +51,96 @@ QSSGClippingFrustum::QSSGClippingFrustum(const QMatrix4x4 &modelviewprojection,
         mPlanes[idx].calculateBBoxEdges();
 }
 
+namespace {
+
+// The corner of the box that lies furthest along the plane's normal ("upper" edge).
+// If that corner is behind the plane, so is the whole box.
+struct PlaneCornerArrays
+{
+    const float *x;
+    const float *y;
+    const float *z;
+    float nx, ny, nz, d;
+};
+
+inline PlaneCornerArrays planeCornerArrays(const QSSGClipPlane &plane, const QSSGBoundsSoA &bounds)
+{
+    const bool xMax = (plane.mEdges.upperEdge & QSSGClipPlane::BoxEdgeID::xMax) != 0;
+    const bool yMax = (plane.mEdges.upperEdge & QSSGClipPlane::BoxEdgeID::yMax) != 0;
+    const bool zMax = (plane.mEdges.upperEdge & QSSGClipPlane::BoxEdgeID::zMax) != 0;
+    return { xMax ? bounds.maxX.constData() : bounds.minX.constData(),
+             yMax ? bounds.maxY.constData() : bounds.minY.constData(),
+             zMax ? bounds.maxZ.constData() : bounds.minZ.constData(),
+             plane.normal.x(), plane.normal.y(), plane.normal.z(), plane.d };
+}
+
+} // namespace
+
+void QSSGClippingFrustum::intersectsWith(const QSSGBoundsSoA &bounds, quint32 *outVisibilityMask) const
+{
+    const qsizetype count = bounds.size();
+    if (count == 0)
+        return;
+
+    std::fill_n(outVisibilityMask, QSSGBoundsSoA::maskWordCount(count), 0u);
+
+    PlaneCornerArrays planes[6];
+    for (int p = 0; p < 6; ++p)
+        planes[p] = planeCornerArrays(mPlanes[p], bounds);
+
+    qsizetype i = 0;
+
+#if defined(__AVX__)
+    for (; i + 8 <= count; i += 8) {
+        __m256 outside = _mm256_setzero_ps();
+        for (const auto &p : planes) {
+            __m256 dist = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.nx), _mm256_loadu_ps(p.x + i)), _mm256_set1_ps(p.d));
+            dist = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.ny), _mm256_loadu_ps(p.y + i)), dist);
+            dist = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.nz), _mm256_loadu_ps(p.z + i)), dist);
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(dist, _mm256_setzero_ps(), _CMP_LT_OQ));
+        }
+        const quint32 visible = ~quint32(_mm256_movemask_ps(outside)) & 0xffu;
+        outVisibilityMask[i >> 5] |= visible << (i & 31);
+    }
+#elif defined(__SSE2__)
+    for (; i + 4 <= count; i += 4) {
+        __m128 outside = _mm_setzero_ps();
+        for (const auto &p : planes) {
+            __m128 dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.nx), _mm_loadu_ps(p.x + i)), _mm_set1_ps(p.d));
+            dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.ny), _mm_loadu_ps(p.y + i)), dist);
+            dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.nz), _mm_loadu_ps(p.z + i)), dist);
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_setzero_ps()));
+        }
+        const quint32 visible = ~quint32(_mm_movemask_ps(outside)) & 0xfu;
+        outVisibilityMask[i >> 5] |= visible << (i & 31);
+    }
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    static const uint32_t laneBits[4] = { 1, 2, 4, 8 };
+    const uint32x4_t bits = vld1q_u32(laneBits);
+    for (; i + 4 <= count; i += 4) {
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (const auto &p : planes) {
+            float32x4_t dist = vmlaq_n_f32(vdupq_n_f32(p.d), vld1q_f32(p.x + i), p.nx);
+            dist = vmlaq_n_f32(dist, vld1q_f32(p.y + i), p.ny);
+            dist = vmlaq_n_f32(dist, vld1q_f32(p.z + i), p.nz);
+            outside = vorrq_u32(outside, vcltq_f32(dist, vdupq_n_f32(0.0f)));
+        }
+        const uint32x4_t outsideBits = vandq_u32(outside, bits);
+        const uint32x2_t sum = vpadd_u32(vget_low_u32(outsideBits), vget_high_u32(outsideBits));
+        const quint32 visible = ~quint32(vget_lane_u32(vpadd_u32(sum, sum), 0)) & 0xfu;
+        outVisibilityMask[i >> 5] |= visible << (i & 31);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        bool visible = true;
+        for (int p = 0; p < 6 && visible; ++p) {
+            const auto &plane = planes[p];
+            visible = !((plane.nx * plane.x[i] + plane.ny * plane.y[i] + plane.nz * plane.z[i] + plane.d) < 0.0f);
+        }
+        if (visible)
+            outVisibilityMask[i >> 5] |= 1u << (i & 31);
+    }
+}
+
 QT_END_NAMESPACE
@@ -18,6 +18,8 @@
 
 #include <QtQuick3DUtils/private/qssgplane_p.h>
 #include <QtQuick3DUtils/private/qssgbounds3_p.h>
+
+#include <QtCore/QVector>
 #include <QtQuick3DRuntimeRender/qtquick3druntimerenderexports.h>
 
 QT_BEGIN_NAMESPACE
@@ -117,6 +119,43 @@ struct QSSGClipPlane
     }
 };
 
+// Structure-of-arrays store for axis-aligned bounds. Keeping the extents in
+// separate contiguous arrays lets the batch culling below test several
+// bounding boxes against a plane at once.
+struct QSSGBoundsSoA
+{
+    QVector<float> minX;
+    QVector<float> minY;
+    QVector<float> minZ;
+    QVector<float> maxX;
+    QVector<float> maxY;
+    QVector<float> maxZ;
+
+    [[nodiscard]] qsizetype size() const { return minX.size(); }
+    [[nodiscard]] bool isEmpty() const { return minX.isEmpty(); }
+
+    void reserve(qsizetype size)
+    {
+        minX.reserve(size); minY.reserve(size); minZ.reserve(size);
+        maxX.reserve(size); maxY.reserve(size); maxZ.reserve(size);
+    }
+
+    void clear()
+    {
+        minX.clear(); minY.clear(); minZ.clear();
+        maxX.clear(); maxY.clear(); maxZ.clear();
+    }
+
+    void push_back(const QSSGBounds3 &bounds)
+    {
+        minX.push_back(bounds.minimum.x()); minY.push_back(bounds.minimum.y()); minZ.push_back(bounds.minimum.z());
+        maxX.push_back(bounds.maximum.x()); maxY.push_back(bounds.maximum.y()); maxZ.push_back(bounds.maximum.z());
+    }
+
+    // Number of 32-bit words needed for a visibility mask of 'count' entries.
+    [[nodiscard]] static constexpr qsizetype maskWordCount(qsizetype count) { return (count + 31) / 32; }
+};
+
 struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGClippingFrustum
 {
     QSSGClipPlane mPlanes[6];
@@ -141,6 +180,11 @@ struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGClippingFrustum
             ret = !(mPlanes[idx].distance(point) < radius);
         return ret;
     }
+
+    // Batch version of intersectsWith(const QSSGBounds3 &), using SSE2/AVX/NEON when available.
+    // Bit (i % 32) of outVisibilityMask[i / 32] is set when bounds[i] intersects with the frustum.
+    // outVisibilityMask needs to have room for QSSGBoundsSoA::maskWordCount(bounds.size()) entries.
+    void intersectsWith(const QSSGBoundsSoA &bounds, quint32 *outVisibilityMask) const;
 };
 QT_END_NAMESPACE
 
@@ -20,6 +20,7 @@
 
 #include <QtQuick3DUtils/private/qssgbounds3_p.h>
 #include <QtQuick3DUtils/private/qssgmeshbvh_p.h>
+#include <QtQuick3DUtils/private/qssgmesh_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -29,6 +30,10 @@ struct QSSGRenderSubset
     quint32 offset;
     QSSGBounds3 bounds; // Vertex buffer bounds
     QSSGMeshBVHNode::Handle bvhRoot;
+    // Changes whenever the buffers are (re)created, unlike their addresses it is never reused
+    quint64 generation = 0;
+    // Finest level of detail in the index buffer, only non-zero when the levels are streamed
+    quint32 residentLevelOfDetail = 0;
     struct {
         QSSGRhiBufferPtr vertexBuffer;
         QSSGRhiBufferPtr indexBuffer;
@@ -49,6 +54,8 @@ struct QSSGRenderSubset
         , offset(inOther.offset)
         , bounds(inOther.bounds)
         , bvhRoot(inOther.bvhRoot)
+        , generation(inOther.generation)
+        , residentLevelOfDetail(inOther.residentLevelOfDetail)
         , rhi(inOther.rhi)
         , lods(inOther.lods)
     {
@@ -60,6 +67,8 @@ struct QSSGRenderSubset
             offset = inOther.offset;
             bounds = inOther.bounds;
             bvhRoot = inOther.bvhRoot;
+            generation = inOther.generation;
+            residentLevelOfDetail = inOther.residentLevelOfDetail;
             rhi = inOther.rhi;
             lods = inOther.lods;
         }
@@ -88,6 +97,29 @@ struct QSSGRenderSubset
         return lods[lodLevel].offset;
     }
 
+    // Same as lodCount() and lodOffset(), but never finer than the level the index
+    // buffer holds. Streamed levels can be dropped between preparing and drawing.
+    quint32 residentLodCount(int lodLevel = 0) const { return lodCount(qMax(lodLevel, int(residentLevelOfDetail))); }
+    quint32 residentLodOffset(int lodLevel = 0) const { return lodOffset(qMax(lodLevel, int(residentLevelOfDetail))); }
+
+};
+
+// State of a mesh whose index buffer only holds the levels of detail that are
+// in use (QT_QUICK3D_MESH_LOD_STREAMING), see QSSGBufferManager. Levels are
+// numbered like QSSGRenderSubset::lodCount(), 0 is the full detail.
+struct QSSGRenderMeshLodStreaming
+{
+    QByteArray indexData; // all levels
+    QSSGMesh::Mesh mappedMesh; // keeps the file mapping indexData points into alive
+    QVector<quint32> levelIndexCounts; // indices needed to draw each level
+    quint32 indexSize = 0;
+    QRhiCommandBuffer::IndexFormat indexFormat = QRhiCommandBuffer::IndexUInt16;
+    quint32 residentLevel = 0; // finest level in the index buffer
+    quint32 usedLevel = 0; // finest level any layer asked for since the last update
+    quint32 lastUsedFrame = 0;
+    bool budgetLimited = false; // the last attempt to load a finer level did not fit the budget
+
+    quint32 coarsestLevel() const { return quint32(levelIndexCounts.size()) - 1; }
 };
 
 struct QSSGRenderMesh
@@ -97,8 +129,10 @@ struct QSSGRenderMesh
     QVector<QSSGRenderSubset> subsets;
     QSSGRenderDrawMode drawMode;
     QSSGRenderWinding winding;
-    std::unique_ptr<QSSGMeshBVH> bvh;
+    // Shared so that pick snapshots (QSSGPickSnapshot) can keep it alive after the mesh is released
+    std::shared_ptr<const QSSGMeshBVH> bvh;
     QSize lightmapSizeHint;
+    std::unique_ptr<QSSGRenderMeshLodStreaming> lodStreaming;
 
     QSSGRenderMesh(QSSGRenderDrawMode inDrawMode, QSSGRenderWinding inWinding)
         : drawMode(inDrawMode), winding(inWinding)
@@ -0,0 +1,54 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qssgrenderoptimizations_p.h"
+
+#include <array>
+
+QT_BEGIN_NAMESPACE
+
+namespace QSSGRenderOptimizations
+{
+
+static constexpr size_t OPTION_COUNT = size_t(Option::OptionCount);
+
+// In the order of the Option enum
+static constexpr std::array<const char *, OPTION_COUNT> optionVariables {
+    "QT_QUICK3D_DYNAMIC_BATCHING",
+    "QT_QUICK3D_FLAT_NODE_HIERARCHY",
+    "QT_QUICK3D_INSTANCE_FRUSTUM_CULLING",
+    "QT_QUICK3D_MESH_LOD_STREAMING",
+    "QT_QUICK3D_OPAQUE_STATE_SORT",
+    "QT_QUICK3D_PACKED_MESH_BVH",
+    "QT_QUICK3D_PARALLEL_TRAVERSAL",
+    "QT_QUICK3D_PICKING_ACCELERATION",
+    "QT_QUICK3D_PIPELINE_WARMUP",
+    "QT_QUICK3D_REUSE_STATIC_FRAMES",
+    "QT_QUICK3D_SHADOW_MAP_CACHING",
+};
+
+bool isEnabled(Option option)
+{
+    static const std::array<bool, OPTION_COUNT> enabled = [] {
+        std::array<bool, OPTION_COUNT> result;
+        for (size_t i = 0; i != OPTION_COUNT; ++i)
+            result[i] = qEnvironmentVariableIntValue(optionVariables[i]) > 0;
+        return result;
+    }();
+    Q_ASSERT(option < Option::OptionCount);
+    return enabled[size_t(option)];
+}
+
+quint64 meshLodStreamingBudget()
+{
+    static const quint64 budget = [] {
+        bool ok = false;
+        const int mb = qEnvironmentVariableIntValue("QT_QUICK3D_MESH_LOD_STREAMING_BUDGET", &ok);
+        return quint64(ok && mb > 0 ? mb : 64) * 1024 * 1024;
+    }();
+    return budget;
+}
+
+} // namespace QSSGRenderOptimizations
+
+QT_END_NAMESPACE
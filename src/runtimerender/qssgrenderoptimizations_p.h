@@ -0,0 +1,55 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QSSGRENDEROPTIMIZATIONS_P_H
+#define QSSGRENDEROPTIMIZATIONS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick3DRuntimeRender/private/qtquick3druntimerenderglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+// Optional renderer optimizations. They are off by default and each one is switched on by
+// setting its environment variable to a positive number. The variables are read once, the
+// first time any of the options is queried. They are documented in the "Optional Rendering
+// Optimizations" section of the architecture overview.
+namespace QSSGRenderOptimizations
+{
+
+enum class Option
+{
+    DynamicBatching,        // QT_QUICK3D_DYNAMIC_BATCHING
+    FlatNodeHierarchy,      // QT_QUICK3D_FLAT_NODE_HIERARCHY
+    InstanceFrustumCulling, // QT_QUICK3D_INSTANCE_FRUSTUM_CULLING
+    MeshLodStreaming,       // QT_QUICK3D_MESH_LOD_STREAMING
+    OpaqueStateSort,        // QT_QUICK3D_OPAQUE_STATE_SORT
+    PackedMeshBVH,          // QT_QUICK3D_PACKED_MESH_BVH
+    ParallelTraversal,      // QT_QUICK3D_PARALLEL_TRAVERSAL
+    PickingAcceleration,    // QT_QUICK3D_PICKING_ACCELERATION
+    PipelineWarmup,         // QT_QUICK3D_PIPELINE_WARMUP
+    ReuseStaticFrames,      // QT_QUICK3D_REUSE_STATIC_FRAMES
+    ShadowMapCaching,       // QT_QUICK3D_SHADOW_MAP_CACHING
+    OptionCount
+};
+
+[[nodiscard]] Q_QUICK3DRUNTIMERENDER_EXPORT bool isEnabled(Option option);
+
+// The budget, in bytes, for the index data of all streamed meshes together
+// (QT_QUICK3D_MESH_LOD_STREAMING_BUDGET, in megabytes, 64 by default).
+[[nodiscard]] Q_QUICK3DRUNTIMERENDER_EXPORT quint64 meshLodStreamingBudget();
+
+} // namespace QSSGRenderOptimizations
+
+QT_END_NAMESPACE
+
+#endif // QSSGRENDEROPTIMIZATIONS_P_H
@@ -0,0 +1,343 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qssgrenderpipelinewarmup_p.h"
+#include "qssgrendershadercache_p.h"
+
+#include <QtQuick3DUtils/private/qssgassert_p.h>
+
+#include <QtCore/qdatastream.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+#include <QtGui/private/qrhi_p.h>
+
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+constexpr quint32 WARMUP_FILE_MAGIC = 0x51335057; // "Q3PW"
+constexpr quint32 WARMUP_FILE_VERSION = 1;
+
+struct WarmupBinding
+{
+    int binding = 0;
+    QRhiShaderResourceBinding::StageFlags stages;
+    QRhiShaderResourceBinding::Type type = QRhiShaderResourceBinding::UniformBuffer;
+    int count = 1;
+    bool hasDynamicOffset = false;
+};
+
+struct WarmupEntry
+{
+    QByteArray shaderKey;
+    quint32 features = 0;
+    QSSGRhiGraphicsPipelineState state;
+    QVector<quint32> renderTargetDescription;
+    QVarLengthArray<WarmupBinding, QSSGRhiShaderResourceBindingList::MAX_SIZE> bindings;
+};
+
+void prepareStream(QDataStream &ds)
+{
+    ds.setVersion(QDataStream::Qt_6_0);
+    ds.setFloatingPointPrecision(QDataStream::SinglePrecision);
+}
+
+QByteArray serializeEntry(const QSSGGraphicsPipelineStateKey &key,
+                          const QSSGRhiShaderPipeline &shaders,
+                          const QRhiShaderResourceBindings *srb)
+{
+    QByteArray data;
+    QDataStream ds(&data, QIODevice::WriteOnly);
+    prepareStream(ds);
+
+    const QSSGRhiGraphicsPipelineState &s = key.state;
+    const auto &ia = QSSGRhiInputAssemblerStatePrivate::get(s);
+
+    ds << shaders.warmupKey() << shaders.warmupFeatures();
+
+    ds << quint32(s.flags.toInt()) << quint32(s.depthFunc) << quint32(s.cullMode) << quint32(s.polygonMode);
+    ds << quint32(s.targetBlend.colorWrite.toInt())
+       << quint32(s.targetBlend.srcColor) << quint32(s.targetBlend.dstColor) << quint32(s.targetBlend.opColor)
+       << quint32(s.targetBlend.srcAlpha) << quint32(s.targetBlend.dstAlpha) << quint32(s.targetBlend.opAlpha);
+    ds << quint32(s.stencilOpFrontState.failOp) << quint32(s.stencilOpFrontState.depthFailOp)
+       << quint32(s.stencilOpFrontState.passOp) << quint32(s.stencilOpFrontState.compareOp);
+    ds << s.stencilWriteMask << s.stencilRef << qint32(s.depthBias) << qint32(s.colorAttachmentCount)
+       << s.slopeScaledDepthBias << s.lineWidth;
+
+    ds << quint32(ia.topology);
+    ds << quint32(ia.inputLayout.bindingCount());
+    for (auto it = ia.inputLayout.cbeginBindings(), end = ia.inputLayout.cendBindings(); it != end; ++it)
+        ds << it->stride() << quint32(it->classification()) << it->instanceStepRate();
+    ds << quint32(ia.inputLayout.attributeCount());
+    for (auto it = ia.inputLayout.cbeginAttributes(), end = ia.inputLayout.cendAttributes(); it != end; ++it)
+        ds << qint32(it->binding()) << qint32(it->location()) << quint32(it->format()) << it->offset() << qint32(it->matrixSlice());
+
+    ds << key.renderTargetDescription;
+
+    ds << quint32(srb->bindingCount());
+    for (auto it = srb->cbeginBindings(), end = srb->cendBindings(); it != end; ++it) {
+        const QRhiShaderResourceBinding::Data *d = QRhiImplementation::shaderResourceBindingData(*it);
+        int count = 1;
+        bool hasDynamicOffset = false;
+        if (d->type == QRhiShaderResourceBinding::UniformBuffer)
+            hasDynamicOffset = d->u.ubuf.hasDynamicOffset;
+        else if (d->type == QRhiShaderResourceBinding::SampledTexture)
+            count = d->u.stex.count;
+        ds << qint32(d->binding) << quint32(d->stage.toInt()) << quint32(d->type) << qint32(count) << hasDynamicOffset;
+    }
+
+    return data;
+}
+
+bool deserializeEntry(const QByteArray &data, WarmupEntry &entry)
+{
+    QDataStream ds(data);
+    prepareStream(ds);
+
+    QSSGRhiGraphicsPipelineState &s = entry.state;
+    auto &ia = QSSGRhiInputAssemblerStatePrivate::get(s);
+
+    ds >> entry.shaderKey >> entry.features;
+
+    quint32 flags, depthFunc, cullMode, polygonMode;
+    ds >> flags >> depthFunc >> cullMode >> polygonMode;
+    s.flags = QSSGRhiGraphicsPipelineState::Flags::fromInt(flags);
+    s.depthFunc = QRhiGraphicsPipeline::CompareOp(depthFunc);
+    s.cullMode = QRhiGraphicsPipeline::CullMode(cullMode);
+    s.polygonMode = QRhiGraphicsPipeline::PolygonMode(polygonMode);
+
+    quint32 colorWrite, srcColor, dstColor, opColor, srcAlpha, dstAlpha, opAlpha;
+    ds >> colorWrite >> srcColor >> dstColor >> opColor >> srcAlpha >> dstAlpha >> opAlpha;
+    s.targetBlend.colorWrite = QRhiGraphicsPipeline::ColorMask::fromInt(colorWrite);
+    s.targetBlend.srcColor = QRhiGraphicsPipeline::BlendFactor(srcColor);
+    s.targetBlend.dstColor = QRhiGraphicsPipeline::BlendFactor(dstColor);
+    s.targetBlend.opColor = QRhiGraphicsPipeline::BlendOp(opColor);
+    s.targetBlend.srcAlpha = QRhiGraphicsPipeline::BlendFactor(srcAlpha);
+    s.targetBlend.dstAlpha = QRhiGraphicsPipeline::BlendFactor(dstAlpha);
+    s.targetBlend.opAlpha = QRhiGraphicsPipeline::BlendOp(opAlpha);
+
+    quint32 failOp, depthFailOp, passOp, compareOp;
+    ds >> failOp >> depthFailOp >> passOp >> compareOp;
+    s.stencilOpFrontState.failOp = QRhiGraphicsPipeline::StencilOp(failOp);
+    s.stencilOpFrontState.depthFailOp = QRhiGraphicsPipeline::StencilOp(depthFailOp);
+    s.stencilOpFrontState.passOp = QRhiGraphicsPipeline::StencilOp(passOp);
+    s.stencilOpFrontState.compareOp = QRhiGraphicsPipeline::CompareOp(compareOp);
+
+    qint32 depthBias, colorAttachmentCount;
+    ds >> s.stencilWriteMask >> s.stencilRef >> depthBias >> colorAttachmentCount
+       >> s.slopeScaledDepthBias >> s.lineWidth;
+    s.depthBias = depthBias;
+    s.colorAttachmentCount = colorAttachmentCount;
+
+    quint32 topology, inputBindingCount;
+    ds >> topology >> inputBindingCount;
+    ia.topology = QRhiGraphicsPipeline::Topology(topology);
+    if (inputBindingCount > 16)
+        return false;
+    QVarLengthArray<QRhiVertexInputBinding, 8> inputBindings;
+    for (quint32 i = 0; i != inputBindingCount; ++i) {
+        quint32 stride, classification, stepRate;
+        ds >> stride >> classification >> stepRate;
+        inputBindings.append({ stride, QRhiVertexInputBinding::Classification(classification), stepRate });
+    }
+    quint32 attributeCount;
+    ds >> attributeCount;
+    if (attributeCount > 32)
+        return false;
+    QVarLengthArray<QRhiVertexInputAttribute, 8> attributes;
+    for (quint32 i = 0; i != attributeCount; ++i) {
+        qint32 binding, location, matrixSlice;
+        quint32 format, offset;
+        ds >> binding >> location >> format >> offset >> matrixSlice;
+        attributes.append({ binding, location, QRhiVertexInputAttribute::Format(format), offset, matrixSlice });
+    }
+    ia.inputLayout.setBindings(inputBindings.cbegin(), inputBindings.cend());
+    ia.inputLayout.setAttributes(attributes.cbegin(), attributes.cend());
+
+    ds >> entry.renderTargetDescription;
+
+    quint32 bindingCount;
+    ds >> bindingCount;
+    if (bindingCount > quint32(QSSGRhiShaderResourceBindingList::MAX_SIZE))
+        return false;
+    for (quint32 i = 0; i != bindingCount; ++i) {
+        qint32 binding, count;
+        quint32 stages, type;
+        bool hasDynamicOffset;
+        ds >> binding >> stages >> type >> count >> hasDynamicOffset;
+        entry.bindings.append({ binding,
+                                QRhiShaderResourceBinding::StageFlags::fromInt(stages),
+                                QRhiShaderResourceBinding::Type(type),
+                                count,
+                                hasDynamicOffset });
+    }
+
+    return ds.status() == QDataStream::Ok;
+}
+
+} // namespace
+
+QSSGPipelineWarmupCache::~QSSGPipelineWarmupCache() = default;
+
+bool QSSGPipelineWarmupCache::load(const QString &fileName)
+{
+    QFile f(fileName);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream ds(&f);
+    prepareStream(ds);
+    quint32 magic = 0;
+    quint32 version = 0;
+    ds >> magic >> version;
+    if (ds.status() != QDataStream::Ok || magic != WARMUP_FILE_MAGIC || version != WARMUP_FILE_VERSION)
+        return false;
+
+    QList<QByteArray> entries;
+    ds >> entries;
+    if (ds.status() != QDataStream::Ok) {
+        qWarning("Failed to read pipeline warmup cache %s", qPrintable(fileName));
+        return false;
+    }
+
+    for (const QByteArray &entry : std::as_const(entries)) {
+        if (m_entries.size() == MAX_ENTRY_COUNT)
+            break;
+        if (!m_knownEntries.contains(entry)) {
+            m_knownEntries.insert(entry);
+            m_entries.append(entry);
+        }
+    }
+
+    return true;
+}
+
+bool QSSGPipelineWarmupCache::save(const QString &fileName) const
+{
+    QSaveFile f(fileName);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QDataStream ds(&f);
+    prepareStream(ds);
+    ds << WARMUP_FILE_MAGIC << WARMUP_FILE_VERSION << m_entries;
+
+    return ds.status() == QDataStream::Ok && f.commit();
+}
+
+void QSSGPipelineWarmupCache::record(const QSSGGraphicsPipelineStateKey &key, const QRhiShaderResourceBindings *srb)
+{
+    const QSSGRhiShaderPipeline *shaders = QSSGRhiGraphicsPipelineStatePrivate::getShaderPipeline(key.state);
+    if (!shaders || shaders->warmupKey().isEmpty() || !srb || m_entries.size() == MAX_ENTRY_COUNT)
+        return;
+
+    QByteArray entry = serializeEntry(key, *shaders, srb);
+    if (m_knownEntries.contains(entry))
+        return;
+
+    m_knownEntries.insert(entry);
+    m_entries.append(std::move(entry));
+    m_dirty = true;
+}
+
+QSSGPipelineWarmupCache::ReplayResult QSSGPipelineWarmupCache::replay(QSSGShaderCache &shaderCache,
+                                                                      QSSGRhiContext &rhiCtx,
+                                                                      const QSSGRhiGraphicsPipelineState &basePs,
+                                                                      QRhiRenderPassDescriptor *rpDesc)
+{
+    ReplayResult result;
+    QSSG_ASSERT(rpDesc && rhiCtx.commandBuffer(), return result);
+    if (m_entries.isEmpty())
+        return result;
+
+    QSSGRhiContextPrivate *rhiCtxD = QSSGRhiContextPrivate::get(&rhiCtx);
+    QRhi *rhi = rhiCtx.rhi();
+
+    // The pipelines are never used for drawing, so the resources only need to
+    // produce the same layout as the real ones.
+    if (!m_dummyUbuf) {
+        m_dummyUbuf.reset(rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 256));
+        if (!m_dummyUbuf->create()) {
+            qWarning("Failed to build uniform buffer for pipeline warmup");
+            m_dummyUbuf.reset();
+            return result;
+        }
+    }
+    QRhiResourceUpdateBatch *rub = rhi->nextResourceUpdateBatch();
+    QRhiTexture *dummyTexture = rhiCtx.dummyTexture({}, rub);
+    rhiCtx.commandBuffer()->resourceUpdate(rub);
+    QRhiSampler *dummySampler = rhiCtx.sampler({ QRhiSampler::Linear, QRhiSampler::Linear, QRhiSampler::None,
+                                                 QRhiSampler::ClampToEdge, QRhiSampler::ClampToEdge, QRhiSampler::Repeat });
+
+    // Do not record the replayed pipelines, they are in the list already
+    QSSGPipelineWarmupCache *recorder = std::exchange(rhiCtxD->m_pipelineWarmup, nullptr);
+
+    const QVector<quint32> rtDesc = rpDesc->serializedFormat();
+    for (const QByteArray &data : std::as_const(m_entries)) {
+        WarmupEntry entry;
+        if (!deserializeEntry(data, entry) || entry.renderTargetDescription != rtDesc)
+            continue;
+
+        QSSGShaderFeatures features;
+        features.flags = entry.features;
+        QSSGRhiShaderPipelinePtr shaders = shaderCache.tryGetRhiShaderPipeline(entry.shaderKey, features);
+        if (!shaders) {
+            const QByteArray qsbcKey = QQsbCollection::EntryDesc::generateSha(entry.shaderKey, QQsbCollection::toFeatureSet(features));
+            shaders = shaderCache.tryNewPipelineFromPersistentCache(qsbcKey, entry.shaderKey, features);
+            if (!shaders) {
+                ++result.missingShaderCount;
+                continue;
+            }
+            shaders->setWarmupKey(entry.shaderKey, entry.features);
+        }
+
+        QSSGRhiShaderResourceBindingList bindings;
+        bool supported = true;
+        for (const WarmupBinding &b : std::as_const(entry.bindings)) {
+            if (b.type == QRhiShaderResourceBinding::UniformBuffer && !b.hasDynamicOffset) {
+                bindings.addUniformBuffer(b.binding, b.stages, m_dummyUbuf.get());
+            } else if (b.type == QRhiShaderResourceBinding::SampledTexture && b.count == 1) {
+                bindings.addTexture(b.binding, b.stages, dummyTexture, dummySampler);
+            } else {
+                supported = false;
+                break;
+            }
+        }
+        if (!supported) {
+            ++result.unsupportedCount;
+            continue;
+        }
+
+        QRhiShaderResourceBindings *srb = rhiCtxD->srb(bindings);
+        if (!srb)
+            continue;
+
+        QSSGRhiGraphicsPipelineState ps = entry.state;
+        ps.viewport = basePs.viewport;
+        ps.scissor = basePs.scissor;
+        ps.samples = basePs.samples;
+        ps.viewCount = basePs.viewCount;
+        ps.flags.setFlag(QSSGRhiGraphicsPipelineState::Flag::UsesScissor,
+                         basePs.flags.testFlag(QSSGRhiGraphicsPipelineState::Flag::UsesScissor));
+        QSSGRhiGraphicsPipelineStatePrivate::setShaderPipeline(ps, shaders.get());
+
+        const auto key = QSSGGraphicsPipelineStateKey::create(ps, rpDesc, srb);
+        if (rhiCtxD->m_pipelines.contains(key))
+            continue;
+        if (rhiCtxD->pipeline(key, rpDesc, srb))
+            ++result.createdCount;
+    }
+
+    rhiCtxD->m_pipelineWarmup = recorder;
+
+    return result;
+}
+
+void QSSGPipelineWarmupCache::releaseCachedResources()
+{
+    m_dummyUbuf.reset();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,91 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QSSGRENDERPIPELINEWARMUP_P_H
+#define QSSGRENDERPIPELINEWARMUP_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick3DRuntimeRender/private/qtquick3druntimerenderglobal_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrhicontext_p.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstring.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+class QSSGShaderCache;
+
+// Manifest of the graphics pipelines that were created for default material
+// shaders in the main render pass. It is recorded while the application runs,
+// stored next to the persistent shader cache (q3dshadercache.qsbc), and can
+// be replayed in a later run so that the QRhiGraphicsPipelines are created
+// up front instead of when a material is first seen.
+//
+// Each entry holds the shader cache key and features (which is what is needed
+// to find the shaders in the qsbc collection), the pipeline state, the render
+// target format and the layout of the shader resource bindings. Viewport,
+// scissor, sample and view count are not stored, they are taken from the
+// layer that the pipelines are replayed for.
+class Q_QUICK3DRUNTIMERENDER_EXPORT QSSGPipelineWarmupCache
+{
+    Q_DISABLE_COPY(QSSGPipelineWarmupCache)
+public:
+    QSSGPipelineWarmupCache() = default;
+    ~QSSGPipelineWarmupCache();
+
+    // No more entries are recorded once the manifest reaches this size
+    static constexpr qsizetype MAX_ENTRY_COUNT = 4096;
+
+    bool load(const QString &fileName);
+    bool save(const QString &fileName) const;
+
+    // Called when a new pipeline got created. Pipelines for shaders without a
+    // warmup key (custom materials, effects, built-in shaders) are ignored.
+    void record(const QSSGGraphicsPipelineStateKey &key, const QRhiShaderResourceBindings *srb);
+
+    struct ReplayResult
+    {
+        int createdCount = 0; // Pipelines that did not exist yet
+        int missingShaderCount = 0; // Entries whose shaders are in neither the shader cache nor the qsbc file
+        int unsupportedCount = 0; // Entries with shader resource bindings that are not replayed
+    };
+
+    // Creates the pipelines of all entries matching the render target format
+    // of rpDesc. Only shader resource bindings made of uniform buffers without
+    // a dynamic offset and single sampled textures are recreated, which is all
+    // the default material shaders use in the main pass. Entries with any other
+    // binding are skipped and counted as unsupported.
+    ReplayResult replay(QSSGShaderCache &shaderCache,
+                        QSSGRhiContext &rhiCtx,
+                        const QSSGRhiGraphicsPipelineState &basePs,
+                        QRhiRenderPassDescriptor *rpDesc);
+
+    void releaseCachedResources();
+
+    [[nodiscard]] qsizetype entryCount() const { return m_entries.size(); }
+    [[nodiscard]] bool isDirty() const { return m_dirty; }
+
+private:
+    QList<QByteArray> m_entries; // serialized entries, in the order they were recorded
+    QSet<QByteArray> m_knownEntries;
+    std::unique_ptr<QRhiBuffer> m_dummyUbuf;
+    bool m_dirty = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSSGRENDERPIPELINEWARMUP_P_H
@@ -9,8 +9,16 @@
 #include <QtQuick3DUtils/private/qssgmeshbvh_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgrendermesh_p.h>
 
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/private/qsimd_p.h>
+
 #include <optional>
 
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 // http://www.siggraph.org/education/materials/HyperGraph/raytrace/rayplane_intersection.htm
@@ -188,6 +196,54 @@ bool QSSGRenderRay::triangleIntersect(const QSSGRenderRay &ray,
 }
 
 
+static QSSGRenderRay::IntersectionResult triangleIntersectionResult(const QSSGRenderRay::RayData &data,
+                                                                    const QVector3D &vertex1,
+                                                                    const QVector3D &vertex2,
+                                                                    const QVector3D &vertex3,
+                                                                    const QVector2D &uvCoord1,
+                                                                    const QVector2D &uvCoord2,
+                                                                    const QVector2D &uvCoord3,
+                                                                    float u,
+                                                                    float v,
+                                                                    const QVector3D &normal)
+{
+    const float w = 1.0f - u - v;
+    const QVector3D localIntersectionPoint = w * vertex1 + u * vertex2 + v * vertex3;
+
+    const QVector2D uvCoordinate = w * uvCoord1 + u * uvCoord2 + v * uvCoord3;
+    // Get the intersection point in scene coordinates
+    const QVector3D sceneIntersectionPos = QSSGUtils::mat44::transform(data.globalTransform,
+                                                            localIntersectionPoint);
+    const QVector3D hitVector = data.ray.origin - sceneIntersectionPos;
+    // Get the magnitude of the hit vector
+    const float rayLengthSquared = QSSGUtils::vec3::magnitudeSquared(hitVector);
+    return QSSGRenderRay::IntersectionResult(rayLengthSquared,
+                                             uvCoordinate,
+                                             sceneIntersectionPos,
+                                             localIntersectionPoint,
+                                             normal);
+}
+
+static void intersectTriangle(const QSSGRenderRay::RayData &data,
+                              const QVector3D &vertex1,
+                              const QVector3D &vertex2,
+                              const QVector3D &vertex3,
+                              const QVector2D &uvCoord1,
+                              const QVector2D &uvCoord2,
+                              const QVector2D &uvCoord3,
+                              QVector<QSSGRenderRay::IntersectionResult> &results)
+{
+    QSSGRenderRay relativeRay(data.origin, data.direction);
+
+    // Use Barycentric Coordinates to get the intersection values
+    float u = 0.f;
+    float v = 0.f;
+    QVector3D normal;
+    const bool intersects = QSSGRenderRay::triangleIntersect(relativeRay, vertex1, vertex2, vertex3, u, v, normal);
+    if (intersects)
+        results.append(triangleIntersectionResult(data, vertex1, vertex2, vertex3, uvCoord1, uvCoord2, uvCoord3, u, v, normal));
+}
+
 void QSSGRenderRay::intersectWithBVH(const RayData &data,
                                      const QSSGMeshBVHNode *bvh,
                                      const QSSGRenderMesh *mesh,
@@ -216,6 +272,397 @@ void QSSGRenderRay::intersectWithBVH(const RayData &data,
 }
 
 
+void QSSGRenderRay::intersectWithPackedBVH(const RayData &data,
+                                           const QSSGMeshBVH &bvh,
+                                           quint32 root,
+                                           QVector<IntersectionResult> &intersections)
+{
+    const QSSGMeshBVHPackedNodes &nodes = bvh.packedNodes();
+    if (root >= nodes.size())
+        return;
+
+    const std::vector<quint32> &triangleIndices = bvh.triangleIndices();
+    const std::vector<QVector3D> &vertices = bvh.vertices();
+    const std::vector<QVector2D> &uvs = bvh.uvs();
+    const bool hasUVs = !uvs.empty();
+
+    QVarLengthArray<quint32, 64> stack;
+    stack.append(root);
+    while (!stack.isEmpty()) {
+        const quint32 nodeIndex = stack.takeLast();
+        const QSSGMeshBVHPackedNode &node = nodes[nodeIndex];
+        const QSSGBounds3 bounds = node.bounds();
+        if (!intersectWithAABBv2(data, bounds).intersects())
+            continue;
+
+        if (!node.isLeaf()) {
+            // The left child follows its parent
+            stack.append(node.index);
+            stack.append(nodeIndex + 1);
+            continue;
+        }
+
+        for (quint32 i = node.index, end = node.index + node.count; i < end; ++i) {
+            const quint32 *indices = triangleIndices.data() + size_t(i) * 3;
+            intersectTriangle(data,
+                              vertices[indices[0]], vertices[indices[1]], vertices[indices[2]],
+                              hasUVs ? uvs[indices[0]] : QVector2D(),
+                              hasUVs ? uvs[indices[1]] : QVector2D(),
+                              hasUVs ? uvs[indices[2]] : QVector2D(),
+                              intersections);
+        }
+    }
+}
+
+namespace {
+
+// Best hit found so far by the closest-hit traversals, t is the distance along the
+// (normalized) ray direction in the space of the mesh.
+struct TriangleHit
+{
+    float t = std::numeric_limits<float>::max();
+    float u = 0.0f;
+    float v = 0.0f;
+    quint32 triangle = 0;
+    bool found = false;
+};
+
+template<typename Node>
+struct TraversalEntry
+{
+    Node node;
+    float tmin;
+};
+
+} // namespace
+
+// Möller-Trumbore with precomputed edges, the same tests as triangleIntersect()
+static inline bool triangleHit(const QVector3D &origin,
+                               const QVector3D &direction,
+                               const QVector3D &vertex0,
+                               const QVector3D &edge1,
+                               const QVector3D &edge2,
+                               float &t,
+                               float &u,
+                               float &v)
+{
+    const float epsilon = std::numeric_limits<float>::epsilon();
+
+    const QVector3D P = QVector3D::crossProduct(direction, edge2);
+    const float determinant = QVector3D::dotProduct(edge1, P);
+    if (!(determinant > epsilon))
+        return false;
+
+    const QVector3D T = origin - vertex0;
+    u = QVector3D::dotProduct(T, P);
+    if (u < 0.0f || u > determinant)
+        return false;
+
+    const QVector3D Q = QVector3D::crossProduct(T, edge1);
+    v = QVector3D::dotProduct(direction, Q);
+    if (v < 0.0f || (u + v) > determinant)
+        return false;
+
+    const float invDeterminant = 1.0f / determinant;
+    t = QVector3D::dotProduct(edge2, Q) * invDeterminant;
+    if (!(t > epsilon))
+        return false;
+
+    u *= invDeterminant;
+    v *= invDeterminant;
+    return true;
+}
+
+static inline void updateTriangleHit(const QSSGMeshBVHTriangleSoA &triangles,
+                                     quint32 triangle,
+                                     const QVector3D &origin,
+                                     const QVector3D &direction,
+                                     TriangleHit &hit)
+{
+    const QVector3D vertex0(triangles.vertex0[0][triangle], triangles.vertex0[1][triangle], triangles.vertex0[2][triangle]);
+    const QVector3D edge1(triangles.edge1[0][triangle], triangles.edge1[1][triangle], triangles.edge1[2][triangle]);
+    const QVector3D edge2(triangles.edge2[0][triangle], triangles.edge2[1][triangle], triangles.edge2[2][triangle]);
+    float t, u, v;
+    if (triangleHit(origin, direction, vertex0, edge1, edge2, t, u, v) && t < hit.t)
+        hit = { t, u, v, triangle, true };
+}
+
+// Tests the triangles [first, first + count) of a leaf, a whole register at a time where
+// available. Lanes past the end of the leaf are masked out (the loads stay in the padding).
+static void intersectLeafTriangles(const QSSGMeshBVHTriangleSoA &triangles,
+                                   quint32 first,
+                                   quint32 count,
+                                   const QVector3D &origin,
+                                   const QVector3D &direction,
+                                   TriangleHit &hit)
+{
+    quint32 i = first;
+    const quint32 end = first + count;
+    [[maybe_unused]] const float epsilon = std::numeric_limits<float>::epsilon();
+    [[maybe_unused]] const auto laneHits = [&](quint32 base, quint32 mask) {
+        // Candidates passed the vector test, pick the nearest with the scalar one
+        for (; mask; mask &= mask - 1)
+            updateTriangleHit(triangles, base + quint32(qCountTrailingZeroBits(mask)), origin, direction, hit);
+    };
+
+#if defined(__AVX__)
+    const __m256 ox = _mm256_set1_ps(origin.x()), oy = _mm256_set1_ps(origin.y()), oz = _mm256_set1_ps(origin.z());
+    const __m256 dx = _mm256_set1_ps(direction.x()), dy = _mm256_set1_ps(direction.y()), dz = _mm256_set1_ps(direction.z());
+    const __m256 eps = _mm256_set1_ps(epsilon);
+    const __m256 zero = _mm256_setzero_ps();
+    for (; i < end; i += 8) {
+        const __m256 e1x = _mm256_loadu_ps(triangles.edge1[0].data() + i);
+        const __m256 e1y = _mm256_loadu_ps(triangles.edge1[1].data() + i);
+        const __m256 e1z = _mm256_loadu_ps(triangles.edge1[2].data() + i);
+        const __m256 e2x = _mm256_loadu_ps(triangles.edge2[0].data() + i);
+        const __m256 e2y = _mm256_loadu_ps(triangles.edge2[1].data() + i);
+        const __m256 e2z = _mm256_loadu_ps(triangles.edge2[2].data() + i);
+        const __m256 tx = _mm256_sub_ps(ox, _mm256_loadu_ps(triangles.vertex0[0].data() + i));
+        const __m256 ty = _mm256_sub_ps(oy, _mm256_loadu_ps(triangles.vertex0[1].data() + i));
+        const __m256 tz = _mm256_sub_ps(oz, _mm256_loadu_ps(triangles.vertex0[2].data() + i));
+        // P = direction x edge2, Q = T x edge1
+        const __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+        const __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+        const __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+        const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(ty, e1z), _mm256_mul_ps(tz, e1y));
+        const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(tz, e1x), _mm256_mul_ps(tx, e1z));
+        const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(tx, e1y), _mm256_mul_ps(ty, e1x));
+        const __m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+        const __m256 u = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tx, px), _mm256_mul_ps(ty, py)), _mm256_mul_ps(tz, pz));
+        const __m256 v = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz));
+        // t * det, compared against the scaled limits since det is positive for all candidates
+        const __m256 tdet = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz));
+        __m256 mask = _mm256_cmp_ps(det, eps, _CMP_GT_OQ);
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(u, det, _CMP_LE_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_add_ps(u, v), det, _CMP_LE_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(tdet, _mm256_mul_ps(eps, det), _CMP_GT_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(tdet, _mm256_mul_ps(_mm256_set1_ps(hit.t), det), _CMP_LT_OQ));
+        const quint32 lanes = qMin(end - i, 8u);
+        laneHits(i, quint32(_mm256_movemask_ps(mask)) & ((1u << lanes) - 1u));
+    }
+#elif defined(__SSE2__)
+    const __m128 ox = _mm_set1_ps(origin.x()), oy = _mm_set1_ps(origin.y()), oz = _mm_set1_ps(origin.z());
+    const __m128 dx = _mm_set1_ps(direction.x()), dy = _mm_set1_ps(direction.y()), dz = _mm_set1_ps(direction.z());
+    const __m128 eps = _mm_set1_ps(epsilon);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i < end; i += 4) {
+        const __m128 e1x = _mm_loadu_ps(triangles.edge1[0].data() + i);
+        const __m128 e1y = _mm_loadu_ps(triangles.edge1[1].data() + i);
+        const __m128 e1z = _mm_loadu_ps(triangles.edge1[2].data() + i);
+        const __m128 e2x = _mm_loadu_ps(triangles.edge2[0].data() + i);
+        const __m128 e2y = _mm_loadu_ps(triangles.edge2[1].data() + i);
+        const __m128 e2z = _mm_loadu_ps(triangles.edge2[2].data() + i);
+        const __m128 tx = _mm_sub_ps(ox, _mm_loadu_ps(triangles.vertex0[0].data() + i));
+        const __m128 ty = _mm_sub_ps(oy, _mm_loadu_ps(triangles.vertex0[1].data() + i));
+        const __m128 tz = _mm_sub_ps(oz, _mm_loadu_ps(triangles.vertex0[2].data() + i));
+        // P = direction x edge2, Q = T x edge1
+        const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+        const __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+        const __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+        const __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+        const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+        const __m128 u = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz));
+        const __m128 v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz));
+        // t * det, compared against the scaled limits since det is positive for all candidates
+        const __m128 tdet = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz));
+        __m128 mask = _mm_cmpgt_ps(det, eps);
+        mask = _mm_and_ps(mask, _mm_cmpge_ps(u, zero));
+        mask = _mm_and_ps(mask, _mm_cmple_ps(u, det));
+        mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+        mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), det));
+        mask = _mm_and_ps(mask, _mm_cmpgt_ps(tdet, _mm_mul_ps(eps, det)));
+        mask = _mm_and_ps(mask, _mm_cmplt_ps(tdet, _mm_mul_ps(_mm_set1_ps(hit.t), det)));
+        const quint32 lanes = qMin(end - i, 4u);
+        laneHits(i, quint32(_mm_movemask_ps(mask)) & ((1u << lanes) - 1u));
+    }
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    static const uint32_t laneBits[4] = { 1, 2, 4, 8 };
+    const uint32x4_t bits = vld1q_u32(laneBits);
+    const float32x4_t ox = vdupq_n_f32(origin.x()), oy = vdupq_n_f32(origin.y()), oz = vdupq_n_f32(origin.z());
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    for (; i < end; i += 4) {
+        const float32x4_t e1x = vld1q_f32(triangles.edge1[0].data() + i);
+        const float32x4_t e1y = vld1q_f32(triangles.edge1[1].data() + i);
+        const float32x4_t e1z = vld1q_f32(triangles.edge1[2].data() + i);
+        const float32x4_t e2x = vld1q_f32(triangles.edge2[0].data() + i);
+        const float32x4_t e2y = vld1q_f32(triangles.edge2[1].data() + i);
+        const float32x4_t e2z = vld1q_f32(triangles.edge2[2].data() + i);
+        const float32x4_t tx = vsubq_f32(ox, vld1q_f32(triangles.vertex0[0].data() + i));
+        const float32x4_t ty = vsubq_f32(oy, vld1q_f32(triangles.vertex0[1].data() + i));
+        const float32x4_t tz = vsubq_f32(oz, vld1q_f32(triangles.vertex0[2].data() + i));
+        // P = direction x edge2, Q = T x edge1
+        const float32x4_t px = vmlsq_n_f32(vmulq_n_f32(e2z, direction.y()), e2y, direction.z());
+        const float32x4_t py = vmlsq_n_f32(vmulq_n_f32(e2x, direction.z()), e2z, direction.x());
+        const float32x4_t pz = vmlsq_n_f32(vmulq_n_f32(e2y, direction.x()), e2x, direction.y());
+        const float32x4_t qx = vmlsq_f32(vmulq_f32(ty, e1z), tz, e1y);
+        const float32x4_t qy = vmlsq_f32(vmulq_f32(tz, e1x), tx, e1z);
+        const float32x4_t qz = vmlsq_f32(vmulq_f32(tx, e1y), ty, e1x);
+        const float32x4_t det = vmlaq_f32(vmlaq_f32(vmulq_f32(e1x, px), e1y, py), e1z, pz);
+        const float32x4_t u = vmlaq_f32(vmlaq_f32(vmulq_f32(tx, px), ty, py), tz, pz);
+        const float32x4_t v = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(qx, direction.x()), qy, direction.y()), qz, direction.z());
+        // t * det, compared against the scaled limits since det is positive for all candidates
+        const float32x4_t tdet = vmlaq_f32(vmlaq_f32(vmulq_f32(e2x, qx), e2y, qy), e2z, qz);
+        uint32x4_t mask = vcgtq_f32(det, vdupq_n_f32(epsilon));
+        mask = vandq_u32(mask, vcgeq_f32(u, zero));
+        mask = vandq_u32(mask, vcleq_f32(u, det));
+        mask = vandq_u32(mask, vcgeq_f32(v, zero));
+        mask = vandq_u32(mask, vcleq_f32(vaddq_f32(u, v), det));
+        mask = vandq_u32(mask, vcgtq_f32(tdet, vmulq_n_f32(det, epsilon)));
+        mask = vandq_u32(mask, vcltq_f32(tdet, vmulq_n_f32(det, hit.t)));
+        const uint32x4_t maskBits = vandq_u32(mask, bits);
+        const uint32x2_t sum = vpadd_u32(vget_low_u32(maskBits), vget_high_u32(maskBits));
+        const quint32 lanes = qMin(end - i, 4u);
+        laneHits(i, vget_lane_u32(vpadd_u32(sum, sum), 0) & ((1u << lanes) - 1u));
+    }
+#endif
+
+    for (; i < end; ++i)
+        updateTriangleHit(triangles, i, origin, direction, hit);
+}
+
+QSSGRenderRay::IntersectionResult QSSGRenderRay::intersectWithBVHClosest(const RayData &data,
+                                                                         const QSSGMeshBVHNode *root,
+                                                                         const QSSGMeshBVH &bvh,
+                                                                         HitMode mode)
+{
+    if (!root)
+        return {};
+
+    const QSSGMeshBVHTriangles &triangles = bvh.triangles();
+    TriangleHit hit;
+
+    const auto rootHit = intersectWithAABBv2(data, root->boundingData);
+    if (!rootHit.intersects())
+        return {};
+
+    QVarLengthArray<TraversalEntry<const QSSGMeshBVHNode *>, 64> stack;
+    stack.append({ root, rootHit.min });
+    while (!stack.isEmpty()) {
+        const auto entry = stack.takeLast();
+        if (entry.tmin > hit.t)
+            continue;
+
+        const QSSGMeshBVHNode *node = entry.node;
+        if (node->count != 0) {
+            for (quint32 i = node->offset, end = node->offset + node->count; i < end; ++i) {
+                const QSSGMeshBVHTriangle &triangle = triangles[i];
+                float t, u, v;
+                if (triangleHit(data.origin, data.direction, triangle.vertex1,
+                                triangle.vertex2 - triangle.vertex1, triangle.vertex3 - triangle.vertex1, t, u, v)
+                        && t < hit.t) {
+                    hit = { t, u, v, i, true };
+                }
+            }
+            if (hit.found && mode == HitMode::Any)
+                break;
+            continue;
+        }
+
+        const auto *left = static_cast<const QSSGMeshBVHNode *>(node->left);
+        const auto *right = static_cast<const QSSGMeshBVHNode *>(node->right);
+        const auto leftHit = intersectWithAABBv2(data, left->boundingData);
+        const auto rightHit = intersectWithAABBv2(data, right->boundingData);
+        const bool visitLeft = leftHit.intersects() && leftHit.min <= hit.t;
+        const bool visitRight = rightHit.intersects() && rightHit.min <= hit.t;
+        // The nearer child goes on top of the stack
+        if (visitLeft && visitRight && leftHit.min > rightHit.min) {
+            stack.append({ left, leftHit.min });
+            stack.append({ right, rightHit.min });
+        } else {
+            if (visitRight)
+                stack.append({ right, rightHit.min });
+            if (visitLeft)
+                stack.append({ left, leftHit.min });
+        }
+    }
+
+    if (!hit.found)
+        return {};
+
+    const QSSGMeshBVHTriangle &triangle = triangles[hit.triangle];
+    const QVector3D normal = QVector3D::crossProduct(triangle.vertex2 - triangle.vertex1,
+                                                     triangle.vertex3 - triangle.vertex1).normalized();
+    return triangleIntersectionResult(data,
+                                      triangle.vertex1, triangle.vertex2, triangle.vertex3,
+                                      triangle.uvCoord1, triangle.uvCoord2, triangle.uvCoord3,
+                                      hit.u, hit.v, normal);
+}
+
+QSSGRenderRay::IntersectionResult QSSGRenderRay::intersectWithPackedBVHClosest(const RayData &data,
+                                                                               const QSSGMeshBVH &bvh,
+                                                                               quint32 root,
+                                                                               HitMode mode)
+{
+    const QSSGMeshBVHPackedNodes &nodes = bvh.packedNodes();
+    if (root >= nodes.size())
+        return {};
+
+    const QSSGMeshBVHTriangleSoA &triangles = bvh.triangleSoA();
+    TriangleHit hit;
+
+    const QSSGBounds3 rootBounds = nodes[root].bounds();
+    const auto rootHit = intersectWithAABBv2(data, rootBounds);
+    if (!rootHit.intersects())
+        return {};
+
+    QVarLengthArray<TraversalEntry<quint32>, 64> stack;
+    stack.append({ root, rootHit.min });
+    while (!stack.isEmpty()) {
+        const auto entry = stack.takeLast();
+        if (entry.tmin > hit.t)
+            continue;
+
+        const QSSGMeshBVHPackedNode &node = nodes[entry.node];
+        if (node.isLeaf()) {
+            intersectLeafTriangles(triangles, node.index, node.count, data.origin, data.direction, hit);
+            if (hit.found && mode == HitMode::Any)
+                break;
+            continue;
+        }
+
+        // The left child follows its parent
+        const quint32 left = entry.node + 1;
+        const quint32 right = node.index;
+        const QSSGBounds3 leftBounds = nodes[left].bounds();
+        const QSSGBounds3 rightBounds = nodes[right].bounds();
+        const auto leftHit = intersectWithAABBv2(data, leftBounds);
+        const auto rightHit = intersectWithAABBv2(data, rightBounds);
+        const bool visitLeft = leftHit.intersects() && leftHit.min <= hit.t;
+        const bool visitRight = rightHit.intersects() && rightHit.min <= hit.t;
+        // The nearer child goes on top of the stack
+        if (visitLeft && visitRight && leftHit.min > rightHit.min) {
+            stack.append({ left, leftHit.min });
+            stack.append({ right, rightHit.min });
+        } else {
+            if (visitRight)
+                stack.append({ right, rightHit.min });
+            if (visitLeft)
+                stack.append({ left, leftHit.min });
+        }
+    }
+
+    if (!hit.found)
+        return {};
+
+    const quint32 *indices = bvh.triangleIndices().data() + size_t(hit.triangle) * 3;
+    const std::vector<QVector3D> &vertices = bvh.vertices();
+    const std::vector<QVector2D> &uvs = bvh.uvs();
+    const bool hasUVs = !uvs.empty();
+    const QVector3D &vertex1 = vertices[indices[0]];
+    const QVector3D &vertex2 = vertices[indices[1]];
+    const QVector3D &vertex3 = vertices[indices[2]];
+    const QVector3D normal = QVector3D::crossProduct(vertex2 - vertex1, vertex3 - vertex1).normalized();
+    return triangleIntersectionResult(data,
+                                      vertex1, vertex2, vertex3,
+                                      hasUVs ? uvs[indices[0]] : QVector2D(),
+                                      hasUVs ? uvs[indices[1]] : QVector2D(),
+                                      hasUVs ? uvs[indices[2]] : QVector2D(),
+                                      hit.u, hit.v, normal);
+}
 
 QVector<QSSGRenderRay::IntersectionResult> QSSGRenderRay::intersectWithBVHTriangles(const RayData &data,
                                                                                     const QSSGMeshBVHTriangles &bvhTriangles,
@@ -228,41 +675,10 @@ QVector<QSSGRenderRay::IntersectionResult> QSSGRenderRay::intersectWithBVHTriang
 
     for (int i = triangleOffset; i < triangleCount + triangleOffset; ++i) {
         const auto &triangle = bvhTriangles[i];
-
-        QSSGRenderRay relativeRay(data.origin, data.direction);
-
-        // Use Barycentric Coordinates to get the intersection values
-        float u = 0.f;
-        float v = 0.f;
-        QVector3D normal;
-        const bool intersects = triangleIntersect(relativeRay,
-                                                  triangle.vertex1,
-                                                  triangle.vertex2,
-                                                  triangle.vertex3,
-                                                  u,
-                                                  v,
-                                                  normal);
-        if (intersects) {
-            const float w = 1.0f - u - v;
-            const QVector3D localIntersectionPoint = w * triangle.vertex1 +
-                                                     u * triangle.vertex2 +
-                                                     v * triangle.vertex3;
-
-            const QVector2D uvCoordinate = w * triangle.uvCoord1 +
-                                           u * triangle.uvCoord2 +
-                                           v * triangle.uvCoord3;
-            // Get the intersection point in scene coordinates
-            const QVector3D sceneIntersectionPos = QSSGUtils::mat44::transform(data.globalTransform,
-                                                                    localIntersectionPoint);
-            const QVector3D hitVector = data.ray.origin - sceneIntersectionPos;
-            // Get the magnitude of the hit vector
-            const float rayLengthSquared = QSSGUtils::vec3::magnitudeSquared(hitVector);
-            results.append(IntersectionResult(rayLengthSquared,
-                                              uvCoordinate,
-                                              sceneIntersectionPos,
-                                              localIntersectionPoint,
-                                              normal));
-        }
+        intersectTriangle(data,
+                          triangle.vertex1, triangle.vertex2, triangle.vertex3,
+                          triangle.uvCoord1, triangle.uvCoord2, triangle.uvCoord3,
+                          results);
     }
 
     // Does not intersect with any of the triangles
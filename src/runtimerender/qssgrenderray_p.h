@@ -27,6 +27,7 @@
 
 QT_BEGIN_NAMESPACE
 class QSSGMeshBVHNode;
+class QSSGMeshBVH;
 struct QSSGRenderMesh;
 struct QSSGMeshBVHTriangle;
 enum class QSSGRenderBasisPlanes
@@ -120,6 +121,30 @@ struct Q_AUTOTEST_EXPORT QSSGRenderRay
                                         QVector<IntersectionResult> &intersections,
                                         int depth = 0);
 
+    // Traversal of the packed layout (QSSGMeshBVH::isPacked()), starting at the given root
+    static void intersectWithPackedBVH(const RayData &data,
+                                       const QSSGMeshBVH &bvh,
+                                       quint32 root,
+                                       QVector<IntersectionResult> &intersections);
+
+    enum class HitMode : quint8
+    {
+        Closest,
+        Any // Stops at the first hit found, for occlusion queries
+    };
+
+    // Nearest hit of the ray with the triangles below the node. Visits the nearer child first
+    // and skips subtrees behind the best hit so far, without collecting all intersections.
+    static IntersectionResult intersectWithBVHClosest(const RayData &data,
+                                                      const QSSGMeshBVHNode *root,
+                                                      const QSSGMeshBVH &bvh,
+                                                      HitMode mode = HitMode::Closest);
+    // Same for the packed layout, the leaf triangles are tested several at a time
+    static IntersectionResult intersectWithPackedBVHClosest(const RayData &data,
+                                                            const QSSGMeshBVH &bvh,
+                                                            quint32 root,
+                                                            HitMode mode = HitMode::Closest);
+
     static QVector<IntersectionResult> intersectWithBVHTriangles(const RayData &data,
                                                                  const std::vector<QSSGMeshBVHTriangle> &bvhTriangles,
                                                                  int triangleOffset,
@@ -260,6 +260,15 @@ static inline QString persistentQsbcFileName()
     return QString();
 }
 
+static inline QString persistentPipelineWarmupFileName()
+{
+    const QString cacheDir = persistentQsbcDir();
+    if (!cacheDir.isEmpty())
+        return cacheDir + QLatin1String("q3dshadercache.pipelines");
+
+    return QString();
+}
+
 QSSGShaderCache::QSSGShaderCache(QSSGRhiContext &ctx,
                                  const InitBakerFunc initBakeFn)
     : m_rhiContext(ctx),
@@ -281,6 +290,15 @@ QSSGShaderCache::QSSGShaderCache(QSSGRhiContext &ctx,
                     }
                 }
             }
+
+            // The pipelines created for the material shaders are recorded, so
+            // that a later run can create them up front.
+            m_pipelineWarmupFileName = persistentPipelineWarmupFileName();
+            if (!skipCacheFile && QFileInfo::exists(m_pipelineWarmupFileName)) {
+                if (m_pipelineWarmupCache.load(m_pipelineWarmupFileName) && shaderDebug)
+                    qDebug("Loaded %d pipeline states for warmup", int(m_pipelineWarmupCache.entryCount()));
+            }
+            QSSGRhiContextPrivate::get(&m_rhiContext)->m_pipelineWarmup = &m_pipelineWarmupCache;
         }
     }
 
@@ -301,6 +319,12 @@ QSSGShaderCache::~QSSGShaderCache()
 {
     if (!m_persistentShaderStorageFileName.isEmpty())
         m_persistentShaderBakingCache.save(m_persistentShaderStorageFileName);
+
+    QSSGRhiContextPrivate *rhiCtxD = QSSGRhiContextPrivate::get(&m_rhiContext);
+    if (rhiCtxD->m_pipelineWarmup == &m_pipelineWarmupCache)
+        rhiCtxD->m_pipelineWarmup = nullptr;
+    if (!m_pipelineWarmupFileName.isEmpty() && m_pipelineWarmupCache.isDirty())
+        m_pipelineWarmupCache.save(m_pipelineWarmupFileName);
 }
 
 void QSSGShaderCache::releaseCachedResources()
@@ -309,8 +333,11 @@ void QSSGShaderCache::releaseCachedResources()
 
     m_rhiShaders.clear();
 
-    // m_persistentShaderBakingCache is not cleared, that is intentional,
-    // otherwise we would permanently lose what got loaded at startup.
+    m_pipelineWarmupCache.releaseCachedResources();
+
+    // m_persistentShaderBakingCache and the recorded pipeline states are not
+    // cleared, that is intentional, otherwise we would permanently lose what
+    // got loaded at startup.
 }
 
 QSSGRhiShaderPipelinePtr QSSGShaderCache::tryGetRhiShaderPipeline(const QByteArray &inKey,
@@ -21,6 +21,7 @@
 #include <QtQuick3DUtils/private/qqsbcollection_p.h>
 
 #include <QtQuick3DRuntimeRender/private/qssgrhicontext_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderpipelinewarmup_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgrendererimplshaders_p.h>
 
 #include <QtCore/QString>
@@ -183,6 +184,8 @@ private:
     InitBakerFunc m_initBaker;
     QQsbInMemoryCollection m_persistentShaderBakingCache;
     QString m_persistentShaderStorageFileName;
+    QSSGPipelineWarmupCache m_pipelineWarmupCache;
+    QString m_pipelineWarmupFileName;
     QSSGBuiltInRhiShaderCache m_builtInShaders;
 
     QSSGRhiShaderPipelinePtr loadBuiltinUncached(const QByteArray &inKey, int viewCount);
@@ -202,6 +205,8 @@ public:
 
     QQsbInMemoryCollection &persistentShaderBakingCache() { return m_persistentShaderBakingCache; }
 
+    QSSGPipelineWarmupCache &pipelineWarmupCache() { return m_pipelineWarmupCache; }
+
     QSSGRhiShaderPipelinePtr tryGetRhiShaderPipeline(const QByteArray &inKey,
                                                      const QSSGShaderFeatures &inFeatures);
 
@@ -219,7 +219,10 @@ QSSGShadowMapEntry *QSSGRenderShadowMap::addDirectionalShadowMap(qint32 lightIdx
             qWarning("Failed to build shadow map render target");
 
         const QByteArray rtName = renderNodeObjName.toLatin1();
-        rt->setName(rtName + QByteArrayLiteral(" shadow map"));
+        if (csmNumSplits > 0)
+            rt->setName(rtName + QByteArrayLiteral(" shadow map cascade: ") + QByteArray::number(splitIndex));
+        else
+            rt->setName(rtName + QByteArrayLiteral(" shadow map"));
     }
 
     pEntry->m_lightIndex = lightIdx;
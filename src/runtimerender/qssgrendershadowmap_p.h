@@ -66,6 +66,10 @@ struct QSSGShadowMapEntry
     float m_csmSplits[4] = {};
     float m_csmActive[4] = {};
     float m_shadowMapFar = 0.f;
+
+    // With shadow map caching, the content each cascade or cube face was last
+    // rendered with. 0 means that it has to be rendered.
+    std::array<size_t, 6> m_contentKeys = {};
 };
 
 class Q_QUICK3DRUNTIMERENDER_EXPORT QSSGRenderShadowMap
@@ -11,6 +11,7 @@
 #include <QtQuick3DUtils/private/qssgassert_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgrenderableimage_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgrendermesh_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderpipelinewarmup_p.h>
 #include <QtQuick3DUtils/private/qssgutils_p.h>
 #include <QtQuick3DUtils/private/qssgassert_p.h>
 #include <qtquick3d_tracepoints_p.h>
@@ -268,6 +269,19 @@ QRhiVertexInputAttribute::Format toVertexInputFormat(QSSGRenderComponentType com
         default:
             break;
         }
+    } else if (compType == QSSGRenderComponentType::Float16) {
+        switch (numComps) {
+        case 1:
+            return QRhiVertexInputAttribute::Half;
+        case 2:
+            return QRhiVertexInputAttribute::Half2;
+        case 3:
+            return QRhiVertexInputAttribute::Half3;
+        case 4:
+            return QRhiVertexInputAttribute::Half4;
+        default:
+            break;
+        }
     } else if (compType == QSSGRenderComponentType::UnsignedInt32) {
         switch (numComps) {
         case 1:
@@ -1492,6 +1506,8 @@ void QSSGRhiContextStats::beginRenderPass(QRhiTextureRenderTarget *rt)
     Q_TRACE(QSSG_renderPass_entry, QString::fromUtf8(rt->name()));
     info.renderPasses.append({ rt->name(), rt->pixelSize(), {}, {}, {}, {} });
     info.currentRenderPassIndex = info.renderPasses.size() - 1;
+    lastPipeline = nullptr;
+    lastSrb = nullptr;
 }
 
 void QSSGRhiContextStats::endRenderPass()
@@ -1499,6 +1515,8 @@ void QSSGRhiContextStats::endRenderPass()
     Q_TRACE(QSSG_renderPass_exit);
     PerLayerInfo &info(perLayerInfo[layerKey]);
     info.currentRenderPassIndex = -1;
+    lastPipeline = nullptr;
+    lastSrb = nullptr;
 }
 
 QSSGRhiContextStats &QSSGRhiContextStats::get(QSSGRhiContext &rhiCtx)
@@ -1559,6 +1577,34 @@ void QSSGRhiContextStats::draw(quint32 vertexCount, quint32 instanceCount)
     }
 }
 
+void QSSGRhiContextStats::setGraphicsPipeline(const QRhiGraphicsPipeline *ps)
+{
+    if (ps == lastPipeline)
+        return;
+    lastPipeline = ps;
+    PerLayerInfo &info(perLayerInfo[layerKey]);
+    RenderPassInfo &rp(info.currentRenderPassIndex >= 0 ? info.renderPasses[info.currentRenderPassIndex] : info.externalRenderPass);
+    rp.pipelineSwitches += 1;
+}
+
+void QSSGRhiContextStats::setShaderResources(const QRhiShaderResourceBindings *srb)
+{
+    if (srb == lastSrb)
+        return;
+    lastSrb = srb;
+    PerLayerInfo &info(perLayerInfo[layerKey]);
+    RenderPassInfo &rp(info.currentRenderPassIndex >= 0 ? info.renderPasses[info.currentRenderPassIndex] : info.externalRenderPass);
+    rp.srbSwitches += 1;
+}
+
+void QSSGRhiContextStats::culledObjects(quint64 count)
+{
+    PerLayerInfo &info(perLayerInfo[layerKey]);
+    RenderPassInfo &rp(info.currentRenderPassIndex >= 0 ? info.renderPasses[info.currentRenderPassIndex] : info.externalRenderPass);
+    rp.culledObjectCount += count;
+    rp.culling = true;
+}
+
 void QSSGRhiContextStats::printRenderPass(const QSSGRhiContextStats::RenderPassInfo &rp)
 {
     qDebug("%llu indexed draw calls with %llu indices in total, "
@@ -1571,6 +1617,10 @@ void QSSGRhiContextStats::printRenderPass(const QSSGRhiContextStats::RenderPassI
                rp.instancedIndexedDraws.callCount, rp.instancedIndexedDraws.vertexOrIndexCount, rp.instancedIndexedDraws.instanceCount,
                rp.instancedDraws.callCount, rp.instancedDraws.vertexOrIndexCount, rp.instancedDraws.instanceCount);
     }
+    if (rp.pipelineSwitches || rp.srbSwitches)
+        qDebug("%llu pipeline switches, %llu shader resource binding switches", rp.pipelineSwitches, rp.srbSwitches);
+    if (rp.culling)
+        qDebug("%llu draw calls after culling %llu objects", totalDrawCallCountForPass(rp), rp.culledObjectCount);
 }
 
 void QSSGRhiShaderResourceBindingList::addUniformBuffer(int binding, QRhiShaderResourceBinding::StageFlags stage, QRhiBuffer *buf, int offset, int size)
@@ -1689,6 +1739,10 @@ QRhiGraphicsPipeline *QSSGRhiContextPrivate::pipeline(const QSSGGraphicsPipeline
     }
 
     m_pipelines.insert(key, ps);
+
+    if (m_pipelineWarmup && rpDesc == m_mainRpDesc)
+        m_pipelineWarmup->record(key, srb);
+
     return ps;
 }
 
@@ -28,6 +28,7 @@ struct QSSGRenderInstanceTable;
 struct QSSGRenderModel;
 struct QSSGRenderMesh;
 class QSSGRenderGraphObject;
+class QSSGPipelineWarmupCache;
 
 struct QSSGRhiInputAssemblerStatePrivate
 {
@@ -507,6 +508,12 @@ public:
 
     int offsetOfUniform(const QByteArray &name);
 
+    // The shader cache key and features the stages were looked up with. Only
+    // set for default material shaders, used to record pipelines for warmup.
+    void setWarmupKey(const QByteArray &key, quint32 features) { m_warmupKey = key; m_warmupFeatures = features; }
+    const QByteArray &warmupKey() const { return m_warmupKey; }
+    quint32 warmupFeatures() const { return m_warmupFeatures; }
+
 private:
     QSSGRhiContext &m_context;
     QVarLengthArray<QRhiShaderStage, 2> m_stages;
@@ -534,6 +541,9 @@ private:
     QRhiTexture *m_ssaoTexture = nullptr;
     QRhiTexture *m_lightmapTexture = nullptr;
     QVarLengthArray<QSSGRhiTexture, 8> m_extraTextures;
+
+    QByteArray m_warmupKey;
+    quint32 m_warmupFeatures = 0;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QSSGRhiShaderPipeline::StageFlags)
@@ -653,12 +663,18 @@ struct QSSGRhiInstanceBufferData
     QRhiBuffer *buffer = nullptr;
     QByteArray sortedData;
     QList<QSSGRhiSortData> sortData;
+    QList<QSSGRhiSortData> sortScratch; // For QSSGRenderSort::sortByKey()
     QVector3D sortedCameraDirection;
     QVector3D cameraPosition;
     QByteArray lodData;
+    QMatrix4x4 cullingViewProjection;
+    QMatrix4x4 cullingModelTransform;
+    int instanceCount = -1; // Number of instances left after culling, -1 when the whole table is uploaded
+    quint32 uploadedBytes = 0; // Written by the last QSSGLayerRenderData::prepareInstancing() call
     int serial = -1;
     bool owned = true;
     bool sorting = false;
+    bool frustumCulling = false;
 };
 
 struct QSSGRhiParticleData
@@ -667,6 +683,7 @@ struct QSSGRhiParticleData
     QByteArray sortedData;
     QByteArray convertData;
     QList<QSSGRhiSortData> sortData;
+    QList<QSSGRhiSortData> sortScratch; // For QSSGRenderSort::sortByKey()
     int particleCount = 0;
     int serial = -1;
     bool sorting = false;
@@ -793,6 +810,13 @@ public:
         DrawInfo draws;
         InstancedDrawInfo instancedIndexedDraws;
         InstancedDrawInfo instancedDraws;
+        // Number of times a different pipeline or set of shader resources was bound
+        quint64 pipelineSwitches = 0;
+        quint64 srbSwitches = 0;
+        // Number of objects skipped by culling done specifically for this pass,
+        // such as the shadow casters outside of a shadow cascade or cube face
+        quint64 culledObjectCount = 0;
+        bool culling = false;
     };
     struct PerLayerInfo {
         PerLayerInfo()
@@ -845,6 +869,9 @@ public:
     bool isEnabled() const;
     void drawIndexed(quint32 indexCount, quint32 instanceCount);
     void draw(quint32 vertexCount, quint32 instanceCount);
+    void setGraphicsPipeline(const QRhiGraphicsPipeline *ps);
+    void setShaderResources(const QRhiShaderResourceBindings *srb);
+    void culledObjects(quint64 count);
 
     void meshDataSizeChanges(quint64 newSize) // can be called outside start-stop
     {
@@ -892,6 +919,9 @@ public:
     QSSGRhiContext *rhiCtx;
     QSSGRenderLayer *layerKey = nullptr;
     QSet<QSSGRenderLayer *> dynamicDataSources;
+    // Last bound state, only used for comparison, never dereferenced
+    const QRhiGraphicsPipeline *lastPipeline = nullptr;
+    const QRhiShaderResourceBindings *lastSrb = nullptr;
 };
 
 class Q_QUICK3DRUNTIMERENDER_EXPORT QSSGRhiContextPrivate
@@ -978,6 +1008,7 @@ public:
     QHash<const QSSGRenderModel *, QSSGRhiInstanceBufferData> m_instanceBuffersLod;
     QHash<const QSSGRenderGraphObject *, QSSGRhiParticleData> m_particleData;
     QSSGRhiContextStats m_stats;
+    QSSGPipelineWarmupCache *m_pipelineWarmup = nullptr; // not owned, records new pipelines when set
 };
 
 inline bool operator==(const QSSGRhiDrawCallDataKey &a, const QSSGRhiDrawCallDataKey &b) noexcept
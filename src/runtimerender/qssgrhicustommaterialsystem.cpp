@@ -247,7 +247,8 @@ void QSSGCustomMaterialSystem::rhiPrepareRenderable(QSSGRhiGraphicsPipelineState
         bool instancing = false;
         if (!alteredCamera) {
             const QSSGRenderCameraDataList &cameraDatas(*layerData.renderedCameraData);
-            instancing = QSSGLayerRenderData::prepareInstancing(rhiCtx, &renderable, cameraDatas[0].direction, cameraDatas[0].position, renderable.instancingLodMin, renderable.instancingLodMax);
+            const QSSGRenderCameraData *cullingCamera = layerData.instanceCullingCamera(renderable);
+            instancing = QSSGLayerRenderData::prepareInstancing(rhiCtx, &renderable, cameraDatas[0].direction, cameraDatas[0].position, renderable.instancingLodMin, renderable.instancingLodMax, cullingCamera);
         } else {
             instancing = QSSGLayerRenderData::prepareInstancing(rhiCtx, &renderable, alteredCamera->getScalingCorrectDirection(), alteredCamera->getGlobalPos(), renderable.instancingLodMin, renderable.instancingLodMax);
         }
@@ -651,6 +652,10 @@ void QSSGCustomMaterialSystem::rhiRenderRenderable(QSSGRhiContext *rhiCtx,
     if (!ps || !srb)
         return;
 
+    // Making an instanced draw call with a count of 0 is invalid, this happens when all instances were culled
+    if (renderable.modelContext.model.instancing() && renderable.instanceCount == 0)
+        return;
+
     Q_QUICK3D_PROFILE_START(QQuick3DProfiler::Quick3DRenderCall);
     QRhiBuffer *vertexBuffer = renderable.subset.rhi.vertexBuffer->buffer();
     QRhiBuffer *indexBuffer = renderable.subset.rhi.indexBuffer ? renderable.subset.rhi.indexBuffer->buffer() : nullptr;
@@ -658,6 +663,8 @@ void QSSGCustomMaterialSystem::rhiRenderRenderable(QSSGRhiContext *rhiCtx,
     QRhiCommandBuffer *cb = rhiCtx->commandBuffer();
     cb->setGraphicsPipeline(ps);
     cb->setShaderResources(srb);
+    QSSGRHICTX_STAT(rhiCtx, setGraphicsPipeline(ps));
+    QSSGRHICTX_STAT(rhiCtx, setShaderResources(srb));
 
     if (*needsSetViewport) {
         cb->setViewport(state.viewport);
@@ -669,14 +676,14 @@ void QSSGCustomMaterialSystem::rhiRenderRenderable(QSSGRhiContext *rhiCtx,
     vertexBuffers[0] = QRhiCommandBuffer::VertexInput(vertexBuffer, 0);
     quint32 instances = 1;
     if (renderable.modelContext.model.instancing()) {
-        instances = renderable.modelContext.model.instanceCount();
+        instances = renderable.instanceCount;
         vertexBuffers[1] = QRhiCommandBuffer::VertexInput(renderable.instanceBuffer, 0);
         vertexBufferCount = 2;
     }
     if (indexBuffer) {
         cb->setVertexInput(0, vertexBufferCount, vertexBuffers, indexBuffer, 0, renderable.subset.rhi.indexBuffer->indexFormat());
-        cb->drawIndexed(renderable.subset.count, instances, renderable.subset.offset);
-        QSSGRHICTX_STAT(rhiCtx, drawIndexed(renderable.subset.count, instances));
+        cb->drawIndexed(renderable.subset.residentLodCount(), instances, renderable.subset.residentLodOffset());
+        QSSGRHICTX_STAT(rhiCtx, drawIndexed(renderable.subset.residentLodCount(), instances));
     } else {
         cb->setVertexInput(0, vertexBufferCount, vertexBuffers);
         cb->draw(renderable.subset.count, instances, renderable.subset.offset);
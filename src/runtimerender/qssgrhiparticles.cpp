@@ -11,6 +11,7 @@
 #include <QtQuick3DRuntimeRender/private/qssgrenderer_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgrendercamera_p.h>
 #include <QtQuick3DRuntimeRender/private/qssglayerrenderdata_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrendersort_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -193,7 +194,7 @@ static void fillTargetBlend(QRhiGraphicsPipeline::TargetBlend &targetBlend, QSSG
     }
 }
 
-static void sortParticles(QByteArray &result, QList<QSSGRhiSortData> &sortData,
+static void sortParticles(QByteArray &result, QList<QSSGRhiSortData> &sortData, QList<QSSGRhiSortData> &sortScratch,
                           const QSSGParticleBuffer &buffer, const QSSGRenderParticles &particles,
                           const QVector3D &cameraDirection, bool animatedParticles)
 {
@@ -264,8 +265,8 @@ static void sortParticles(QByteArray &result, QList<QSSGRhiSortData> &sortData,
 
     // sort
     result.resize(buffer.bufferSize());
-    std::sort(sortData.begin(), sortData.end(), [](const QSSGRhiSortData &a, const QSSGRhiSortData &b){
-        return a.d > b.d;
+    QSSGRenderSort::sortByKey(sortData, sortScratch, [](const QSSGRhiSortData &s) {
+        return ~QSSGRenderSort::floatToSortableKey(s.d);
     });
 
     auto copyParticles = [&](QByteArray &dst, const QList<QSSGRhiSortData> &data, const QSSGParticleBuffer &buffer) {
@@ -379,6 +380,7 @@ void QSSGParticleRenderer::rhiPrepareRenderable(QSSGRhiShaderPipeline &shaderPip
     bool sortingChanged = particleData.sorting != renderable.particles.m_depthSorting;
     if (sortingChanged && !renderable.particles.m_depthSorting) {
         particleData.sortData.clear();
+        particleData.sortScratch.clear();
         particleData.sortedData.clear();
     }
     particleData.sorting = renderable.particles.m_depthSorting;
@@ -388,9 +390,9 @@ void QSSGParticleRenderer::rhiPrepareRenderable(QSSGRhiShaderPipeline &shaderPip
     if (renderable.particles.m_depthSorting) {
         bool animatedParticles = renderable.particles.m_featureLevel == QSSGRenderParticles::FeatureLevel::Animated;
         if (!alteredCamera)
-            sortParticles(particleData.sortedData, particleData.sortData, particleBuffer, renderable.particles, inData.renderedCameraData.value()[0].direction, animatedParticles);
+            sortParticles(particleData.sortedData, particleData.sortData, particleData.sortScratch, particleBuffer, renderable.particles, inData.renderedCameraData.value()[0].direction, animatedParticles);
         else
-            sortParticles(particleData.sortedData, particleData.sortData, particleBuffer, renderable.particles, alteredCamera->getScalingCorrectDirection(), animatedParticles);
+            sortParticles(particleData.sortedData, particleData.sortData, particleData.sortScratch, particleBuffer, renderable.particles, alteredCamera->getScalingCorrectDirection(), animatedParticles);
         uploadData = convertParticleData(particleData.convertData, particleData.sortedData, needsConversion);
     } else {
         uploadData = convertParticleData(particleData.convertData, particleBuffer.data(), needsConversion);
@@ -619,6 +621,8 @@ void QSSGParticleRenderer::rhiRenderRenderable(QSSGRhiContext *rhiCtx,
     cb->setGraphicsPipeline(ps);
     cb->setVertexInput(0, 0, nullptr);
     cb->setShaderResources(srb);
+    QSSGRHICTX_STAT(rhiCtx, setGraphicsPipeline(ps));
+    QSSGRHICTX_STAT(rhiCtx, setShaderResources(srb));
 
     if (needsSetViewport && *needsSetViewport) {
         cb->setViewport(state.viewport);
@@ -23,6 +23,7 @@
 #include <QtQuick3DRuntimeRender/private/qssgruntimerenderlogging_p.h>
 #include <QtQuick3DRuntimeRender/private/qssglightmapper_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgdebugdrawsystem_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderoptimizations_p.h>
 
 #include <QtQuick3DUtils/private/qssgutils_p.h>
 #include <QtQuick3DUtils/private/qssgassert_p.h>
@@ -33,8 +34,11 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QBitArray>
 #include <array>
+#include <cmath>
 
 #include "qssgrenderpass_p.h"
+#include "qssgrenderjobs_p.h"
+#include "qssgrendersort_p.h"
 #include "rendererimpl/qssgrenderhelpers_p.h"
 
 QT_BEGIN_NAMESPACE
@@ -108,6 +112,47 @@ qsizetype QSSGLayerRenderData::frustumCullingInline(const QSSGClippingFrustum &c
     return back + 1;
 }
 
+qsizetype QSSGLayerRenderData::frustumCullingBatch(const QSSGClippingFrustum &clipFrustum, const QSSGBoundsSoA &bounds, QSSGRenderableObjectList &renderables)
+{
+    QSSG_ASSERT(bounds.size() == renderables.size(), return frustumCullingInline(clipFrustum, renderables));
+
+    const qsizetype count = renderables.size();
+    QVarLengthArray<quint32, 64> visibilityMask(QSSGBoundsSoA::maskWordCount(count));
+    clipFrustum.intersectsWith(bounds, visibilityMask.data());
+
+    qsizetype visibleCount = 0;
+    for (qsizetype idx = 0; idx != count; ++idx) {
+        if (visibilityMask[idx >> 5] & (1u << (idx & 31)))
+            renderables[visibleCount++] = renderables.at(idx);
+    }
+
+    return visibleCount;
+}
+
+qsizetype QSSGLayerRenderData::frustumCullingBatch(const QSSGClippingFrustum &clipFrustum, const QSSGBoundsSoA &first, const QSSGBoundsSoA &second, QSSGRenderableObjectList &renderables)
+{
+    QSSG_ASSERT(first.size() + second.size() == renderables.size(), return frustumCullingInline(clipFrustum, renderables));
+
+    const qsizetype firstCount = first.size();
+    const qsizetype secondCount = second.size();
+    QVarLengthArray<quint32, 64> firstMask(QSSGBoundsSoA::maskWordCount(firstCount));
+    QVarLengthArray<quint32, 64> secondMask(QSSGBoundsSoA::maskWordCount(secondCount));
+    clipFrustum.intersectsWith(first, firstMask.data());
+    clipFrustum.intersectsWith(second, secondMask.data());
+
+    qsizetype visibleCount = 0;
+    for (qsizetype idx = 0; idx != firstCount; ++idx) {
+        if (firstMask[idx >> 5] & (1u << (idx & 31)))
+            renderables[visibleCount++] = renderables.at(idx);
+    }
+    for (qsizetype idx = 0; idx != secondCount; ++idx) {
+        if (secondMask[idx >> 5] & (1u << (idx & 31)))
+            renderables[visibleCount++] = renderables.at(firstCount + idx);
+    }
+
+    return visibleCount;
+}
+
 [[nodiscard]] constexpr static inline bool nearestToFurthestCompare(const QSSGRenderableObjectHandle &lhs, const QSSGRenderableObjectHandle &rhs) noexcept
 {
     return lhs.cameraDistanceSq < rhs.cameraDistanceSq;
@@ -118,6 +163,74 @@ qsizetype QSSGLayerRenderData::frustumCullingInline(const QSSGClippingFrustum &c
     return lhs.cameraDistanceSq > rhs.cameraDistanceSq;
 }
 
+// Optional opaque ordering (QT_QUICK3D_OPAQUE_STATE_SORT=1) that groups draws sharing the same
+// pipeline and shader resources, so fewer switches are needed, while coarse depth buckets keep
+// the order roughly front to back. See sortOpaqueByState().
+static constexpr int OPAQUE_SORT_DEPTH_BUCKETS = 8;
+
+// The state the renderable was prepared with for the main pass
+static std::pair<quintptr, quintptr> mainPassState(const QSSGRenderableObject *obj)
+{
+    switch (obj->type) {
+    case QSSGRenderableObject::Type::DefaultMaterialMeshSubset:
+    case QSSGRenderableObject::Type::CustomMaterialMeshSubset: {
+        const auto &mainPass = static_cast<const QSSGSubsetRenderable *>(obj)->rhiRenderData.mainPass;
+        return { quintptr(mainPass.pipeline), quintptr(mainPass.srb) };
+    }
+    case QSSGRenderableObject::Type::Particles: {
+        const auto &mainPass = static_cast<const QSSGParticlesRenderable *>(obj)->rhiRenderData.mainPass;
+        return { quintptr(mainPass.pipeline), quintptr(mainPass.srb) };
+    }
+    }
+    return {};
+}
+
+void QSSGLayerRenderData::sortOpaqueByState(QSSGRenderableObjectList &renderables)
+{
+    if (renderables.size() < 2)
+        return;
+
+    // Buckets are spread evenly over the logarithm of the distance, so that nearby objects,
+    // which cover more of the screen, are split finer than the ones far away.
+    constexpr float minDistance = 1e-3f;
+    const auto logDistance = [](const QSSGRenderableObjectHandle &handle) {
+        return std::log2(std::max(std::sqrt(handle.cameraDistanceSq), minDistance));
+    };
+    float minLogDistance = logDistance(renderables.first());
+    float maxLogDistance = minLogDistance;
+    for (const auto &handle : std::as_const(renderables)) {
+        const float d = logDistance(handle);
+        minLogDistance = qMin(minLogDistance, d);
+        maxLogDistance = qMax(maxLogDistance, d);
+    }
+    const float range = maxLogDistance - minLogDistance;
+    const float bucketScale = range > 0.0f ? OPAQUE_SORT_DEPTH_BUCKETS / range : 0.0f;
+
+    struct KeyedHandle
+    {
+        int bucket;
+        quintptr pipeline;
+        quintptr srb;
+        QSSGRenderableObjectHandle handle;
+    };
+    QVarLengthArray<KeyedHandle, 128> keyed;
+    keyed.reserve(renderables.size());
+    for (const auto &handle : std::as_const(renderables)) {
+        const int bucket = qBound(0, int((logDistance(handle) - minLogDistance) * bucketScale), OPAQUE_SORT_DEPTH_BUCKETS - 1);
+        const auto [pipeline, srb] = mainPassState(handle.obj);
+        keyed.append({ bucket, pipeline, srb, handle });
+    }
+
+    // Within the same state the objects are still drawn nearest to furthest
+    std::sort(keyed.begin(), keyed.end(), [](const KeyedHandle &lhs, const KeyedHandle &rhs) {
+        return std::tie(lhs.bucket, lhs.pipeline, lhs.srb, lhs.handle.cameraDistanceSq)
+                < std::tie(rhs.bucket, rhs.pipeline, rhs.srb, rhs.handle.cameraDistanceSq);
+    });
+
+    for (qsizetype i = 0, end = keyed.size(); i != end; ++i)
+        renderables[i] = keyed[i].handle;
+}
+
 static void collectBoneTransforms(QSSGRenderNode *node, QSSGRenderSkeleton *skeletonNode, const QVector<QMatrix4x4> &poses)
 {
     if (node->type == QSSGRenderGraphObject::Type::Joint) {
@@ -191,6 +304,40 @@ static inline void collectNodeFront(V node, QVector<T> &dst, int &dstPos)
 #define MAX_MORPH_TARGET_INDEX_SUPPORTS_NORMALS 3
 #define MAX_MORPH_TARGET_INDEX_SUPPORTS_TANGENTS 1
 
+static void queueNodeForRender(QSSGRenderNode &inNode,
+                               QVector<QSSGRenderableNodeEntry> &outRenderableModels,
+                               int &ioRenderableModelsCount,
+                               QVector<QSSGRenderableNodeEntry> &outRenderableParticles,
+                               int &ioRenderableParticlesCount,
+                               QVector<QSSGRenderItem2D *> &outRenderableItem2Ds,
+                               int &ioRenderableItem2DsCount,
+                               QVector<QSSGRenderCamera *> &outCameras,
+                               int &ioCameraCount,
+                               QVector<QSSGRenderLight *> &outLights,
+                               int &ioLightCount,
+                               QVector<QSSGRenderReflectionProbe *> &outReflectionProbes,
+                               int &ioReflectionProbeCount,
+                               quint32 &ioDFSIndex)
+{
+    ++ioDFSIndex;
+    inNode.dfsIndex = ioDFSIndex;
+    if (QSSGRenderGraphObject::isRenderable(inNode.type)) {
+        if (inNode.type == QSSGRenderNode::Type::Model)
+            collectNode(QSSGRenderableNodeEntry(inNode), outRenderableModels, ioRenderableModelsCount);
+        else if (inNode.type == QSSGRenderNode::Type::Particles)
+            collectNode(QSSGRenderableNodeEntry(inNode), outRenderableParticles, ioRenderableParticlesCount);
+        else if (inNode.type == QSSGRenderNode::Type::Item2D) // Pushing front to keep item order inside QML file
+            collectNodeFront(static_cast<QSSGRenderItem2D *>(&inNode), outRenderableItem2Ds, ioRenderableItem2DsCount);
+    } else if (QSSGRenderGraphObject::isCamera(inNode.type)) {
+        collectNode(static_cast<QSSGRenderCamera *>(&inNode), outCameras, ioCameraCount);
+    } else if (QSSGRenderGraphObject::isLight(inNode.type)) {
+        if (auto &light = static_cast<QSSGRenderLight &>(inNode); light.isEnabled())
+            collectNode(&light, outLights, ioLightCount);
+    } else if (inNode.type == QSSGRenderGraphObject::Type::ReflectionProbe) {
+        collectNode(static_cast<QSSGRenderReflectionProbe *>(&inNode), outReflectionProbes, ioReflectionProbeCount);
+    }
+}
+
 static bool maybeQueueNodeForRender(QSSGRenderNode &inNode,
                                     QVector<QSSGRenderableNodeEntry> &outRenderableModels,
                                     int &ioRenderableModelsCount,
@@ -208,23 +355,20 @@ static bool maybeQueueNodeForRender(QSSGRenderNode &inNode,
 {
     bool wasDirty = inNode.isDirty(QSSGRenderNode::DirtyFlag::GlobalValuesDirty) && inNode.calculateGlobalVariables();
     if (inNode.getGlobalState(QSSGRenderNode::GlobalState::Active)) {
-        ++ioDFSIndex;
-        inNode.dfsIndex = ioDFSIndex;
-        if (QSSGRenderGraphObject::isRenderable(inNode.type)) {
-            if (inNode.type == QSSGRenderNode::Type::Model)
-                collectNode(QSSGRenderableNodeEntry(inNode), outRenderableModels, ioRenderableModelsCount);
-            else if (inNode.type == QSSGRenderNode::Type::Particles)
-                collectNode(QSSGRenderableNodeEntry(inNode), outRenderableParticles, ioRenderableParticlesCount);
-            else if (inNode.type == QSSGRenderNode::Type::Item2D) // Pushing front to keep item order inside QML file
-                collectNodeFront(static_cast<QSSGRenderItem2D *>(&inNode), outRenderableItem2Ds, ioRenderableItem2DsCount);
-        } else if (QSSGRenderGraphObject::isCamera(inNode.type)) {
-            collectNode(static_cast<QSSGRenderCamera *>(&inNode), outCameras, ioCameraCount);
-        } else if (QSSGRenderGraphObject::isLight(inNode.type)) {
-            if (auto &light = static_cast<QSSGRenderLight &>(inNode); light.isEnabled())
-                collectNode(&light, outLights, ioLightCount);
-        } else if (inNode.type == QSSGRenderGraphObject::Type::ReflectionProbe) {
-            collectNode(static_cast<QSSGRenderReflectionProbe *>(&inNode), outReflectionProbes, ioReflectionProbeCount);
-        }
+        queueNodeForRender(inNode,
+                           outRenderableModels,
+                           ioRenderableModelsCount,
+                           outRenderableParticles,
+                           ioRenderableParticlesCount,
+                           outRenderableItem2Ds,
+                           ioRenderableItem2DsCount,
+                           outCameras,
+                           ioCameraCount,
+                           outLights,
+                           ioLightCount,
+                           outReflectionProbes,
+                           ioReflectionProbeCount,
+                           ioDFSIndex);
 
         for (auto &theChild : inNode.children)
             wasDirty |= maybeQueueNodeForRender(theChild,
@@ -245,6 +389,225 @@ static bool maybeQueueNodeForRender(QSSGRenderNode &inNode,
     return wasDirty;
 }
 
+// Flat variant of the traversal above (QT_QUICK3D_FLAT_NODE_HIERARCHY=1).
+// The nodes are kept in an array in DFS order together with the end of each node's
+// subtree, and the array is only rebuilt when nodes are added or removed. Walking
+// the graph is then a linear pass over the array: parents always come before their
+// children, so calculateGlobalVariables() finds the parent up-to-date and does not
+// recurse, and inactive subtrees are skipped by jumping to their end. The result
+// (including the dfsIndex) is identical to the recursive traversal.
+static void flattenNodeHierarchy(QSSGRenderNode &inNode, QVector<QSSGRenderNode *> &outNodes, QVector<qsizetype> &outSubtreeEnds)
+{
+    const qsizetype index = outNodes.size();
+    outNodes.push_back(&inNode);
+    outSubtreeEnds.push_back(index + 1);
+    for (auto &theChild : inNode.children)
+        flattenNodeHierarchy(theChild, outNodes, outSubtreeEnds);
+    outSubtreeEnds[index] = outNodes.size();
+}
+
+static bool maybeQueueNodesForRenderFlat(const QVector<QSSGRenderNode *> &nodes,
+                                         const QVector<qsizetype> &subtreeEnds,
+                                         QVector<QSSGRenderableNodeEntry> &outRenderableModels,
+                                         int &ioRenderableModelsCount,
+                                         QVector<QSSGRenderableNodeEntry> &outRenderableParticles,
+                                         int &ioRenderableParticlesCount,
+                                         QVector<QSSGRenderItem2D *> &outRenderableItem2Ds,
+                                         int &ioRenderableItem2DsCount,
+                                         QVector<QSSGRenderCamera *> &outCameras,
+                                         int &ioCameraCount,
+                                         QVector<QSSGRenderLight *> &outLights,
+                                         int &ioLightCount,
+                                         QVector<QSSGRenderReflectionProbe *> &outReflectionProbes,
+                                         int &ioReflectionProbeCount,
+                                         quint32 &ioDFSIndex)
+{
+    bool wasDirty = false;
+    for (qsizetype i = 0, end = nodes.size(); i < end; ) {
+        QSSGRenderNode &inNode = *nodes.at(i);
+        wasDirty |= inNode.isDirty(QSSGRenderNode::DirtyFlag::GlobalValuesDirty) && inNode.calculateGlobalVariables();
+        if (!inNode.getGlobalState(QSSGRenderNode::GlobalState::Active)) {
+            i = subtreeEnds.at(i);
+            continue;
+        }
+        queueNodeForRender(inNode,
+                           outRenderableModels,
+                           ioRenderableModelsCount,
+                           outRenderableParticles,
+                           ioRenderableParticlesCount,
+                           outRenderableItem2Ds,
+                           ioRenderableItem2DsCount,
+                           outCameras,
+                           ioCameraCount,
+                           outLights,
+                           ioLightCount,
+                           outReflectionProbes,
+                           ioReflectionProbeCount,
+                           ioDFSIndex);
+        ++i;
+    }
+    return wasDirty;
+}
+
+// Parallel variant of the traversal above (QT_QUICK3D_PARALLEL_TRAVERSAL=1).
+// The top of the tree is walked on the calling thread, and everything below
+// PARALLEL_TRAVERSAL_SPLIT_DEPTH is handed out as independent subtrees to the worker
+// threads. Each job writes to its own output lists, which are then merged in DFS order,
+// so the result (including the dfsIndex) is identical to the serial traversal.
+static constexpr int PARALLEL_TRAVERSAL_SPLIT_DEPTH = 2;
+static constexpr int PARALLEL_TRAVERSAL_JOBS_PER_THREAD = 4;
+
+namespace {
+struct NodeQueueTask
+{
+    QSSGRenderNode *node = nullptr;
+    bool subtree = false; // false: the node was already resolved, collect just the node.
+};
+
+struct NodeQueueResult
+{
+    QVector<QSSGRenderableNodeEntry> renderableModels;
+    QVector<QSSGRenderableNodeEntry> renderableParticles;
+    QVector<QSSGRenderItem2D *> renderableItem2Ds; // DFS order (the serial path stores them reversed)
+    QVector<QSSGRenderCamera *> cameras;
+    QVector<QSSGRenderLight *> lights;
+    QVector<QSSGRenderReflectionProbe *> reflectionProbes;
+    QVector<QSSGRenderNode *> activeNodes; // DFS order, used to assign the final dfsIndex
+    QVector<QSSGRenderNode *> instanceRootNodes; // Instance transforms resolved after the traversal
+    bool wasDirty = false;
+};
+}
+
+static void collectActiveNode(QSSGRenderNode &inNode, NodeQueueResult &out)
+{
+    out.activeNodes.push_back(&inNode);
+    if (QSSGRenderGraphObject::isRenderable(inNode.type)) {
+        if (inNode.type == QSSGRenderNode::Type::Model)
+            out.renderableModels.push_back(QSSGRenderableNodeEntry(inNode));
+        else if (inNode.type == QSSGRenderNode::Type::Particles)
+            out.renderableParticles.push_back(QSSGRenderableNodeEntry(inNode));
+        else if (inNode.type == QSSGRenderNode::Type::Item2D)
+            out.renderableItem2Ds.push_back(static_cast<QSSGRenderItem2D *>(&inNode));
+    } else if (QSSGRenderGraphObject::isCamera(inNode.type)) {
+        out.cameras.push_back(static_cast<QSSGRenderCamera *>(&inNode));
+    } else if (QSSGRenderGraphObject::isLight(inNode.type)) {
+        if (auto &light = static_cast<QSSGRenderLight &>(inNode); light.isEnabled())
+            out.lights.push_back(&light);
+    } else if (inNode.type == QSSGRenderGraphObject::Type::ReflectionProbe) {
+        out.reflectionProbes.push_back(static_cast<QSSGRenderReflectionProbe *>(&inNode));
+    }
+}
+
+// NOTE: The parent chain above inNode is expected to be up-to-date, so that
+// calculateGlobalVariables() only reads from nodes outside of this subtree. The
+// instance root of a node can be in any other subtree though, so those instance
+// transforms are left for the serial pass after the traversal.
+static void collectSubtree(QSSGRenderNode &inNode, NodeQueueResult &out)
+{
+    const bool isDirty = inNode.isDirty(QSSGRenderNode::DirtyFlag::GlobalValuesDirty);
+    out.wasDirty |= isDirty && inNode.calculateGlobalVariables(QSSGRenderNode::InstanceRootResolution::Deferred);
+    if (inNode.getGlobalState(QSSGRenderNode::GlobalState::Active)) {
+        if (isDirty && inNode.hasForeignInstanceRoot() && inNode.parent->type != QSSGRenderGraphObject::Type::Layer)
+            out.instanceRootNodes.push_back(&inNode);
+        collectActiveNode(inNode, out);
+        for (auto &theChild : inNode.children)
+            collectSubtree(theChild, out);
+    }
+}
+
+static bool gatherNodeQueueTasks(QSSGRenderNode &inNode, int depth, QVector<NodeQueueTask> &tasks)
+{
+    if (depth == PARALLEL_TRAVERSAL_SPLIT_DEPTH) {
+        tasks.push_back({ &inNode, true });
+        return false;
+    }
+
+    bool wasDirty = inNode.isDirty(QSSGRenderNode::DirtyFlag::GlobalValuesDirty) && inNode.calculateGlobalVariables();
+    if (inNode.getGlobalState(QSSGRenderNode::GlobalState::Active)) {
+        tasks.push_back({ &inNode, false });
+        for (auto &theChild : inNode.children)
+            wasDirty |= gatherNodeQueueTasks(theChild, depth + 1, tasks);
+    }
+    return wasDirty;
+}
+
+static bool maybeQueueNodesForRenderParallel(QSSGRenderLayer &layer,
+                                             QVector<QSSGRenderableNodeEntry> &outRenderableModels,
+                                             int &outRenderableModelsCount,
+                                             QVector<QSSGRenderableNodeEntry> &outRenderableParticles,
+                                             int &outRenderableParticlesCount,
+                                             QVector<QSSGRenderItem2D *> &outRenderableItem2Ds,
+                                             int &outRenderableItem2DsCount,
+                                             QVector<QSSGRenderCamera *> &outCameras,
+                                             int &outCameraCount,
+                                             QVector<QSSGRenderLight *> &outLights,
+                                             int &outLightCount,
+                                             QVector<QSSGRenderReflectionProbe *> &outReflectionProbes,
+                                             int &outReflectionProbeCount,
+                                             quint32 &outDFSIndex)
+{
+    QVector<NodeQueueTask> tasks;
+    bool wasDirty = false;
+    for (auto &theChild : layer.children)
+        wasDirty |= gatherNodeQueueTasks(theChild, 0, tasks);
+
+    const qsizetype taskCount = tasks.size();
+    const qsizetype jobCount = qMin<qsizetype>(taskCount, QSSGRenderJobs::maxThreadCount() * PARALLEL_TRAVERSAL_JOBS_PER_THREAD);
+    std::vector<NodeQueueResult> results(jobCount);
+
+    QSSGRenderJobs::parallelFor(jobCount, [&tasks, &results, taskCount, jobCount](qsizetype job) {
+        NodeQueueResult &out = results[job];
+        const qsizetype begin = (taskCount * job) / jobCount;
+        const qsizetype end = (taskCount * (job + 1)) / jobCount;
+        for (qsizetype i = begin; i != end; ++i) {
+            const NodeQueueTask &task = tasks.at(i);
+            if (task.subtree)
+                collectSubtree(*task.node, out);
+            else
+                collectActiveNode(*task.node, out);
+        }
+    });
+
+    outRenderableModels.clear();
+    outRenderableParticles.clear();
+    outRenderableItem2Ds.clear();
+    outCameras.clear();
+    outLights.clear();
+    outReflectionProbes.clear();
+
+    quint32 dfsIndex = 0;
+    for (const NodeQueueResult &result : results) {
+        for (QSSGRenderNode *node : result.activeNodes)
+            node->dfsIndex = ++dfsIndex;
+        outRenderableModels.append(result.renderableModels);
+        outRenderableParticles.append(result.renderableParticles);
+        outCameras.append(result.cameras);
+        outLights.append(result.lights);
+        outReflectionProbes.append(result.reflectionProbes);
+        wasDirty |= result.wasDirty;
+    }
+
+    // All the global transforms are up-to-date now, the instance roots can be read
+    for (const NodeQueueResult &result : results) {
+        for (QSSGRenderNode *node : result.instanceRootNodes)
+            node->calculateGlobalInstanceTransform();
+    }
+
+    // Item2Ds are expected in reverse DFS order (see collectNodeFront())
+    for (auto rit = results.crbegin(), rend = results.crend(); rit != rend; ++rit)
+        outRenderableItem2Ds.append(QVector<QSSGRenderItem2D *>(rit->renderableItem2Ds.crbegin(), rit->renderableItem2Ds.crend()));
+
+    outRenderableModelsCount = int(outRenderableModels.size());
+    outRenderableParticlesCount = int(outRenderableParticles.size());
+    outRenderableItem2DsCount = int(outRenderableItem2Ds.size());
+    outCameraCount = int(outCameras.size());
+    outLightCount = int(outLights.size());
+    outReflectionProbeCount = int(outReflectionProbes.size());
+    outDFSIndex = dfsIndex;
+
+    return wasDirty;
+}
+
 QSSGDefaultMaterialPreparationResult::QSSGDefaultMaterialPreparationResult(QSSGShaderDefaultMaterialKey inKey)
     : firstImage(nullptr), opacity(1.0f), materialKey(inKey), dirty(false)
 {
@@ -313,12 +676,14 @@ const QVector<QSSGRenderableObjectHandle> &QSSGLayerRenderData::getSortedOpaqueR
         sortedOpaqueObjects = std::as_const(opaqueObjectStore)[index];
 
     const auto &clippingFrustum = getCameraRenderData(&camera).clippingFrustum;
-    if (clippingFrustum.has_value()) { // Frustum culling
-        const auto visibleObjects = QSSGLayerRenderData::frustumCullingInline(clippingFrustum.value(), sortedOpaqueObjects);
+    if (clippingFrustum.has_value() && !sortedOpaqueObjects.isEmpty()) { // Frustum culling
+        const auto &bounds = opaqueBoundsStore[index];
+        const auto visibleObjects = QSSGLayerRenderData::frustumCullingBatch(clippingFrustum.value(), bounds, sortedOpaqueObjects);
         sortedOpaqueObjects.resize(visibleObjects);
     }
 
-    // Render nearest to furthest objects
+    // Render nearest to furthest objects. With the opaque state sort the main pass groups
+    // them by state once it knows the pipelines, see OpaquePass::renderPrep().
     std::sort(sortedOpaqueObjects.begin(), sortedOpaqueObjects.end(), nearestToFurthestCompare);
 
     return sortedOpaqueObjects;
@@ -335,19 +700,29 @@ const QVector<QSSGRenderableObjectHandle> &QSSGLayerRenderData::getSortedTranspa
 
     sortedTransparentObjects = std::as_const(transparentObjectStore)[index];
 
-    if (!layer.layerFlags.testFlag(QSSGRenderLayer::LayerFlag::EnableDepthTest)) {
+    const bool includeOpaque = !layer.layerFlags.testFlag(QSSGRenderLayer::LayerFlag::EnableDepthTest);
+    if (includeOpaque) {
         const auto &opaqueObjects = std::as_const(opaqueObjectStore)[index];
         sortedTransparentObjects.append(opaqueObjects);
     }
 
     const auto &clippingFrustum = getCameraRenderData(&camera).clippingFrustum;
     if (clippingFrustum.has_value()) { // Frustum culling
-        const auto visibleObjects = QSSGLayerRenderData::frustumCullingInline(clippingFrustum.value(), sortedTransparentObjects);
+        const auto &transparentBounds = transparentBoundsStore[index];
+        qsizetype visibleObjects = 0;
+        if (includeOpaque) {
+            const auto &opaqueBounds = opaqueBoundsStore[index];
+            visibleObjects = QSSGLayerRenderData::frustumCullingBatch(clippingFrustum.value(), transparentBounds, opaqueBounds, sortedTransparentObjects);
+        } else {
+            visibleObjects = QSSGLayerRenderData::frustumCullingBatch(clippingFrustum.value(), transparentBounds, sortedTransparentObjects);
+        }
         sortedTransparentObjects.resize(visibleObjects);
     }
 
     // render furthest to nearest.
-    std::sort(sortedTransparentObjects.begin(), sortedTransparentObjects.end(), furthestToNearestCompare);
+    QSSGRenderSort::sortByKey(sortedTransparentObjects, transparentSortScratch, [](const QSSGRenderableObjectHandle &handle) {
+        return ~QSSGRenderSort::floatToSortableKey(handle.cameraDistanceSq);
+    });
 
     return sortedTransparentObjects;
 }
@@ -469,9 +844,14 @@ void QSSGLayerRenderData::updateSortedDepthObjectsListImp(const QSSGRenderCamera
     }
 }
 
-const std::unique_ptr<QSSGPerFrameAllocator> &QSSGLayerRenderData::perFrameAllocator(QSSGRenderContextInterface &ctx)
+QSSGPerFrameAllocator &QSSGLayerRenderData::perFrameAllocator(QSSGRenderContextInterface &ctx)
 {
-    return ctx.perFrameAllocator();
+    if (!QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::ReuseStaticFrames))
+        return *ctx.perFrameAllocator();
+
+    if (!reusableFrameAllocator)
+        reusableFrameAllocator = std::make_unique<QSSGPerFrameAllocator>();
+    return *reusableFrameAllocator;
 }
 
 static constexpr quint16 PREP_CTX_INDEX_MASK = 0xffff;
@@ -495,6 +875,8 @@ QSSGPrepContextId QSSGLayerRenderData::getOrCreateExtensionContext(const QSSGRen
         screenTextureObjectStore.emplace_back();
         opaqueObjectStore.emplace_back();
         transparentObjectStore.emplace_back();
+        opaqueBoundsStore.emplace_back();
+        transparentBoundsStore.emplace_back();
         sortedOpaqueObjectCache.emplace_back();
         sortedTransparentObjectCache.emplace_back();
         sortedScreenTextureObjectCache.emplace_back();
@@ -506,6 +888,8 @@ QSSGPrepContextId QSSGLayerRenderData::getOrCreateExtensionContext(const QSSGRen
         QSSG_ASSERT(screenTextureObjectStore.size() == extContexts.size(), screenTextureObjectStore.resize(extContexts.size()));
         QSSG_ASSERT(opaqueObjectStore.size() == extContexts.size(), opaqueObjectStore.resize(extContexts.size()));
         QSSG_ASSERT(transparentObjectStore.size() == extContexts.size(), transparentObjectStore.resize(extContexts.size()));
+        QSSG_ASSERT(opaqueBoundsStore.size() == extContexts.size(), opaqueBoundsStore.resize(extContexts.size()));
+        QSSG_ASSERT(transparentBoundsStore.size() == extContexts.size(), transparentBoundsStore.resize(extContexts.size()));
         QSSG_ASSERT(sortedOpaqueObjectCache.size() == extContexts.size(), sortedOpaqueObjectCache.resize(extContexts.size()));
         QSSG_ASSERT(sortedTransparentObjectCache.size() == extContexts.size(), sortedTransparentObjectCache.resize(extContexts.size()));
         QSSG_ASSERT(sortedScreenTextureObjectCache.size() == extContexts.size(), sortedScreenTextureObjectCache.resize(extContexts.size()));
@@ -712,6 +1096,12 @@ QSSGPrepResultId QSSGLayerRenderData::prepareModelsForRender(QSSGRenderContextIn
     auto &transparentObjects = transparentObjectStore[index];
     QSSG_ASSERT(transparentObjects.isEmpty(), transparentObjects.clear());
 
+    auto &opaqueBounds = opaqueBoundsStore[index];
+    QSSG_ASSERT(opaqueBounds.isEmpty(), opaqueBounds.clear());
+
+    auto &transparentBounds = transparentBoundsStore[index];
+    QSSG_ASSERT(transparentBounds.isEmpty(), transparentBounds.clear());
+
     auto &screenTextureObjects = screenTextureObjectStore[index];
     QSSG_ASSERT(screenTextureObjects.isEmpty(), screenTextureObjects.clear());
 
@@ -722,7 +1112,9 @@ QSSGPrepResultId QSSGLayerRenderData::prepareModelsForRender(QSSGRenderContextIn
                                            cameraData,
                                            modelContexts,
                                            opaqueObjects,
+                                           opaqueBounds,
                                            transparentObjects,
+                                           transparentBounds,
                                            screenTextureObjects,
                                            lodThreshold);
 
@@ -826,22 +1218,22 @@ const QSSGRenderableObjectList &QSSGLayerRenderData::getSortedrenderedOpaqueDept
 }
 
 /**
- * Usage: T *ptr = RENDER_FRAME_NEW<T>(context, arg0, arg1, ...); is equivalent to: T *ptr = new T(arg0, arg1, ...);
- * so RENDER_FRAME_NEW() takes the RCI + T's arguments
+ * Usage: T *ptr = RENDER_FRAME_NEW<T>(allocator, arg0, arg1, ...); is equivalent to: T *ptr = new T(arg0, arg1, ...);
+ * so RENDER_FRAME_NEW() takes the allocator (see perFrameAllocator()) + T's arguments
  */
 template <typename T, typename... Args>
-[[nodiscard]] inline T *RENDER_FRAME_NEW(QSSGRenderContextInterface &ctx, Args&&... args)
+[[nodiscard]] inline T *RENDER_FRAME_NEW(QSSGPerFrameAllocator &allocator, Args&&... args)
 {
     static_assert(std::is_trivially_destructible_v<T>, "Objects allocated using the per-frame allocator needs to be trivially destructible!");
-    return new (QSSGLayerRenderData::perFrameAllocator(ctx)->allocate(sizeof(T)))T(std::forward<Args>(args)...);
+    return new (allocator.allocate(sizeof(T)))T(std::forward<Args>(args)...);
 }
 
 template <typename T>
-[[nodiscard]] inline QSSGDataRef<T> RENDER_FRAME_NEW_BUFFER(QSSGRenderContextInterface &ctx, size_t count)
+[[nodiscard]] inline QSSGDataRef<T> RENDER_FRAME_NEW_BUFFER(QSSGPerFrameAllocator &allocator, size_t count)
 {
     static_assert(std::is_trivially_destructible_v<T>, "Objects allocated using the per-frame allocator needs to be trivially destructible!");
     const size_t asize = sizeof(T) * count;
-    return { reinterpret_cast<T *>(QSSGLayerRenderData::perFrameAllocator(ctx)->allocate(asize)), qsizetype(count) };
+    return { reinterpret_cast<T *>(allocator.allocate(asize)), qsizetype(count) };
 }
 
 QSSGShaderDefaultMaterialKey QSSGLayerRenderData::generateLightingKey(
@@ -904,7 +1296,15 @@ void QSSGLayerRenderData::prepareImageForRender(QSSGRenderImage &inImage,
     // models (QSSGRenderModel -> QSSGRenderMesh retrieved from the
     // bufferManager in each prepareModelForRender, etc.).
 
-    const QSSGRenderImageTexture texture = bufferManager->loadRenderImage(&inImage);
+    // An asynchronous image that is still loading is replaced by a placeholder that
+    // leaves the material as it would look without the map
+    QSSGBufferManager::LoadRenderImageFlags loadFlags = QSSGBufferManager::LoadWithFlippedY;
+    if (inMapType == QSSGRenderableImage::Type::Normal || inMapType == QSSGRenderableImage::Type::ClearcoatNormal)
+        loadFlags |= QSSGBufferManager::FlatNormalPlaceholder;
+    else if (inMapType == QSSGRenderableImage::Type::Emissive)
+        loadFlags |= QSSGBufferManager::BlackPlaceholder;
+
+    const QSSGRenderImageTexture texture = bufferManager->loadRenderImage(&inImage, QSSGBufferManager::MipModeFollowRenderImage, loadFlags);
 
     if (texture.m_texture) {
         if (texture.m_flags.hasTransparency()
@@ -915,7 +1315,7 @@ void QSSGLayerRenderData::prepareImageForRender(QSSGRenderImage &inImage,
             ioFlags |= QSSGRenderableObjectFlag::HasTransparency;
         }
 
-        QSSGRenderableImage *theImage = RENDER_FRAME_NEW<QSSGRenderableImage>(contextInterface, inMapType, inImage, texture);
+        QSSGRenderableImage *theImage = RENDER_FRAME_NEW<QSSGRenderableImage>(perFrameAllocator(contextInterface), inMapType, inImage, texture);
         QSSGShaderKeyImageMap &theKeyProp = defaultMaterialShaderKeyProperties.m_imageMaps[inImageIndex];
 
         theKeyProp.setEnabled(inShaderKey, true);
@@ -1497,6 +1897,218 @@ void QSSGLayerRenderData::prepareModelMeshes(const QSSGRenderContextInterface &c
     bufferManager->commitBufferResourceUpdates();
 }
 
+// Dynamic batching (QT_QUICK3D_DYNAMIC_BATCHING=1)
+// Models that share the same mesh, materials, lights and render state are drawn
+// with a single instanced draw call. Each group is replaced by a stand-in model
+// with an instance table holding the global transforms of the grouped models.
+static constexpr qsizetype DYNAMIC_BATCH_MIN_COUNT = 2;
+
+// Texture alpha is not known before the maps are loaded, that is left to the prepared
+// renderables of the stand-in (see updateBlendedDynamicBatches()).
+static bool isBlendedMaterial(const QSSGRenderDefaultMaterial &material)
+{
+    // Same conditions as prepareDefaultMaterialForRender() uses to flag the renderable as transparent
+    return material.blendMode != QSSGRenderDefaultMaterial::MaterialBlendMode::SourceOver || material.opacityMap
+            || material.alphaMode == QSSGRenderDefaultMaterial::Blend || material.isTransmissionEnabled()
+            || material.opacity <= 1.0f - QSSG_RENDER_MINIMUM_RENDER_OPACITY;
+}
+
+static bool canBatchModel(const QSSGRenderableNodeEntry &entry)
+{
+    if (entry.overridden != QSSGRenderableNodeEntry::Original || !entry.mesh || entry.materials.isEmpty())
+        return false;
+
+    // Reflection probes are picked per model
+    const QSSGRenderModel &model = *static_cast<const QSSGRenderModel *>(entry.node);
+    if (model.instancing() || model.instanceRoot || model.usesBoneTexture() || !model.morphTargets.isEmpty()
+            || model.particleBuffer || model.hasLightmap() || model.usedInBakedLighting || model.receivesReflections) {
+        return false;
+    }
+
+    // Blended models are sorted back to front one by one, which a single instanced draw can't do
+    if (model.hasTransparency || model.globalOpacity <= 1.0f - QSSG_RENDER_MINIMUM_RENDER_OPACITY)
+        return false;
+
+    // Custom materials can depend on the model matrix, which is not the model's own
+    // transform when drawn as an instance.
+    for (const auto *material : entry.materials) {
+        if (!material || !QSSGRenderGraphObject::isMaterial(material->type)
+                || material->type == QSSGRenderGraphObject::Type::CustomMaterial) {
+            return false;
+        }
+        if (isBlendedMaterial(static_cast<const QSSGRenderDefaultMaterial &>(*material)))
+            return false;
+    }
+
+    // The level of detail and morphing are selected per model
+    for (const auto &subset : std::as_const(entry.mesh->subsets)) {
+        if (!subset.lods.isEmpty() || subset.rhi.targetsTexture)
+            return false;
+    }
+
+    return true;
+}
+
+void QSSGLayerRenderData::batchIdenticalModels(RenderableNodeEntries &renderableModels)
+{
+    if (!renderer->contextInterface()->rhiContext()->rhi()->isFeatureSupported(QRhi::Instancing))
+        return;
+
+    for (auto &batch : dynamicBatches) {
+        batch.members.clear();
+        batch.used = false;
+    }
+    dynamicBatchOrder.clear();
+    dynamicBatchBounds.clear();
+
+    // Group the models, the groups keep the order the models were found in
+    DynamicBatchKey &key = dynamicBatchScratchKey;
+    for (qsizetype idx = 0, end = renderableModels.size(); idx != end; ++idx) {
+        const QSSGRenderableNodeEntry &entry = renderableModels.at(idx);
+        if (!canBatchModel(entry))
+            continue;
+
+        const QSSGRenderModel &model = *static_cast<const QSSGRenderModel *>(entry.node);
+        key.mesh = entry.mesh;
+        key.materials = entry.materials;
+        key.lights.clear();
+        for (const QSSGShaderLight &light : entry.lights)
+            key.lights.push_back(light.light);
+        key.opacity = model.globalOpacity;
+        key.depthBiasSq = model.m_depthBiasSq;
+        key.flags = quint8(quint8(model.castsShadows) | quint8(model.receivesShadows) << 1 | quint8(model.castsReflections) << 2
+                           | quint8(model.hasTransparency) << 3);
+
+        DynamicBatch &batch = dynamicBatches[key];
+        if (!batch.used) {
+            batch.used = true;
+            dynamicBatchOrder.push_back(key);
+        }
+        batch.members.push_back(idx);
+    }
+
+    QBitArray batched(renderableModels.size());
+    bool hasBatches = false;
+    for (const auto &batchKey : std::as_const(dynamicBatchOrder)) {
+        DynamicBatch &batch = dynamicBatches[batchKey];
+        const QList<qsizetype> &group = batch.members;
+        if (group.size() < DYNAMIC_BATCH_MIN_COUNT || batch.blended)
+            continue;
+
+        if (!batch.model) {
+            batch.model = new QSSGRenderModel;
+            batch.instanceTable = new QSSGRenderInstanceTable;
+            batch.model->instanceTable = batch.instanceTable;
+        }
+
+        // The instances carry the global transforms. The instance transforms of the stand-in stay
+        // identity, its global transform is only used to place it at the center of the group for sorting.
+        // The stand-in's renderables are culled with the union of the bounds of the models instead.
+        QByteArray instanceData(group.size() * sizeof(QSSGRenderInstanceTableEntry), Qt::Uninitialized);
+        auto *instances = reinterpret_cast<QSSGRenderInstanceTableEntry *>(instanceData.data());
+        const auto &subsets = renderableModels.at(group.first()).mesh->subsets;
+        QVector<QSSGBounds3> subsetBounds(subsets.size());
+        QVector3D center;
+        for (const qsizetype idx : group) {
+            const QSSGRenderNode &node = *renderableModels.at(idx).node;
+            const QMatrix4x4 &globalTransform = node.globalTransform;
+            *instances++ = { globalTransform.row(0), globalTransform.row(1), globalTransform.row(2), QVector4D(1.0f, 1.0f, 1.0f, 1.0f), QVector4D() };
+            for (qsizetype subsetIdx = 0, subsetCount = subsets.size(); subsetIdx != subsetCount; ++subsetIdx) {
+                QSSGBounds3 bounds = subsets.at(subsetIdx).bounds;
+                bounds.transform(globalTransform);
+                subsetBounds[subsetIdx].include(bounds);
+            }
+            center += node.getGlobalPos();
+            batched.setBit(idx);
+        }
+        center /= float(group.size());
+        // Only bump the serial, and so re-upload the buffer, when something moved
+        QSSGRenderInstanceTable &table = *batch.instanceTable;
+        if (table.count() != group.size() || table.dataSize() != instanceData.size()
+                || std::memcmp(table.constData(), instanceData.constData(), instanceData.size()) != 0) {
+            table.setData(instanceData, int(group.size()), int(sizeof(QSSGRenderInstanceTableEntry)));
+        }
+
+        const QSSGRenderableNodeEntry &first = renderableModels.at(group.first());
+        const QSSGRenderModel &firstModel = *static_cast<const QSSGRenderModel *>(first.node);
+        QSSGRenderModel &model = *batch.model;
+        model.globalTransform.setToIdentity();
+        model.globalTransform.translate(center);
+        model.materials = first.materials;
+        model.geometry = firstModel.geometry;
+        model.meshPath = firstModel.meshPath;
+        model.globalOpacity = firstModel.globalOpacity;
+        model.m_depthBiasSq = firstModel.m_depthBiasSq;
+        model.castsShadows = firstModel.castsShadows;
+        model.receivesShadows = firstModel.receivesShadows;
+        model.castsReflections = firstModel.castsReflections;
+        model.hasTransparency = firstModel.hasTransparency;
+        dynamicBatchBounds.insert(&model, subsetBounds);
+
+        // The group's first entry is replaced with the stand-in
+        QSSGRenderableNodeEntry entry(model);
+        entry.mesh = first.mesh;
+        entry.materials = first.materials;
+        entry.lights = first.lights;
+        renderableModels[group.first()] = entry;
+        batched.clearBit(group.first());
+        hasBatches = true;
+    }
+
+    if (hasBatches) {
+        qsizetype end = 0;
+        for (qsizetype idx = 0, count = renderableModels.size(); idx != count; ++idx) {
+            if (!batched.testBit(idx))
+                renderableModels[end++] = renderableModels.at(idx);
+        }
+        renderableModels.resize(end);
+    }
+
+    releaseDynamicBatches(true);
+}
+
+void QSSGLayerRenderData::releaseDynamicBatches(bool unusedOnly)
+{
+    QList<QSSGRenderGraphObject *> resources;
+    for (auto it = dynamicBatches.begin(); it != dynamicBatches.end();) {
+        if (unusedOnly && it->used) {
+            ++it;
+            continue;
+        }
+        if (it->model) {
+            dynamicBatchBounds.remove(it->model);
+            resources.push_back(it->model);
+            resources.push_back(it->instanceTable);
+        }
+        it = dynamicBatches.erase(it);
+    }
+    if (!unusedOnly)
+        dynamicBatchOrder.clear();
+
+    if (!resources.isEmpty())
+        renderer->cleanupResources(resources);
+}
+
+void QSSGLayerRenderData::updateBlendedDynamicBatches()
+{
+    if (dynamicBatchBounds.isEmpty())
+        return;
+
+    for (const QSSGModelContext *modelContext : std::as_const(modelContexts)) {
+        if (!dynamicBatchBounds.contains(&modelContext->model))
+            continue;
+        const bool blended = std::any_of(modelContext->subsets.begin(), modelContext->subsets.end(), [](const QSSGSubsetRenderable &renderable) {
+            return renderable.renderableFlags.hasTransparency();
+        });
+        if (!blended)
+            continue;
+        for (auto &batch : dynamicBatches) {
+            if (batch.model == &modelContext->model)
+                batch.blended = true;
+        }
+    }
+}
+
 void QSSGLayerRenderData::setLightmapTexture(const QSSGModelContext &modelContext, QRhiTexture *lightmapTexture)
 {
     lightmapTextures[&modelContext] = lightmapTexture;
@@ -1540,7 +2152,9 @@ bool QSSGLayerRenderData::prepareModelsForRender(QSSGRenderContextInterface &con
                                                  const QSSGRenderCameraDataList &allCameraData,
                                                  TModelContextPtrList &modelContexts,
                                                  QSSGRenderableObjectList &opaqueObjects,
+                                                 QSSGBoundsSoA &opaqueBounds,
                                                  QSSGRenderableObjectList &transparentObjects,
+                                                 QSSGBoundsSoA &transparentBounds,
                                                  QSSGRenderableObjectList &screenTextureObjects,
                                                  float lodThreshold)
 {
@@ -1564,13 +2178,13 @@ bool QSSGLayerRenderData::prepareModelsForRender(QSSGRenderContextInterface &con
 
         const bool altGlobalTransform = ((renderable.overridden & QSSGRenderableNodeEntry::Overridden::GlobalTransform) != 0);
         const auto &globalTransform = altGlobalTransform ? renderable.globalTransform : model.globalTransform;
-        QSSGModelContext &theModelContext = *RENDER_FRAME_NEW<QSSGModelContext>(contextInterface, model, globalTransform, allCameraData);
+        QSSGModelContext &theModelContext = *RENDER_FRAME_NEW<QSSGModelContext>(perFrameAllocator(contextInterface), model, globalTransform, allCameraData);
         modelContexts.push_back(&theModelContext);
         // We might over-allocate here, as the material list technically can contain an invalid (nullptr) material.
         // We'll fix that by adjusting the size at the end for now...
         const auto &meshSubsets = theMesh->subsets;
         const auto meshSubsetCount = meshSubsets.size();
-        theModelContext.subsets = RENDER_FRAME_NEW_BUFFER<QSSGSubsetRenderable>(contextInterface, meshSubsetCount);
+        theModelContext.subsets = RENDER_FRAME_NEW_BUFFER<QSSGSubsetRenderable>(perFrameAllocator(contextInterface), meshSubsetCount);
 
         // Prepare boneTexture for skinning
         if (model.skin) {
@@ -1644,6 +2258,10 @@ bool QSSGLayerRenderData::prepareModelsForRender(QSSGRenderContextInterface &con
         bool usesBlendParticles = particlesEnabled && theModelContext.model.particleBuffer != nullptr
                 && model.particleBuffer->particleCount();
 
+        // The world bounds of a dynamic batch's stand-in cover all the models it draws
+        const auto batchBoundsIt = dynamicBatchBounds.constFind(&model);
+        const QVector<QSSGBounds3> *batchBounds = (batchBoundsIt != dynamicBatchBounds.cend()) ? &batchBoundsIt.value() : nullptr;
+
         // Subset(s)
         auto &renderableSubsets = theModelContext.subsets;
         const auto &materials = renderable.materials;
@@ -1726,6 +2344,9 @@ bool QSSGLayerRenderData::prepareModelsForRender(QSSGRenderContextInterface &con
                 if (maybeDebugDraw && debugDrawSystem->isEnabled(QSSGDebugDrawSystem::Mode::MeshLod))
                     debugDrawSystem->drawBounds(transformedBounds, QSSGDebugDrawSystem::levelOfDetailColor(subsetLevelOfDetail));
             }
+            // Draws a coarser level until the requested one is streamed in
+            if (theMesh->lodStreaming && !theSubset.lods.isEmpty())
+                subsetLevelOfDetail = bufferManager->streamLevelOfDetail(*theMesh, subsetLevelOfDetail);
 
             QVector3D theModelCenter(theSubset.bounds.center());
             theModelCenter = QSSGUtils::mat44::transform(model.globalTransform, theModelCenter);
@@ -1866,8 +2487,11 @@ bool QSSGLayerRenderData::prepareModelsForRender(QSSGRenderContextInterface &con
                                                                theGeneratedKey,
                                                                lights);
             }
-            if (theRenderableObject) // NOTE: Should just go in with the ctor args
+            if (theRenderableObject) { // NOTE: Should just go in with the ctor args
                 theRenderableObject->camdistSq = getCameraDistanceSq(*theRenderableObject, allCameraData[0]);
+                if (batchBounds && idx < batchBounds->size())
+                    theRenderableObject->globalBounds = batchBounds->at(idx);
+            }
         }
 
         // If the indices don't match then something's off and we need to adjust the subset renderable list size.
@@ -1888,9 +2512,11 @@ bool QSSGLayerRenderData::prepareModelsForRender(QSSGRenderContextInterface &con
             } else if (ro.renderableFlags.hasTransparency()) {
                 depthPrepassObjectsState |= DepthPrepassObjectStateT(ppState[ObjectType::Transparent][size_t(depthMode == QSSGDepthDrawMode::OpaquePrePass)]);
                 transparentObjects.push_back({&ro, ro.camdistSq});
+                transparentBounds.push_back(ro.globalBounds);
             } else {
                 depthPrepassObjectsState |= DepthPrepassObjectStateT(ppState[ObjectType::Opaque][size_t(depthMode == QSSGDepthDrawMode::OpaquePrePass)]);
                 opaqueObjects.push_back({&ro, ro.camdistSq});
+                opaqueBounds.push_back(ro.globalBounds);
             }
 
             if (ro.renderableFlags.usedInBakedLighting())
@@ -1916,6 +2542,8 @@ bool QSSGLayerRenderData::prepareParticlesForRender(const RenderableNodeEntries
     auto &opaqueObjects = opaqueObjectStore[0];
     auto &transparentObjects = transparentObjectStore[0];
     auto &screenTextureObjects = screenTextureObjectStore[0];
+    auto &opaqueBounds = opaqueBoundsStore[0];
+    auto &transparentBounds = transparentBoundsStore[0];
 
     for (const auto &renderable : renderableParticles) {
         const QSSGRenderParticles &particles = *static_cast<QSSGRenderParticles *>(renderable.node);
@@ -1943,7 +2571,7 @@ bool QSSGLayerRenderData::prepareParticlesForRender(const RenderableNodeEntries
                 dirty = true;
 
             const QSSGRenderImageTexture texture = bufferManager->loadRenderImage(particles.m_sprite);
-            QSSGRenderableImage *theImage = RENDER_FRAME_NEW<QSSGRenderableImage>(contextInterface, QSSGRenderableImage::Type::Diffuse, *particles.m_sprite, texture);
+            QSSGRenderableImage *theImage = RENDER_FRAME_NEW<QSSGRenderableImage>(perFrameAllocator(contextInterface), QSSGRenderableImage::Type::Diffuse, *particles.m_sprite, texture);
             firstImage = theImage;
         }
 
@@ -1956,12 +2584,12 @@ bool QSSGLayerRenderData::prepareParticlesForRender(const RenderableNodeEntries
 
             const QSSGRenderImageTexture texture = bufferManager->loadRenderImage(particles.m_colorTable);
 
-            QSSGRenderableImage *theImage = RENDER_FRAME_NEW<QSSGRenderableImage>(contextInterface, QSSGRenderableImage::Type::Diffuse, *particles.m_colorTable, texture);
+            QSSGRenderableImage *theImage = RENDER_FRAME_NEW<QSSGRenderableImage>(perFrameAllocator(contextInterface), QSSGRenderableImage::Type::Diffuse, *particles.m_colorTable, texture);
             colorTable = theImage;
         }
 
         if (opacity > 0.0f && particles.m_particleBuffer.particleCount()) {
-            auto *theRenderableObject = RENDER_FRAME_NEW<QSSGParticlesRenderable>(contextInterface,
+            auto *theRenderableObject = RENDER_FRAME_NEW<QSSGParticlesRenderable>(perFrameAllocator(contextInterface),
                                                                                   renderableFlags,
                                                                                   center,
                                                                                   renderer,
@@ -1971,12 +2599,15 @@ bool QSSGLayerRenderData::prepareParticlesForRender(const RenderableNodeEntries
                                                                                   lights,
                                                                                   opacity);
             if (theRenderableObject) {
-                if (theRenderableObject->renderableFlags.requiresScreenTexture())
+                if (theRenderableObject->renderableFlags.requiresScreenTexture()) {
                     screenTextureObjects.push_back({theRenderableObject, getCameraDistanceSq(*theRenderableObject, cameraData)});
-                else if (theRenderableObject->renderableFlags.hasTransparency())
+                } else if (theRenderableObject->renderableFlags.hasTransparency()) {
                     transparentObjects.push_back({theRenderableObject, getCameraDistanceSq(*theRenderableObject, cameraData)});
-                else
+                    transparentBounds.push_back(theRenderableObject->globalBounds);
+                } else {
                     opaqueObjects.push_back({theRenderableObject, getCameraDistanceSq(*theRenderableObject, cameraData)});
+                    opaqueBounds.push_back(theRenderableObject->globalBounds);
+                }
             }
         }
     }
@@ -2268,21 +2899,63 @@ void QSSGLayerRenderData::prepareForRender()
     int lightNodeCount = 0;
     int reflectionProbeCount = 0;
     quint32 dfsIndex = 0;
-    for (auto &theChild : layer.children)
-        wasDataDirty |= maybeQueueNodeForRender(theChild,
-                                                renderableModels,
-                                                renderableModelsCount,
-                                                renderableParticles,
-                                                renderableParticlesCount,
-                                                renderableItem2Ds,
-                                                renderableItem2DsCount,
-                                                cameras,
-                                                cameraNodeCount,
-                                                lights,
-                                                lightNodeCount,
-                                                reflectionProbes,
-                                                reflectionProbeCount,
-                                                dfsIndex);
+    if (QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::ParallelTraversal)) {
+        wasDataDirty |= maybeQueueNodesForRenderParallel(layer,
+                                                         renderableModels,
+                                                         renderableModelsCount,
+                                                         renderableParticles,
+                                                         renderableParticlesCount,
+                                                         renderableItem2Ds,
+                                                         renderableItem2DsCount,
+                                                         cameras,
+                                                         cameraNodeCount,
+                                                         lights,
+                                                         lightNodeCount,
+                                                         reflectionProbes,
+                                                         reflectionProbeCount,
+                                                         dfsIndex);
+    } else if (QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::FlatNodeHierarchy)) {
+        const quint32 generation = QSSGRenderNode::hierarchyGeneration();
+        if (!flatNodeHierarchy.valid || flatNodeHierarchy.generation != generation) {
+            flatNodeHierarchy.nodes.clear();
+            flatNodeHierarchy.subtreeEnds.clear();
+            for (auto &theChild : layer.children)
+                flattenNodeHierarchy(theChild, flatNodeHierarchy.nodes, flatNodeHierarchy.subtreeEnds);
+            flatNodeHierarchy.generation = generation;
+            flatNodeHierarchy.valid = true;
+        }
+        wasDataDirty |= maybeQueueNodesForRenderFlat(flatNodeHierarchy.nodes,
+                                                     flatNodeHierarchy.subtreeEnds,
+                                                     renderableModels,
+                                                     renderableModelsCount,
+                                                     renderableParticles,
+                                                     renderableParticlesCount,
+                                                     renderableItem2Ds,
+                                                     renderableItem2DsCount,
+                                                     cameras,
+                                                     cameraNodeCount,
+                                                     lights,
+                                                     lightNodeCount,
+                                                     reflectionProbes,
+                                                     reflectionProbeCount,
+                                                     dfsIndex);
+    } else {
+        for (auto &theChild : layer.children)
+            wasDataDirty |= maybeQueueNodeForRender(theChild,
+                                                    renderableModels,
+                                                    renderableModelsCount,
+                                                    renderableParticles,
+                                                    renderableParticlesCount,
+                                                    renderableItem2Ds,
+                                                    renderableItem2DsCount,
+                                                    cameras,
+                                                    cameraNodeCount,
+                                                    lights,
+                                                    lightNodeCount,
+                                                    reflectionProbes,
+                                                    reflectionProbeCount,
+                                                    dfsIndex);
+    }
 
     if (renderableModels.size() != renderableModelsCount)
         renderableModels.resize(renderableModelsCount);
@@ -2423,7 +3096,7 @@ void QSSGLayerRenderData::prepareForRender()
                     // This node has scoped lights, i.e., it's lights differ from the global list
                     // we therefore create a bespoke light list for it. Technically this might be the same for
                     // more then this one node, but the overhead for tracking that is not worth it.
-                    auto customLightList = RENDER_FRAME_NEW_BUFFER<QSSGShaderLight>(*renderer->contextInterface(), filteredLights.size());
+                    auto customLightList = RENDER_FRAME_NEW_BUFFER<QSSGShaderLight>(perFrameAllocator(*renderer->contextInterface()), filteredLights.size());
                     std::copy(filteredLights.cbegin(), filteredLights.cend(), customLightList.begin());
                     theNodeEntry.lights = customLightList;
                 }
@@ -2469,13 +3142,19 @@ void QSSGLayerRenderData::prepareForRender()
     prepareModelMaterials(renderableModels, !hasUserExtensions);
     // Ensure meshes for models
     prepareModelMeshes(*renderer->contextInterface(), renderableModels, QSSGRendererPrivate::isGlobalPickingEnabled(*renderer));
+    // User extensions can look up and modify the renderables of specific models, so leave them untouched
+    if (QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::DynamicBatching) && !hasUserExtensions)
+        batchIdenticalModels(renderableModels);
+    else if (!dynamicBatches.isEmpty())
+        releaseDynamicBatches(false);
 
     auto &opaqueObjects = opaqueObjectStore[0];
     auto &transparentObjects = transparentObjectStore[0];
     auto &screenTextureObjects = screenTextureObjectStore[0];
 
     if (!renderedCameras.isEmpty()) { // NOTE: We shouldn't really get this far without a camera...
-        wasDirty |= prepareModelsForRender(*renderer->contextInterface(), renderableModels, layerPrepResult.flags, renderedCameras, getCachedCameraDatas(), modelContexts, opaqueObjects, transparentObjects, screenTextureObjects, meshLodThreshold);
+        wasDirty |= prepareModelsForRender(*renderer->contextInterface(), renderableModels, layerPrepResult.flags, renderedCameras, getCachedCameraDatas(), modelContexts, opaqueObjects, opaqueBoundsStore[0], transparentObjects, transparentBoundsStore[0], screenTextureObjects, meshLodThreshold);
+        updateBlendedDynamicBatches();
         if (particlesEnabled) {
             const auto &cameraDatas = getCachedCameraDatas();
             wasDirty |= prepareParticlesForRender(renderableParticles, cameraDatas[0]);
@@ -2605,6 +3284,8 @@ void QSSGLayerRenderData::prepareForRender()
 
     if (const auto &dbgDrawSystem = renderer->contextInterface()->debugDrawSystem(); dbgDrawSystem && dbgDrawSystem->isEnabled())
         activePasses.push_back(&debugDrawPass);
+
+    preparedFrame = { layer.sceneRevision, renderer->viewport(), renderer->scissorRect(), renderer->dpr(), !renderedCameras.isEmpty() };
 }
 
 template<typename T>
@@ -2619,6 +3300,9 @@ void QSSGLayerRenderData::resetForFrame()
     for (const auto &pass : activePasses)
         pass->resetForFrame();
     activePasses.clear();
+    preparedFrame.valid = false;
+    if (reusableFrameAllocator)
+        reusableFrameAllocator->reset();
     bakedLightingModels.clear();
     layerPrepResult = {};
     renderedCameras.clear();
@@ -2641,6 +3325,8 @@ void QSSGLayerRenderData::resetForFrame()
     clearTable(opaqueObjectStore);
     clearTable(transparentObjectStore);
     clearTable(screenTextureObjectStore);
+    clearTable(opaqueBoundsStore);
+    clearTable(transparentBoundsStore);
     clearTable(sortedOpaqueObjectCache);
     clearTable(sortedTransparentObjectCache);
     clearTable(sortedScreenTextureObjectCache);
@@ -2648,6 +3334,57 @@ void QSSGLayerRenderData::resetForFrame()
     clearTable(sortedDepthWriteCache);
 }
 
+bool QSSGLayerRenderData::canReusePreviousFrame() const
+{
+    if (!QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::ReuseStaticFrames) || !preparedFrame.valid)
+        return false;
+
+    // A revision of 0 means the owner of the layer does not track changes
+    if (layer.sceneRevision == 0 || layer.sceneRevision != preparedFrame.sceneRevision)
+        return false;
+
+    if (renderer->viewport() != preparedFrame.viewport
+            || renderer->scissorRect() != preparedFrame.scissorRect
+            || renderer->dpr() != preparedFrame.dpr) {
+        return false;
+    }
+
+    // Content that changes from frame to frame without the scene changing:
+    // 2D items, render extensions, the jittered camera of temporal and
+    // progressive AA and the debug drawing.
+    if (!renderableItem2Ds.isEmpty() || layer.temporalAAEnabled
+            || layer.antialiasingMode == QSSGRenderLayer::AAMode::ProgressiveAA) {
+        return false;
+    }
+    for (const auto &renderExtensions : layer.renderExtensions) {
+        if (!renderExtensions.isEmpty())
+            return false;
+    }
+    const auto &contextInterface = *renderer->contextInterface();
+    if (const auto &dbgDrawSystem = contextInterface.debugDrawSystem(); dbgDrawSystem && (dbgDrawSystem->isEnabled() || dbgDrawSystem->hasContent()))
+        return false;
+
+    // Meshes and images that are still being loaded end up in the renderables later
+    const auto &bufferManager = contextInterface.bufferManager();
+    if (bufferManager->hasPendingMeshLoads() || bufferManager->hasPendingImageLoads() || bufferManager->hasPendingMeshLodRequests())
+        return false;
+
+    // Streamed levels of detail are only kept resident for the layers that ask for
+    // them while being prepared
+    if (QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::MeshLodStreaming))
+        return false;
+
+    return true;
+}
+
+void QSSGLayerRenderData::resetForReusedFrame()
+{
+    // The passes only hold on to what they collected in renderPrep(), which
+    // is called again for every frame.
+    for (const auto &pass : activePasses)
+        pass->resetForFrame();
+}
+
 QSSGLayerRenderPreparationResult::QSSGLayerRenderPreparationResult(const QRectF &inViewport, QSSGRenderLayer &inLayer)
     : layer(&inLayer)
 {
@@ -2693,6 +3430,7 @@ QSSGLayerRenderData::QSSGLayerRenderData(QSSGRenderLayer &inLayer, QSSGRenderer
 QSSGLayerRenderData::~QSSGLayerRenderData()
 {
     delete m_lightmapper;
+    releaseDynamicBatches(false);
     for (auto &pass : activePasses)
         pass->resetForFrame();
 
@@ -2700,52 +3438,128 @@ QSSGLayerRenderData::~QSSGLayerRenderData()
         renderResult.reset();
 }
 
-static void sortInstances(QByteArray &sortedData, QList<QSSGRhiSortData> &sortData, const void *instances,
+static void sortInstances(QByteArray &sortedData, QList<QSSGRhiSortData> &sortData, QList<QSSGRhiSortData> &sortScratch, const void *instances,
                           int stride, int count, const QVector3D &cameraDirection)
 {
-    sortData.resize(count);
     Q_ASSERT(stride == sizeof(QSSGRenderInstanceTableEntry));
+    const QSSGRenderInstanceTableEntry *instance = reinterpret_cast<const QSSGRenderInstanceTableEntry *>(instances);
+    const auto depth = [instance, &cameraDirection](int i) {
+        const QVector3D pos = QVector3D(instance[i].row0.w(), instance[i].row1.w(), instance[i].row2.w());
+        return QVector3D::dotProduct(pos, cameraDirection);
+    };
+
     // create sort data
-    {
-        const QSSGRenderInstanceTableEntry *instance = reinterpret_cast<const QSSGRenderInstanceTableEntry *>(instances);
-        for (int i = 0; i < count; i++) {
-            const QVector3D pos = QVector3D(instance->row0.w(), instance->row1.w(), instance->row2.w());
-            sortData[i] = {QVector3D::dotProduct(pos, cameraDirection), i};
-            instance++;
-        }
+    bool sorted = false;
+    if (sortData.size() == count) {
+        // Start from last frame's order, which is usually close to the new one when the camera
+        // or the instances only moved a little, and fix it up. Fall back to a full sort if too
+        // much has changed.
+        for (auto &s : sortData)
+            s.d = depth(s.indexOrOffset);
+        sorted = QSSGRenderSort::insertionSortNearlySorted(sortData.data(), sortData.size(), [](const QSSGRhiSortData &a, const QSSGRhiSortData &b) {
+            return a.d > b.d;
+        }, sortData.size());
+    } else {
+        sortData.resize(count);
+        for (int i = 0; i < count; i++)
+            sortData[i] = { depth(i), i };
     }
 
     // sort
-    std::sort(sortData.begin(), sortData.end(), [](const QSSGRhiSortData &a, const QSSGRhiSortData &b){
-        return a.d > b.d;
-    });
+    if (!sorted) {
+        QSSGRenderSort::sortByKey(sortData, sortScratch, [](const QSSGRhiSortData &s) {
+            return ~QSSGRenderSort::floatToSortableKey(s.d);
+        });
+    }
 
     // copy instances
     {
-        const QSSGRenderInstanceTableEntry *instance = reinterpret_cast<const QSSGRenderInstanceTableEntry *>(instances);
         QSSGRenderInstanceTableEntry *dest = reinterpret_cast<QSSGRenderInstanceTableEntry *>(sortedData.data());
         for (auto &s : sortData)
             *dest++ = instance[s.indexOrOffset];
     }
 }
 
-static void cullLodInstances(QByteArray &lodData, const void *instances, int count,
-                             const QVector3D &cameraPosition, float minThreshold, float maxThreshold)
+// Copies the instances that pass the LOD distance test and, when a frustum is given, the frustum test,
+// to the front of outData and returns the number of instances written. The instance buffer can then be
+// drawn with the returned count instead of submitting degenerate (zeroed) instances.
+static int cullInstances(QByteArray &outData, const void *instances, int count,
+                         const QVector3D &cameraPosition, float minThreshold, float maxThreshold,
+                         const QSSGClippingFrustum *clipFrustum, const QSSGBounds3 &localBounds,
+                         const QMatrix4x4 &globalInstanceTransform, const QMatrix4x4 &localInstanceTransform)
 {
+    const bool usesLod = minThreshold >= 0 || maxThreshold >= 0;
+    outData.resize(count * sizeof(QSSGRenderInstanceTableEntry));
     const QSSGRenderInstanceTableEntry *instance = reinterpret_cast<const QSSGRenderInstanceTableEntry *>(instances);
-    QSSGRenderInstanceTableEntry *dest = reinterpret_cast<QSSGRenderInstanceTableEntry *>(lodData.data());
-    for (int i = 0; i < count; ++i) {
-        const float x = cameraPosition.x() - instance->row0.w();
-        const float y = cameraPosition.y() - instance->row1.w();
-        const float z = cameraPosition.z() - instance->row2.w();
-        const float distanceSq = x * x + y * y + z * z;
-        if (distanceSq >= minThreshold * minThreshold && (maxThreshold < 0 || distanceSq < maxThreshold * maxThreshold))
-            *dest = *instance;
-        else
-            *dest= {};
-        dest++;
-        instance++;
+    QSSGRenderInstanceTableEntry *dest = reinterpret_cast<QSSGRenderInstanceTableEntry *>(outData.data());
+    int visibleCount = 0;
+    for (int i = 0; i < count; ++i, ++instance) {
+        if (usesLod) {
+            const float x = cameraPosition.x() - instance->row0.w();
+            const float y = cameraPosition.y() - instance->row1.w();
+            const float z = cameraPosition.z() - instance->row2.w();
+            const float distanceSq = x * x + y * y + z * z;
+            if (!(distanceSq >= minThreshold * minThreshold && (maxThreshold < 0 || distanceSq < maxThreshold * maxThreshold)))
+                continue;
+        }
+        if (clipFrustum) {
+            const QMatrix4x4 instanceTransform(instance->row0.x(), instance->row0.y(), instance->row0.z(), instance->row0.w(),
+                                               instance->row1.x(), instance->row1.y(), instance->row1.z(), instance->row1.w(),
+                                               instance->row2.x(), instance->row2.y(), instance->row2.z(), instance->row2.w(),
+                                               0.0f, 0.0f, 0.0f, 1.0f);
+            QSSGBounds3 globalBounds = localBounds;
+            globalBounds.transform(globalInstanceTransform * instanceTransform * localInstanceTransform);
+            if (!clipFrustum->intersectsWith(globalBounds))
+                continue;
+        }
+        dest[visibleCount++] = *instance;
     }
+
+    return visibleCount;
+}
+
+quint32 QSSGLayerRenderData::uploadInstanceData(QSSGRhiContext *rhiCtx,
+                                                QRhiBuffer *buffer,
+                                                const void *data,
+                                                quint32 size,
+                                                quint32 stride,
+                                                const QSSGRenderInstanceTable::DirtyRanges &dirtyRanges)
+{
+    if (size == 0)
+        return 0;
+
+    quint32 uploadedBytes = 0;
+    QRhiResourceUpdateBatch *rub = rhiCtx->rhi()->nextResourceUpdateBatch();
+    if (dirtyRanges.isEmpty()) {
+        rub->updateDynamicBuffer(buffer, 0, size, data);
+        uploadedBytes = size;
+    } else {
+        const char *bytes = static_cast<const char *>(data);
+        for (const auto &range : dirtyRanges) {
+            const quint32 offset = quint32(range.offset) * stride;
+            QSSG_ASSERT(offset < size, continue);
+            const quint32 rangeSize = qMin(quint32(range.count) * stride, size - offset);
+            rub->updateDynamicBuffer(buffer, offset, rangeSize, bytes + offset);
+            uploadedBytes += rangeSize;
+        }
+    }
+    rhiCtx->commandBuffer()->resourceUpdate(rub);
+
+    return uploadedBytes;
+}
+
+const QSSGRenderCameraData *QSSGLayerRenderData::instanceCullingCamera(const QSSGSubsetRenderable &renderable) const
+{
+    const QSSGRenderCameraDataList &cameraDatas = *renderedCameraData;
+    if (cameraDatas.size() != 1)
+        return nullptr;
+    // The culled buffer is used by every pass drawing the renderable this frame, and instances
+    // outside the view can still cast visible shadows or show up in a reflection probe.
+    if (renderable.renderableFlags.castsShadows() && layerPrepResult.flags.requiresShadowMapPass())
+        return nullptr;
+    if (renderable.renderableFlags.castsReflections() && !reflectionProbes.isEmpty())
+        return nullptr;
+    return &cameraDatas[0];
 }
 
 bool QSSGLayerRenderData::prepareInstancing(QSSGRhiContext *rhiCtx,
@@ -2753,16 +3567,23 @@ bool QSSGLayerRenderData::prepareInstancing(QSSGRhiContext *rhiCtx,
                                             const QVector3D &cameraDirection,
                                             const QVector3D &cameraPosition,
                                             float minThreshold,
-                                            float maxThreshold)
+                                            float maxThreshold,
+                                            const QSSGRenderCameraData *cullingCamera)
 {
     QSSGRhiContextPrivate *rhiCtxD = QSSGRhiContextPrivate::get(rhiCtx);
     auto &modelContext = renderable->modelContext;
     auto &instanceBuffer = renderable->instanceBuffer; // intentional ref2ptr
     if (!modelContext.model.instancing() || instanceBuffer)
         return instanceBuffer;
-    auto *table = modelContext.model.instanceTable;
+    const auto &model = modelContext.model;
+    auto *table = model.instanceTable;
     bool usesLod = minThreshold >= 0 || maxThreshold >= 0;
-    QSSGRhiInstanceBufferData &instanceData(usesLod ? rhiCtxD->instanceBufferData(&modelContext.model) : rhiCtxD->instanceBufferData(table));
+    // Instances are culled against the camera the buffer is prepared for, see instanceCullingCamera()
+    const bool usesFrustumCulling = cullingCamera && cullingCamera->clippingFrustum.has_value()
+            && table->stride() == sizeof(QSSGRenderInstanceTableEntry)
+            && QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::InstanceFrustumCulling);
+    const bool usesCulling = usesLod || usesFrustumCulling;
+    QSSGRhiInstanceBufferData &instanceData(usesCulling ? rhiCtxD->instanceBufferData(&model) : rhiCtxD->instanceBufferData(table));
     quint32 instanceBufferSize = table->dataSize();
     // Create or resize the instance buffer ### if (instanceData.owned)
     bool sortingChanged = table->isDepthSortingEnabled() != instanceData.sorting;
@@ -2770,13 +3591,23 @@ bool QSSGLayerRenderData::prepareInstancing(QSSGRhiContext *rhiCtx,
     bool cameraPositionChanged = !qFuzzyCompare(instanceData.cameraPosition, cameraPosition);
     bool updateInstanceBuffer = table->serial() != instanceData.serial || sortingChanged || (cameraDirectionChanged && table->isDepthSortingEnabled());
     bool updateForLod = cameraPositionChanged && usesLod;
+    bool updateForFrustum = usesFrustumCulling != instanceData.frustumCulling;
+    if (usesFrustumCulling) {
+        updateForFrustum |= !qFuzzyCompare(instanceData.cullingViewProjection, cullingCamera->viewProjection)
+                || !qFuzzyCompare(instanceData.cullingModelTransform, model.globalTransform);
+    }
     if (sortingChanged && !table->isDepthSortingEnabled()) {
         instanceData.sortedData.clear();
         instanceData.sortData.clear();
+        instanceData.sortScratch.clear();
         instanceData.sortedCameraDirection = {};
     }
     instanceData.sorting = table->isDepthSortingEnabled();
+    // Only the changed instances need to be uploaded if the buffer holds the previous version of the table as-is.
+    bool canUploadDirtyRanges = !usesCulling && !table->isDepthSortingEnabled() && !sortingChanged
+            && !table->dirtyRanges().isEmpty() && instanceData.serial == table->serial() - 1;
     if (instanceData.buffer && instanceData.buffer->size() < instanceBufferSize) {
+        canUploadDirtyRanges = false;
         updateInstanceBuffer = true;
         //                    qDebug() << "Resizing instance buffer";
         instanceData.buffer->setSize(instanceBufferSize);
@@ -2784,18 +3615,21 @@ bool QSSGLayerRenderData::prepareInstancing(QSSGRhiContext *rhiCtx,
     }
     if (!instanceData.buffer) {
         //                    qDebug() << "Creating instance buffer";
+        canUploadDirtyRanges = false;
         updateInstanceBuffer = true;
         instanceData.buffer = rhiCtx->rhi()->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer, instanceBufferSize);
         instanceData.buffer->create();
     }
-    if (updateInstanceBuffer || updateForLod) {
+    instanceData.uploadedBytes = 0;
+    if (updateInstanceBuffer || updateForLod || updateForFrustum) {
         const void *data = nullptr;
         if (table->isDepthSortingEnabled()) {
             if (updateInstanceBuffer) {
-                QMatrix4x4 invGlobalTransform = modelContext.model.globalTransform.inverted();
+                QMatrix4x4 invGlobalTransform = model.globalTransform.inverted();
                 instanceData.sortedData.resize(table->dataSize());
                 sortInstances(instanceData.sortedData,
                               instanceData.sortData,
+                              instanceData.sortScratch,
                               table->constData(),
                               table->stride(),
                               table->count(),
@@ -2807,28 +3641,36 @@ bool QSSGLayerRenderData::prepareInstancing(QSSGRhiContext *rhiCtx,
             data = table->constData();
         }
         if (data) {
-            if (updateForLod) {
-                if (table->isDepthSortingEnabled()) {
-                    instanceData.lodData.resize(table->dataSize());
-                    cullLodInstances(instanceData.lodData, instanceData.sortedData.constData(), instanceData.sortedData.size(), cameraPosition, minThreshold, maxThreshold);
-                    data = instanceData.lodData.constData();
-                } else {
-                    instanceData.lodData.resize(table->dataSize());
-                    cullLodInstances(instanceData.lodData, table->constData(), table->count(), cameraPosition, minThreshold, maxThreshold);
-                    data = instanceData.lodData.constData();
+            quint32 uploadSize = instanceBufferSize;
+            instanceData.instanceCount = -1;
+            if (usesCulling) {
+                QSSGBounds3 localBounds;
+                if (usesFrustumCulling) {
+                    for (const auto &subsetRenderable : modelContext.subsets)
+                        localBounds.include(subsetRenderable.subset.bounds);
                 }
+                instanceData.instanceCount = cullInstances(instanceData.lodData, data, table->count(), cameraPosition, minThreshold, maxThreshold,
+                                                           usesFrustumCulling ? &cullingCamera->clippingFrustum.value() : nullptr, localBounds,
+                                                           model.globalInstanceTransform, model.localInstanceTransform);
+                data = instanceData.lodData.constData();
+                uploadSize = quint32(instanceData.instanceCount) * table->stride();
             }
-            QRhiResourceUpdateBatch *rub = rhiCtx->rhi()->nextResourceUpdateBatch();
-            rub->updateDynamicBuffer(instanceData.buffer, 0, instanceBufferSize, data);
-            rhiCtx->commandBuffer()->resourceUpdate(rub);
-            //qDebug() << "****** UPDATING INST BUFFER. Size" << instanceBufferSize;
+            instanceData.uploadedBytes = uploadInstanceData(rhiCtx, instanceData.buffer, data, uploadSize, table->stride(),
+                                                            canUploadDirtyRanges ? table->dirtyRanges() : QSSGRenderInstanceTable::DirtyRanges());
+            //qDebug() << "****** UPDATING INST BUFFER. Size" << uploadSize;
         } else {
             qWarning() << "NO DATA IN INSTANCE TABLE";
         }
         instanceData.serial = table->serial();
         instanceData.cameraPosition = cameraPosition;
+        instanceData.frustumCulling = usesFrustumCulling;
+        if (usesFrustumCulling) {
+            instanceData.cullingViewProjection = cullingCamera->viewProjection;
+            instanceData.cullingModelTransform = model.globalTransform;
+        }
     }
     instanceBuffer = instanceData.buffer;
+    renderable->instanceCount = (instanceData.instanceCount >= 0) ? instanceData.instanceCount : table->count();
     return instanceBuffer;
 }
 
@@ -2880,6 +3722,43 @@ void QSSGLayerRenderData::maybeBakeLightmap()
     interactiveLightmapBakingRequested = false;
 }
 
+void QSSGLayerRenderData::maybeWarmupPipelines()
+{
+    // QT_QUICK3D_PIPELINE_WARMUP=1 replays the recorded pipeline states on the
+    // first frame, otherwise it only happens when requested from the View3D.
+    const bool warmupOnStartup = QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::PipelineWarmup);
+    if (!pipelineWarmupRequested && (!warmupOnStartup || pipelineWarmupDone))
+        return;
+
+    pipelineWarmupRequested = false;
+    pipelineWarmupDone = true;
+
+    const auto &contextInterface = renderer->contextInterface();
+    QSSGRhiContext *rhiCtx = contextInterface->rhiContext().get();
+    QRhiRenderPassDescriptor *rpDesc = rhiCtx->mainRenderPassDescriptor();
+    if (!rpDesc)
+        return;
+
+    // Same as what the main pass uses, see OpaquePass::renderPrep()
+    QSSGRhiGraphicsPipelineState basePs = ps;
+    basePs.samples = rhiCtx->mainPassSampleCount();
+    basePs.viewCount = rhiCtx->mainPassViewCount();
+
+    QRhiCommandBuffer *cb = rhiCtx->commandBuffer();
+    cb->debugMarkBegin("Quick3D pipeline warmup");
+    auto &shaderCache = *contextInterface->shaderCache();
+    const auto result = shaderCache.pipelineWarmupCache().replay(shaderCache, *rhiCtx, basePs, rpDesc);
+    cb->debugMarkEnd();
+
+    const bool shaderDebug = !QSSGRhiContextPrivate::editorMode() && QSSGRhiContextPrivate::shaderDebuggingEnabled();
+    if (shaderDebug)
+        qDebug("Created %d graphics pipelines from the warmup cache", result.createdCount);
+    if (result.missingShaderCount > 0 || result.unsupportedCount > 0) {
+        qCDebug(PERF_INFO, "Pipeline warmup skipped %d entries without cached shaders and %d entries with unsupported shader resource bindings",
+                result.missingShaderCount, result.unsupportedCount);
+    }
+}
+
 QSSGFrameData &QSSGLayerRenderData::getFrameData()
 {
     return frameData;
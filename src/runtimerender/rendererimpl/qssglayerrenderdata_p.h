@@ -207,7 +207,9 @@ public:
                                 const QSSGRenderCameraDataList &allCameraData,
                                 TModelContextPtrList &modelContexts,
                                 QSSGRenderableObjectList &opaqueObjects,
+                                QSSGBoundsSoA &opaqueBounds,
                                 QSSGRenderableObjectList &transparentObjects,
+                                QSSGBoundsSoA &transparentBounds,
                                 QSSGRenderableObjectList &screenTextureObjects,
                                 float lodThreshold = 0.0f);
     bool prepareParticlesForRender(const RenderableNodeEntries &renderableParticles, const QSSGRenderCameraData &cameraData);
@@ -222,6 +224,13 @@ public:
 
     static qsizetype frustumCulling(const QSSGClippingFrustum &clipFrustum, const QSSGRenderableObjectList &renderables, QSSGRenderableObjectList &visibleRenderables);
     [[nodiscard]] static qsizetype frustumCullingInline(const QSSGClippingFrustum &clipFrustum, QSSGRenderableObjectList &renderables);
+    // Same as frustumCullingInline(), but tests the bounds in batches. 'bounds' needs to match 'renderables' entry by entry.
+    [[nodiscard]] static qsizetype frustumCullingBatch(const QSSGClippingFrustum &clipFrustum, const QSSGBoundsSoA &bounds, QSSGRenderableObjectList &renderables);
+    // Same as above, for renderables that hold the objects of 'first' followed by the objects of 'second'.
+    [[nodiscard]] static qsizetype frustumCullingBatch(const QSSGClippingFrustum &clipFrustum, const QSSGBoundsSoA &first, const QSSGBoundsSoA &second, QSSGRenderableObjectList &renderables);
+    // Groups renderables that were prepared with the same main pass pipeline and shader resources, within
+    // depth buckets spread over the log of the camera distance. Ties are ordered nearest to furthest.
+    static void sortOpaqueByState(QSSGRenderableObjectList &renderables);
 
 
     // Per-frame cache of renderable objects post-sort (for the MAIN rendering camera, i.e., don't use these lists for rendering from a different camera).
@@ -236,7 +245,14 @@ public:
 
     void resetForFrame();
 
+    // True when the scene, viewport and everything else that goes into the prepared
+    // renderables are the same as in the previous frame (QT_QUICK3D_REUSE_STATIC_FRAMES).
+    [[nodiscard]] bool canReusePreviousFrame() const;
+    // Keeps the renderables, sort lists and passes of the previous frame.
+    void resetForReusedFrame();
+
     void maybeBakeLightmap();
+    void maybeWarmupPipelines();
 
     QSSGFrameData &getFrameData();
 
@@ -300,6 +316,9 @@ public:
     bool interactiveLightmapBakingRequested = false;
     QSSGLightmapper::Callback lightmapBakingOutputCallback;
 
+    bool pipelineWarmupRequested = false;
+    bool pipelineWarmupDone = false;
+
     [[nodiscard]] QSSGRenderGraphObject *getCamera(QSSGCameraId id) const;
     [[nodiscard]] QSSGRenderCamera *activeCamera() const { return !renderedCameras.isEmpty() ? renderedCameras[0] : nullptr; }
 
@@ -344,11 +363,23 @@ public:
                                   const QVector3D &cameraDirection,
                                   const QVector3D &cameraPosition,
                                   float minThreshold,
-                                  float maxThreshold);
+                                  float maxThreshold,
+                                  const QSSGRenderCameraData *cullingCamera = nullptr);
+    // The camera the instances of 'renderable' can be frustum culled against in prepareInstancing(),
+    // or null if a pass rendering from another camera shares its instance buffer.
+    const QSSGRenderCameraData *instanceCullingCamera(const QSSGSubsetRenderable &renderable) const;
+    // Uploads 'size' bytes of instance data to 'buffer'. If 'dirtyRanges' is not empty, only the instances
+    // in those ranges are written. Returns the number of bytes uploaded.
+    static quint32 uploadInstanceData(QSSGRhiContext *rhiCtx,
+                                      QRhiBuffer *buffer,
+                                      const void *data,
+                                      quint32 size,
+                                      quint32 stride,
+                                      const QSSGRenderInstanceTable::DirtyRanges &dirtyRanges = {});
 
     [[nodiscard]] QSSGRhiRenderableTexture *getRenderResult(QSSGFrameData::RenderResult id) { return &renderResults[size_t(id)]; }
     [[nodiscard]] const QSSGRhiRenderableTexture *getRenderResult(QSSGFrameData::RenderResult id) const { return &renderResults[size_t(id)]; }
-    [[nodiscard]] static inline const std::unique_ptr<QSSGPerFrameAllocator> &perFrameAllocator(QSSGRenderContextInterface &ctx);
+    [[nodiscard]] QSSGPerFrameAllocator &perFrameAllocator(QSSGRenderContextInterface &ctx);
     [[nodiscard]] static inline QSSGLayerRenderData *getCurrent(const QSSGRenderer &renderer) { return renderer.m_currentLayer; }
 
     static void setTonemapFeatures(QSSGShaderFeatures &features, QSSGRenderLayer::TonemapMode tonemapMode)
@@ -417,6 +448,10 @@ private:
     std::vector<QSSGRenderableObjectList> opaqueObjectStore { { /* 0 - Always available */ }};
     std::vector<QSSGRenderableObjectList> transparentObjectStore { { /* 0 - Always available */ }};
     std::vector<QSSGRenderableObjectList> screenTextureObjectStore { { /* 0 - Always available */ }};
+    // Bounds of the objects in the opaque and transparent stores (same order), in SoA form for
+    // batch culling. Filled where the objects are added to the stores.
+    std::vector<QSSGBoundsSoA> opaqueBoundsStore { { /* 0 - Always available */ }};
+    std::vector<QSSGBoundsSoA> transparentBoundsStore { { /* 0 - Always available */ }};
 
     // Soreted cache (per camera and extension)
     using PerCameraCache = std::unordered_map<const QSSGRenderCamera *, QSSGRenderableObjectList>;
@@ -425,6 +460,8 @@ private:
     std::vector<PerCameraCache> sortedScreenTextureObjectCache { { /* 0 - Always available */ } };
     std::vector<PerCameraCache> sortedOpaqueDepthPrepassCache { { /* 0 - Always available */ } };
     std::vector<PerCameraCache> sortedDepthWriteCache { { /* 0 - Always available */ } };
+    // Scratch space for QSSGRenderSort::sortByKey(), kept between frames
+    QSSGRenderableObjectList transparentSortScratch;
 
     [[nodiscard]] const QSSGRenderCameraDataList &getCachedCameraDatas();
     void ensureCachedCameraDatas();
@@ -454,6 +491,10 @@ private:
                                    const RenderableNodeEntries::ConstIterator begin,
                                    const RenderableNodeEntries::ConstIterator end,
                                    bool globalPickingEnabled);
+    // Replaces models sharing the same mesh, materials and state with one instanced model per group
+    void batchIdenticalModels(RenderableNodeEntries &renderableModels);
+    void releaseDynamicBatches(bool unusedOnly);
+    void updateBlendedDynamicBatches();
 
     // Persistent data
     QHash<QSSGShaderMapKey, QSSGRhiShaderPipelinePtr> shaderMap;
@@ -481,6 +522,72 @@ private:
     QHash<const QSSGModelContext *, QRhiTexture *> lightmapTextures;
     QHash<const QSSGModelContext *, QRhiTexture *> bonemapTextures;
     QSSGRhiRenderableTexture renderResults[3] {};
+
+    // Dynamic batching
+    struct DynamicBatchKey
+    {
+        const QSSGRenderMesh *mesh = nullptr;
+        QVector<QSSGRenderGraphObject *> materials;
+        QVector<const QSSGRenderLight *> lights; // The lights affecting the models, not the per-frame light list
+        float opacity = 1.0f;
+        float depthBiasSq = 0.0f;
+        quint8 flags = 0;
+
+        friend bool operator==(const DynamicBatchKey &a, const DynamicBatchKey &b) noexcept
+        {
+            return a.mesh == b.mesh && a.opacity == b.opacity && a.depthBiasSq == b.depthBiasSq && a.flags == b.flags
+                    && a.materials == b.materials && a.lights == b.lights;
+        }
+        friend size_t qHash(const DynamicBatchKey &key, size_t seed = 0) noexcept
+        {
+            return qHashMulti(seed, key.mesh, key.materials, key.lights, key.opacity, key.depthBiasSq, key.flags);
+        }
+    };
+    struct DynamicBatch
+    {
+        // Stand-in model drawing all the batched models as instances, owned by the layer data.
+        // Only created once the group has enough models.
+        QSSGRenderModel *model = nullptr;
+        QSSGRenderInstanceTable *instanceTable = nullptr;
+        // Indices of this frame's renderable models in the group
+        QList<qsizetype> members;
+        // Set when the stand-in was prepared with a blended material (e.g. a texture with
+        // alpha), the group is drawn model by model from then on.
+        bool blended = false;
+        bool used = false;
+    };
+    // Kept between frames so that the groups and their member lists don't need to be
+    // allocated again every frame.
+    QHash<DynamicBatchKey, DynamicBatch> dynamicBatches;
+    QList<DynamicBatchKey> dynamicBatchOrder;
+    DynamicBatchKey dynamicBatchScratchKey;
+    // Per subset union of the world bounds of the models drawn by each stand-in, rebuilt every frame
+    QHash<const QSSGRenderModel *, QVector<QSSGBounds3>> dynamicBatchBounds;
+
+    // Flattened node hierarchy (QT_QUICK3D_FLAT_NODE_HIERARCHY), rebuilt only when
+    // nodes are added or removed.
+    struct FlatNodeHierarchy
+    {
+        QVector<QSSGRenderNode *> nodes; // DFS order, parents come before their children
+        QVector<qsizetype> subtreeEnds; // index one past the last node of the subtree
+        quint32 generation = 0;
+        bool valid = false;
+    };
+    FlatNodeHierarchy flatNodeHierarchy;
+
+    // Inputs of the last fully prepared frame, see canReusePreviousFrame()
+    struct PreparedFrame
+    {
+        quint64 sceneRevision = 0;
+        QRect viewport;
+        QRect scissorRect;
+        float dpr = 0.0f;
+        bool valid = false;
+    };
+    PreparedFrame preparedFrame;
+    // Renderables that may outlive the frame cannot come from the context's per-frame
+    // allocator, as that is reset by every layer that starts a frame.
+    std::unique_ptr<QSSGPerFrameAllocator> reusableFrameAllocator;
 };
 
 QT_END_NAMESPACE
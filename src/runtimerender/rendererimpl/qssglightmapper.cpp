@@ -81,6 +81,7 @@ struct QSSGLightmapperPrivate
         quint32 binormalOffset = UINT_MAX;
         QRhiVertexInputAttribute::Format binormalFormat = QRhiVertexInputAttribute::Float;
         QSSGMesh::Mesh meshWithLightmapUV; // only set when model->hasLightmap() == true
+        QSSGMesh::Mesh sourceMesh; // owns vertexData and indexData when the mesh file is memory mapped
     };
     QVector<DrawInfo> drawInfos;
 
@@ -281,6 +282,10 @@ bool QSSGLightmapperPrivate::commitGeometry()
             return false;
         }
 
+        // Baking with the placeholder of an image that is still loading would store the
+        // wrong result, wait for the image instead
+        const QSSGBufferManager::LoadRenderImageFlags bakeImageFlags = QSSGBufferManager::LoadWithFlippedY
+                | QSSGBufferManager::LoadSynchronously;
         subMeshInfos[lmIdx].reserve(lm.renderables.size());
         for (const QSSGRenderableObjectHandle &handle : std::as_const(lm.renderables)) {
             Q_ASSERT(handle.obj->type == QSSGRenderableObject::Type::DefaultMaterialMeshSubset
@@ -296,17 +301,17 @@ bool QSSGLightmapperPrivate::commitGeometry()
                 info.emissiveFactor = defMat->emissiveColor;
                 if (defMat->colorMap) {
                     info.baseColorNode = defMat->colorMap;
-                    QSSGRenderImageTexture texture = bufferManager->loadRenderImage(defMat->colorMap);
+                    QSSGRenderImageTexture texture = bufferManager->loadRenderImage(defMat->colorMap, QSSGBufferManager::MipModeFollowRenderImage, bakeImageFlags);
                     info.baseColorMap = texture.m_texture;
                 }
                 if (defMat->emissiveMap) {
                     info.emissiveNode = defMat->emissiveMap;
-                    QSSGRenderImageTexture texture = bufferManager->loadRenderImage(defMat->emissiveMap);
+                    QSSGRenderImageTexture texture = bufferManager->loadRenderImage(defMat->emissiveMap, QSSGBufferManager::MipModeFollowRenderImage, bakeImageFlags);
                     info.emissiveMap = texture.m_texture;
                 }
                 if (defMat->normalMap) {
                     info.normalMapNode = defMat->normalMap;
-                    QSSGRenderImageTexture texture = bufferManager->loadRenderImage(defMat->normalMap);
+                    QSSGRenderImageTexture texture = bufferManager->loadRenderImage(defMat->normalMap, QSSGBufferManager::MipModeFollowRenderImage, bakeImageFlags);
                     info.normalMap = texture.m_texture;
                     info.normalStrength = defMat->bumpAmount;
                 }
@@ -337,6 +342,10 @@ bool QSSGLightmapperPrivate::commitGeometry()
             return false;
         }
 
+        // The vertex data is read below as floats, meshes saved with quantized attributes
+        // store normals, tangents and UVs as half floats
+        mesh.dequantizeAttributes();
+
         if (!mesh.hasLightmapUVChannel()) {
             QElapsedTimer unwrapTimer;
             unwrapTimer.start();
@@ -362,6 +371,7 @@ bool QSSGLightmapperPrivate::commitGeometry()
             drawInfo.lightmapSize = QSize(1024, 1024);
         }
 
+        drawInfo.sourceMesh = mesh;
         drawInfo.vertexData = mesh.vertexBuffer().data;
         drawInfo.vertexStride = mesh.vertexBuffer().stride;
         drawInfo.indexData = mesh.indexBuffer().data;
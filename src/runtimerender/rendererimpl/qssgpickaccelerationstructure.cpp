@@ -0,0 +1,440 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qssgpickaccelerationstructure_p.h"
+#include "qssgrenderjobs_p.h"
+
+#include <QtQuick3DRuntimeRender/private/qssgrenderlayer_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrendermodel_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrendergeometry_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderinstancetable_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderbuffermanager_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrendermesh_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderray_p.h>
+
+#include <QtCore/QMutexLocker>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <optional>
+
+QT_BEGIN_NAMESPACE
+
+// Leaves of the tree reference up to this many boxes
+static constexpr quint32 MAX_ITEMS_PER_LEAF = 4;
+// Instance bounds are calculated in chunks of this size on the worker threads
+static constexpr int INSTANCE_BOUNDS_CHUNK_SIZE = 4096;
+
+namespace {
+struct SlabRay
+{
+    explicit SlabRay(const QSSGRenderRay &ray)
+        : origin(ray.origin)
+    {
+        for (int i = 0; i != 3; ++i) {
+            parallel[i] = (std::abs(ray.direction[i]) < std::numeric_limits<float>::min());
+            directionInverse[i] = parallel[i] ? 0.0f : 1.0f / ray.direction[i];
+        }
+    }
+
+    bool intersects(const QSSGBounds3 &bounds) const
+    {
+        float tMin = 0.0f;
+        float tMax = std::numeric_limits<float>::max();
+        for (int i = 0; i != 3; ++i) {
+            if (parallel[i]) {
+                if (origin[i] < bounds.minimum[i] || origin[i] > bounds.maximum[i])
+                    return false;
+                continue;
+            }
+            float t0 = (bounds.minimum[i] - origin[i]) * directionInverse[i];
+            float t1 = (bounds.maximum[i] - origin[i]) * directionInverse[i];
+            if (t0 > t1)
+                std::swap(t0, t1);
+            tMin = std::max(tMin, t0);
+            tMax = std::min(tMax, t1);
+            if (tMin > tMax)
+                return false;
+        }
+        return true;
+    }
+
+    QVector3D origin;
+    QVector3D directionInverse;
+    bool parallel[3];
+};
+}
+
+bool QSSGPickBVH::intersects(const QSSGRenderRay &ray, const QSSGBounds3 &bounds)
+{
+    return SlabRay(ray).intersects(bounds);
+}
+
+// The exact test is done against the (local) box of the mesh, so the transformed box only needs to be
+// grown a tiny bit to not lose grazing hits to rounding.
+QSSGBounds3 QSSGPickBVH::transformedBounds(const QSSGBounds3 &bounds, const QMatrix4x4 &transform)
+{
+    QSSGBounds3 result = bounds;
+    result.transform(transform);
+    const QVector3D padding = (result.maximum - result.minimum) * 1e-4f + QVector3D(1e-6f, 1e-6f, 1e-6f);
+    result.minimum -= padding;
+    result.maximum += padding;
+    return result;
+}
+
+void QSSGPickBVH::build(const QSSGBounds3 *bounds, std::vector<quint32> &&items)
+{
+    m_items = std::move(items);
+    m_nodes.clear();
+    if (!m_items.empty()) {
+        m_nodes.reserve(2 * (m_items.size() / MAX_ITEMS_PER_LEAF + 1));
+        buildNode(bounds, 0, quint32(m_items.size()));
+    }
+}
+
+// Splits at the median centroid along the longest axis of the centroid bounds
+quint32 QSSGPickBVH::buildNode(const QSSGBounds3 *bounds, quint32 begin, quint32 end)
+{
+    const quint32 index = quint32(m_nodes.size());
+    m_nodes.emplace_back();
+
+    QSSGBounds3 nodeBounds;
+    QSSGBounds3 centroidBounds;
+    for (quint32 i = begin; i != end; ++i) {
+        const QSSGBounds3 &itemBounds = bounds[m_items[i]];
+        nodeBounds.include(itemBounds);
+        centroidBounds.include(itemBounds.center());
+    }
+
+    if (end - begin <= MAX_ITEMS_PER_LEAF) {
+        m_nodes[index] = Node { nodeBounds, begin, end - begin };
+        return index;
+    }
+
+    const QVector3D centroidExtents = centroidBounds.maximum - centroidBounds.minimum;
+    int axis = 0;
+    if (centroidExtents.y() > centroidExtents[axis])
+        axis = 1;
+    if (centroidExtents.z() > centroidExtents[axis])
+        axis = 2;
+
+    const quint32 mid = begin + (end - begin) / 2;
+    std::nth_element(m_items.begin() + begin, m_items.begin() + mid, m_items.begin() + end,
+                     [bounds, axis](quint32 lhs, quint32 rhs) {
+        return bounds[lhs].center(axis) < bounds[rhs].center(axis);
+    });
+
+    buildNode(bounds, begin, mid);
+    const quint32 right = buildNode(bounds, mid, end);
+    m_nodes[index] = Node { nodeBounds, right, 0 };
+    return index;
+}
+
+// Children are always stored after their parent, so walking the nodes backwards updates the
+// children before the parents.
+void QSSGPickBVH::refit(const QSSGBounds3 *bounds)
+{
+    for (quint32 index = quint32(m_nodes.size()); index-- > 0;) {
+        Node &node = m_nodes[index];
+        node.bounds.setEmpty();
+        if (node.count > 0) {
+            for (quint32 i = node.first, last = node.first + node.count; i != last; ++i)
+                node.bounds.include(bounds[m_items[i]]);
+        } else {
+            node.bounds.include(m_nodes[index + 1].bounds);
+            node.bounds.include(m_nodes[node.first].bounds);
+        }
+    }
+}
+
+void QSSGPickBVH::findHits(const QSSGRenderRay &ray, const QSSGBounds3 *bounds, HitList &outHits) const
+{
+    if (m_nodes.empty())
+        return;
+
+    const SlabRay slabRay(ray);
+    QVarLengthArray<quint32, 64> stack;
+    stack.push_back(0);
+    while (!stack.isEmpty()) {
+        const quint32 index = stack.takeLast();
+        const Node &node = m_nodes[index];
+        if (!slabRay.intersects(node.bounds))
+            continue;
+        if (node.count > 0) {
+            for (quint32 i = node.first, last = node.first + node.count; i != last; ++i) {
+                const quint32 item = m_items[i];
+                if (slabRay.intersects(bounds[item]))
+                    outHits.push_back(item);
+            }
+        } else {
+            stack.push_back(node.first);
+            stack.push_back(index + 1);
+        }
+    }
+}
+
+static void collectRenderables(const QSSGRenderNode &node, std::vector<const QSSGRenderNode *> &renderables)
+{
+    if (QSSGRenderGraphObject::isRenderable(node.type))
+        renderables.push_back(&node);
+
+    for (const auto &child : node.children)
+        collectRenderables(child, renderables);
+}
+
+QSSGPickAccelerationStructure::ItemList QSSGPickAccelerationStructure::listFor(ItemState state)
+{
+    switch (state) {
+    case ItemState::Bounded:
+        return ItemList::Tree;
+    case ItemState::Unresolved:
+    case ItemState::Unbounded:
+        return ItemList::Unbounded;
+    case ItemState::Skipped:
+        break;
+    }
+    return ItemList::None;
+}
+
+void QSSGPickAccelerationStructure::rebuildItems(const QSSGRenderLayer &layer)
+{
+    std::vector<const QSSGRenderNode *> renderables;
+    renderables.reserve(m_items.size());
+    for (const auto &childNode : layer.children)
+        collectRenderables(childNode, renderables);
+
+    m_items.clear();
+    m_items.resize(renderables.size());
+    m_worldBounds.clear();
+    m_worldBounds.resize(renderables.size());
+    m_itemIndex.clear();
+    m_itemIndex.reserve(qsizetype(renderables.size()));
+    for (size_t i = 0, end = renderables.size(); i != end; ++i) {
+        m_items[i].node = renderables[i];
+        m_itemIndex.insert(renderables[i], quint32(i));
+    }
+}
+
+// Returns true when the item's mesh or state changed. Called with the mesh update mutex held.
+bool QSSGPickAccelerationStructure::resolveItem(Item &item, QSSGBufferManager &bufferManager)
+{
+    const ItemState previousState = item.state;
+    const QSSGBounds3 previousBounds = item.localBounds;
+
+    if (item.node->type == QSSGRenderGraphObject::Type::Item2D) {
+        item.state = ItemState::Unbounded;
+    } else if (item.node->type != QSSGRenderGraphObject::Type::Model) {
+        item.state = ItemState::Skipped;
+    } else {
+        const auto &model = static_cast<const QSSGRenderModel &>(*item.node);
+        item.meshPath = model.meshPath;
+        item.geometry = model.geometry;
+        item.geometryGeneration = model.geometry ? model.geometry->generationId() : 0;
+
+        bool isCurrent = true;
+        const QSSGRenderMesh *mesh = bufferManager.getMeshForPicking(model, &isCurrent);
+        if (!mesh || !isCurrent) {
+            item.state = ItemState::Unresolved;
+        } else {
+            item.localBounds.setEmpty();
+            for (const auto &subMesh : mesh->subsets)
+                item.localBounds.include(subMesh.bounds);
+            if (item.localBounds.isEmpty())
+                item.state = ItemState::Skipped;
+            else
+                item.state = model.instancing() ? ItemState::Unbounded : ItemState::Bounded;
+        }
+    }
+
+    return item.state != previousState
+            || (item.state == ItemState::Bounded && (item.localBounds.minimum != previousBounds.minimum
+                                                     || item.localBounds.maximum != previousBounds.maximum));
+}
+
+void QSSGPickAccelerationStructure::update(const QSSGRenderLayer &layer, QSSGBufferManager &bufferManager)
+{
+    const quint32 hierarchyGeneration = QSSGRenderNode::hierarchyGeneration();
+    bool needsBuild = false;
+    if (!m_valid || hierarchyGeneration != m_hierarchyGeneration) {
+        rebuildItems(layer);
+        m_hierarchyGeneration = hierarchyGeneration;
+        m_valid = true;
+        needsBuild = true;
+    }
+
+    // Only the items whose mesh might have changed need the buffer manager, in the common
+    // case nothing is looked up and the mutex is not taken at all.
+    std::optional<QMutexLocker<QMutex>> meshLocker;
+    bool needsRefit = false;
+    for (size_t i = 0, end = m_items.size(); i != end; ++i) {
+        Item &item = m_items[i];
+        bool needsResolve = needsBuild || item.state == ItemState::Unresolved;
+        if (!needsResolve && item.node->type == QSSGRenderGraphObject::Type::Model) {
+            const auto &model = static_cast<const QSSGRenderModel &>(*item.node);
+            needsResolve = model.geometry != item.geometry
+                    || (model.geometry && model.geometry->generationId() != item.geometryGeneration)
+                    || !(model.meshPath == item.meshPath)
+                    || (item.state == ItemState::Bounded && model.instancing())
+                    || (item.state == ItemState::Unbounded && !model.instancing());
+        }
+
+        bool boundsChanged = false;
+        if (needsResolve) {
+            if (!meshLocker)
+                meshLocker.emplace(bufferManager.meshUpdateMutex());
+            const ItemState previousState = item.state;
+            if (resolveItem(item, bufferManager)) {
+                boundsChanged = true;
+                // Items moving in or out of the tree or the always tested items need a new tree
+                needsBuild = needsBuild || (listFor(previousState) != listFor(item.state));
+            }
+        }
+
+        if (item.state != ItemState::Bounded)
+            continue;
+
+        if (boundsChanged || item.transformRevision != item.node->globalTransformRevision) {
+            item.transformRevision = item.node->globalTransformRevision;
+            m_worldBounds[i] = QSSGPickBVH::transformedBounds(item.localBounds, item.node->globalTransform);
+            needsRefit = true;
+        }
+    }
+
+    if (needsBuild)
+        buildTree();
+    else if (needsRefit)
+        m_bvh.refit(m_worldBounds.data());
+}
+
+void QSSGPickAccelerationStructure::buildTree()
+{
+    std::vector<quint32> treeItems;
+    m_unboundedItems.clear();
+
+    for (quint32 i = 0, end = quint32(m_items.size()); i != end; ++i) {
+        switch (listFor(m_items[i].state)) {
+        case ItemList::Tree:
+            treeItems.push_back(i);
+            break;
+        case ItemList::Unbounded:
+            m_unboundedItems.push_back(i);
+            break;
+        case ItemList::None:
+            break;
+        }
+    }
+
+    m_bvh.build(m_worldBounds.data(), std::move(treeItems));
+}
+
+void QSSGPickAccelerationStructure::findCandidates(const QSSGRenderRay &ray, bool pickEverything, CandidateList &outCandidates) const
+{
+    QSSGPickBVH::HitList hits(m_unboundedItems.cbegin(), m_unboundedItems.cend());
+    m_bvh.findHits(ray, m_worldBounds.data(), hits);
+
+    // Same order as the linear search, the distance sort of the results is stable
+    std::sort(hits.begin(), hits.end(), std::greater<quint32>());
+    for (const quint32 itemIndex : std::as_const(hits)) {
+        const QSSGRenderNode *node = m_items[itemIndex].node;
+        if (pickEverything || node->getLocalState(QSSGRenderNode::LocalState::Pickable))
+            outCandidates.push_back(node);
+    }
+}
+
+bool QSSGPickAccelerationStructure::mayIntersect(const QSSGRenderNode &node, const QSSGRenderRay &ray) const
+{
+    const auto it = m_itemIndex.constFind(&node);
+    if (it == m_itemIndex.cend())
+        return true;
+
+    switch (m_items[*it].state) {
+    case ItemState::Bounded:
+        return QSSGPickBVH::intersects(ray, m_worldBounds[*it]);
+    case ItemState::Skipped:
+        return false;
+    case ItemState::Unresolved:
+    case ItemState::Unbounded:
+        break;
+    }
+    return true;
+}
+
+void QSSGInstancePickAccelerationStructure::updateInstanceBounds(const QSSGRenderInstanceTable &table, int offset, int count)
+{
+    const qsizetype chunkCount = (count + INSTANCE_BOUNDS_CHUNK_SIZE - 1) / INSTANCE_BOUNDS_CHUNK_SIZE;
+    const QSSGBounds3 localBounds = QSSGPickBVH::transformedBounds(m_modelBounds, m_localInstanceTransform);
+    QSSGRenderJobs::parallelFor(chunkCount, [&](qsizetype chunk) {
+        const int begin = offset + int(chunk) * INSTANCE_BOUNDS_CHUNK_SIZE;
+        const int end = qMin(begin + INSTANCE_BOUNDS_CHUNK_SIZE, offset + count);
+        for (int i = begin; i < end; ++i)
+            m_instanceBounds[i] = QSSGPickBVH::transformedBounds(localBounds, table.getTransform(i));
+    });
+}
+
+std::shared_ptr<const QSSGInstancePickAccelerationStructure> QSSGInstancePickAccelerationStructure::update(std::shared_ptr<const QSSGInstancePickAccelerationStructure> current,
+                                                                                                           const QSSGRenderModel &model,
+                                                                                                           const QSSGBounds3 &modelBounds)
+{
+    const QSSGRenderInstanceTable *table = model.instanceTable;
+    Q_ASSERT(table);
+
+    if (current) {
+        const bool sameInstances = (table == current->m_table && table->count() == current->m_count);
+        const bool sameModel = (model.localInstanceTransform == current->m_localInstanceTransform
+                                && modelBounds.minimum == current->m_modelBounds.minimum
+                                && modelBounds.maximum == current->m_modelBounds.maximum);
+        if (sameInstances && sameModel) {
+            if (table->serial() == current->m_serial)
+                return current;
+
+            // Only some of the instances moved, refit a copy of the tree around them
+            if (table->serial() == current->m_serial + 1 && !table->dirtyRanges().isEmpty()) {
+                auto refitted = std::make_shared<QSSGInstancePickAccelerationStructure>(*current);
+                for (const auto &range : table->dirtyRanges()) {
+                    if (range.offset < refitted->m_count)
+                        refitted->updateInstanceBounds(*table, range.offset, qMin(range.count, refitted->m_count - range.offset));
+                }
+                refitted->m_bvh.refit(refitted->m_instanceBounds.data());
+                refitted->m_serial = table->serial();
+                return refitted;
+            }
+        }
+    }
+
+    auto built = std::make_shared<QSSGInstancePickAccelerationStructure>();
+    built->m_table = table;
+    built->m_serial = table->serial();
+    built->m_count = table->count();
+    built->m_localInstanceTransform = model.localInstanceTransform;
+    built->m_modelBounds = modelBounds;
+
+    built->m_instanceBounds.resize(built->m_count);
+    built->updateInstanceBounds(*table, 0, built->m_count);
+    std::vector<quint32> items(built->m_count);
+    for (int i = 0; i != built->m_count; ++i)
+        items[i] = quint32(i);
+    built->m_bvh.build(built->m_instanceBounds.data(), std::move(items));
+    return built;
+}
+
+bool QSSGInstancePickAccelerationStructure::findCandidates(const QMatrix4x4 &globalInstanceTransform, const QSSGRenderRay &ray, CandidateList &outCandidates) const
+{
+    bool invertible = false;
+    const QMatrix4x4 inverse = globalInstanceTransform.inverted(&invertible);
+    if (!invertible)
+        return false;
+
+    const QSSGRenderRay tableRay(inverse.map(ray.origin), inverse.mapVector(ray.direction));
+    QSSGPickBVH::HitList hits;
+    m_bvh.findHits(tableRay, m_instanceBounds.data(), hits);
+
+    // Same order as testing the instances one by one
+    std::sort(hits.begin(), hits.end());
+    for (const quint32 instance : std::as_const(hits))
+        outCandidates.push_back(int(instance));
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,178 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QSSGPICKACCELERATIONSTRUCTURE_P_H
+#define QSSGPICKACCELERATIONSTRUCTURE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick3DRuntimeRender/private/qtquick3druntimerenderglobal_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrendererutil_p.h>
+#include <QtQuick3DUtils/private/qssgbounds3_p.h>
+
+#include <QtCore/qhash.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtGui/qmatrix4x4.h>
+
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+struct QSSGRenderLayer;
+struct QSSGRenderNode;
+struct QSSGRenderModel;
+struct QSSGRenderInstanceTable;
+class QSSGRenderGeometry;
+struct QSSGRenderRay;
+class QSSGBufferManager;
+
+// BVH over a set of boxes, the boxes are identified by their index in the bounds array
+// passed to build() and refit().
+class Q_AUTOTEST_EXPORT QSSGPickBVH
+{
+public:
+    using HitList = QVarLengthArray<quint32, 64>;
+
+    // Builds the tree over the boxes listed in items
+    void build(const QSSGBounds3 *bounds, std::vector<quint32> &&items);
+    // Updates the tree after boxes moved, the tree structure stays the same.
+    void refit(const QSSGBounds3 *bounds);
+
+    // Appends the (unordered) indices of the boxes hit by the ray
+    void findHits(const QSSGRenderRay &ray, const QSSGBounds3 *bounds, HitList &outHits) const;
+
+    [[nodiscard]] bool isEmpty() const { return m_nodes.empty(); }
+    [[nodiscard]] qsizetype nodeCount() const { return qsizetype(m_nodes.size()); }
+
+    static bool intersects(const QSSGRenderRay &ray, const QSSGBounds3 &bounds);
+    // The bounds of the transformed box, grown by a tiny bit so that they can be used as a
+    // conservative test in front of the exact intersection test.
+    static QSSGBounds3 transformedBounds(const QSSGBounds3 &bounds, const QMatrix4x4 &transform);
+
+private:
+    // Children of an inner node are at index + 1 and at 'first', leaves reference
+    // 'count' entries in m_items starting at 'first'.
+    struct Node
+    {
+        QSSGBounds3 bounds;
+        quint32 first = 0;
+        quint32 count = 0;
+    };
+
+    quint32 buildNode(const QSSGBounds3 *bounds, quint32 begin, quint32 end);
+
+    std::vector<Node> m_nodes;
+    std::vector<quint32> m_items;
+};
+
+// Top-level BVH over the world bounds of the renderables in a layer, used to find the
+// candidates for the exact (per model) ray tests when picking.
+//
+// The structure is kept alive between picks (owned by the layer) and is brought up to date
+// at the start of each query: it is rebuilt when the node hierarchy changed and refitted
+// when only transforms or meshes changed. Models that can't be represented by a single
+// world space box (instanced models, Item2Ds) are always handed to the exact test.
+// Candidates are returned in the same order as a reverse depth-first traversal of the
+// layer, so the pick results are the same as without the structure.
+class Q_AUTOTEST_EXPORT QSSGPickAccelerationStructure
+{
+public:
+    using CandidateList = QVarLengthArray<const QSSGRenderNode *, 32>;
+
+    void update(const QSSGRenderLayer &layer, QSSGBufferManager &bufferManager);
+
+    // Nodes that might be hit by the ray, farthest in traversal order first.
+    void findCandidates(const QSSGRenderRay &ray, bool pickEverything, CandidateList &outCandidates) const;
+    // False only if the node is known to the structure and the ray misses its world bounds.
+    [[nodiscard]] bool mayIntersect(const QSSGRenderNode &node, const QSSGRenderRay &ray) const;
+
+    [[nodiscard]] qsizetype itemCount() const { return qsizetype(m_items.size()); }
+    [[nodiscard]] qsizetype nodeCount() const { return m_bvh.nodeCount(); }
+
+private:
+    enum class ItemState : quint8
+    {
+        Unresolved, // Mesh not (yet) loaded or out of date, re-checked on each update
+        Bounded,
+        Unbounded, // No world bounds (instanced model or Item2D)
+        Skipped // Never hit
+    };
+
+    enum class ItemList : quint8
+    {
+        None,
+        Tree,
+        Unbounded // Always tested
+    };
+
+    struct Item
+    {
+        const QSSGRenderNode *node = nullptr;
+        QSSGBounds3 localBounds;
+        QSSGRenderPath meshPath;
+        const QSSGRenderGeometry *geometry = nullptr;
+        quint32 geometryGeneration = 0;
+        quint32 transformRevision = 0;
+        ItemState state = ItemState::Unresolved;
+    };
+
+    static ItemList listFor(ItemState state);
+    void rebuildItems(const QSSGRenderLayer &layer);
+    bool resolveItem(Item &item, QSSGBufferManager &bufferManager);
+    void buildTree();
+
+    std::vector<Item> m_items; // Depth-first order
+    std::vector<QSSGBounds3> m_worldBounds; // Same indices as m_items
+    std::vector<quint32> m_unboundedItems;
+    QSSGPickBVH m_bvh;
+    QHash<const QSSGRenderNode *, quint32> m_itemIndex;
+    quint32 m_hierarchyGeneration = 0;
+    bool m_valid = false;
+};
+
+// BVH over the bounds of the instances of an instanced model, in the space of the instance
+// table (i.e. before the model's globalInstanceTransform is applied). Held by the model and
+// replaced when the instance table, its serial or the model's mesh bounds change. A structure
+// is never modified once built, so pick snapshots (QSSGPickSnapshot) share it with the model.
+class Q_AUTOTEST_EXPORT QSSGInstancePickAccelerationStructure
+{
+public:
+    // Below this the instances are simply tested one by one
+    static constexpr int MIN_INSTANCE_COUNT = 64;
+
+    using CandidateList = QVarLengthArray<int, 64>;
+
+    // Returns current when it is up to date with the model, otherwise a new structure (refitted
+    // from a copy of current when only some of the instances moved).
+    static std::shared_ptr<const QSSGInstancePickAccelerationStructure> update(std::shared_ptr<const QSSGInstancePickAccelerationStructure> current,
+                                                                               const QSSGRenderModel &model,
+                                                                               const QSSGBounds3 &modelBounds);
+    // Instances that might be hit by the (world space) ray in increasing index order.
+    // Returns false when the ray can't be brought to the space of the instance table.
+    bool findCandidates(const QMatrix4x4 &globalInstanceTransform, const QSSGRenderRay &ray, CandidateList &outCandidates) const;
+
+private:
+    void updateInstanceBounds(const QSSGRenderInstanceTable &table, int offset, int count);
+
+    const QSSGRenderInstanceTable *m_table = nullptr;
+    int m_serial = -1;
+    int m_count = 0;
+    QMatrix4x4 m_localInstanceTransform;
+    QSSGBounds3 m_modelBounds;
+    std::vector<QSSGBounds3> m_instanceBounds;
+    QSSGPickBVH m_bvh;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSSGPICKACCELERATIONSTRUCTURE_P_H
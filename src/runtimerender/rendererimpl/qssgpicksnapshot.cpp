@@ -0,0 +1,184 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qssgpicksnapshot_p.h"
+
+#include "../qssgrendercontextcore.h"
+#include <QtQuick3DRuntimeRender/private/qssgrenderlayer_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrendermodel_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderinstancetable_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderbuffermanager_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrendermesh_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderray_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderoptimizations_p.h>
+
+#include <QtCore/QMutexLocker>
+
+#include <algorithm>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+using RenderableList = QVarLengthArray<const QSSGRenderNode *>;
+static void collectRenderables(const QSSGRenderNode &node, RenderableList &renderables)
+{
+    if (QSSGRenderGraphObject::isRenderable(node.type))
+        renderables.push_back(&node);
+
+    for (const auto &child : node.children)
+        collectRenderables(child, renderables);
+}
+
+std::shared_ptr<const QSSGPickSnapshot> QSSGPickSnapshot::create(const QSSGRenderContextInterface &ctx,
+                                                                 const QSSGRenderLayer &layer)
+{
+    std::shared_ptr<QSSGPickSnapshot> snapshot(new QSSGPickSnapshot);
+
+    const bool pickEverything = QSSGRendererPrivate::isGlobalPickingEnabled(*ctx.renderer());
+    RenderableList renderables;
+    for (const auto &childNode : layer.children)
+        collectRenderables(childNode, renderables);
+
+    auto &items = snapshot->m_items;
+    items.reserve(renderables.size());
+
+    // Items of the instanced models that get an instance acceleration structure
+    QVarLengthArray<size_t, 8> acceleratedItems;
+    {
+        // Only held while the mesh data is copied, the queries don't need it (the BVHs are
+        // shared and stay alive for as long as the snapshot does).
+        auto &bufferManager = *ctx.bufferManager();
+        QMutexLocker mutexLocker(bufferManager.meshUpdateMutex());
+
+        for (const QSSGRenderNode *node : std::as_const(renderables)) {
+            if (!pickEverything && !node->getLocalState(QSSGRenderNode::LocalState::Pickable))
+                continue;
+
+            Item item;
+            item.node = node;
+            item.globalTransform = node->globalTransform;
+
+            if (node->type == QSSGRenderGraphObject::Type::Item2D) {
+                item.isItem2D = true;
+                items.push_back(std::move(item));
+                continue;
+            }
+
+            if (node->type != QSSGRenderGraphObject::Type::Model)
+                continue;
+
+            const auto &model = static_cast<const QSSGRenderModel &>(*node);
+            const QSSGRenderMesh *mesh = bufferManager.getMeshForPicking(model);
+            if (!mesh)
+                continue;
+
+            item.subsetBounds.reserve(mesh->subsets.size());
+            for (const auto &subMesh : mesh->subsets) {
+                item.subsetBounds.push_back(subMesh.bounds);
+                item.modelBounds.include(subMesh.bounds);
+            }
+            if (item.modelBounds.isEmpty())
+                continue;
+
+            item.bvh = mesh->bvh;
+
+            if (model.instancing()) {
+                const QSSGRenderInstanceTable &table = *model.instanceTable;
+                auto instances = std::make_unique<Instances>();
+                instances->table = table.data();
+                instances->stride = table.stride();
+                instances->count = instances->stride > 0 ? qMin(table.count(), int(instances->table.size() / instances->stride)) : 0;
+                instances->globalInstanceTransform = model.globalInstanceTransform;
+                instances->localInstanceTransform = model.localInstanceTransform;
+                if (instances->count >= QSSGInstancePickAccelerationStructure::MIN_INSTANCE_COUNT
+                        && QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::PickingAcceleration)) {
+                    acceleratedItems.push_back(items.size());
+                }
+                item.instances = std::move(instances);
+            }
+
+            items.push_back(std::move(item));
+        }
+    }
+
+    // Only needs the instance table and the bounds copied above, not the mesh data. The
+    // structures are never modified once built so the snapshot shares them with the models.
+    for (const size_t itemIndex : std::as_const(acceleratedItems)) {
+        Item &item = items[itemIndex];
+        const auto &model = static_cast<const QSSGRenderModel &>(*item.node);
+        model.instancePickAccelerationStructure = QSSGInstancePickAccelerationStructure::update(model.instancePickAccelerationStructure,
+                                                                                             model, item.modelBounds);
+        item.instances->accelerationStructure = model.instancePickAccelerationStructure;
+    }
+
+    // Everything but the non-instanced models is always tested
+    std::vector<quint32> treeItems;
+    snapshot->m_worldBounds.resize(items.size());
+    for (quint32 i = 0, end = quint32(items.size()); i != end; ++i) {
+        const Item &item = items[i];
+        if (!item.isItem2D && !item.instances) {
+            snapshot->m_worldBounds[i] = QSSGPickBVH::transformedBounds(item.modelBounds, item.globalTransform);
+            treeItems.push_back(i);
+        } else {
+            snapshot->m_unboundedItems.push_back(i);
+        }
+    }
+    snapshot->m_bvh.build(snapshot->m_worldBounds.data(), std::move(treeItems));
+
+    return snapshot;
+}
+
+void QSSGPickSnapshot::intersect(const Item &item, const QSSGRenderRay &ray, PickResultList &outResults) const
+{
+    if (item.isItem2D) {
+        QSSGRendererPrivate::intersectRayWithItem2D(ray, item.node, item.globalTransform, outResults);
+        return;
+    }
+
+    const Instances *instances = item.instances.get();
+    if (!instances) {
+        QSSGRendererPrivate::intersectRayWithMesh(ray, item.node, item.globalTransform, item.modelBounds, item.bvh.get(),
+                                                  item.subsetBounds.data(), qsizetype(item.subsetBounds.size()), 0,
+                                                  outResults);
+        return;
+    }
+
+    int instanceCount = instances->count;
+    QSSGInstancePickAccelerationStructure::CandidateList instanceCandidates;
+    bool useInstanceCandidates = false;
+    if (instances->accelerationStructure) {
+        useInstanceCandidates = instances->accelerationStructure->findCandidates(instances->globalInstanceTransform, ray, instanceCandidates);
+        if (useInstanceCandidates)
+            instanceCount = int(instanceCandidates.size());
+    }
+
+    for (int candidateIndex = 0; candidateIndex < instanceCount; ++candidateIndex) {
+        const int instanceIndex = useInstanceCandidates ? instanceCandidates.at(candidateIndex) : candidateIndex;
+        const QMatrix4x4 modelTransform = instances->globalInstanceTransform
+                * QSSGRenderInstanceTable::getTransform(instances->table, instances->stride, instanceIndex)
+                * instances->localInstanceTransform;
+        QSSGRendererPrivate::intersectRayWithMesh(ray, item.node, modelTransform, item.modelBounds, item.bvh.get(),
+                                                  item.subsetBounds.data(), qsizetype(item.subsetBounds.size()), instanceIndex,
+                                                  outResults);
+    }
+}
+
+QSSGPickSnapshot::PickResultList QSSGPickSnapshot::pick(const QSSGRenderRay &ray) const
+{
+    QSSGPickBVH::HitList hits(m_unboundedItems.cbegin(), m_unboundedItems.cend());
+    m_bvh.findHits(ray, m_worldBounds.data(), hits);
+
+    // Same order as QSSGRendererPrivate::getLayerHitObjectList(), the distance sort is stable
+    std::sort(hits.begin(), hits.end(), std::greater<quint32>());
+
+    PickResultList results;
+    for (const quint32 itemIndex : std::as_const(hits))
+        intersect(m_items[itemIndex], ray, results);
+
+    std::stable_sort(results.begin(), results.end(), [](const QSSGRenderPickResult &lhs, const QSSGRenderPickResult &rhs) {
+        return lhs.m_distanceSq < rhs.m_distanceSq;
+    });
+    return results;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,98 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QSSGPICKSNAPSHOT_P_H
+#define QSSGPICKSNAPSHOT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick3DRuntimeRender/private/qtquick3druntimerenderglobal_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderer_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgpickaccelerationstructure_p.h>
+#include <QtQuick3DUtils/private/qssgbounds3_p.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtGui/qmatrix4x4.h>
+
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+struct QSSGRenderLayer;
+struct QSSGRenderNode;
+struct QSSGRenderRay;
+class QSSGMeshBVH;
+class QSSGRenderContextInterface;
+
+// Copy of the pickable parts of a layer (transforms, mesh bounds and BVHs, instance tables)
+// taken on the thread that owns the scene. Once created it does not reference any scene data
+// and can be queried from any number of threads at the same time, which is what allows
+// batches of rays to be picked off the GUI thread.
+//
+// The nodes in the results are only meant to identify the picked objects, they must not be
+// dereferenced unless the caller knows the node is still alive (i.e. on the GUI thread).
+class Q_QUICK3DRUNTIMERENDER_EXPORT QSSGPickSnapshot
+{
+public:
+    using PickResultList = QSSGRendererPrivate::PickResultList;
+
+    // Must be called with the same restrictions as QSSGRendererPrivate::syncPickAll()
+    static std::shared_ptr<const QSSGPickSnapshot> create(const QSSGRenderContextInterface &ctx,
+                                                          const QSSGRenderLayer &layer);
+
+    // Same results as QSSGRendererPrivate::syncPickAll() at the time the snapshot was taken.
+    // Thread-safe.
+    [[nodiscard]] PickResultList pick(const QSSGRenderRay &ray) const;
+
+    [[nodiscard]] qsizetype itemCount() const { return qsizetype(m_items.size()); }
+    // The node of each item, only to be dereferenced while the scene is known to be unchanged
+    [[nodiscard]] const QSSGRenderNode *itemNode(qsizetype index) const { return m_items[index].node; }
+
+private:
+    QSSGPickSnapshot() = default;
+
+    struct Instances
+    {
+        QByteArray table;
+        int count = 0;
+        int stride = 0;
+        QMatrix4x4 globalInstanceTransform;
+        QMatrix4x4 localInstanceTransform;
+        std::shared_ptr<const QSSGInstancePickAccelerationStructure> accelerationStructure;
+    };
+
+    struct Item
+    {
+        // Only used to identify the item in the results, the node can be deleted while the
+        // snapshot is queried.
+        const QSSGRenderNode *node = nullptr;
+        bool isItem2D = false;
+        QMatrix4x4 globalTransform;
+        // Models only
+        QSSGBounds3 modelBounds;
+        std::vector<QSSGBounds3> subsetBounds;
+        std::shared_ptr<const QSSGMeshBVH> bvh;
+        std::unique_ptr<Instances> instances;
+    };
+
+    void intersect(const Item &item, const QSSGRenderRay &ray, PickResultList &outResults) const;
+
+    std::vector<Item> m_items; // Depth-first order
+    std::vector<QSSGBounds3> m_worldBounds; // Same indices as m_items
+    std::vector<quint32> m_unboundedItems; // Always tested
+    QSSGPickBVH m_bvh;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSSGPICKSNAPSHOT_P_H
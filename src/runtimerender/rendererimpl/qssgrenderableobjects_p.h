@@ -332,6 +332,7 @@ struct Q_QUICK3DRUNTIMERENDER_EXPORT QSSGSubsetRenderable : public QSSGRenderabl
     const QSSGModelContext &modelContext;
     const QSSGRenderSubset &subset;
     QRhiBuffer *instanceBuffer = nullptr;
+    int instanceCount = 0; // Number of instances in instanceBuffer, set together with the buffer
     float opacity;
     const QSSGRenderGraphObject &material;
     QSSGRenderableImage *firstImage;
@@ -21,6 +21,8 @@
 #include <QtQuick3DRuntimeRender/private/qssglayerrenderdata_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgrhiparticles_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgvertexpipelineimpl_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderoptimizations_p.h>
+#include "qssgpickaccelerationstructure_p.h"
 #include "../qssgshadermapkey_p.h"
 #include "../qssgrenderpickresult_p.h"
 
@@ -99,6 +101,12 @@ bool QSSGRenderer::prepareLayerForRender(QSSGRenderLayer &inLayer)
     QSSGLayerRenderData *theRenderData = getOrCreateLayerRenderData(inLayer);
     Q_ASSERT(theRenderData);
     beginLayerRender(*theRenderData);
+    if (theRenderData->canReusePreviousFrame()) {
+        // Nothing changed, the renderables of the previous frame are still valid
+        theRenderData->resetForReusedFrame();
+        endLayerRender();
+        return false;
+    }
     theRenderData->resetForFrame();
     theRenderData->prepareForRender();
     endLayerRender();
@@ -117,6 +125,7 @@ void QSSGRenderer::rhiPrepare(QSSGRenderLayer &inLayer)
         QSSGRhiContext *rhiCtx = contextInterface()->rhiContext().get();
         QSSG_ASSERT(rhiCtx->isValid() && rhiCtx->rhi()->isRecordingFrame(), return);
         theRenderData->maybeBakeLightmap();
+        theRenderData->maybeWarmupPipelines();
         beginLayerRender(*theRenderData);
         // Process active passes. "PreMain" passes are individual passes
         // that does can and should be done in the rhi prepare phase.
@@ -279,7 +288,11 @@ QSSGRhiShaderPipelinePtr QSSGRendererPrivate::generateRhiShaderPipeline(QSSGRend
     const auto &theCache = m_contextInterface->shaderCache();
     const auto &shaderProgramGenerator = m_contextInterface->shaderProgramGenerator();
     const auto &shaderLibraryManager = m_contextInterface->shaderLibraryManager();
-    return QSSGRendererPrivate::generateRhiShaderPipelineImpl(inRenderable, *shaderLibraryManager, *theCache, *shaderProgramGenerator, m_currentLayer->defaultMaterialShaderKeyProperties, inFeatureSet, m_generatedShaderString);
+    auto shaderPipeline = QSSGRendererPrivate::generateRhiShaderPipelineImpl(inRenderable, *shaderLibraryManager, *theCache, *shaderProgramGenerator, m_currentLayer->defaultMaterialShaderKeyProperties, inFeatureSet, m_generatedShaderString);
+    // Lets the pipelines created with these shaders be recorded for warmup
+    if (shaderPipeline && shaderPipeline->warmupKey().isEmpty())
+        shaderPipeline->setWarmupKey(m_generatedShaderString, inFeatureSet.flags);
+    return shaderPipeline;
 }
 
 void QSSGRenderer::beginFrame(QSSGRenderLayer &layer, bool allowRecursion)
@@ -288,7 +301,11 @@ void QSSGRenderer::beginFrame(QSSGRenderLayer &layer, bool allowRecursion)
     if (executeBeginFrame) {
         m_contextInterface->perFrameAllocator()->reset();
         QSSGRHICTX_STAT(m_contextInterface->rhiContext().get(), start(&layer));
-        resetResourceCounters(&layer);
+        // The buffers used by a reused frame are not looked up again, so they
+        // must keep the usage counts of the previous frame.
+        const QSSGLayerRenderData *layerData = layer.renderData;
+        if (!layerData || !layerData->canReusePreviousFrame())
+            resetResourceCounters(&layer);
     }
 }
 
@@ -318,6 +335,18 @@ bool QSSGRenderer::endFrame(QSSGRenderLayer &layer, bool allowRecursion)
     return executeEndFrame;
 }
 
+// Returns null when the acceleration structure is not used
+static QSSGPickAccelerationStructure *updatedPickAccelerationStructure(const QSSGRenderLayer &layer, QSSGBufferManager &bufferManager)
+{
+    if (!QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::PickingAcceleration))
+        return nullptr;
+
+    if (!layer.pickAccelerationStructure)
+        layer.pickAccelerationStructure = new QSSGPickAccelerationStructure;
+    layer.pickAccelerationStructure->update(layer, bufferManager);
+    return layer.pickAccelerationStructure;
+}
+
 QSSGRendererPrivate::PickResultList QSSGRendererPrivate::syncPickAll(const QSSGRenderContextInterface &ctx,
                                                                      const QSSGRenderLayer &layer,
                                                                      const QSSGRenderRay &ray)
@@ -363,8 +392,11 @@ QSSGRendererPrivate::PickResultList QSSGRendererPrivate::syncPickSubset(const QS
     QSSGRendererPrivate::PickResultList pickResults;
     Q_ASSERT(layer.getGlobalState(QSSGRenderNode::GlobalState::Active));
 
-    for (auto target : subset)
-        intersectRayWithSubsetRenderable(bufferManager, ray, *target, pickResults);
+    const QSSGPickAccelerationStructure *accelerationStructure = updatedPickAccelerationStructure(layer, bufferManager);
+    for (auto target : subset) {
+        if (!accelerationStructure || accelerationStructure->mayIntersect(*target, ray))
+            intersectRayWithSubsetRenderable(bufferManager, ray, *target, pickResults);
+    }
 
     std::stable_sort(pickResults.begin(), pickResults.end(), [](const QSSGRenderPickResult &lhs, const QSSGRenderPickResult &rhs) {
         return lhs.m_distanceSq < rhs.m_distanceSq;
@@ -424,6 +456,14 @@ void QSSGRendererPrivate::getLayerHitObjectList(const QSSGRenderLayer &layer,
                                                 bool inPickEverything,
                                                 PickResultList &outIntersectionResult)
 {
+    if (const auto *accelerationStructure = updatedPickAccelerationStructure(layer, bufferManager)) {
+        QSSGPickAccelerationStructure::CandidateList candidates;
+        accelerationStructure->findCandidates(ray, inPickEverything, candidates);
+        for (const QSSGRenderNode *candidate : std::as_const(candidates))
+            intersectRayWithSubsetRenderable(bufferManager, ray, *candidate, outIntersectionResult);
+        return;
+    }
+
     RenderableList renderables;
     for (const auto &childNode : layer.children)
         dfs(childNode, renderables);
@@ -470,10 +510,28 @@ void QSSGRendererPrivate::intersectRayWithSubsetRenderable(QSSGBufferManager &bu
     if (modelBounds.isEmpty())
         return;
 
+    QVarLengthArray<QSSGBounds3, 8> subsetBounds;
+    subsetBounds.reserve(subMeshes.size());
+    for (const auto &subMesh : subMeshes)
+        subsetBounds.push_back(subMesh.bounds);
+
     const bool instancing = model.instancing(); // && instancePickingEnabled
     int instanceCount = instancing ? model.instanceTable->count() : 1;
 
-    for (int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex) {
+    // With many instances only the ones whose bounds are hit by the ray are tested
+    QSSGInstancePickAccelerationStructure::CandidateList instanceCandidates;
+    bool useInstanceCandidates = false;
+    if (instancing && instanceCount >= QSSGInstancePickAccelerationStructure::MIN_INSTANCE_COUNT
+            && QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::PickingAcceleration)) {
+        model.instancePickAccelerationStructure = QSSGInstancePickAccelerationStructure::update(model.instancePickAccelerationStructure,
+                                                                                             model, modelBounds);
+        useInstanceCandidates = model.instancePickAccelerationStructure->findCandidates(model.globalInstanceTransform, inRay, instanceCandidates);
+        if (useInstanceCandidates)
+            instanceCount = int(instanceCandidates.size());
+    }
+
+    for (int candidateIndex = 0; candidateIndex < instanceCount; ++candidateIndex) {
+        const int instanceIndex = useInstanceCandidates ? instanceCandidates.at(candidateIndex) : candidateIndex;
 
         QMatrix4x4 modelTransform;
         if (instancing) {
@@ -481,67 +539,80 @@ void QSSGRendererPrivate::intersectRayWithSubsetRenderable(QSSGBufferManager &bu
         } else {
             modelTransform = model.globalTransform;
         }
-        auto rayData = QSSGRenderRay::createRayData(modelTransform, inRay);
-
-        auto hit = QSSGRenderRay::intersectWithAABBv2(rayData, modelBounds);
-
-        // If we don't intersect with the model at all, then there's no need to go furher down!
-        if (!hit.intersects())
-            continue;
-
-        // Check each submesh to find the closest intersection point
-        float minRayLength = std::numeric_limits<float>::max();
-        QSSGRenderRay::IntersectionResult intersectionResult;
-        QVector<QSSGRenderRay::IntersectionResult> results;
-
-        int subset = 0;
-        int resultSubset = 0;
-        for (const auto &subMesh : subMeshes) {
-            QSSGRenderRay::IntersectionResult result;
-            if (!subMesh.bvhRoot.isNull()) {
-                hit = QSSGRenderRay::intersectWithAABBv2(rayData, subMesh.bvhRoot->boundingData);
-                if (hit.intersects()) {
-                    results.clear();
-                    inRay.intersectWithBVH(rayData, static_cast<const QSSGMeshBVHNode *>(subMesh.bvhRoot), mesh, results);
-                    float subMeshMinRayLength = std::numeric_limits<float>::max();
-                    for (const auto &subMeshResult : std::as_const(results)) {
-                        if (subMeshResult.rayLengthSquared < subMeshMinRayLength) {
-                            result = subMeshResult;
-                            subMeshMinRayLength = result.rayLengthSquared;
-                        }
-                    }
-                }
-            } else {
-                hit = QSSGRenderRay::intersectWithAABBv2(rayData, subMesh.bounds);
-                if (hit.intersects())
-                    result = QSSGRenderRay::createIntersectionResult(rayData, hit);
-            }
-            if (result.intersects && result.rayLengthSquared < minRayLength) {
-                intersectionResult = result;
-                minRayLength = intersectionResult.rayLengthSquared;
-                resultSubset = subset;
-            }
-            subset++;
-        }
+        intersectRayWithMesh(inRay, &model, modelTransform, modelBounds, mesh->bvh.get(),
+                             subsetBounds.constData(), subsetBounds.size(), instanceIndex,
+                             outIntersectionResultList);
+    }
+}
+
+void QSSGRendererPrivate::intersectRayWithMesh(const QSSGRenderRay &inRay,
+                                               const QSSGRenderNode *node,
+                                               const QMatrix4x4 &modelTransform,
+                                               const QSSGBounds3 &modelBounds,
+                                               const QSSGMeshBVH *bvh,
+                                               const QSSGBounds3 *subsetBounds,
+                                               qsizetype subsetCount,
+                                               int instanceIndex,
+                                               PickResultList &outIntersectionResultList)
+{
+    auto rayData = QSSGRenderRay::createRayData(modelTransform, inRay);
+
+    auto hit = QSSGRenderRay::intersectWithAABBv2(rayData, modelBounds);
+
+    // If we don't intersect with the model at all, then there's no need to go furher down!
+    if (!hit.intersects())
+        return;
+
+    const bool packed = bvh && bvh->isPacked();
 
-        if (intersectionResult.intersects)
-            outIntersectionResultList.push_back(QSSGRenderPickResult { &model,
-                                                                       intersectionResult.rayLengthSquared,
-                                                                       intersectionResult.relXY,
-                                                                       intersectionResult.scenePosition,
-                                                                       intersectionResult.localPosition,
-                                                                       intersectionResult.faceNormal,
-                                                                       resultSubset,
-                                                                       instanceIndex
-                                                });
+    // Check each submesh to find the closest intersection point
+    float minRayLength = std::numeric_limits<float>::max();
+    QSSGRenderRay::IntersectionResult intersectionResult;
+
+    int resultSubset = 0;
+    for (qsizetype subset = 0; subset < subsetCount; ++subset) {
+        QSSGRenderRay::IntersectionResult result;
+        if (packed && size_t(subset) < bvh->packedRoots().size()) {
+            result = QSSGRenderRay::intersectWithPackedBVHClosest(rayData, *bvh, bvh->packedRoots()[subset]);
+        } else if (bvh && size_t(subset) < bvh->roots().size() && !bvh->roots()[subset].isNull()) {
+            result = QSSGRenderRay::intersectWithBVHClosest(rayData, static_cast<const QSSGMeshBVHNode *>(bvh->roots()[subset]), *bvh);
+        } else {
+            hit = QSSGRenderRay::intersectWithAABBv2(rayData, subsetBounds[subset]);
+            if (hit.intersects())
+                result = QSSGRenderRay::createIntersectionResult(rayData, hit);
+        }
+        if (result.intersects && result.rayLengthSquared < minRayLength) {
+            intersectionResult = result;
+            minRayLength = intersectionResult.rayLengthSquared;
+            resultSubset = int(subset);
+        }
     }
+
+    if (intersectionResult.intersects)
+        outIntersectionResultList.push_back(QSSGRenderPickResult { node,
+                                                                   intersectionResult.rayLengthSquared,
+                                                                   intersectionResult.relXY,
+                                                                   intersectionResult.scenePosition,
+                                                                   intersectionResult.localPosition,
+                                                                   intersectionResult.faceNormal,
+                                                                   resultSubset,
+                                                                   instanceIndex
+                                            });
 }
 
 void QSSGRendererPrivate::intersectRayWithItem2D(const QSSGRenderRay &inRay, const QSSGRenderItem2D &item2D, PickResultList &outIntersectionResultList)
+{
+    intersectRayWithItem2D(inRay, &item2D, item2D.globalTransform, outIntersectionResultList);
+}
+
+void QSSGRendererPrivate::intersectRayWithItem2D(const QSSGRenderRay &inRay,
+                                                 const QSSGRenderNode *item2D,
+                                                 const QMatrix4x4 &globalTransform,
+                                                 PickResultList &outIntersectionResultList)
 {
     // Get the plane (and normal) that the item 2D is on
-    const QVector3D p0 = item2D.getGlobalPos();
-    const QVector3D normal  = -item2D.getDirection();
+    const QVector3D p0 = globalTransform.column(3).toVector3D();
+    const QVector3D normal  = -globalTransform.column(2).toVector3D().normalized();
 
     const float d = QVector3D::dotProduct(inRay.direction, normal);
     float intersectionTime = 0;
@@ -551,10 +622,10 @@ void QSSGRendererPrivate::intersectRayWithItem2D(const QSSGRenderRay &inRay, con
         if (intersectionTime >= 0) {
             // Intersection
             const QVector3D intersectionPoint = inRay.origin + inRay.direction * intersectionTime;
-            const QMatrix4x4 inverseGlobalTransform = item2D.globalTransform.inverted();
+            const QMatrix4x4 inverseGlobalTransform = globalTransform.inverted();
             const QVector3D localIntersectionPoint = QSSGUtils::mat44::transform(inverseGlobalTransform, intersectionPoint);
             const QVector2D qmlCoordinate(localIntersectionPoint.x(), -localIntersectionPoint.y());
-            outIntersectionResultList.push_back(QSSGRenderPickResult { &item2D,
+            outIntersectionResultList.push_back(QSSGRenderPickResult { item2D,
                                                                        intersectionTime * intersectionTime,
                                                                        qmlCoordinate,
                                                                        intersectionPoint,
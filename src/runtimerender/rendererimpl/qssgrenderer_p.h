@@ -30,6 +30,8 @@ class QSSGLayerRenderData;
 class QSSGRenderContextInterface;
 struct QSSGRenderNode;
 struct QSSGRenderItem2D;
+class QSSGBounds3;
+class QSSGMeshBVH;
 struct QSSGRenderRay;
 struct QSSGSubsetRenderable;
 struct QSSGShaderDefaultMaterialKeyProperties;
@@ -149,6 +151,22 @@ public:
     static void intersectRayWithItem2D(const QSSGRenderRay &inRay,
                                        const QSSGRenderItem2D &item2D,
                                        PickResultList &outIntersectionResultList);
+    // The parts of the tests above that only depend on data that can be copied out of the
+    // scene, shared with the pick snapshots. The node is never dereferenced, it is only
+    // stored in the results.
+    static void intersectRayWithMesh(const QSSGRenderRay &inRay,
+                                     const QSSGRenderNode *node,
+                                     const QMatrix4x4 &modelTransform,
+                                     const QSSGBounds3 &modelBounds,
+                                     const QSSGMeshBVH *bvh,
+                                     const QSSGBounds3 *subsetBounds,
+                                     qsizetype subsetCount,
+                                     int instanceIndex,
+                                     PickResultList &outIntersectionResultList);
+    static void intersectRayWithItem2D(const QSSGRenderRay &inRay,
+                                       const QSSGRenderNode *item2D,
+                                       const QMatrix4x4 &globalTransform,
+                                       PickResultList &outIntersectionResultList);
 
     static PickResultList syncPickAll(const QSSGRenderContextInterface &ctx,
                                       const QSSGRenderLayer &layer,
@@ -12,8 +12,11 @@
 #include "../qssgrhicustommaterialsystem_p.h"
 #include "../resourcemanager/qssgrenderbuffermanager_p.h"
 #include "../qssgrenderdefaultmaterialshadergenerator_p.h"
+#include "../qssgrenderoptimizations_p.h"
 #include "rendererimpl/qssgshadowmaphelpers_p.h"
 #include <QtQuick3DUtils/private/qssgassert_p.h>
+#include <QtQuick3DUtils/private/qssgutils_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrendertexturedata_p.h>
 
 #include <QtCore/qbitarray.h>
 
@@ -561,10 +564,10 @@ static void setupCubeShadowCameras(const QSSGRenderLight *inLight, float shadowM
     */
 }
 
-static int setupInstancing(QSSGSubsetRenderable *renderable, QSSGRhiGraphicsPipelineState *ps, QSSGRhiContext *rhiCtx, const QVector3D &cameraDirection, const QVector3D &cameraPosition)
+static int setupInstancing(QSSGSubsetRenderable *renderable, QSSGRhiGraphicsPipelineState *ps, QSSGRhiContext *rhiCtx, const QVector3D &cameraDirection, const QVector3D &cameraPosition, const QSSGRenderCameraData *cullingCamera = nullptr)
 {
     // TODO: non-static so it can be used from QSSGCustomMaterialSystem::rhiPrepareRenderable()?
-    const bool instancing = QSSGLayerRenderData::prepareInstancing(rhiCtx, renderable, cameraDirection, cameraPosition, renderable->instancingLodMin, renderable->instancingLodMax);
+    const bool instancing = QSSGLayerRenderData::prepareInstancing(rhiCtx, renderable, cameraDirection, cameraPosition, renderable->instancingLodMin, renderable->instancingLodMax, cullingCamera);
     int instanceBufferBinding = 0;
     if (instancing) {
         auto &ia = QSSGRhiInputAssemblerStatePrivate::get(*ps);
@@ -992,7 +995,8 @@ void RenderHelpers::rhiPrepareRenderable(QSSGRhiContext *rhiCtx,
             QVector3D cameraPosition = cameraDatas[0].position;
             if (alteredCamera)
                 cameraPosition = alteredCamera->getGlobalPos();
-            int instanceBufferBinding = setupInstancing(&subsetRenderable, ps, rhiCtx, cameraDirection, cameraPosition);
+            const QSSGRenderCameraData *cullingCamera = alteredCamera ? nullptr : inData.instanceCullingCamera(subsetRenderable);
+            int instanceBufferBinding = setupInstancing(&subsetRenderable, ps, rhiCtx, cameraDirection, cameraPosition, cullingCamera);
             QSSGRhiHelpers::bakeVertexInputLocations(&ia, *shaderPipeline, instanceBufferBinding);
 
             bindings.addUniformBuffer(0, RENDERER_VISIBILITY_ALL, dcd.ubuf, 0, shaderPipeline->ub0Size());
@@ -1246,6 +1250,8 @@ void RenderHelpers::rhiRenderRenderable(QSSGRhiContext *rhiCtx,
         // QRhi optimizes out unnecessary binding of the same pipline
         cb->setGraphicsPipeline(ps);
         cb->setShaderResources(srb);
+        QSSGRHICTX_STAT(rhiCtx, setGraphicsPipeline(ps));
+        QSSGRHICTX_STAT(rhiCtx, setShaderResources(srb));
 
         if (*needsSetViewport) {
             cb->setViewport(state.viewport);
@@ -1259,11 +1265,12 @@ void RenderHelpers::rhiRenderRenderable(QSSGRhiContext *rhiCtx,
         vertexBuffers[0] = QRhiCommandBuffer::VertexInput(vertexBuffer, 0);
         quint32 instances = 1;
         if ( subsetRenderable.modelContext.model.instancing()) {
-            instances = subsetRenderable.modelContext.model.instanceCount();
+            instances = subsetRenderable.instanceCount;
             // If the instance count is 0, the bail out before trying to do any
             // draw calls. Making an instanced draw call with a count of 0 is invalid
             // for Metal and likely other API's as well.
-            // It is possible that the particale system may produce 0 instances here
+            // It is possible that the particale system may produce 0 instances here,
+            // or that all instances were culled
             if (instances == 0)
                 return;
             vertexBuffers[1] = QRhiCommandBuffer::VertexInput(subsetRenderable.instanceBuffer, 0);
@@ -1274,8 +1281,8 @@ void RenderHelpers::rhiRenderRenderable(QSSGRhiContext *rhiCtx,
             cb->setStencilRef(state.stencilRef);
         if (indexBuffer) {
             cb->setVertexInput(0, vertexBufferCount, vertexBuffers, indexBuffer, 0, subsetRenderable.subset.rhi.indexBuffer->indexFormat());
-            cb->drawIndexed(subsetRenderable.subset.lodCount(subsetRenderable.subsetLevelOfDetail), instances, subsetRenderable.subset.lodOffset(subsetRenderable.subsetLevelOfDetail));
-            QSSGRHICTX_STAT(rhiCtx, drawIndexed(subsetRenderable.subset.lodCount(subsetRenderable.subsetLevelOfDetail), instances));
+            cb->drawIndexed(subsetRenderable.subset.residentLodCount(subsetRenderable.subsetLevelOfDetail), instances, subsetRenderable.subset.residentLodOffset(subsetRenderable.subsetLevelOfDetail));
+            QSSGRHICTX_STAT(rhiCtx, drawIndexed(subsetRenderable.subset.residentLodCount(subsetRenderable.subsetLevelOfDetail), instances));
         } else {
             cb->setVertexInput(0, vertexBufferCount, vertexBuffers);
             cb->draw(subsetRenderable.subset.count, instances, subsetRenderable.subset.offset);
@@ -1302,6 +1309,109 @@ void RenderHelpers::rhiRenderRenderable(QSSGRhiContext *rhiCtx,
     }
 }
 
+// Keeps the casters whose bounds intersect with the shadow camera's view volume, anything
+// outside of it would be clipped away anyway. Instanced, skinned and morphed models are always
+// kept since their global bounds do not cover the geometry that actually gets rendered.
+// Returns the number of casters that were culled.
+static qsizetype cullShadowCasters(const QSSGRenderCamera &shadowCamera,
+                                   const QMatrix4x4 &viewProjection,
+                                   const QSSGRenderableObjectList &casters,
+                                   QSSGRenderableObjectList &visibleCasters)
+{
+    QSSGClipPlane nearPlane;
+    const QMatrix3x3 theUpper33(shadowCamera.globalTransform.normalMatrix());
+    const QVector3D dir = QSSGUtils::mat33::transform(theUpper33, QVector3D(0, 0, -1)).normalized();
+    nearPlane.normal = dir;
+    const QVector3D theGlobalPos = shadowCamera.getGlobalPos() + shadowCamera.clipNear * dir;
+    nearPlane.d = -(QVector3D::dotProduct(dir, theGlobalPos));
+    const QSSGClippingFrustum clipFrustum(viewProjection, nearPlane);
+
+    visibleCasters.clear();
+    visibleCasters.reserve(casters.size());
+    for (const auto &handle : casters) {
+        const QSSGRenderableObject *obj = handle.obj;
+        bool alwaysVisible = false;
+        if (obj->type == QSSGRenderableObject::Type::DefaultMaterialMeshSubset || obj->type == QSSGRenderableObject::Type::CustomMaterialMeshSubset) {
+            const QSSGRenderModel &model = static_cast<const QSSGSubsetRenderable *>(obj)->modelContext.model;
+            alwaysVisible = model.instancing() || model.usesBoneTexture() || !model.morphTargets.isEmpty();
+        }
+        if (alwaysVisible || clipFrustum.intersectsWith(obj->globalBounds))
+            visibleCasters.push_back(handle);
+    }
+
+    return casters.size() - visibleCasters.size();
+}
+
+// The material state that decides which fragments of a caster end up in the shadow map. Only the
+// opaque pre-pass mode runs the material's alpha test (alpha cutoff, color and opacity maps) in the
+// depth shaders. Returns 0 when the depth output can change without the renderer noticing: a custom
+// material's shader code, or images whose content is provided from elsewhere.
+static size_t shadowCasterMaterialKey(const QSSGSubsetRenderable &renderable)
+{
+    if (renderable.type == QSSGRenderableObject::Type::CustomMaterialMeshSubset) {
+        const auto &material = static_cast<const QSSGRenderCustomMaterial &>(renderable.material);
+        if (material.m_customShaderPresence.testFlag(QSSGRenderCustomMaterial::CustomShaderPresenceFlag::Vertex)
+                || renderable.depthWriteMode == QSSGDepthDrawMode::OpaquePrePass) {
+            return 0;
+        }
+        return qHash(int(material.m_cullMode)) | 1;
+    }
+
+    const auto &material = static_cast<const QSSGRenderDefaultMaterial &>(renderable.material);
+    size_t key = qHash(int(material.cullMode));
+    if (renderable.depthWriteMode != QSSGDepthDrawMode::OpaquePrePass)
+        return key | 1;
+
+    key = qHashMulti(key, material.alphaCutoff, material.color.w(), renderable.opacity);
+    for (const QSSGRenderableImage *image = renderable.firstImage; image; image = image->m_nextImage) {
+        const QSSGRenderImage &imageNode = image->m_imageNode;
+        if (imageNode.m_qsgTexture || imageNode.m_extensionsSource)
+            return 0;
+        // The texture changes when an asynchronous image replaces its placeholder
+        key = qHashMulti(key, int(image->m_mapType), imageNode.m_imagePath, image->m_texture.m_texture,
+                         qHashBits(imageNode.m_textureTransform.constData(), 16 * sizeof(float)));
+        if (imageNode.m_rawTextureData)
+            key = qHashMulti(key, imageNode.m_rawTextureData, imageNode.m_rawTextureData->version());
+    }
+    return key | 1;
+}
+
+// Identifies what a cascade or cube face renders: the shadow camera and the casters that ended up
+// in its view. When it is equal to the key of the previous frame, the shadow map can be kept as-is.
+// The casters are sorted for the main camera, so their keys are combined independently of the order.
+// Returns 0 when one of the casters can change shape without its transform changing (skinning,
+// morphing, instancing, particles, see also shadowCasterMaterialKey()), such shadow maps are
+// rendered every frame. Meshes are identified by their generation, as the address of a released
+// buffer can be reused by the next one.
+static size_t shadowMapContentKey(const QMatrix4x4 &viewProjection, float shadowMapFar, const QSSGRenderableObjectList &casters)
+{
+    size_t casterKeys = 0;
+    for (const auto &handle : casters) {
+        const QSSGRenderableObject *obj = handle.obj;
+        if (obj->type != QSSGRenderableObject::Type::DefaultMaterialMeshSubset && obj->type != QSSGRenderableObject::Type::CustomMaterialMeshSubset)
+            continue; // not rendered in the shadow pass
+        const QSSGSubsetRenderable *renderable = static_cast<const QSSGSubsetRenderable *>(obj);
+        const QSSGRenderModel &model = renderable->modelContext.model;
+        if (model.instancing() || model.usesBoneTexture() || !model.morphTargets.isEmpty() || model.particleBuffer)
+            return 0;
+        const size_t materialKey = shadowCasterMaterialKey(*renderable);
+        if (!materialKey)
+            return 0;
+        const size_t casterKey = qHashMulti(qHashBits(renderable->globalTransform.constData(), 16 * sizeof(float)),
+                                            &model,
+                                            materialKey,
+                                            renderable->subset.generation,
+                                            renderable->subset.offset,
+                                            renderable->subset.count,
+                                            renderable->subsetLevelOfDetail,
+                                            renderable->shaderDescription.hash());
+        casterKeys += casterKey;
+    }
+
+    const size_t key = qHashMulti(qHashBits(viewProjection.constData(), 16 * sizeof(float)), shadowMapFar, casters.size(), casterKeys);
+    return key ? key : 1;
+}
+
 void RenderHelpers::rhiRenderShadowMap(QSSGRhiContext *rhiCtx,
                                        QSSGPassKey passKey,
                                        QSSGRhiGraphicsPipelineState &ps,
@@ -1338,12 +1448,18 @@ void RenderHelpers::rhiRenderShadowMap(QSSGRhiContext *rhiCtx,
                 if (!renderable->rhiRenderData.shadowPass.pipeline)
                     continue;
 
+                // All instances culled, nothing to draw
+                if (renderable->modelContext.model.instancing() && renderable->instanceCount == 0)
+                    continue;
+
                 Q_QUICK3D_PROFILE_START(QQuick3DProfiler::Quick3DRenderCall);
 
                 cb->setGraphicsPipeline(renderable->rhiRenderData.shadowPass.pipeline);
 
                 QRhiShaderResourceBindings *srb = renderable->rhiRenderData.shadowPass.srb[cubeFace];
                 cb->setShaderResources(srb);
+                QSSGRHICTX_STAT(rhiCtx, setGraphicsPipeline(renderable->rhiRenderData.shadowPass.pipeline));
+                QSSGRHICTX_STAT(rhiCtx, setShaderResources(srb));
 
                 if (needsSetViewport) {
                     cb->setViewport(ps->viewport);
@@ -1355,14 +1471,14 @@ void RenderHelpers::rhiRenderShadowMap(QSSGRhiContext *rhiCtx,
                 vertexBuffers[0] = QRhiCommandBuffer::VertexInput(vertexBuffer, 0);
                 quint32 instances = 1;
                 if (renderable->modelContext.model.instancing()) {
-                    instances = renderable->modelContext.model.instanceCount();
+                    instances = renderable->instanceCount;
                     vertexBuffers[1] = QRhiCommandBuffer::VertexInput(renderable->instanceBuffer, 0);
                     vertexBufferCount = 2;
                 }
                 if (indexBuffer) {
                     cb->setVertexInput(0, vertexBufferCount, vertexBuffers, indexBuffer, 0, renderable->subset.rhi.indexBuffer->indexFormat());
-                    cb->drawIndexed(renderable->subset.count, instances, renderable->subset.offset);
-                    QSSGRHICTX_STAT(rhiCtx, drawIndexed(renderable->subset.count, instances));
+                    cb->drawIndexed(renderable->subset.residentLodCount(), instances, renderable->subset.residentLodOffset());
+                    QSSGRHICTX_STAT(rhiCtx, drawIndexed(renderable->subset.residentLodCount(), instances));
                 } else {
                     cb->setVertexInput(0, vertexBufferCount, vertexBuffers);
                     cb->draw(renderable->subset.count, instances, renderable->subset.offset);
@@ -1404,6 +1520,11 @@ void RenderHelpers::rhiRenderShadowMap(QSSGRhiContext *rhiCtx,
     if (drawShadowReceivingBounds)
         ShadowmapHelpers::addDebugBox(receivingObjectsBox.toQSSGBoxPointsNoEmptyCheck(), QColorConstants::Green, debugDrawSystem);
 
+    // Casters culled against each cascade or cube face, reused for all lights
+    QSSGRenderableObjectList visibleCasters[6];
+    qsizetype culledCasterCounts[6] = {};
+    const bool cachingEnabled = QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::ShadowMapCaching);
+
     // Create shadow map for each light in the scene
     for (int i = 0, ie = globalLights.size(); i != ie; ++i) {
         if (!globalLights[i].shadows || globalLights[i].light->m_fullyBaked)
@@ -1485,16 +1606,29 @@ void RenderHelpers::rhiRenderShadowMap(QSSGRhiContext *rhiCtx,
                 cascadeCamera->calculateViewProjectionMatrix(pEntry->m_lightViewProjection[cascadeIndex]);
                 pEntry->m_lightView = cascadeCamera->globalTransform.inverted(); // pre-calculate this for the material
                 const bool isOrtho = cascadeCamera->type == QSSGRenderGraphObject::Type::OrthographicCamera;
-                rhiPrepareResourcesForShadowMap(rhiCtx, layerData, passKey, pEntry, &ps, &depthAdjust, sortedOpaqueObjects, *cascadeCamera, isOrtho, QSSGRenderTextureCubeFaceNone, cascadeIndex);
-                // Render into the 2D texture pEntry->m_rhiDepthMap, using
-                // pEntry->m_rhiDepthStencil as the (throwaway) depth/stencil buffer.
-                QRhiTextureRenderTarget *rt = pEntry->m_rhiRenderTargets[cascadeIndex];
-                cb->beginPass(rt, Qt::white, { 1.0f, 0 }, nullptr, rhiCtx->commonPassFlags());
-                Q_QUICK3D_PROFILE_START(QQuick3DProfiler::Quick3DRenderPass);
-                QSSGRHICTX_STAT(rhiCtx, beginRenderPass(rt));
-                rhiRenderOneShadowMap(rhiCtx, &ps, sortedOpaqueObjects, 0);
-                cb->endPass();
-                QSSGRHICTX_STAT(rhiCtx, endRenderPass());
+                const qsizetype culledCasterCount = cullShadowCasters(*cascadeCamera,
+                                                                      pEntry->m_lightViewProjection[cascadeIndex],
+                                                                      sortedOpaqueObjects,
+                                                                      visibleCasters[0]);
+                bool needsRender = true;
+                if (cachingEnabled) {
+                    const size_t contentKey = shadowMapContentKey(pEntry->m_lightViewProjection[cascadeIndex], pEntry->m_shadowMapFar, visibleCasters[0]);
+                    needsRender = contentKey == 0 || contentKey != pEntry->m_contentKeys[cascadeIndex];
+                    pEntry->m_contentKeys[cascadeIndex] = contentKey;
+                }
+                if (needsRender) {
+                    rhiPrepareResourcesForShadowMap(rhiCtx, layerData, passKey, pEntry, &ps, &depthAdjust, visibleCasters[0], *cascadeCamera, isOrtho, QSSGRenderTextureCubeFaceNone, cascadeIndex);
+                    // Render into the 2D texture pEntry->m_rhiDepthMap, using
+                    // pEntry->m_rhiDepthStencil as the (throwaway) depth/stencil buffer.
+                    QRhiTextureRenderTarget *rt = pEntry->m_rhiRenderTargets[cascadeIndex];
+                    cb->beginPass(rt, Qt::white, { 1.0f, 0 }, nullptr, rhiCtx->commonPassFlags());
+                    Q_QUICK3D_PROFILE_START(QQuick3DProfiler::Quick3DRenderPass);
+                    QSSGRHICTX_STAT(rhiCtx, beginRenderPass(rt));
+                    QSSGRHICTX_STAT(rhiCtx, culledObjects(culledCasterCount));
+                    rhiRenderOneShadowMap(rhiCtx, &ps, visibleCasters[0], 0);
+                    cb->endPass();
+                    QSSGRHICTX_STAT(rhiCtx, endRenderPass());
+                }
 
                 if (drawDirectionalLightShadowBoxes)
                     ShadowmapHelpers::addDirectionalLightDebugBox(computeFrustumBounds(*cascadeCamera), debugDrawSystem);
@@ -1517,9 +1651,21 @@ void RenderHelpers::rhiRenderShadowMap(QSSGRhiContext *rhiCtx,
             pEntry->m_shadowMapFar = shadowMapFar;
 
             const bool swapYFaces = !rhi->isYUpInFramebuffer();
+            bool faceNeedsRender[6] = { true, true, true, true, true, true };
             for (const auto face : QSSGRenderTextureCubeFaces) {
                 theCameras[quint8(face)].calculateViewProjectionMatrix(pEntry->m_lightViewProjection[0]);
                 pEntry->m_lightCubeView[quint8(face)] = theCameras[quint8(face)].globalTransform.inverted(); // pre-calculate this for the material
+                culledCasterCounts[quint8(face)] = cullShadowCasters(theCameras[quint8(face)],
+                                                                     pEntry->m_lightViewProjection[0],
+                                                                     sortedOpaqueObjects,
+                                                                     visibleCasters[quint8(face)]);
+                if (cachingEnabled) {
+                    const size_t contentKey = shadowMapContentKey(pEntry->m_lightViewProjection[0], shadowMapFar, visibleCasters[quint8(face)]);
+                    faceNeedsRender[quint8(face)] = contentKey == 0 || contentKey != pEntry->m_contentKeys[quint8(face)];
+                    pEntry->m_contentKeys[quint8(face)] = contentKey;
+                    if (!faceNeedsRender[quint8(face)])
+                        continue;
+                }
 
                 rhiPrepareResourcesForShadowMap(rhiCtx,
                                                 layerData,
@@ -1527,7 +1673,7 @@ void RenderHelpers::rhiRenderShadowMap(QSSGRhiContext *rhiCtx,
                                                 pEntry,
                                                 &ps,
                                                 &depthAdjust,
-                                                sortedOpaqueObjects,
+                                                visibleCasters[quint8(face)],
                                                 theCameras[quint8(face)],
                                                 false,
                                                 face,
@@ -1535,6 +1681,9 @@ void RenderHelpers::rhiRenderShadowMap(QSSGRhiContext *rhiCtx,
             }
 
             for (const auto face : QSSGRenderTextureCubeFaces) {
+                if (!faceNeedsRender[quint8(face)])
+                    continue;
+
                 // Render into one face of the cubemap texture pEntry->m_rhiDephCube, using
                 // pEntry->m_rhiDepthStencil as the (throwaway) depth/stencil buffer.
 
@@ -1564,8 +1713,9 @@ void RenderHelpers::rhiRenderShadowMap(QSSGRhiContext *rhiCtx,
                 QRhiTextureRenderTarget *rt = pEntry->m_rhiRenderTargets[quint8(outFace)];
                 cb->beginPass(rt, Qt::white, { 1.0f, 0 }, nullptr, rhiCtx->commonPassFlags());
                 QSSGRHICTX_STAT(rhiCtx, beginRenderPass(rt));
+                QSSGRHICTX_STAT(rhiCtx, culledObjects(culledCasterCounts[quint8(face)]));
                 Q_QUICK3D_PROFILE_START(QQuick3DProfiler::Quick3DRenderPass);
-                rhiRenderOneShadowMap(rhiCtx, &ps, sortedOpaqueObjects, quint8(face));
+                rhiRenderOneShadowMap(rhiCtx, &ps, visibleCasters[quint8(face)], quint8(face));
                 cb->endPass();
                 QSSGRHICTX_STAT(rhiCtx, endRenderPass());
                 Q_QUICK3D_PROFILE_END_WITH_STRING(QQuick3DProfiler::Quick3DRenderPass, 0, QSSG_RENDERPASS_NAME("shadow_cube", 0, outFace));
@@ -2145,7 +2295,8 @@ bool RenderHelpers::rhiPrepareDepthPass(QSSGRhiContext *rhiCtx,
             ia = subsetRenderable.subset.rhi.ia;
 
             const QSSGRenderCameraDataList &cameraDatas(*inData.renderedCameraData);
-            int instanceBufferBinding = setupInstancing(&subsetRenderable, ps, rhiCtx, cameraDatas[0].direction, cameraDatas[0].position);
+            const QSSGRenderCameraData *cullingCamera = inData.instanceCullingCamera(subsetRenderable);
+            int instanceBufferBinding = setupInstancing(&subsetRenderable, ps, rhiCtx, cameraDatas[0].direction, cameraDatas[0].position, cullingCamera);
             QSSGRhiHelpers::bakeVertexInputLocations(&ia, *shaderPipeline, instanceBufferBinding);
 
             QSSGRhiShaderResourceBindingList bindings;
@@ -2266,9 +2417,15 @@ void RenderHelpers::rhiRenderDepthPass(QSSGRhiContext *rhiCtx,
                 if (!srb)
                     return;
 
+                // All instances culled, nothing to draw
+                if (subsetRenderable->modelContext.model.instancing() && subsetRenderable->instanceCount == 0)
+                    return;
+
                 Q_QUICK3D_PROFILE_START(QQuick3DProfiler::Quick3DRenderCall);
                 cb->setGraphicsPipeline(ps);
                 cb->setShaderResources(srb);
+                QSSGRHICTX_STAT(rhiCtx, setGraphicsPipeline(ps));
+                QSSGRHICTX_STAT(rhiCtx, setShaderResources(srb));
 
                 if (*needsSetViewport) {
                     cb->setViewport(pipelineState.viewport);
@@ -2280,15 +2437,15 @@ void RenderHelpers::rhiRenderDepthPass(QSSGRhiContext *rhiCtx,
                 vertexBuffers[0] = QRhiCommandBuffer::VertexInput(vertexBuffer, 0);
                 quint32 instances = 1;
                 if (subsetRenderable->modelContext.model.instancing()) {
-                    instances = subsetRenderable->modelContext.model.instanceCount();
+                    instances = subsetRenderable->instanceCount;
                     vertexBuffers[1] = QRhiCommandBuffer::VertexInput(subsetRenderable->instanceBuffer, 0);
                     vertexBufferCount = 2;
                 }
 
                 if (indexBuffer) {
                     cb->setVertexInput(0, vertexBufferCount, vertexBuffers, indexBuffer, 0, subsetRenderable->subset.rhi.indexBuffer->indexFormat());
-                    cb->drawIndexed(subsetRenderable->subset.count, instances, subsetRenderable->subset.offset);
-                    QSSGRHICTX_STAT(rhiCtx, drawIndexed(subsetRenderable->subset.count, instances));
+                    cb->drawIndexed(subsetRenderable->subset.residentLodCount(), instances, subsetRenderable->subset.residentLodOffset());
+                    QSSGRHICTX_STAT(rhiCtx, drawIndexed(subsetRenderable->subset.residentLodCount(), instances));
                 } else {
                     cb->setVertexInput(0, vertexBufferCount, vertexBuffers);
                     cb->draw(subsetRenderable->subset.count, instances, subsetRenderable->subset.offset);
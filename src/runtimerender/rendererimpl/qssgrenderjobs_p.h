@@ -0,0 +1,75 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QSSGRENDERJOBS_P_H
+#define QSSGRENDERJOBS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick3DRuntimeRender/private/qtquick3druntimerenderglobal_p.h>
+
+#include <QtCore/QThreadPool>
+#include <QtCore/QSemaphore>
+
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+namespace QSSGRenderJobs
+{
+
+// Number of threads that can take part in a parallel job, including the calling thread.
+[[nodiscard]] inline int maxThreadCount()
+{
+    return qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+}
+
+// Runs func(index) for every index in [0, count). The calling thread takes part in the
+// work, the remaining jobs are picked up by the global thread pool. Jobs are handed out
+// through a shared counter, so idle threads keep pulling work until everything is done.
+// NOTE: Returns when all jobs have finished.
+template <typename Func>
+void parallelFor(qsizetype count, Func &&func)
+{
+    if (count <= 0)
+        return;
+
+    const int helperCount = int(qMin<qsizetype>(count, maxThreadCount())) - 1;
+    if (helperCount <= 0) {
+        for (qsizetype i = 0; i != count; ++i)
+            func(i);
+        return;
+    }
+
+    std::atomic<qsizetype> next { 0 };
+    QSemaphore done;
+    const auto worker = [&next, &func, count]() {
+        for (qsizetype i = next.fetch_add(1, std::memory_order_relaxed); i < count; i = next.fetch_add(1, std::memory_order_relaxed))
+            func(i);
+    };
+
+    for (int i = 0; i != helperCount; ++i) {
+        QThreadPool::globalInstance()->start([&worker, &done]() {
+            worker();
+            done.release();
+        });
+    }
+
+    worker();
+    done.acquire(helperCount);
+}
+
+} // namespace QSSGRenderJobs
+
+QT_END_NAMESPACE
+
+#endif // QSSGRENDERJOBS_P_H
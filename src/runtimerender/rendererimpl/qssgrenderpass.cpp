@@ -8,6 +8,7 @@
 #include "qssgdebugdrawsystem_p.h"
 #include "extensionapi/qssgrenderextensions.h"
 #include "qssgrenderhelpers_p.h"
+#include "../qssgrenderoptimizations_p.h"
 
 #include "../utils/qssgassert_p.h"
 
@@ -702,6 +703,10 @@ void OpaquePass::renderPrep(QSSGRenderer &renderer, QSSGLayerRenderData &data)
 
     QRhiRenderPassDescriptor *mainRpDesc = rhiCtx->mainRenderPassDescriptor();
     prep(*ctx, data, this, ps, shaderFeatures, mainRpDesc, sortedOpaqueObjects);
+
+    // The pipelines and shader resources are known now
+    if (QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::OpaqueStateSort))
+        QSSGLayerRenderData::sortOpaqueByState(sortedOpaqueObjects);
 }
 
 void OpaquePass::renderPass(QSSGRenderer &renderer)
@@ -0,0 +1,133 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QSSGRENDERSORT_P_H
+#define QSSGRENDERSORT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick3DRuntimeRender/private/qtquick3druntimerenderglobal_p.h>
+
+#include <QtCore/qlist.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace QSSGRenderSort
+{
+
+// Below this size std::sort is usually faster than going through all the radix passes.
+constexpr qsizetype RADIX_SORT_MIN_COUNT = 256;
+
+// Maps a float to an unsigned integer with the same ordering, so that it can be used as a radix sort key.
+[[nodiscard]] inline quint32 floatToSortableKey(float f) noexcept
+{
+    quint32 u;
+    std::memcpy(&u, &f, sizeof(u));
+    // Negative values: flip all bits, positive values: flip the sign bit.
+    return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+}
+
+// Stable LSD radix sort (4 passes of 8 bits) in ascending order of key(item). 'scratch' needs room for 'count'
+// items. Passes where all keys share the same byte are skipped.
+template <typename T, typename KeyFunc>
+void radixSort(T *items, T *scratch, qsizetype count, KeyFunc key)
+{
+    if (count < 2)
+        return;
+
+    quint32 histograms[4][256] = {};
+    for (qsizetype i = 0; i != count; ++i) {
+        const quint32 k = key(items[i]);
+        ++histograms[0][k & 0xff];
+        ++histograms[1][(k >> 8) & 0xff];
+        ++histograms[2][(k >> 16) & 0xff];
+        ++histograms[3][k >> 24];
+    }
+
+    T *src = items;
+    T *dst = scratch;
+    for (int pass = 0; pass != 4; ++pass) {
+        quint32 *histogram = histograms[pass];
+        const int shift = pass * 8;
+        // All items end up in the same bucket, so this pass wouldn't change the order
+        if (histogram[(key(src[0]) >> shift) & 0xff] == quint32(count))
+            continue;
+
+        quint32 offset = 0;
+        for (int b = 0; b != 256; ++b) {
+            const quint32 c = histogram[b];
+            histogram[b] = offset;
+            offset += c;
+        }
+
+        for (qsizetype i = 0; i != count; ++i) {
+            const quint32 bucket = (key(src[i]) >> shift) & 0xff;
+            dst[histogram[bucket]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != items) {
+        for (qsizetype i = 0; i != count; ++i)
+            items[i] = src[i];
+    }
+}
+
+// Insertion sort for input that is expected to be close to sorted already, for example last frame's order
+// with updated keys. Gives up when more than 'maxMoves' element moves are needed and returns false, the
+// items are then still a permutation of the input, but not sorted.
+template <typename T, typename LessThan>
+[[nodiscard]] bool insertionSortNearlySorted(T *items, qsizetype count, LessThan lessThan, qsizetype maxMoves)
+{
+    qsizetype moves = 0;
+    for (qsizetype i = 1; i < count; ++i) {
+        if (!lessThan(items[i], items[i - 1]))
+            continue;
+        T value = std::move(items[i]);
+        qsizetype j = i;
+        do {
+            items[j] = std::move(items[j - 1]);
+            --j;
+            ++moves;
+        } while (j > 0 && lessThan(value, items[j - 1]));
+        items[j] = std::move(value);
+        if (moves > maxMoves)
+            return false;
+    }
+
+    return true;
+}
+
+// Sorts 'items' in ascending order of key(item). Larger lists are radix sorted, smaller ones use std::sort.
+// 'scratch' is only grown, never shrunk, so callers keep it around to avoid an allocation per sort.
+template <typename T, typename KeyFunc>
+void sortByKey(QList<T> &items, QList<T> &scratch, KeyFunc key)
+{
+    if (items.size() < RADIX_SORT_MIN_COUNT) {
+        std::sort(items.begin(), items.end(), [&key](const T &a, const T &b) { return key(a) < key(b); });
+        return;
+    }
+
+    if (scratch.size() < items.size())
+        scratch.resize(items.size());
+    radixSort(items.data(), scratch.data(), items.size(), key);
+}
+
+} // namespace QSSGRenderSort
+
+QT_END_NAMESPACE
+
+#endif // QSSGRENDERSORT_P_H
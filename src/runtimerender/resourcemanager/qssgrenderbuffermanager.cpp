@@ -7,6 +7,7 @@
 #include <QtQuick3DRuntimeRender/private/qssgrenderloadedtexture_p.h>
 
 #include <QtQuick3DRuntimeRender/private/qssgruntimerenderlogging_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderoptimizations_p.h>
 #include <QtQuick3DUtils/private/qssgmeshbvhbuilder_p.h>
 #include <QtQuick3DUtils/private/qssgbounds3_p.h>
 #include <QtQuick3DUtils/private/qssgassert_p.h>
@@ -14,6 +15,7 @@
 #include <QtQuick/QSGTexture>
 
 #include <QtCore/QDir>
+#include <QtCore/QThreadPool>
 #include <QtGui/private/qimage_p.h>
 #include <QtQuick/private/qsgtexture_p.h>
 #include <QtQuick/private/qsgcompressedtexture_p.h>
@@ -153,6 +155,7 @@ void QSSGBufferManager::releaseResourcesForLayer(QSSGRenderLayer *layer)
     // the layer is destroyed
     resetUsageCounters(frameResetIndex + 1, layer);
     cleanupUnreferencedBuffers(frameResetIndex + 1, layer);
+    lodStreamingLayers.remove(layer);
 }
 
 QSSGRenderImageTexture QSSGBufferManager::loadRenderImage(const QSSGRenderImage *image,
@@ -212,6 +215,12 @@ QSSGRenderImageTexture QSSGBufferManager::loadRenderImage(const QSSGRenderImage
     } else if (!image->m_imagePath.isEmpty()) {
 
         const ImageCacheKey imageKey = { image->m_imagePath, inMipMode, int(image->type) };
+        // Light probes and cube maps need all their data before they can be processed further
+        if (image->m_asyncLoading && !flags.testFlag(LoadSynchronously)
+                && inMipMode != MipModeBsdf && image->type == QSSGRenderGraphObject::Type::Image2D) {
+            return loadRenderImageAsync(image, imageKey, flags);
+        }
+
         auto foundIt = imageMap.find(imageKey);
         if (foundIt != imageMap.cend()) {
             result = foundIt.value().renderImageTexture;
@@ -255,6 +264,80 @@ QSSGRenderImageTexture QSSGBufferManager::loadRenderImage(const QSSGRenderImage
     return result;
 }
 
+QSSGRenderImageTexture QSSGBufferManager::loadRenderImageAsync(const QSSGRenderImage *image, const ImageCacheKey &imageKey, LoadRenderImageFlags flags)
+{
+    // Loaded already, possibly synchronously for another image
+    if (auto foundIt = imageMap.find(imageKey); foundIt != imageMap.end()) {
+        foundIt.value().usageCounts[currentLayer]++;
+        return foundIt.value().renderImageTexture;
+    }
+
+    const auto &path = image->m_imagePath.path();
+    if (auto it = pendingImageLoads.find(imageKey); it != pendingImageLoads.end()) {
+        const std::shared_ptr<AsyncImageLoad> load = *it;
+        load->requested = true;
+        if (load->finished.load(std::memory_order_acquire)) {
+            pendingImageLoads.erase(it);
+            Q_QUICK3D_PROFILE_START(QQuick3DProfiler::Quick3DTextureLoad);
+            auto foundIt = imageMap.insert(imageKey, ImageData());
+            if (load->texture) {
+                auto &renderImageTexture = foundIt.value().renderImageTexture;
+                if (!setRhiTexture(renderImageTexture, load->texture.get(), MipMode(imageKey.mipMode), {}, QFileInfo(path).fileName())) {
+                    foundIt.value() = ImageData();
+                } else {
+                    renderImageTexture.m_flags.setHasTransparency(load->hasTransparency);
+                    if (QSSGBufferManagerStat::enabled(QSSGBufferManagerStat::Level::Debug))
+                        qDebug() << "+ uploadTexture: " << path << currentLayer;
+                    increaseMemoryStat(renderImageTexture.m_texture);
+                }
+            } else {
+                // Same as for synchronous loads, a bad path only fails once
+                qCWarning(WARNING, "Failed to load image: %s", qPrintable(path));
+            }
+            Q_QUICK3D_PROFILE_END_WITH_STRING(QQuick3DProfiler::Quick3DTextureLoad, stats.imageDataSize, path.toUtf8());
+            foundIt.value().usageCounts[currentLayer]++;
+            return foundIt.value().renderImageTexture;
+        }
+    } else {
+        startImageLoad(*image, imageKey, flags.testFlag(LoadWithFlippedY));
+    }
+
+    // Until the image is uploaded it is sampled as a placeholder that leaves the material
+    // as it would be without the map. It is not cached in imageMap, the rhi context owns it.
+    QColor placeholderColor = Qt::white;
+    if (flags.testFlag(FlatNormalPlaceholder))
+        placeholderColor = QColor(128, 128, 255);
+    else if (flags.testFlag(BlackPlaceholder))
+        placeholderColor = Qt::black;
+    const auto &context = m_contextInterface->rhiContext();
+    QSSGRenderImageTexture placeholder;
+    placeholder.m_mipmapCount = 1;
+    // Once created, the placeholder is found without touching an update batch in later frames
+    const QSSGRhiDummyTextureKey placeholderKey { {}, QSize(64, 64), placeholderColor, 0 };
+    placeholder.m_texture = QSSGRhiContextPrivate::get(context.get())->m_dummyTextures.value(placeholderKey);
+    if (!placeholder.m_texture) {
+        placeholder.m_texture = context->dummyTexture({}, meshBufferUpdateBatch(), QSize(64, 64), placeholderColor);
+        // Sampled right away, possibly after this frame's buffer uploads were committed
+        commitBufferResourceUpdates();
+    }
+    return placeholder;
+}
+
+void QSSGBufferManager::startImageLoad(const QSSGRenderImage &image, const ImageCacheKey &imageKey, bool flipY)
+{
+    auto load = std::make_shared<AsyncImageLoad>();
+    pendingImageLoads.insert(imageKey, load);
+    const QString path = image.m_imagePath.path();
+    const QSSGRenderTextureFormat format = image.m_format;
+    QThreadPool::globalInstance()->start([load, path, format, flipY]() {
+        Q_TRACE_SCOPE(QSSG_textureLoadPath, path);
+        load->texture.reset(QSSGLoadedTexture::load(path, format, flipY));
+        if (load->texture)
+            load->hasTransparency = hasTransparency(*load->texture);
+        load->finished.store(true, std::memory_order_release);
+    });
+}
+
 QSSGRenderImageTexture QSSGBufferManager::loadTextureData(QSSGRenderTextureData *data, MipMode inMipMode)
 {
     QSSG_ASSERT(data != nullptr, return {});
@@ -336,8 +419,11 @@ QSSGRenderImageTexture QSSGBufferManager::loadSkinmap(QSSGRenderTextureData *ski
     return loadTextureData(skin, MipModeDisable);
 }
 
-QSSGRenderMesh *QSSGBufferManager::getMeshForPicking(const QSSGRenderModel &model) const
+QSSGRenderMesh *QSSGBufferManager::getMeshForPicking(const QSSGRenderModel &model, bool *outIsCurrent) const
 {
+    if (outIsCurrent)
+        *outIsCurrent = true;
+
     if (!model.meshPath.isNull()) {
         const auto foundIt = meshMap.constFind(model.meshPath);
         if (foundIt != meshMap.constEnd())
@@ -346,8 +432,11 @@ QSSGRenderMesh *QSSGBufferManager::getMeshForPicking(const QSSGRenderModel &mode
 
     if (model.geometry) {
         const auto foundIt = customMeshMap.constFind(model.geometry);
-        if (foundIt != customMeshMap.constEnd())
+        if (foundIt != customMeshMap.constEnd()) {
+            if (outIsCurrent)
+                *outIsCurrent = (foundIt->generationId == model.geometry->generationId());
             return foundIt->mesh;
+        }
     }
 
     return nullptr;
@@ -1045,10 +1134,8 @@ bool QSSGBufferManager::setRhiTexture(QSSGRenderImageTexture &texture,
                 textureUploads << QRhiTextureUploadEntry{ face, level, subDesc };
             }
         }
-        if (checkTransp) {
-            auto glFormat = texFileData.glInternalFormat() ? texFileData.glInternalFormat() : texFileData.glFormat();
-            hasTransp = !QSGCompressedTexture::formatIsOpaque(glFormat);
-        }
+        if (checkTransp)
+            hasTransp = hasTransparency(*inTexture);
     } else if (inFlags.testFlag(Texture3D)) {
         // 3D textures are currently only setup via QQuick3DTextureData
         quint32 formatSize = (quint32)inTexture->format.getSizeofFormat();
@@ -1065,14 +1152,12 @@ bool QSSGBufferManager::setRhiTexture(QSSGRenderImageTexture &texture,
         QRhiTextureSubresourceUploadDescription subDesc;
         if (!inTexture->image.isNull()) {
             subDesc.setImage(inTexture->image);
-            if (checkTransp)
-                hasTransp = QImageData::get(inTexture->image)->checkForAlphaPixels();
         } else if (inTexture->data) {
             QByteArray buf(static_cast<const char *>(inTexture->data), qMax(0, int(inTexture->dataSizeInBytes)));
             subDesc.setData(buf);
-            if (checkTransp)
-                hasTransp = inTexture->scanForTransparency();
         }
+        if (checkTransp)
+            hasTransp = hasTransparency(*inTexture);
         subDesc.setSourceSize(size);
         if (!subDesc.data().isEmpty() || !subDesc.image().isNull())
             textureUploads << QRhiTextureUploadEntry{0, 0, subDesc};
@@ -1103,6 +1188,20 @@ bool QSSGBufferManager::setRhiTexture(QSSGRenderImageTexture &texture,
     return true;
 }
 
+bool QSSGBufferManager::hasTransparency(const QSSGLoadedTexture &texture)
+{
+    const QTextureFileData &texFileData = texture.textureFileData;
+    if (texFileData.isValid()) {
+        auto glFormat = texFileData.glInternalFormat() ? texFileData.glInternalFormat() : texFileData.glFormat();
+        return !QSGCompressedTexture::formatIsOpaque(glFormat);
+    }
+    if (!texture.image.isNull())
+        return QImageData::get(texture.image)->checkForAlphaPixels();
+    if (texture.data)
+        return texture.scanForTransparency();
+    return false;
+}
+
 QString QSSGBufferManager::primitivePath(const QString &primitive)
 {
     QByteArray theName = primitive.toUtf8();
@@ -1136,28 +1235,122 @@ QSSGMesh::Mesh QSSGBufferManager::loadPrimitive(const QString &inRelativePath)
     return QSSGMesh::Mesh();
 }
 
-QSSGRenderMesh *QSSGBufferManager::loadMesh(const QSSGRenderModel *model)
+static QSSGMeshProcessingOptions meshProcessingOptions(const QSSGRenderModel &model)
 {
     QSSGMeshProcessingOptions options;
-    if (model->hasLightmap()) {
+    if (model.hasLightmap()) {
         options.wantsLightmapUVs = true;
-        options.lightmapBaseResolution = model->lightmapBaseResolution;
+        options.lightmapBaseResolution = model.lightmapBaseResolution;
+        if (!model.meshPath.isNull()) {
+            options.meshFileOverride = QSSGLightmapper::lightmapAssetPathForLoad(model,
+                                                                                 QSSGLightmapper::LightmapAsset::MeshWithLightmapUV);
+        }
     }
+    return options;
+}
+
+// Primitives and meshes registered at runtime are already in memory
+bool QSSGBufferManager::canLoadMeshAsync(const QSSGRenderModel &model)
+{
+    const QString &path = model.meshPath.path();
+    return model.asyncMeshLoading && !path.isEmpty() && !path.startsWith(u'#') && !path.startsWith(u'!');
+}
+
+QSSGRenderMesh *QSSGBufferManager::loadMesh(const QSSGRenderModel *model)
+{
+    const QSSGMeshProcessingOptions options = meshProcessingOptions(*model);
 
     QSSGRenderMesh *theMesh = nullptr;
-    if (model->meshPath.isNull() && model->geometry) {
+    if (model->meshPath.isNull() && model->geometry)
         theMesh = loadRenderMesh(model->geometry, options);
-    } else {
-        if (model->hasLightmap()) {
-            options.meshFileOverride = QSSGLightmapper::lightmapAssetPathForLoad(*model,
-                                                                                 QSSGLightmapper::LightmapAsset::MeshWithLightmapUV);
-        }
+    else if (canLoadMeshAsync(*model))
+        theMesh = loadRenderMeshAsync(model->meshPath, options);
+    else
         theMesh = loadRenderMesh(model->meshPath, options);
-    }
 
     return theMesh;
 }
 
+void QSSGBufferManager::requestMeshLoad(const QSSGRenderModel &model)
+{
+    if (!canLoadMeshAsync(model) || meshMap.contains(model.meshPath))
+        return;
+
+    if (auto it = failedMeshLoads.find(model.meshPath); it != failedMeshLoads.end()) {
+        *it = true;
+        return;
+    }
+
+    if (auto it = pendingMeshLoads.constFind(model.meshPath); it != pendingMeshLoads.cend()) {
+        (*it)->requested = true;
+        return;
+    }
+
+    startMeshLoad(model.meshPath, meshProcessingOptions(model));
+}
+
+QSSGBufferManager::LoadStatus QSSGBufferManager::meshLoadStatus(const QSSGRenderModel &model) const
+{
+    if (model.meshPath.isNull())
+        return model.geometry ? LoadStatus::Ready : LoadStatus::Null;
+    if (meshMap.contains(model.meshPath))
+        return LoadStatus::Ready;
+    if (failedMeshLoads.contains(model.meshPath))
+        return LoadStatus::Error;
+    // Loaded for requestMeshLoad() but not (yet) used for rendering
+    if (auto it = pendingMeshLoads.constFind(model.meshPath); it != pendingMeshLoads.cend()
+            && (*it)->finished.load(std::memory_order_acquire)) {
+        return (*it)->mesh.isValid() ? LoadStatus::Ready : LoadStatus::Error;
+    }
+
+    // Either on its way or not requested yet
+    return LoadStatus::Loading;
+}
+
+QSSGBufferManager::LoadStatus QSSGBufferManager::imageLoadStatus(const QSSGRenderImage &image) const
+{
+    if (image.m_qsgTexture || image.m_rawTextureData || image.m_extensionsSource)
+        return LoadStatus::Ready;
+    if (image.m_imagePath.isEmpty())
+        return LoadStatus::Null;
+
+    const int type = int(image.type);
+    for (MipMode mipMode : { image.m_generateMipmaps ? MipModeEnable : MipModeDisable, MipModeBsdf }) {
+        const ImageCacheKey imageKey = { image.m_imagePath, mipMode, type };
+        if (const auto it = imageMap.constFind(imageKey); it != imageMap.cend())
+            return it->renderImageTexture.m_texture ? LoadStatus::Ready : LoadStatus::Error;
+        // Loaded for requestImageLoad() but not (yet) used for rendering
+        if (const auto it = pendingImageLoads.constFind(imageKey); it != pendingImageLoads.cend()) {
+            if (!(*it)->finished.load(std::memory_order_acquire))
+                return LoadStatus::Loading;
+            return (*it)->texture ? LoadStatus::Ready : LoadStatus::Error;
+        }
+    }
+
+    // Either on its way or not requested yet
+    return LoadStatus::Loading;
+}
+
+void QSSGBufferManager::requestImageLoad(const QSSGRenderImage &image)
+{
+    // Light probes and cube maps are only ever loaded by the prepare pass that uses them
+    if (image.m_imagePath.isEmpty() || image.m_qsgTexture || image.m_rawTextureData || image.m_extensionsSource
+            || image.type != QSSGRenderGraphObject::Type::Image2D) {
+        return;
+    }
+
+    const ImageCacheKey imageKey = { image.m_imagePath, image.m_generateMipmaps ? MipModeEnable : MipModeDisable, int(image.type) };
+    if (imageMap.contains(imageKey))
+        return;
+
+    if (auto it = pendingImageLoads.constFind(imageKey); it != pendingImageLoads.cend()) {
+        (*it)->requested = true;
+        return;
+    }
+
+    startImageLoad(image, imageKey, true);
+}
+
 QSSGBounds3 QSSGBufferManager::getModelBounds(const QSSGRenderModel *model) const
 {
     QSSGBounds3 retval;
@@ -1176,6 +1369,12 @@ QSSGBounds3 QSSGBufferManager::getModelBounds(const QSSGRenderModel *model) cons
             const auto &subSets = theMesh->subsets;
             for (const auto &subSet : subSets)
                 retval.include(subSet.bounds);
+        } else if (auto loadItr = pendingMeshLoads.constFind(model->meshPath);
+                   loadItr != pendingMeshLoads.cend() && (*loadItr)->finished.load(std::memory_order_acquire)) {
+            // Loaded in the background, but not uploaded yet
+            const auto &subsets = (*loadItr)->mesh.subsets();
+            for (const auto &subset : subsets)
+                retval.include(QSSGBounds3(subset.bounds.min, subset.bounds.max));
         } else {
             // The model has not been loaded yet, load it without uploading the geometry
             // TODO: Try to do this without loading the whole mesh struct
@@ -1190,6 +1389,12 @@ QSSGBounds3 QSSGBufferManager::getModelBounds(const QSSGRenderModel *model) cons
     return retval;
 }
 
+static quint64 nextMeshGeneration()
+{
+    static std::atomic<quint64> generation = 0;
+    return ++generation;
+}
+
 QSSGRenderMesh *QSSGBufferManager::createRenderMesh(const QSSGMesh::Mesh &mesh, const QString &debugObjectName)
 {
     QSSGRenderMesh *newMesh = new QSSGRenderMesh(QSSGRenderDrawMode(mesh.drawMode()),
@@ -1233,8 +1438,48 @@ QSSGRenderMesh *QSSGBufferManager::createRenderMesh(const QSSGMesh::Mesh &mesh,
                                                        vertexBuffer.data.size());
     rhi.vertexBuffer->buffer()->setName(debugObjectName.toLatin1()); // this is what shows up in DebugView
     rub->uploadStaticBuffer(rhi.vertexBuffer->buffer(), vertexBuffer.data);
+    if (mesh.isMapped())
+        mappedMeshUploads.append(mesh);
+
+    // With level of detail streaming, meshes that have their levels of detail stored
+    // coarsest first (see QSSGMesh::Mesh::arrangeLevelsOfDetailCoarsestFirst()) start
+    // out with only the coarsest level in the index buffer. Finer levels are uploaded
+    // when they are requested by streamLevelOfDetail().
+    std::unique_ptr<QSSGRenderMeshLodStreaming> lodStreaming;
+    if (QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::MeshLodStreaming) && !indexBuffer.data.isEmpty()
+            && mesh.drawMode() == QSSGMesh::Mesh::DrawMode::Triangles && mesh.maxLevelOfDetail() > 0) {
+        const quint32 indexSize = quint32(QSSGBaseTypeHelpers::getSizeOfType(indexBufComponentType));
+        const quint32 levelCount = mesh.maxLevelOfDetail() + 1;
+        QVector<quint32> levelIndexCounts(levelCount);
+        for (quint32 level = 0; level < levelCount; ++level)
+            levelIndexCounts[level] = mesh.levelOfDetailIndexCount(level);
+        // Only possible when every level is a prefix of the next finer one, and only
+        // worth it when the coarsest level is smaller than the full detail
+        const bool coarsestFirst = std::is_sorted(levelIndexCounts.crbegin(), levelIndexCounts.crend());
+        if (coarsestFirst && levelIndexCounts.last() < levelIndexCounts.first()
+                && quint64(levelIndexCounts.first()) * indexSize <= quint64(indexBuffer.data.size())) {
+            lodStreaming = std::make_unique<QSSGRenderMeshLodStreaming>();
+            lodStreaming->indexData = indexBuffer.data;
+            if (mesh.isMapped())
+                lodStreaming->mappedMesh = mesh;
+            lodStreaming->levelIndexCounts = levelIndexCounts;
+            lodStreaming->indexSize = indexSize;
+            lodStreaming->indexFormat = rhiIndexFormat;
+            lodStreaming->residentLevel = lodStreaming->coarsestLevel();
+            lodStreaming->usedLevel = lodStreaming->coarsestLevel();
+        }
+    }
 
-    if (!indexBuffer.data.isEmpty()) {
+    if (lodStreaming) {
+        const quint32 residentSize = lodStreaming->levelIndexCounts.last() * lodStreaming->indexSize;
+        rhi.indexBuffer = std::make_shared<QSSGRhiBuffer>(*context.get(),
+                                                          QRhiBuffer::Static,
+                                                          QRhiBuffer::IndexBuffer,
+                                                          0,
+                                                          residentSize,
+                                                          rhiIndexFormat);
+        rub->uploadStaticBuffer(rhi.indexBuffer->buffer(), 0, residentSize, indexBuffer.data.constData());
+    } else if (!indexBuffer.data.isEmpty()) {
         rhi.indexBuffer = std::make_shared<QSSGRhiBuffer>(*context.get(),
                                                           QRhiBuffer::Static,
                                                           QRhiBuffer::IndexBuffer,
@@ -1346,10 +1591,14 @@ QSSGRenderMesh *QSSGBufferManager::createRenderMesh(const QSSGMesh::Mesh &mesh,
         qWarning("Mesh topology is TriangleFan but this is not supported with the active graphics API. Rendering will be incorrect.");
 
     QVector<QSSGMesh::Mesh::Subset> meshSubsets = mesh.subsets();
+    const quint64 generation = nextMeshGeneration();
     for (quint32 subsetIdx = 0, subsetEnd = meshSubsets.size(); subsetIdx < subsetEnd; ++subsetIdx) {
         QSSGRenderSubset subset;
         const QSSGMesh::Mesh::Subset &source(meshSubsets[subsetIdx]);
         subset.bounds = QSSGBounds3(source.bounds.min, source.bounds.max);
+        subset.generation = generation;
+        if (lodStreaming)
+            subset.residentLevelOfDetail = lodStreaming->residentLevel;
         subset.count = source.count;
         subset.offset = source.offset;
         for (auto &lod : source.lods)
@@ -1371,9 +1620,148 @@ QSSGRenderMesh *QSSGBufferManager::createRenderMesh(const QSSGMesh::Mesh &mesh,
     if (!meshSubsets.isEmpty())
         newMesh->lightmapSizeHint = meshSubsets.first().lightmapSizeHint;
 
+    newMesh->lodStreaming = std::move(lodStreaming);
+
     return newMesh;
 }
 
+quint32 QSSGBufferManager::streamLevelOfDetail(QSSGRenderMesh &mesh, quint32 level)
+{
+    QSSGRenderMeshLodStreaming *streaming = mesh.lodStreaming.get();
+    if (!streaming)
+        return level;
+
+    level = qMin(level, streaming->coarsestLevel());
+    QMutexLocker meshMutexLocker(&meshBufferMutex);
+    streaming->usedLevel = qMin(streaming->usedLevel, level);
+    streaming->lastUsedFrame = frameResetIndex;
+    if (level < streaming->residentLevel && !streaming->budgetLimited)
+        lodStreamingRequested = true;
+    // Finer levels that are no longer drawn can make room for a request that did not fit
+    else if (level > streaming->residentLevel && lodStreamingBudgetLimited)
+        lodStreamingRequested = true;
+
+    return qMax(level, streaming->residentLevel);
+}
+
+void QSSGBufferManager::setResidentLevelOfDetail(QSSGRenderMesh *mesh, quint32 level)
+{
+    QSSGRenderMeshLodStreaming *streaming = mesh->lodStreaming.get();
+    Q_ASSERT(streaming && level < quint32(streaming->levelIndexCounts.size()));
+    if (level == streaming->residentLevel)
+        return;
+
+    const auto &context = m_contextInterface->rhiContext();
+    const quint32 size = streaming->levelIndexCounts.at(level) * streaming->indexSize;
+    auto indexBuffer = std::make_shared<QSSGRhiBuffer>(*context.get(),
+                                                       QRhiBuffer::Static,
+                                                       QRhiBuffer::IndexBuffer,
+                                                       0,
+                                                       size,
+                                                       streaming->indexFormat);
+    const QSSGRhiBufferPtr &vertexBuffer = mesh->subsets.at(0).rhi.vertexBuffer;
+    if (vertexBuffer)
+        indexBuffer->buffer()->setName(vertexBuffer->buffer()->name());
+    meshBufferUpdateBatch()->uploadStaticBuffer(indexBuffer->buffer(), 0, size, streaming->indexData.constData());
+
+    decreaseMemoryStat(mesh);
+    const quint64 generation = nextMeshGeneration();
+    for (QSSGRenderSubset &subset : mesh->subsets) {
+        subset.rhi.indexBuffer = indexBuffer;
+        subset.generation = generation;
+        subset.residentLevelOfDetail = level;
+    }
+    streaming->residentLevel = level;
+    increaseMemoryStat(mesh);
+
+    if (QSSGBufferManagerStat::enabled(QSSGBufferManagerStat::Level::Debug))
+        qDebug() << "- setResidentLevelOfDetail: " << mesh << level << size;
+}
+
+// Called once all layers have been prepared (see resetUsageCounters()). Uploads the
+// levels of detail that were requested by any of them, and drops the finer levels
+// of meshes that none of them drew with when the index data of all streamed meshes
+// does not fit in the budget. The least recently used meshes are shrunk first.
+void QSSGBufferManager::updateStreamedMeshLods()
+{
+    if (!QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::MeshLodStreaming))
+        return;
+
+    QMutexLocker meshMutexLocker(&meshBufferMutex);
+
+    const auto sizeOfLevel = [](const QSSGRenderMeshLodStreaming &streaming, quint32 level) {
+        return quint64(streaming.levelIndexCounts.at(level)) * streaming.indexSize;
+    };
+
+    QVarLengthArray<QSSGRenderMesh *, 32> streamedMeshes;
+    quint64 residentSize = 0;
+    const auto collect = [&](QSSGRenderMesh *mesh) {
+        if (mesh && mesh->lodStreaming) {
+            streamedMeshes.append(mesh);
+            residentSize += sizeOfLevel(*mesh->lodStreaming, mesh->lodStreaming->residentLevel);
+        }
+    };
+    for (const auto &meshData : std::as_const(meshMap))
+        collect(meshData.mesh);
+    for (const auto &meshData : std::as_const(customMeshMap))
+        collect(meshData.mesh);
+
+    if (streamedMeshes.isEmpty()) {
+        lodStreamingRequested = false;
+        lodStreamingBudgetLimited = false;
+        return;
+    }
+
+    // Most recently used first
+    std::sort(streamedMeshes.begin(), streamedMeshes.end(), [](QSSGRenderMesh *a, QSSGRenderMesh *b) {
+        return a->lodStreaming->lastUsedFrame > b->lodStreaming->lastUsedFrame;
+    });
+
+    // Drops the finer levels that were not drawn by any layer, least recently
+    // used meshes first, until 'needed' more bytes fit in the budget.
+    const quint64 budget = QSSGRenderOptimizations::meshLodStreamingBudget();
+    bool freedMemory = false;
+    const auto makeRoom = [&](quint64 needed) {
+        for (auto it = streamedMeshes.rbegin(); it != streamedMeshes.rend() && residentSize + needed > budget; ++it) {
+            QSSGRenderMeshLodStreaming &streaming = *(*it)->lodStreaming;
+            if (streaming.usedLevel > streaming.residentLevel) {
+                residentSize -= sizeOfLevel(streaming, streaming.residentLevel) - sizeOfLevel(streaming, streaming.usedLevel);
+                setResidentLevelOfDetail(*it, streaming.usedLevel);
+                freedMemory = true;
+            }
+        }
+        return residentSize + needed <= budget;
+    };
+
+    makeRoom(0);
+    for (QSSGRenderMesh *mesh : streamedMeshes) {
+        QSSGRenderMeshLodStreaming &streaming = *mesh->lodStreaming;
+        // Retried also when budget limited, as other meshes may have stopped using their finer levels
+        if (streaming.usedLevel < streaming.residentLevel) {
+            const quint64 growth = sizeOfLevel(streaming, streaming.usedLevel) - sizeOfLevel(streaming, streaming.residentLevel);
+            if (makeRoom(growth)) {
+                residentSize += growth;
+                setResidentLevelOfDetail(mesh, streaming.usedLevel);
+                streaming.budgetLimited = false;
+            } else {
+                // Stop requesting new frames until something else gets dropped
+                streaming.budgetLimited = true;
+            }
+        }
+    }
+
+    lodStreamingBudgetLimited = false;
+    for (QSSGRenderMesh *mesh : streamedMeshes) {
+        QSSGRenderMeshLodStreaming &streaming = *mesh->lodStreaming;
+        if (freedMemory || streaming.usedLevel >= streaming.residentLevel)
+            streaming.budgetLimited = false;
+        lodStreamingBudgetLimited |= streaming.budgetLimited;
+        streaming.usedLevel = streaming.coarsestLevel();
+    }
+
+    lodStreamingRequested = false;
+}
+
 void QSSGBufferManager::releaseGeometry(QSSGRenderGeometry *geometry)
 {
     QMutexLocker meshMutexLocker(&meshBufferMutex);
@@ -1500,6 +1888,27 @@ void QSSGBufferManager::cleanupUnreferencedBuffers(quint32 frameId, QSSGRenderLa
             }
         }
 
+        // Finished async loads nobody asked for since the last cleanup
+        for (auto it = pendingMeshLoads.begin(); it != pendingMeshLoads.end(); ) {
+            const bool unused = !(*it)->requested && (*it)->finished.load(std::memory_order_acquire);
+            (*it)->requested = false;
+            if (unused)
+                it = pendingMeshLoads.erase(it);
+            else
+                ++it;
+        }
+
+        // Failed loads are retried once nothing has asked for the path since the last
+        // cleanup, e.g. after the source of the models using it was changed and back
+        for (auto it = failedMeshLoads.begin(); it != failedMeshLoads.end(); ) {
+            if (!*it) {
+                it = failedMeshLoads.erase(it);
+            } else {
+                *it = false;
+                ++it;
+            }
+        }
+
         // Meshes (custom)
         auto customMeshIterator = customMeshMap.cbegin();
         while (customMeshIterator != customMeshMap.cend()) {
@@ -1545,6 +1954,16 @@ void QSSGBufferManager::cleanupUnreferencedBuffers(quint32 frameId, QSSGRenderLa
         }
     }
 
+    // Finished async image loads nobody asked for since the last cleanup
+    for (auto it = pendingImageLoads.begin(); it != pendingImageLoads.end(); ) {
+        const bool unused = !(*it)->requested && (*it)->finished.load(std::memory_order_acquire);
+        (*it)->requested = false;
+        if (unused)
+            it = pendingImageLoads.erase(it);
+        else
+            ++it;
+    }
+
     // Custom Texture Data
     auto textureDataIterator = customTextureMap.cbegin();
     while (textureDataIterator != customTextureMap.cend()) {
@@ -1579,6 +1998,11 @@ void QSSGBufferManager::cleanupUnreferencedBuffers(quint32 frameId, QSSGRenderLa
         }
     }
 
+    // The uploads from mapped meshes have been submitted with an earlier frame, unmap them
+    committedMappedMeshUploads.removeIf([frameId](const std::pair<quint32, QSSGMesh::Mesh> &upload) {
+        return frameId > upload.first + 1;
+    });
+
     // Resource Tracking Debug Code
     frameCleanupIndex = frameId;
     if (QSSGBufferManagerStat::enabled(QSSGBufferManagerStat::Level::Usage)) {
@@ -1625,6 +2049,15 @@ void QSSGBufferManager::resetUsageCounters(quint32 frameId, QSSGRenderLayer *lay
         retData.usageCounts[layer] = uint32_t(hasTexture) * 1;
     }
 
+    // Every layer draws from the same streamed meshes, so nothing is evicted until all
+    // the layers have recorded the levels they use. That is the case once a layer that
+    // was already prepared since the last update comes around again.
+    if (lodStreamingLayers.contains(layer)) {
+        updateStreamedMeshLods();
+        lodStreamingLayers.clear();
+    }
+    lodStreamingLayers.insert(layer);
+
     frameResetIndex = frameId;
 }
 
@@ -1667,50 +2100,126 @@ QSSGRenderMesh *QSSGBufferManager::loadRenderMesh(const QSSGRenderPath &inMeshPa
     Q_QUICK3D_PROFILE_START(QQuick3DProfiler::Quick3DMeshLoad);
     Q_TRACE_SCOPE(QSSG_meshLoadPath, inMeshPath.path());
 
-    QSSGMesh::Mesh result;
     QString resultSourcePath;
+    const QSSGMesh::Mesh result = loadMeshDataWithOptions(inMeshPath, options, &resultSourcePath);
+
+    if (!result.isValid()) {
+        qCWarning(WARNING, "Failed to load mesh: %s", qPrintable(inMeshPath.path()));
+        Q_QUICK3D_PROFILE_END_WITH_PAYLOAD(QQuick3DProfiler::Quick3DMeshLoad,
+                                           stats.meshDataSize);
+        return nullptr;
+    }
+
+    auto ret = insertRenderMesh(inMeshPath, result, resultSourcePath, options);
+    Q_QUICK3D_PROFILE_END_WITH_STRING(QQuick3DProfiler::Quick3DMeshLoad,
+                                       stats.meshDataSize, inMeshPath.path().toUtf8());
+    return ret;
+}
+
+// NOTE: Static and only touching the file system, so this can be called from any thread.
+QSSGMesh::Mesh QSSGBufferManager::loadMeshDataWithOptions(const QSSGRenderPath &inMeshPath,
+                                                          const QSSGMeshProcessingOptions &options,
+                                                          QString *sourcePath)
+{
+    QSSGMesh::Mesh result;
 
     if (options.wantsLightmapUVs && !options.meshFileOverride.isEmpty()) {
         // So now we have a hint, e.g "qlm_xxxx.mesh" that says that if that
         // file exists, then we should prefer that because it has the lightmap
         // UV unwrapping and associated rebuilding already done.
         if (QFile::exists(options.meshFileOverride)) {
-            resultSourcePath = options.meshFileOverride;
+            *sourcePath = options.meshFileOverride;
             result = loadMeshData(QSSGRenderPath(options.meshFileOverride));
         }
     }
 
     if (!result.isValid()) {
-        resultSourcePath = inMeshPath.path();
+        *sourcePath = inMeshPath.path();
         result = loadMeshData(inMeshPath);
     }
 
-    if (!result.isValid()) {
-        qCWarning(WARNING, "Failed to load mesh: %s", qPrintable(inMeshPath.path()));
-        Q_QUICK3D_PROFILE_END_WITH_PAYLOAD(QQuick3DProfiler::Quick3DMeshLoad,
-                                           stats.meshDataSize);
-        return nullptr;
-    }
-    if (QSSGBufferManagerStat::enabled(QSSGBufferManagerStat::Level::Debug))
-        qDebug() << "+ uploadGeometry: " << inMeshPath.path() << currentLayer;
-
-    if (options.wantsLightmapUVs) {
+    if (result.isValid() && options.wantsLightmapUVs) {
         // Does nothing if the lightmap uv attribute is already present,
         // otherwise this is a potentially expensive step that will do UV
         // unwrapping and rebuild much of the mesh's data.
         result.createLightmapUVChannel(options.lightmapBaseResolution);
     }
 
-    auto ret = createRenderMesh(result, QFileInfo(resultSourcePath).fileName());
+    return result;
+}
+
+QSSGRenderMesh *QSSGBufferManager::insertRenderMesh(const QSSGRenderPath &inMeshPath, const QSSGMesh::Mesh &mesh,
+                                                    const QString &sourcePath, const QSSGMeshProcessingOptions &options)
+{
+    // An incompatible version might still be in use, reap it like loadRenderMesh() does.
+    if (auto meshItr = meshMap.find(inMeshPath); meshItr != meshMap.end()) {
+        auto *oldMesh = meshItr->mesh;
+        meshMap.erase(meshItr);
+        meshMap.insert(QSSGRenderPath(inMeshPath.path() + u"@reaped"), { oldMesh, {{currentLayer, 0}}, 0, {} });
+    }
+
+    if (QSSGBufferManagerStat::enabled(QSSGBufferManagerStat::Level::Debug))
+        qDebug() << "+ uploadGeometry: " << inMeshPath.path() << currentLayer;
+
+    // The buffer uploads end up in meshBufferUpdateBatch()
+    auto ret = createRenderMesh(mesh, QFileInfo(sourcePath).fileName());
     meshMap.insert(inMeshPath, { ret, {{currentLayer, 1}}, 0, options });
     QSSGRhiContextPrivate *rhiCtxD = QSSGRhiContextPrivate::get(m_contextInterface->rhiContext().get());
     rhiCtxD->registerMesh(ret);
     increaseMemoryStat(ret);
-    Q_QUICK3D_PROFILE_END_WITH_STRING(QQuick3DProfiler::Quick3DMeshLoad,
-                                       stats.meshDataSize, inMeshPath.path().toUtf8());
     return ret;
 }
 
+QSSGRenderMesh *QSSGBufferManager::loadRenderMeshAsync(const QSSGRenderPath &inMeshPath, const QSSGMeshProcessingOptions &options)
+{
+    // Loaded already, possibly synchronously for another model
+    if (const auto meshItr = meshMap.constFind(inMeshPath); meshItr != meshMap.cend() && options.isCompatible(meshItr->options))
+        return loadRenderMesh(inMeshPath, options);
+
+    if (auto it = failedMeshLoads.find(inMeshPath); it != failedMeshLoads.end()) {
+        *it = true;
+        return nullptr;
+    }
+
+    if (auto it = pendingMeshLoads.find(inMeshPath); it != pendingMeshLoads.end()) {
+        const std::shared_ptr<AsyncMeshLoad> load = *it;
+        load->requested = true;
+        if (!load->finished.load(std::memory_order_acquire))
+            return nullptr;
+
+        pendingMeshLoads.erase(it);
+        if (options.isCompatible(load->options)) {
+            if (!load->mesh.isValid()) {
+                qCWarning(WARNING, "Failed to load mesh: %s", qPrintable(inMeshPath.path()));
+                failedMeshLoads.insert(inMeshPath, true);
+                return nullptr;
+            }
+
+            Q_QUICK3D_PROFILE_START(QQuick3DProfiler::Quick3DMeshLoad);
+            auto ret = insertRenderMesh(inMeshPath, load->mesh, load->sourcePath, load->options);
+            Q_QUICK3D_PROFILE_END_WITH_STRING(QQuick3DProfiler::Quick3DMeshLoad,
+                                               stats.meshDataSize, inMeshPath.path().toUtf8());
+            return ret;
+        }
+        // The processing options changed while loading, start over
+    }
+
+    startMeshLoad(inMeshPath, options);
+    return nullptr;
+}
+
+void QSSGBufferManager::startMeshLoad(const QSSGRenderPath &inMeshPath, const QSSGMeshProcessingOptions &options)
+{
+    auto load = std::make_shared<AsyncMeshLoad>();
+    load->options = options;
+    pendingMeshLoads.insert(inMeshPath, load);
+    QThreadPool::globalInstance()->start([load, inMeshPath]() {
+        Q_TRACE_SCOPE(QSSG_meshLoadPath, inMeshPath.path());
+        load->mesh = loadMeshDataWithOptions(inMeshPath, load->options, &load->sourcePath);
+        load->finished.store(true, std::memory_order_release);
+    });
+}
+
 QSSGRenderMesh *QSSGBufferManager::loadRenderMesh(QSSGRenderGeometry *geometry, QSSGMeshProcessingOptions options)
 {
     QSSGRhiContextPrivate *rhiCtxD = QSSGRhiContextPrivate::get(m_contextInterface->rhiContext().get());
@@ -1769,7 +2278,7 @@ std::unique_ptr<QSSGMeshBVH> QSSGBufferManager::loadMeshBVH(const QSSGRenderPath
         return nullptr;
     }
     QSSGMeshBVHBuilder meshBVHBuilder(mesh);
-    return meshBVHBuilder.buildTree();
+    return QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::PackedMeshBVH) ? meshBVHBuilder.buildPackedTree() : meshBVHBuilder.buildTree();
 }
 
 std::unique_ptr<QSSGMeshBVH> QSSGBufferManager::loadMeshBVH(QSSGRenderGeometry *geometry)
@@ -1815,7 +2324,7 @@ std::unique_ptr<QSSGMeshBVH> QSSGBufferManager::loadMeshBVH(QSSGRenderGeometry *
                                       hasIndexBuffer,
                                       geometry->indexBuffer(),
                                       indexBufferFormat);
-    return meshBVHBuilder.buildTree();
+    return QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::PackedMeshBVH) ? meshBVHBuilder.buildPackedTree() : meshBVHBuilder.buildTree();
 }
 
 QSSGMesh::Mesh QSSGBufferManager::loadMeshData(const QSSGRenderPath &inMeshPath)
@@ -1853,7 +2362,7 @@ QSSGMesh::Mesh QSSGBufferManager::loadMeshData(const QSSGRenderPath &inMeshPath)
         if (!pathBuilder.isEmpty()) {
             QSharedPointer<QIODevice> device(QSSGInputUtil::getStreamForFile(pathBuilder));
             if (device) {
-                QSSGMesh::Mesh mesh = QSSGMesh::Mesh::loadMesh(device.data(), id);
+                QSSGMesh::Mesh mesh = QSSGMesh::Mesh::loadMeshMapped(device, id);
                 if (mesh.isValid())
                     result = mesh;
             }
@@ -1899,6 +2408,8 @@ void QSSGBufferManager::clear()
         meshBufferUpdates->release();
         meshBufferUpdates = nullptr;
     }
+    mappedMeshUploads.clear();
+    committedMappedMeshUploads.clear();
 
     {
         QMutexLocker meshMutexLocker(&meshBufferMutex);
@@ -1915,6 +2426,9 @@ void QSSGBufferManager::clear()
             }
         }
         meshMap.clear();
+        // Any loads still running finish into their own, now unreferenced, state
+        pendingMeshLoads.clear();
+        failedMeshLoads.clear();
 
         // Meshes (custom)
         auto customMeshMapCopy = customMeshMap;
@@ -1936,6 +2450,8 @@ void QSSGBufferManager::clear()
         releaseImage(it.key());
 
     imageMap.clear();
+    // Any loads still running finish into their own, now unreferenced, state
+    pendingImageLoads.clear();
 
     // Textures (custom)
     for (auto it = customTextureMap.cbegin(), end = customTextureMap.cend(); it != end; ++it)
@@ -1960,6 +2476,9 @@ void QSSGBufferManager::commitBufferResourceUpdates()
     if (meshBufferUpdates) {
         m_contextInterface->rhiContext()->commandBuffer()->resourceUpdate(meshBufferUpdates);
         meshBufferUpdates = nullptr;
+        for (const QSSGMesh::Mesh &mesh : std::as_const(mappedMeshUploads))
+            committedMappedMeshUploads.append({ frameCleanupIndex, mesh });
+        mappedMeshUploads.clear();
     }
 }
 
@@ -27,8 +27,12 @@
 
 #include <QtCore/QMutex>
 #include <QtCore/qhash.h>
+#include <QtCore/qset.h>
 #include <QtCore/qsize.h>
 
+#include <atomic>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 struct QSSGRenderMesh;
@@ -88,7 +92,12 @@ public:
     };
 
     enum LoadRenderImageFlag {
-        LoadWithFlippedY = 0x01
+        LoadWithFlippedY = 0x01,
+        // Loads asynchronous images right away instead of returning a placeholder
+        LoadSynchronously = 0x02,
+        // The placeholder of an asynchronous image is opaque white unless one of these is set
+        FlatNormalPlaceholder = 0x04,
+        BlackPlaceholder = 0x08
     };
     Q_DECLARE_FLAGS(LoadRenderImageFlags, LoadRenderImageFlag)
 
@@ -122,6 +131,13 @@ public:
         quint64 imageDataSize = 0;
     };
 
+    enum class LoadStatus : quint8 {
+        Null,
+        Loading,
+        Ready,
+        Error
+    };
+
     QSSGBufferManager();
     ~QSSGBufferManager();
 
@@ -137,10 +153,31 @@ public:
     QSSGRenderImageTexture loadLightmap(const QSSGRenderModel &model);
     QSSGRenderImageTexture loadSkinmap(QSSGRenderTextureData *skin);
 
-    QSSGRenderMesh *getMeshForPicking(const QSSGRenderModel &model) const;
+    // outIsCurrent (optional) is set to false when the returned mesh was created from an older
+    // generation of the model's custom geometry.
+    QSSGRenderMesh *getMeshForPicking(const QSSGRenderModel &model, bool *outIsCurrent = nullptr) const;
     QSSGBounds3 getModelBounds(const QSSGRenderModel *model) const;
 
     QSSGRenderMesh *loadMesh(const QSSGRenderModel *model);
+    // False for models that are not asynchronous and for meshes that are always loaded
+    // synchronously (primitives, meshes registered at runtime, custom geometry).
+    static bool canLoadMeshAsync(const QSSGRenderModel &model);
+    LoadStatus meshLoadStatus(const QSSGRenderModel &model) const;
+    // Starts loading the mesh of an asynchronous model in the background, without using it for
+    // rendering. For models that are not prepared for rendering but need a status and bounds.
+    void requestMeshLoad(const QSSGRenderModel &model);
+    bool hasPendingMeshLoads() const { return !pendingMeshLoads.isEmpty(); }
+    LoadStatus imageLoadStatus(const QSSGRenderImage &image) const;
+    // Starts loading the image of a texture in the background, without using it for
+    // rendering. For textures that are not sampled by any material but need a status.
+    void requestImageLoad(const QSSGRenderImage &image);
+    bool hasPendingImageLoads() const { return !pendingImageLoads.isEmpty(); }
+
+    // Level of detail streaming (QT_QUICK3D_MESH_LOD_STREAMING). Records that a subset
+    // of the mesh wants to be drawn with 'level' and returns the finest level that is
+    // resident right now. Finer levels are loaded once all layers have been prepared.
+    quint32 streamLevelOfDetail(QSSGRenderMesh &mesh, quint32 level);
+    bool hasPendingMeshLodRequests() const { return lodStreamingRequested; }
 
     // Called at the end of the frame to release unreferenced geometry and textures
     void cleanupUnreferencedBuffers(quint32 frameId, QSSGRenderLayer *layer);
@@ -206,12 +243,25 @@ private:
     QSSGRenderMesh *loadRenderMesh(QSSGRenderGeometry *geometry, QSSGMeshProcessingOptions options);
 
     QSSGRenderMesh *createRenderMesh(const QSSGMesh::Mesh &mesh, const QString &debugObjectName = {});
+    QSSGRenderMesh *insertRenderMesh(const QSSGRenderPath &inMeshPath, const QSSGMesh::Mesh &mesh,
+                                     const QString &sourcePath, const QSSGMeshProcessingOptions &options);
+    QSSGRenderMesh *loadRenderMeshAsync(const QSSGRenderPath &inMeshPath, const QSSGMeshProcessingOptions &options);
+    void startMeshLoad(const QSSGRenderPath &inMeshPath, const QSSGMeshProcessingOptions &options);
+    static QSSGMesh::Mesh loadMeshDataWithOptions(const QSSGRenderPath &inMeshPath,
+                                                  const QSSGMeshProcessingOptions &options,
+                                                  QString *sourcePath);
     QSSGRenderImageTexture loadTextureData(QSSGRenderTextureData *data, MipMode inMipMode);
+    QSSGRenderImageTexture loadRenderImageAsync(const QSSGRenderImage *image, const ImageCacheKey &imageKey, LoadRenderImageFlags flags);
+    void startImageLoad(const QSSGRenderImage &image, const ImageCacheKey &imageKey, bool flipY);
+    static bool hasTransparency(const QSSGLoadedTexture &texture);
     bool createEnvironmentMap(const QSSGLoadedTexture *inImage, QSSGRenderImageTexture *outTexture, const QString &debugObjectName);
 
     void releaseMesh(const QSSGRenderPath &inSourcePath);
     void releaseImage(const ImageCacheKey &key);
 
+    void updateStreamedMeshLods();
+    void setResidentLevelOfDetail(QSSGRenderMesh *mesh, quint32 level);
+
     QSSGRenderContextInterface *m_contextInterface = nullptr; // ContextInterfaces owns BufferManager
 
     // These store the actual buffer handles
@@ -222,8 +272,36 @@ private:
     QHash<QSSGRenderPath, MeshData> meshMap;                    // Meshes (specififed by path)
     QHash<QSSGRenderGeometry *, MeshData> customMeshMap;        // Meshes (QQuick3DGeometry)
 
+    // Mesh files being read and parsed on the thread pool
+    struct AsyncMeshLoad {
+        QSSGMesh::Mesh mesh;
+        QString sourcePath;
+        QSSGMeshProcessingOptions options;
+        std::atomic_bool finished = false;
+        bool requested = true; // Requested since the last cleanup, only touched by the render thread
+    };
+    QHash<QSSGRenderPath, std::shared_ptr<AsyncMeshLoad>> pendingMeshLoads;
+    QHash<QSSGRenderPath, bool> failedMeshLoads; // Requested since the last cleanup
+
+    // Image files being decoded and scanned for transparency on the thread pool
+    struct AsyncImageLoad {
+        std::unique_ptr<QSSGLoadedTexture> texture;
+        bool hasTransparency = false;
+        std::atomic_bool finished = false;
+        bool requested = true; // Requested since the last cleanup, only touched by the render thread
+    };
+    QHash<ImageCacheKey, std::shared_ptr<AsyncImageLoad>> pendingImageLoads;
+
     QRhiResourceUpdateBatch *meshBufferUpdates = nullptr;
     QMutex meshBufferMutex;
+    // Memory mapped meshes whose data is referenced by the upload batch. Kept until the
+    // frame the batch was committed in has been submitted (frame index, mesh).
+    QList<QSSGMesh::Mesh> mappedMeshUploads;
+    QList<std::pair<quint32, QSSGMesh::Mesh>> committedMappedMeshUploads;
+
+    bool lodStreamingRequested = false;
+    bool lodStreamingBudgetLimited = false; // some mesh did not get its level at the last update
+    QSet<const QSSGRenderLayer *> lodStreamingLayers; // prepared since the last updateStreamedMeshLods()
 
     quint32 frameCleanupIndex = 0;
     quint32 frameResetIndex = 0;
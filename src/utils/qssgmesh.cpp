@@ -4,6 +4,10 @@
 #include "qssgmesh_p.h"
 
 #include <QtCore/QVector>
+#include <QtCore/QFile>
+#include <QtCore/qendian.h>
+#include <QtCore/qfloat16.h>
+#include <QtCore/qvarlengtharray.h>
 #include <QtQuick3DUtils/private/qssgdataref_p.h>
 #include <QtQuick3DUtils/private/qssglightmapuvgenerator_p.h>
 
@@ -40,16 +44,103 @@ static const size_t SUBSET_STRUCT_SIZE_V6 = 52;
 //lod entry: count, offset, distance
 static const size_t LOD_STRUCT_SIZE = 12;
 
-MeshInternal::MultiMeshInfo MeshInternal::readFileHeader(QIODevice *device)
+namespace {
+
+// Reads through a QDataStream on the device, buffer data is copied out of the device
+struct StreamMeshReader
+{
+    explicit StreamMeshReader(QIODevice *device)
+        : device(device), stream(device)
+    {
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    }
+
+    template <typename T>
+    StreamMeshReader &operator>>(T &value)
+    {
+        stream >> value;
+        return *this;
+    }
+
+    QByteArray read(quint32 size) { return device->read(size); }
+    void skip(quint32 size) { device->skip(size); }
+    void seek(qint64 pos) { device->seek(pos); }
+    qint64 pos() const { return device->pos(); }
+    qint64 size() const { return device->size(); }
+    // Short reads are tolerated like they always have been, the result is just an incomplete mesh
+    bool hasError() const { return false; }
+
+    QIODevice *device;
+    QDataStream stream;
+};
+
+// Reads from a memory mapped file, buffer data is returned as views into the mapping.
+// Any read past the end of the mapping puts the reader in an error state.
+struct MappedMeshReader
+{
+    MappedMeshReader(const uchar *data, qint64 size)
+        : data(data), dataSize(size)
+    {
+    }
+
+    bool ensure(qint64 count)
+    {
+        if (error || count < 0 || count > dataSize - position)
+            error = true;
+        return !error;
+    }
+
+    template <typename T>
+    MappedMeshReader &operator>>(T &value)
+    {
+        if (ensure(qint64(sizeof(T)))) {
+            value = qFromLittleEndian<T>(data + position);
+            position += qint64(sizeof(T));
+        } else {
+            value = T();
+        }
+        return *this;
+    }
+
+    QByteArray read(quint32 size)
+    {
+        if (!ensure(size))
+            return QByteArray();
+        QByteArray view = QByteArray::fromRawData(reinterpret_cast<const char *>(data + position), qsizetype(size));
+        position += size;
+        return view;
+    }
+    void skip(quint32 size)
+    {
+        if (ensure(size))
+            position += size;
+    }
+    void seek(qint64 pos)
+    {
+        if (pos < 0 || pos > dataSize)
+            error = true;
+        else
+            position = pos;
+    }
+    qint64 pos() const { return position; }
+    qint64 size() const { return dataSize; }
+    bool hasError() const { return error; }
+
+    const uchar *data;
+    qint64 dataSize;
+    qint64 position = 0;
+    bool error = false;
+};
+
+template <typename Reader>
+MeshInternal::MultiMeshInfo readFileHeaderImpl(Reader &inputStream)
 {
-    const qint64 multiHeaderStartOffset = device->size() - qint64(MULTI_HEADER_STRUCT_SIZE);
+    const qint64 multiHeaderStartOffset = inputStream.size() - qint64(MULTI_HEADER_STRUCT_SIZE);
 
-    device->seek(multiHeaderStartOffset);
-    QDataStream inputStream(device);
-    inputStream.setByteOrder(QDataStream::LittleEndian);
-    inputStream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    inputStream.seek(multiHeaderStartOffset);
 
-    MultiMeshInfo meshFileInfo;
+    MeshInternal::MultiMeshInfo meshFileInfo;
     inputStream >> meshFileInfo.fileId >> meshFileInfo.fileVersion;
 
     if (!meshFileInfo.isValid()) {
@@ -61,19 +152,129 @@ MeshInternal::MultiMeshInfo MeshInternal::readFileHeader(QIODevice *device)
     quint32 meshCount;
     inputStream >> multiEntriesOffset >> meshCount;
 
-    for (quint32 i = 0; i < meshCount; ++i) {
-        device->seek(multiHeaderStartOffset
+    for (quint32 i = 0; i < meshCount && !inputStream.hasError(); ++i) {
+        inputStream.seek(multiHeaderStartOffset
                      - (qint64(MULTI_ENTRY_STRUCT_SIZE) * meshCount)
                      + (qint64(MULTI_ENTRY_STRUCT_SIZE) * i));
         quint64 offset;
         quint32 id;
         inputStream >> offset >> id;
+        if (inputStream.hasError())
+            break;
         meshFileInfo.meshEntries.insert(id, offset);
     }
 
     return meshFileInfo;
 }
 
+bool decodeVertexBuffer(const QByteArray &encodedData, quint32 dataSize, Mesh::VertexBuffer *vertexBuffer)
+{
+    vertexBuffer->data.clear();
+    if (dataSize == 0)
+        return true;
+
+    // meshoptimizer asserts on these, so a corrupt file must not get that far
+    const quint32 stride = vertexBuffer->stride;
+    if (stride == 0 || stride > 256 || stride % 4 != 0 || dataSize % stride != 0)
+        return false;
+
+    QByteArray data(dataSize, Qt::Uninitialized);
+    if (meshopt_decodeVertexBuffer(data.data(), dataSize / stride, stride,
+                                   reinterpret_cast<const unsigned char *>(encodedData.constData()),
+                                   size_t(encodedData.size())) != 0)
+        return false;
+
+    vertexBuffer->data = data;
+    return true;
+}
+
+bool decodeIndexBuffer(const QByteArray &encodedData, quint32 dataSize, Mesh::DrawMode drawMode, Mesh::IndexBuffer *indexBuffer)
+{
+    indexBuffer->data.clear();
+    if (dataSize == 0)
+        return true;
+
+    const quint32 indexSize = MeshInternal::byteSizeForComponentType(indexBuffer->componentType);
+    if ((indexSize != 2 && indexSize != 4) || dataSize % indexSize != 0)
+        return false;
+
+    const size_t indexCount = dataSize / indexSize;
+    const unsigned char *src = reinterpret_cast<const unsigned char *>(encodedData.constData());
+    QByteArray data(dataSize, Qt::Uninitialized);
+    int result = -1;
+    if (drawMode == Mesh::DrawMode::Triangles) {
+        if (indexCount % 3 == 0)
+            result = meshopt_decodeIndexBuffer(data.data(), indexCount, indexSize, src, size_t(encodedData.size()));
+    } else {
+        result = meshopt_decodeIndexSequence(data.data(), indexCount, indexSize, src, size_t(encodedData.size()));
+    }
+    if (result != 0)
+        return false;
+
+    indexBuffer->data = data;
+    return true;
+}
+
+QByteArray encodeVertexBuffer(const Mesh::VertexBuffer &vertexBuffer)
+{
+    if (vertexBuffer.data.isEmpty())
+        return QByteArray();
+
+    const size_t vertexCount = vertexBuffer.data.size() / vertexBuffer.stride;
+    QByteArray encodedData(meshopt_encodeVertexBufferBound(vertexCount, vertexBuffer.stride), Qt::Uninitialized);
+    const size_t encodedSize = meshopt_encodeVertexBuffer(reinterpret_cast<unsigned char *>(encodedData.data()),
+                                                          size_t(encodedData.size()),
+                                                          vertexBuffer.data.constData(),
+                                                          vertexCount,
+                                                          vertexBuffer.stride);
+    encodedData.resize(qsizetype(encodedSize));
+    return encodedData;
+}
+
+QByteArray encodeIndexBuffer(const Mesh::IndexBuffer &indexBuffer, Mesh::DrawMode drawMode)
+{
+    const quint32 indexSize = MeshInternal::byteSizeForComponentType(indexBuffer.componentType);
+    const qsizetype indexCount = indexBuffer.data.size() / indexSize;
+    if (indexCount == 0)
+        return QByteArray();
+
+    // The encoder only takes 32-bit indices, the index size is restored when decoding
+    QVector<quint32> indices(indexCount);
+    if (indexSize == 2) {
+        const quint16 *src = reinterpret_cast<const quint16 *>(indexBuffer.data.constData());
+        std::copy(src, src + indexCount, indices.begin());
+    } else {
+        memcpy(indices.data(), indexBuffer.data.constData(), indexCount * sizeof(quint32));
+    }
+    const size_t vertexCount = *std::max_element(indices.cbegin(), indices.cend()) + 1;
+
+    QByteArray encodedData;
+    size_t encodedSize = 0;
+    if (drawMode == Mesh::DrawMode::Triangles) {
+        encodedData.resize(qsizetype(meshopt_encodeIndexBufferBound(indexCount, vertexCount)));
+        encodedSize = meshopt_encodeIndexBuffer(reinterpret_cast<unsigned char *>(encodedData.data()),
+                                                size_t(encodedData.size()),
+                                                indices.constData(),
+                                                indexCount);
+    } else {
+        encodedData.resize(qsizetype(meshopt_encodeIndexSequenceBound(indexCount, vertexCount)));
+        encodedSize = meshopt_encodeIndexSequence(reinterpret_cast<unsigned char *>(encodedData.data()),
+                                                  size_t(encodedData.size()),
+                                                  indices.constData(),
+                                                  indexCount);
+    }
+    encodedData.resize(qsizetype(encodedSize));
+    return encodedData;
+}
+
+} // namespace
+
+MeshInternal::MultiMeshInfo MeshInternal::readFileHeader(QIODevice *device)
+{
+    StreamMeshReader reader(device);
+    return readFileHeaderImpl(reader);
+}
+
 void MeshInternal::writeFileHeader(QIODevice *device, const MeshInternal::MultiMeshInfo &meshFileInfo)
 {
     QDataStream outputStream(device);
@@ -92,14 +293,10 @@ void MeshInternal::writeFileHeader(QIODevice *device, const MeshInternal::MultiM
     outputStream << meshFileInfo.fileId << meshFileInfo.fileVersion << multiEntriesOffset << meshCount;
 }
 
-quint64 MeshInternal::readMeshData(QIODevice *device, quint64 offset, Mesh *mesh, MeshDataHeader *header)
+template <typename Reader>
+quint64 MeshInternal::readMeshDataImpl(Reader &inputStream, quint64 offset, Mesh *mesh, MeshDataHeader *header)
 {
-    static char alignPadding[4] = {};
-
-    device->seek(offset);
-    QDataStream inputStream(device);
-    inputStream.setByteOrder(QDataStream::LittleEndian);
-    inputStream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    inputStream.seek(qint64(offset));
 
     inputStream >> header->fileId >> header->fileVersion >> header->flags >> header->sizeInBytes;
     if (!header->isValid()) {
@@ -116,7 +313,7 @@ quint64 MeshInternal::readMeshData(QIODevice *device, quint64 offset, Mesh *mesh
     }
 
     MeshInternal::MeshOffsetTracker offsetTracker(offset + MESH_HEADER_STRUCT_SIZE);
-    Q_ASSERT(offsetTracker.offset() == device->pos());
+    Q_ASSERT(inputStream.hasError() || offsetTracker.offset() == inputStream.pos());
 
     quint32 targetBufferEntriesCount;
     quint32 vertexBufferEntriesCount;
@@ -167,12 +364,14 @@ quint64 MeshInternal::readMeshData(QIODevice *device, quint64 offset, Mesh *mesh
                     >> vertexBufferEntry.componentCount
                     >> vertexBufferEntry.offset;
         vertexBufferEntry.componentType = Mesh::ComponentType(componentType);
+        if (inputStream.hasError())
+            break;
         mesh->m_vertexBuffer.entries.append(vertexBufferEntry);
         entriesByteSize += VERTEX_BUFFER_ENTRY_STRUCT_SIZE;
     }
     quint32 alignAmount = offsetTracker.alignedAdvance(entriesByteSize);
     if (alignAmount)
-        device->read(alignPadding, alignAmount);
+        inputStream.skip(alignAmount);
 
     // vertex buffer entry names
     quint32 numTargets = 0;
@@ -183,11 +382,11 @@ quint64 MeshInternal::readMeshData(QIODevice *device, quint64 offset, Mesh *mesh
         quint32 nameLength;
         inputStream >> nameLength;
         offsetTracker.advance(sizeof(quint32));
-        const QByteArray nameWithZeroTerminator = device->read(nameLength);
+        const QByteArray nameWithZeroTerminator = inputStream.read(nameLength);
         entry.name = QByteArray(nameWithZeroTerminator.constData(), qMax(0, nameWithZeroTerminator.size() - 1));
         alignAmount = offsetTracker.alignedAdvance(nameLength);
         if (alignAmount)
-            device->read(alignPadding, alignAmount);
+            inputStream.skip(alignAmount);
         // Old morph meshes' target attributes were appended sequentially
         // behind vertex attributes. However, since the number of targets are restricted by 8
         // the other attributes were named by "attr_unsupported"
@@ -236,15 +435,41 @@ quint64 MeshInternal::readMeshData(QIODevice *device, quint64 offset, Mesh *mesh
         }
     }
 
-    mesh->m_vertexBuffer.data = device->read(vertexBufferDataSize);
-    alignAmount = offsetTracker.alignedAdvance(vertexBufferDataSize);
-    if (alignAmount)
-        device->read(alignPadding, alignAmount);
+    if (header->hasCompressedBuffers()) {
+        // the sizes above are the decoded sizes, the encoded data is prefixed with its own size
+        quint32 encodedSize = 0;
+        inputStream >> encodedSize;
+        offsetTracker.advance(sizeof(quint32));
+        QByteArray encodedData = inputStream.read(encodedSize);
+        alignAmount = offsetTracker.alignedAdvance(encodedSize);
+        if (alignAmount)
+            inputStream.skip(alignAmount);
+        if (!inputStream.hasError() && !decodeVertexBuffer(encodedData, vertexBufferDataSize, &mesh->m_vertexBuffer)) {
+            qWarning() << "Failed to decode compressed vertex data";
+            return 0;
+        }
 
-    mesh->m_indexBuffer.data = device->read(indexBufferDataSize);
-    alignAmount = offsetTracker.alignedAdvance(indexBufferDataSize);
-    if (alignAmount)
-        device->read(alignPadding, alignAmount);
+        inputStream >> encodedSize;
+        offsetTracker.advance(sizeof(quint32));
+        encodedData = inputStream.read(encodedSize);
+        alignAmount = offsetTracker.alignedAdvance(encodedSize);
+        if (alignAmount)
+            inputStream.skip(alignAmount);
+        if (!inputStream.hasError() && !decodeIndexBuffer(encodedData, indexBufferDataSize, mesh->m_drawMode, &mesh->m_indexBuffer)) {
+            qWarning() << "Failed to decode compressed index data";
+            return 0;
+        }
+    } else {
+        mesh->m_vertexBuffer.data = inputStream.read(vertexBufferDataSize);
+        alignAmount = offsetTracker.alignedAdvance(vertexBufferDataSize);
+        if (alignAmount)
+            inputStream.skip(alignAmount);
+
+        mesh->m_indexBuffer.data = inputStream.read(indexBufferDataSize);
+        alignAmount = offsetTracker.alignedAdvance(indexBufferDataSize);
+        if (alignAmount)
+            inputStream.skip(alignAmount);
+    }
 
     quint32 subsetByteSize = 0;
     QVector<MeshInternal::Subset> internalSubsets;
@@ -286,18 +511,19 @@ quint64 MeshInternal::readMeshData(QIODevice *device, quint64 offset, Mesh *mesh
             subset.lightmapSizeHint = QSize(0, 0);
             subsetByteSize += SUBSET_STRUCT_SIZE_V3_V4;
         }
+        if (inputStream.hasError())
+            break;
         internalSubsets.append(subset);
-
     }
     alignAmount = offsetTracker.alignedAdvance(subsetByteSize);
     if (alignAmount)
-        device->read(alignPadding, alignAmount);
+        inputStream.skip(alignAmount);
 
     for (MeshInternal::Subset &internalSubset : internalSubsets) {
-        internalSubset.rawNameUtf16 = device->read(internalSubset.nameLength * 2); //UTF_16_le
+        internalSubset.rawNameUtf16 = inputStream.read(internalSubset.nameLength * 2); //UTF_16_le
         alignAmount = offsetTracker.alignedAdvance(internalSubset.nameLength * 2);
         if (alignAmount)
-            device->read(alignPadding, alignAmount);
+            inputStream.skip(alignAmount);
     }
 
     quint32 lodByteSize = 0;
@@ -319,8 +545,13 @@ quint64 MeshInternal::readMeshData(QIODevice *device, quint64 offset, Mesh *mesh
     }
     alignAmount = offsetTracker.alignedAdvance(lodByteSize);
     if (alignAmount)
-        device->read(alignPadding, alignAmount);
+        inputStream.skip(alignAmount);
+
 
+    if (inputStream.hasError()) {
+        qWarning() << "Mesh data truncated";
+        return 0;
+    }
 
     // Data for morphTargets
     if (targetBufferEntriesCount > 0) {
@@ -335,25 +566,27 @@ quint64 MeshInternal::readMeshData(QIODevice *device, quint64 offset, Mesh *mesh
                             >> targetBufferEntry.componentCount
                             >> targetBufferEntry.offset;
                 targetBufferEntry.componentType = Mesh::ComponentType(componentType);
+                if (inputStream.hasError())
+                    break;
                 mesh->m_targetBuffer.entries.append(targetBufferEntry);
                 entriesByteSize += VERTEX_BUFFER_ENTRY_STRUCT_SIZE;
             }
             alignAmount = offsetTracker.alignedAdvance(entriesByteSize);
             if (alignAmount)
-                device->read(alignPadding, alignAmount);
+                inputStream.skip(alignAmount);
 
             for (auto &entry : mesh->m_targetBuffer.entries) {
                 quint32 nameLength;
                 inputStream >> nameLength;
                 offsetTracker.advance(sizeof(quint32));
-                const QByteArray nameWithZeroTerminator = device->read(nameLength);
+                const QByteArray nameWithZeroTerminator = inputStream.read(nameLength);
                 entry.name = QByteArray(nameWithZeroTerminator.constData(), qMax(0, nameWithZeroTerminator.size() - 1));
                 alignAmount = offsetTracker.alignedAdvance(nameLength);
                 if (alignAmount)
-                    device->read(alignPadding, alignAmount);
+                    inputStream.skip(alignAmount);
             }
 
-            mesh->m_targetBuffer.data = device->read(targetBufferDataSize);
+            mesh->m_targetBuffer.data = inputStream.read(targetBufferDataSize);
         } else {
             // remove target entries from vertexbuffer entries
             mesh->m_vertexBuffer.entries.remove(vertexBufferEntriesCount - targetBufferEntriesCount,
@@ -383,9 +616,20 @@ quint64 MeshInternal::readMeshData(QIODevice *device, quint64 offset, Mesh *mesh
         }
     }
 
+    if (inputStream.hasError()) {
+        qWarning() << "Mesh data truncated";
+        return 0;
+    }
+
     return header->sizeInBytes;
 }
 
+quint64 MeshInternal::readMeshData(QIODevice *device, quint64 offset, Mesh *mesh, MeshDataHeader *header)
+{
+    StreamMeshReader reader(device);
+    return readMeshDataImpl(reader, offset, mesh, header);
+}
+
 void MeshInternal::writeMeshHeader(QIODevice *device, const MeshDataHeader &header)
 {
     QDataStream outputStream(device);
@@ -404,7 +648,7 @@ void MeshInternal::writeMeshHeader(QIODevice *device, const MeshDataHeader &head
 // that's also legacy nonsense, but having that allows the reader not have to
 // branch based on the version.
 
-quint64 MeshInternal::writeMeshData(QIODevice *device, const Mesh &mesh)
+quint64 MeshInternal::writeMeshData(QIODevice *device, const Mesh &mesh, quint16 flags)
 {
     static const char alignPadding[4] = {};
 
@@ -474,15 +718,29 @@ quint64 MeshInternal::writeMeshData(QIODevice *device, const Mesh &mesh)
             device->write(alignPadding, alignAmount);
     }
 
-    device->write(mesh.m_vertexBuffer.data.constData(), vertexBufferDataSize);
-    alignAmount = offsetTracker.alignedAdvance(vertexBufferDataSize);
-    if (alignAmount)
-        device->write(alignPadding, alignAmount);
+    if (flags & MeshDataHeader::CompressedBuffers) {
+        Q_ASSERT(canCompressBuffers(mesh));
+        const QByteArray encodedBuffers[2] = { encodeVertexBuffer(mesh.m_vertexBuffer),
+                                               encodeIndexBuffer(mesh.m_indexBuffer, mesh.m_drawMode) };
+        for (const QByteArray &encodedData : encodedBuffers) {
+            const quint32 encodedSize = encodedData.size();
+            outputStream << encodedSize;
+            device->write(encodedData.constData(), encodedSize);
+            alignAmount = offsetTracker.alignedAdvance(sizeof(quint32) + encodedSize);
+            if (alignAmount)
+                device->write(alignPadding, alignAmount);
+        }
+    } else {
+        device->write(mesh.m_vertexBuffer.data.constData(), vertexBufferDataSize);
+        alignAmount = offsetTracker.alignedAdvance(vertexBufferDataSize);
+        if (alignAmount)
+            device->write(alignPadding, alignAmount);
 
-    device->write(mesh.m_indexBuffer.data.constData(), indexBufferDataSize);
-    alignAmount = offsetTracker.alignedAdvance(indexBufferDataSize);
-    if (alignAmount)
-        device->write(alignPadding, alignAmount);
+        device->write(mesh.m_indexBuffer.data.constData(), indexBufferDataSize);
+        alignAmount = offsetTracker.alignedAdvance(indexBufferDataSize);
+        if (alignAmount)
+            device->write(alignPadding, alignAmount);
+    }
 
     quint32 subsetByteSize = 0;
     for (quint32 i = 0; i < subsetsCount; ++i) {
@@ -578,6 +836,166 @@ quint64 MeshInternal::writeMeshData(QIODevice *device, const Mesh &mesh)
     return sizeInBytes;
 }
 
+bool MeshInternal::canCompressBuffers(const Mesh &mesh)
+{
+    const quint32 stride = mesh.m_vertexBuffer.stride;
+    if (!mesh.m_vertexBuffer.data.isEmpty()) {
+        // the vertex codec works on whole 32-bit words, up to 256 bytes per vertex
+        if (stride == 0 || stride > 256 || stride % 4 != 0 || mesh.m_vertexBuffer.data.size() % stride != 0)
+            return false;
+    }
+
+    if (!mesh.m_indexBuffer.data.isEmpty()) {
+        const quint32 indexSize = byteSizeForComponentType(mesh.m_indexBuffer.componentType);
+        if ((indexSize != 2 && indexSize != 4) || mesh.m_indexBuffer.data.size() % indexSize != 0)
+            return false;
+        if (mesh.m_drawMode == Mesh::DrawMode::Triangles && (mesh.m_indexBuffer.data.size() / indexSize) % 3 != 0)
+            return false;
+    }
+
+    return true;
+}
+
+// Lightmap UVs are left alone, half floats do not have enough precision for
+// addressing texels in large lightmaps.
+static bool isQuantizableAttribute(const Mesh::VertexBufferEntry &entry)
+{
+    if (entry.componentType != Mesh::ComponentType::Float32)
+        return false;
+
+    return entry.name == MeshInternal::getNormalAttrName()
+            || entry.name == MeshInternal::getTexTanAttrName()
+            || entry.name == MeshInternal::getTexBinormalAttrName()
+            || entry.name == MeshInternal::getUV0AttrName()
+            || entry.name == MeshInternal::getUV1AttrName();
+}
+
+// Number of float components of an attribute before quantizeVertexBuffer() padded it
+static quint32 unquantizedComponentCount(const Mesh::VertexBufferEntry &entry)
+{
+    if (entry.name == MeshInternal::getUV0AttrName() || entry.name == MeshInternal::getUV1AttrName())
+        return 2;
+    return 3;
+}
+
+Mesh::VertexBuffer MeshInternal::quantizeVertexBuffer(const Mesh::VertexBuffer &vertexBuffer)
+{
+    if (vertexBuffer.stride == 0 || vertexBuffer.data.isEmpty())
+        return vertexBuffer;
+
+    Mesh::VertexBuffer result;
+    QVarLengthArray<quint32, 16> srcOffsets;
+    QVarLengthArray<quint32, 16> srcByteSizes;
+    QVarLengthArray<bool, 16> quantize;
+    bool hasQuantizableAttribute = false;
+    for (const Mesh::VertexBufferEntry &entry : vertexBuffer.entries) {
+        Mesh::VertexBufferEntry newEntry = entry;
+        const bool q = isQuantizableAttribute(entry);
+        if (q) {
+            // Keep the attributes 4 byte aligned, there are no 3 component
+            // half formats with some of the graphics APIs either.
+            newEntry.componentType = Mesh::ComponentType::Float16;
+            newEntry.componentCount = (entry.componentCount + 1) & ~1u;
+            hasQuantizableAttribute = true;
+        }
+        newEntry.offset = result.stride;
+        const quint32 byteSize = byteSizeForComponentType(newEntry.componentType) * newEntry.componentCount;
+        result.stride += (byteSize + 3) & ~3u;
+        result.entries.append(newEntry);
+        srcOffsets.append(entry.offset);
+        srcByteSizes.append(byteSizeForComponentType(entry.componentType) * entry.componentCount);
+        quantize.append(q);
+    }
+
+    if (!hasQuantizableAttribute)
+        return vertexBuffer;
+
+    const qsizetype vertexCount = vertexBuffer.data.size() / vertexBuffer.stride;
+    result.data = QByteArray(vertexCount * result.stride, '\0');
+    const char *src = vertexBuffer.data.constData();
+    char *dst = result.data.data();
+    for (qsizetype vertexIdx = 0; vertexIdx < vertexCount; ++vertexIdx) {
+        for (qsizetype entryIdx = 0, entryEnd = result.entries.size(); entryIdx < entryEnd; ++entryIdx) {
+            const Mesh::VertexBufferEntry &entry(result.entries[entryIdx]);
+            const char *srcAttr = src + srcOffsets[entryIdx];
+            char *dstAttr = dst + entry.offset;
+            if (quantize[entryIdx]) {
+                float values[4] = {};
+                qfloat16 halfValues[4];
+                const quint32 srcComponentCount = srcByteSizes[entryIdx] / sizeof(float);
+                memcpy(values, srcAttr, qMin<size_t>(srcComponentCount, 4) * sizeof(float));
+                qFloatToFloat16(halfValues, values, 4);
+                memcpy(dstAttr, halfValues, entry.componentCount * sizeof(qfloat16));
+            } else {
+                memcpy(dstAttr, srcAttr, srcByteSizes[entryIdx]);
+            }
+        }
+        src += vertexBuffer.stride;
+        dst += result.stride;
+    }
+
+    return result;
+}
+
+Mesh::VertexBuffer MeshInternal::dequantizeVertexBuffer(const Mesh::VertexBuffer &vertexBuffer)
+{
+    if (vertexBuffer.stride == 0 || vertexBuffer.data.isEmpty())
+        return vertexBuffer;
+
+    Mesh::VertexBuffer result;
+    QVarLengthArray<quint32, 16> srcOffsets;
+    QVarLengthArray<quint32, 16> srcByteSizes;
+    QVarLengthArray<bool, 16> dequantize;
+    bool hasQuantizedAttribute = false;
+    for (const Mesh::VertexBufferEntry &entry : vertexBuffer.entries) {
+        Mesh::VertexBufferEntry newEntry = entry;
+        Mesh::VertexBufferEntry floatEntry = entry;
+        floatEntry.componentType = Mesh::ComponentType::Float32;
+        const bool d = entry.componentType == Mesh::ComponentType::Float16 && isQuantizableAttribute(floatEntry);
+        if (d) {
+            newEntry.componentType = Mesh::ComponentType::Float32;
+            newEntry.componentCount = qMin(entry.componentCount, unquantizedComponentCount(entry));
+            hasQuantizedAttribute = true;
+        }
+        newEntry.offset = result.stride;
+        const quint32 byteSize = byteSizeForComponentType(newEntry.componentType) * newEntry.componentCount;
+        result.stride += (byteSize + 3) & ~3u;
+        result.entries.append(newEntry);
+        srcOffsets.append(entry.offset);
+        srcByteSizes.append(byteSizeForComponentType(entry.componentType) * entry.componentCount);
+        dequantize.append(d);
+    }
+
+    if (!hasQuantizedAttribute)
+        return vertexBuffer;
+
+    const qsizetype vertexCount = vertexBuffer.data.size() / vertexBuffer.stride;
+    result.data = QByteArray(vertexCount * result.stride, '\0');
+    const char *src = vertexBuffer.data.constData();
+    char *dst = result.data.data();
+    for (qsizetype vertexIdx = 0; vertexIdx < vertexCount; ++vertexIdx) {
+        for (qsizetype entryIdx = 0, entryEnd = result.entries.size(); entryIdx < entryEnd; ++entryIdx) {
+            const Mesh::VertexBufferEntry &entry(result.entries[entryIdx]);
+            const char *srcAttr = src + srcOffsets[entryIdx];
+            char *dstAttr = dst + entry.offset;
+            if (dequantize[entryIdx]) {
+                qfloat16 halfValues[4] = {};
+                float values[4];
+                const quint32 srcComponentCount = srcByteSizes[entryIdx] / sizeof(qfloat16);
+                memcpy(halfValues, srcAttr, qMin<size_t>(srcComponentCount, 4) * sizeof(qfloat16));
+                qFloatFromFloat16(values, halfValues, 4);
+                memcpy(dstAttr, values, entry.componentCount * sizeof(float));
+            } else {
+                memcpy(dstAttr, srcAttr, srcByteSizes[entryIdx]);
+            }
+        }
+        src += vertexBuffer.stride;
+        dst += result.stride;
+    }
+
+    return result;
+}
+
 Mesh Mesh::loadMesh(QIODevice *device, quint32 id)
 {
     MeshInternal::MeshDataHeader header;
@@ -597,6 +1015,34 @@ Mesh Mesh::loadMesh(QIODevice *device, quint32 id)
     return Mesh();
 }
 
+Mesh Mesh::loadMeshMapped(const QSharedPointer<QIODevice> &device, quint32 id)
+{
+    QFile *file = qobject_cast<QFile *>(device.data());
+    const qint64 fileSize = file ? file->size() : 0;
+    const uchar *data = fileSize > 0 ? file->map(0, fileSize) : nullptr;
+    if (!data)
+        return device ? loadMesh(device.data(), id) : Mesh();
+
+    MappedMeshReader headerReader(data, fileSize);
+    const MeshInternal::MultiMeshInfo meshFileInfo = readFileHeaderImpl(headerReader);
+    auto it = meshFileInfo.meshEntries.constFind(id);
+    if (it == meshFileInfo.meshEntries.constEnd()) {
+        if (id != 0 || meshFileInfo.meshEntries.isEmpty())
+            return Mesh();
+        it = meshFileInfo.meshEntries.cbegin();
+    }
+
+    Mesh mesh;
+    MeshInternal::MeshDataHeader header;
+    MappedMeshReader reader(data, fileSize);
+    if (!MeshInternal::readMeshDataImpl(reader, *it, &mesh, &header))
+        return Mesh();
+
+    // The buffers reference the mapping, which lives as long as the file is open
+    mesh.m_mappedDevice = device;
+    return mesh;
+}
+
 QMap<quint32, Mesh> Mesh::loadAll(QIODevice *device)
 {
     MeshInternal::MeshDataHeader header;
@@ -910,7 +1356,7 @@ Mesh Mesh::fromRuntimeData(const RuntimeMeshData &data, QString *error)
     return mesh;
 }
 
-quint32 Mesh::save(QIODevice *device, quint32 id) const
+quint32 Mesh::save(QIODevice *device, quint32 id, SaveOptions options) const
 {
     qint64 newMeshStartPosFromEnd = 0;
     quint32 newId = 1;
@@ -940,10 +1386,26 @@ quint32 Mesh::save(QIODevice *device, quint32 id) const
     const qint64 meshOffset = device->pos();
     header.meshEntries.insert(newId, meshOffset);
 
+    Mesh mesh = *this;
+    bool quantized = false;
+    if (options.testFlag(QuantizeAttributes)) {
+        mesh.m_vertexBuffer = MeshInternal::quantizeVertexBuffer(m_vertexBuffer);
+        quantized = mesh.m_vertexBuffer.data.constData() != m_vertexBuffer.data.constData();
+    }
+
     MeshInternal::MeshDataHeader meshHeader = MeshInternal::MeshDataHeader::withDefaults();
+    if (options.testFlag(CompressBuffers)) {
+        if (MeshInternal::canCompressBuffers(mesh))
+            meshHeader.flags |= MeshInternal::MeshDataHeader::CompressedBuffers;
+        else
+            qWarning("Mesh buffer layout is not suitable for compression, saving uncompressed");
+    }
+    if (!quantized && !(meshHeader.flags & MeshInternal::MeshDataHeader::CompressedBuffers))
+        meshHeader.fileVersion = MeshInternal::MeshDataHeader::UNCOMPRESSED_FILE_VERSION;
+
     // skip the space for the mesh header for now
     device->seek(device->pos() + MESH_HEADER_STRUCT_SIZE);
-    meshHeader.sizeInBytes = MeshInternal::writeMeshData(device, *this);
+    meshHeader.sizeInBytes = MeshInternal::writeMeshData(device, mesh, meshHeader.flags);
     // now the mesh header is ready to be written out
     device->seek(meshOffset);
     MeshInternal::writeMeshHeader(device, meshHeader);
@@ -1019,6 +1481,88 @@ bool Mesh::hasLightmapUVChannel() const
     return false;
 }
 
+quint32 Mesh::maxLevelOfDetail() const
+{
+    quint32 result = 0;
+    for (const Subset &subset : m_subsets)
+        result = qMax(result, quint32(subset.lods.size()));
+    return result;
+}
+
+// Subsets with fewer levels than requested are drawn with their coarsest one
+static inline std::pair<quint32, quint32> subsetLevelOfDetailRange(const Mesh::Subset &subset, quint32 level)
+{
+    if (level == 0 || subset.lods.isEmpty())
+        return { subset.offset, subset.count };
+    const Mesh::Lod &lod = subset.lods[qMin(qsizetype(level), subset.lods.size()) - 1];
+    return { lod.offset, lod.count };
+}
+
+quint32 Mesh::levelOfDetailIndexCount(quint32 level) const
+{
+    quint32 result = 0;
+    for (const Subset &subset : m_subsets) {
+        const auto [offset, count] = subsetLevelOfDetailRange(subset, level);
+        result = qMax(result, offset + count);
+    }
+    return result;
+}
+
+bool Mesh::arrangeLevelsOfDetailCoarsestFirst()
+{
+    const quint32 maxLevel = maxLevelOfDetail();
+    if (maxLevel == 0 || m_indexBuffer.data.isEmpty())
+        return false;
+
+    const quint32 indexSize = MeshInternal::byteSizeForComponentType(m_indexBuffer.componentType);
+    const quint32 indexCount = m_indexBuffer.data.size() / indexSize;
+    for (const Subset &subset : std::as_const(m_subsets)) {
+        for (quint32 level = 0; level <= quint32(subset.lods.size()); ++level) {
+            const auto [offset, count] = subsetLevelOfDetailRange(subset, level);
+            if (offset + count > indexCount) {
+                qWarning("Level of detail index range out of bounds, not rearranging");
+                return false;
+            }
+        }
+    }
+
+    QByteArray newIndexData;
+    newIndexData.reserve(m_indexBuffer.data.size());
+    const char *src = m_indexBuffer.data.constData();
+    QVector<Subset> newSubsets = m_subsets;
+    // A subset's coarsest level goes in with the coarsest level of the mesh,
+    // so that any prefix has something to draw for every subset.
+    for (quint32 level = maxLevel + 1; level-- > 0; ) {
+        for (qsizetype subsetIdx = 0, subsetEnd = m_subsets.size(); subsetIdx < subsetEnd; ++subsetIdx) {
+            const Subset &subset(m_subsets[subsetIdx]);
+            const quint32 subsetMaxLevel = quint32(subset.lods.size());
+            if (level != maxLevel && level >= subsetMaxLevel)
+                continue; // added already
+            const quint32 subsetLevel = qMin(level, subsetMaxLevel);
+            const auto [offset, count] = subsetLevelOfDetailRange(subset, subsetLevel);
+            const quint32 newOffset = newIndexData.size() / indexSize;
+            newIndexData.append(src + offset * indexSize, count * indexSize);
+            if (subsetLevel == 0)
+                newSubsets[subsetIdx].offset = newOffset;
+            else
+                newSubsets[subsetIdx].lods[subsetLevel - 1].offset = newOffset;
+        }
+    }
+
+    m_indexBuffer.data = newIndexData;
+    m_subsets = newSubsets;
+    return true;
+}
+
+bool Mesh::dequantizeAttributes()
+{
+    VertexBuffer vertexBuffer = MeshInternal::dequantizeVertexBuffer(m_vertexBuffer);
+    if (vertexBuffer.data.constData() == m_vertexBuffer.data.constData())
+        return false;
+    m_vertexBuffer = vertexBuffer;
+    return true;
+}
+
 bool Mesh::createLightmapUVChannel(uint lightmapBaseResolution)
 {
     const char *posAttrName = MeshInternal::getPositionAttrName();
@@ -1030,6 +1574,9 @@ bool Mesh::createLightmapUVChannel(uint lightmapBaseResolution)
     if (hasLightmapUVChannel())
         return true;
 
+    // The unwrapping reads the normals and UVs as floats
+    dequantizeAttributes();
+
     const char *srcVertexData = m_vertexBuffer.data.constData();
     const quint32 srcVertexStride = m_vertexBuffer.stride;
     if (!srcVertexStride) {
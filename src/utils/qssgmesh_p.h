@@ -23,8 +23,10 @@
 
 #include <QtCore/qstring.h>
 #include <QtCore/qbytearray.h>
+#include <QtCore/qflags.h>
 #include <QtCore/qiodevice.h>
 #include <QtCore/qmap.h>
+#include <QtCore/qsharedpointer.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -85,6 +87,19 @@ public:
     using Winding = QSSGRenderWinding;
     using ComponentType = QSSGRenderComponentType;
 
+    enum SaveOption : quint8 {
+        NoSaveOptions = 0x0,
+        // Stores the vertex and index data encoded with the meshoptimizer codecs,
+        // the buffers are decoded again when loading the mesh. The vertex data is
+        // unchanged and the triangle order and winding are preserved, but the
+        // indices of a triangle may start at a different vertex.
+        CompressBuffers = 0x1,
+        // Stores normals, tangents, binormals and the first two UV channels as
+        // half floats. Positions, lightmap UVs and other attributes are kept as-is.
+        QuantizeAttributes = 0x2
+    };
+    Q_DECLARE_FLAGS(SaveOptions, SaveOption)
+
     struct VertexBufferEntry {
         ComponentType componentType = ComponentType::Float32;
         quint32 componentCount = 0;
@@ -147,6 +162,13 @@ public:
 
     static QMap<quint32, Mesh> loadAll(QIODevice *device);
 
+    // Like loadMesh(), but maps the file into memory when 'device' is a QFile. The vertex,
+    // index and target data then point straight into the mapping instead of being copied,
+    // and the device is kept open for as long as a copy of the mesh exists. Buffer data
+    // taken out of the mesh must not outlive it. Falls back to loadMesh() when the file
+    // cannot be mapped, for example for compressed resources.
+    static Mesh loadMeshMapped(const QSharedPointer<QIODevice> &device, quint32 id = 0);
+
     static Mesh fromAssetData(const QVector<AssetVertexEntry> &vbufEntries,
                               const QByteArray &indexBufferData,
                               ComponentType indexComponentType,
@@ -157,16 +179,33 @@ public:
                                 QString *error);
 
     bool isValid() const { return !m_subsets.isEmpty(); }
+    bool isMapped() const { return !m_mappedDevice.isNull(); }
 
     DrawMode drawMode() const { return m_drawMode; }
     Winding winding() const { return m_winding; }
 
     // id 0 == generate new id; otherwise uses it as-is, and must be an unused one
-    quint32 save(QIODevice *device, quint32 id = 0) const;
+    quint32 save(QIODevice *device, quint32 id = 0, SaveOptions options = NoSaveOptions) const;
 
     bool hasLightmapUVChannel() const;
     bool createLightmapUVChannel(uint lightmapBaseResolution);
 
+    // Converts the attributes stored as half floats by QuantizeAttributes back
+    // to floats, for code that reads the vertex data on the CPU, such as
+    // lightmap baking. Returns false when there was nothing to convert.
+    bool dequantizeAttributes();
+
+    // Rearranges the index buffer so that the levels of detail of all subsets
+    // are stored coarsest first, with the full detail indices at the end. A
+    // prefix of the index buffer ending at levelOfDetailIndexCount(level) then
+    // holds everything needed to draw that level and all coarser ones.
+    // Returns false when there is nothing to rearrange.
+    bool arrangeLevelsOfDetailCoarsestFirst();
+    // The number of indices from the start of the index buffer that are needed
+    // to draw 'level' (0 is full detail) for all subsets.
+    quint32 levelOfDetailIndexCount(quint32 level) const;
+    quint32 maxLevelOfDetail() const;
+
 private:
     DrawMode m_drawMode = DrawMode::Triangles;
     Winding m_winding = Winding::CounterClockwise;
@@ -174,6 +213,7 @@ private:
     IndexBuffer m_indexBuffer;
     TargetBuffer m_targetBuffer;
     QVector<Subset> m_subsets;
+    QSharedPointer<QIODevice> m_mappedDevice;
     friend struct MeshInternal;
 };
 
@@ -310,7 +350,18 @@ struct Q_QUICK3DUTILS_EXPORT MeshInternal
         // Version 6 differs from 5 with additional lodCount per subset as well
         // as a list of Level of Detail data after the subset names.
         // Version 7 will split the morph target data
-        static const quint32 FILE_VERSION = 7;
+        // Version 8 can have the vertex and index data compressed, this is
+        // indicated by the CompressedBuffers flag. Each compressed buffer is
+        // then prefixed with the size of its encoded data. Version 8 files
+        // may also contain half float attributes (QuantizeAttributes). Meshes
+        // that use neither are written as version 7, so that older readers
+        // can still load them.
+        static const quint32 FILE_VERSION = 8;
+        static const quint32 UNCOMPRESSED_FILE_VERSION = 7;
+
+        enum Flag : quint16 {
+            CompressedBuffers = 0x1
+        };
 
         static MeshDataHeader withDefaults() {
             return { FILE_ID, FILE_VERSION, 0, 0 };
@@ -333,6 +384,10 @@ struct Q_QUICK3DUTILS_EXPORT MeshInternal
         bool hasSeparateTargetBuffer() const {
             return fileVersion >= 7;
         }
+
+        bool hasCompressedBuffers() const {
+            return fileVersion >= 8 && (flags & CompressedBuffers);
+        }
     };
 
     struct MeshOffsetTracker {
@@ -384,8 +439,18 @@ struct Q_QUICK3DUTILS_EXPORT MeshInternal
     static MultiMeshInfo readFileHeader(QIODevice *device);
     static void writeFileHeader(QIODevice *device, const MultiMeshInfo &meshFileInfo);
     static quint64 readMeshData(QIODevice *device, quint64 offset, Mesh *mesh, MeshDataHeader *header);
+    // Reader is either a QIODevice or a memory mapped file reader, see qssgmesh.cpp
+    template <typename Reader>
+    static quint64 readMeshDataImpl(Reader &reader, quint64 offset, Mesh *mesh, MeshDataHeader *header);
     static void writeMeshHeader(QIODevice *device, const MeshDataHeader &header);
-    static quint64 writeMeshData(QIODevice *device, const Mesh &mesh);
+    // flags are the MeshDataHeader flags, CompressedBuffers needs canCompressBuffers() to be true
+    static quint64 writeMeshData(QIODevice *device, const Mesh &mesh, quint16 flags = 0);
+    static bool canCompressBuffers(const Mesh &mesh);
+    // Returns a copy of the vertex buffer with the attributes listed for Mesh::QuantizeAttributes
+    // converted to half floats. Three component attributes are padded to four components.
+    static Mesh::VertexBuffer quantizeVertexBuffer(const Mesh::VertexBuffer &vertexBuffer);
+    // The reverse of quantizeVertexBuffer(), restoring the original component counts
+    static Mesh::VertexBuffer dequantizeVertexBuffer(const Mesh::VertexBuffer &vertexBuffer);
 
     static quint32 byteSizeForComponentType(Mesh::ComponentType componentType) { return quint32(QSSGBaseTypeHelpers::getSizeOfType(componentType)); }
 
@@ -431,6 +496,8 @@ void Q_QUICK3DUTILS_EXPORT optimizeVertexCache(unsigned int* destination,
 
 } // namespace QSSGMesh
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(QSSGMesh::Mesh::SaveOptions)
+
 QT_END_NAMESPACE
 
 #endif // QSSGMESHUTILITIES_P_H
@@ -22,6 +22,8 @@
 #include <QtGui/QVector2D>
 #include <QtCore/QVector>
 
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
 class QSSGMeshBVH;
@@ -80,9 +82,39 @@ struct Q_QUICK3DUTILS_EXPORT QSSGMeshBVHTriangle
     QVector2D uvCoord3;
 };
 
+// Node of the packed BVH (see QSSGMeshBVHBuilder::buildPackedTree()). The nodes are stored
+// in depth-first order, so the left child of an inner node directly follows its parent.
+struct Q_QUICK3DUTILS_EXPORT QSSGMeshBVHPackedNode
+{
+    QVector3D minimum;
+    // Inner node: index of the right child, leaf: first triangle in the triangle index array
+    quint32 index = 0;
+    QVector3D maximum;
+    // Number of triangles in a leaf, 0 for inner nodes
+    quint32 count = 0;
+
+    [[nodiscard]] bool isLeaf() const { return count != 0; }
+    [[nodiscard]] QSSGBounds3 bounds() const { return QSSGBounds3(minimum, maximum); }
+};
+
+static_assert(sizeof(QSSGMeshBVHPackedNode) == 32, "Packed BVH nodes are expected to be 32 bytes");
+
+// The triangles of the packed BVH in leaf order as a structure of arrays (the first vertex and
+// the two edges leaving it) for intersecting several triangles at once. The arrays are padded
+// with degenerate triangles so that Padding floats can be loaded from any triangle.
+struct Q_QUICK3DUTILS_EXPORT QSSGMeshBVHTriangleSoA
+{
+    static constexpr size_t Padding = 8;
+
+    std::vector<float> vertex0[3];
+    std::vector<float> edge1[3];
+    std::vector<float> edge2[3];
+};
+
 using QSSGMeshBVHTriangles = std::vector<QSSGMeshBVHTriangle>;
 using QSSGMeshBVHRoots = std::vector<QSSGMeshBVHNode::Handle>;
 using QSSGMeshBVHNodes = std::vector<QSSGMeshBVHNode>;
+using QSSGMeshBVHPackedNodes = std::vector<QSSGMeshBVHPackedNode>;
 
 class Q_QUICK3DUTILS_EXPORT QSSGMeshBVH
 {
@@ -100,6 +132,21 @@ public:
     [[nodiscard]] const QSSGMeshBVHRoots &roots() const { return m_roots; }
     [[nodiscard]] const QSSGMeshBVHNodes &nodes() const { return m_nodes; }
 
+    // Packed layout, only set when built with QSSGMeshBVHBuilder::buildPackedTree() (the
+    // triangles, roots and nodes above are empty then).
+    static constexpr quint32 InvalidPackedRoot = std::numeric_limits<quint32>::max();
+    [[nodiscard]] bool isPacked() const { return !m_packedRoots.empty(); }
+    // Root node for each subset, InvalidPackedRoot for subsets without triangles
+    [[nodiscard]] const std::vector<quint32> &packedRoots() const { return m_packedRoots; }
+    [[nodiscard]] const QSSGMeshBVHPackedNodes &packedNodes() const { return m_packedNodes; }
+    // Three vertex indices per triangle, in the order the leaves reference them
+    [[nodiscard]] const std::vector<quint32> &triangleIndices() const { return m_triangleIndices; }
+    [[nodiscard]] const std::vector<QVector3D> &vertices() const { return m_vertices; }
+    // Same indices as vertices(), empty if the mesh has no texture coordinates
+    [[nodiscard]] const std::vector<QVector2D> &uvs() const { return m_uvs; }
+    // Same order as triangleIndices()
+    [[nodiscard]] const QSSGMeshBVHTriangleSoA &triangleSoA() const { return m_triangleSoA; }
+
 private:
     friend class QSSGMeshBVHNode::Handle;
     friend class QSSGMeshBVHBuilder;
@@ -123,6 +170,13 @@ private:
     QSSGMeshBVHRoots m_roots;
     QSSGMeshBVHNodes m_nodes { { /* 0 - reserved for invalid reads */ }, { /* 1 - reserved for invalid writes */ } };
     QSSGMeshBVHTriangles m_triangles;
+
+    std::vector<quint32> m_packedRoots;
+    QSSGMeshBVHPackedNodes m_packedNodes;
+    std::vector<quint32> m_triangleIndices;
+    std::vector<QVector3D> m_vertices;
+    std::vector<QVector2D> m_uvs;
+    QSSGMeshBVHTriangleSoA m_triangleSoA;
 };
 
 QSSGMeshBVHNode::Handle::operator const QSSGMeshBVHNode *() const
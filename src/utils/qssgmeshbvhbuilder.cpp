@@ -4,11 +4,29 @@
 #include "qssgmeshbvhbuilder_p.h"
 #include <QtQuick3DUtils/private/qssgassert_p.h>
 
+#include <QtCore/qfloat16.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+#include <numeric>
+
 QT_BEGIN_NAMESPACE
 
 static constexpr quint32 QSSG_MAX_TREE_DEPTH = 40;
 static constexpr quint32 QSSG_MAX_LEAF_TRIANGLES = 10;
 
+// Packed (SAH) builder
+static constexpr int QSSG_SAH_BIN_COUNT = 16;
+static constexpr quint32 QSSG_SAH_MAX_LEAF_TRIANGLES = 8;
+// Cost of visiting a node relative to the cost of one triangle test. The box test and the
+// stack handling of a node are about as expensive as two triangle tests.
+static constexpr float QSSG_SAH_TRAVERSAL_COST = 2.0f;
+// Both sides of a split need at least this many triangles for one of them to be built on
+// another thread.
+static constexpr quint32 QSSG_SAH_PARALLEL_MIN_TRIANGLES = 8192;
+
 QSSGMeshBVHBuilder::QSSGMeshBVHBuilder(const QSSGMesh::Mesh &mesh)
     : m_mesh(mesh)
 {
@@ -33,9 +51,11 @@ QSSGMeshBVHBuilder::QSSGMeshBVHBuilder(const QSSGMesh::Mesh &mesh)
         } else if (!strcmp(entry.m_name, QSSGMesh::MeshInternal::getUV0AttrName())) {
             m_hasUVData = true;
             m_vertexUVOffset = entry.m_firstItemOffset;
+            m_hasHalfUVData = entry.m_componentType == QSSGRenderComponentType::Float16;
         } else if (!m_hasUVData && !strcmp(entry.m_name, QSSGMesh::MeshInternal::getUV1AttrName())) {
             m_hasUVData = true;
             m_vertexUVOffset = entry.m_firstItemOffset;
+            m_hasHalfUVData = entry.m_componentType == QSSGRenderComponentType::Float16;
         }
     }
     m_vertexStride = vb.stride;
@@ -137,9 +157,14 @@ static inline QVector3D getVertexBufferValuePosition(quint32 index, const quint3
     return *position;
 }
 
-static inline QVector2D getVertexBufferValueUV(quint32 index, const quint32 vertexStride, const quint32 vertexUVOffset, const QByteArray &vertexBufferData)
+static inline QVector2D getVertexBufferValueUV(quint32 index, const quint32 vertexStride, const quint32 vertexUVOffset, const bool halfUV, const QByteArray &vertexBufferData)
 {
     const quint32 offset = index * vertexStride + vertexUVOffset;
+    if (halfUV) {
+        // Quantized meshes store the UVs as half floats
+        const qfloat16 *uv = reinterpret_cast<const qfloat16 *>(vertexBufferData.begin() + offset);
+        return QVector2D(uv[0], uv[1]);
+    }
     const QVector2D *uv = reinterpret_cast<const QVector2D *>(vertexBufferData.begin() + offset);
 
     return *uv;
@@ -152,6 +177,7 @@ static void calculateTriangleBoundsImpl(quint32 indexOffset,
                                         const QByteArray &vertexBufferData,
                                         [[maybe_unused]] const quint32 vertexStride,
                                         [[maybe_unused]] const quint32 vertexUVOffset,
+                                        [[maybe_unused]] const bool halfUV,
                                         [[maybe_unused]] const quint32 vertexPosOffset,
                                         QSSGMeshBVHTriangles &triangleBounds)
 {
@@ -181,9 +207,9 @@ static void calculateTriangleBoundsImpl(quint32 indexOffset,
             }
 
             if constexpr (hasUVData) {
-                triangle.uvCoord1 = getVertexBufferValueUV(index1, vertexStride, vertexUVOffset, vertexBufferData);
-                triangle.uvCoord2 = getVertexBufferValueUV(index2, vertexStride, vertexUVOffset, vertexBufferData);
-                triangle.uvCoord3 = getVertexBufferValueUV(index3, vertexStride, vertexUVOffset, vertexBufferData);
+                triangle.uvCoord1 = getVertexBufferValueUV(index1, vertexStride, vertexUVOffset, halfUV, vertexBufferData);
+                triangle.uvCoord2 = getVertexBufferValueUV(index2, vertexStride, vertexUVOffset, halfUV, vertexBufferData);
+                triangle.uvCoord3 = getVertexBufferValueUV(index3, vertexStride, vertexUVOffset, halfUV, vertexBufferData);
             }
         }
 
@@ -198,7 +224,7 @@ QSSGMeshBVHTriangles QSSGMeshBVHBuilder::calculateTriangleBounds(quint32 indexOf
 {
     QSSGMeshBVHTriangles data;
 
-    using CalcTriangleBoundsFn = void (*)(quint32, quint32, const QByteArray &, const QByteArray &, const quint32, const quint32, const quint32, QSSGMeshBVHTriangles &);
+    using CalcTriangleBoundsFn = void (*)(quint32, quint32, const QByteArray &, const QByteArray &, const quint32, const quint32, const bool, const quint32, QSSGMeshBVHTriangles &);
     static const CalcTriangleBoundsFn calcTriangleBounds16Fns[] { &calculateTriangleBoundsImpl<QSSGRenderComponentType::UnsignedInt16, false, false, false>,
                                                                   &calculateTriangleBoundsImpl<QSSGRenderComponentType::UnsignedInt16, false, false, true>,
                                                                   &calculateTriangleBoundsImpl<QSSGRenderComponentType::UnsignedInt16, false, true, false>,
@@ -221,9 +247,9 @@ QSSGMeshBVHTriangles QSSGMeshBVHBuilder::calculateTriangleBounds(quint32 indexOf
     const size_t idx = (size_t(m_hasIndexBuffer) << 2u) | (size_t(m_hasPositionData) << 1u) | (size_t(m_hasUVData));
 
     if (m_indexBufferComponentType == QSSGRenderComponentType::UnsignedInt16)
-        calcTriangleBounds16Fns[idx](indexOffset, indexCount, m_indexBufferData, m_vertexBufferData, m_vertexStride, m_vertexUVOffset, m_vertexPosOffset, data);
+        calcTriangleBounds16Fns[idx](indexOffset, indexCount, m_indexBufferData, m_vertexBufferData, m_vertexStride, m_vertexUVOffset, m_hasHalfUVData, m_vertexPosOffset, data);
     else if (m_indexBufferComponentType == QSSGRenderComponentType::UnsignedInt32)
-        calcTriangleBounds32Fns[idx](indexOffset, indexCount, m_indexBufferData, m_vertexBufferData, m_vertexStride, m_vertexUVOffset, m_vertexPosOffset, data);
+        calcTriangleBounds32Fns[idx](indexOffset, indexCount, m_indexBufferData, m_vertexBufferData, m_vertexStride, m_vertexUVOffset, m_hasHalfUVData, m_vertexPosOffset, data);
     return data;
 }
 
@@ -370,4 +396,313 @@ quint32 QSSGMeshBVHBuilder::partition(QSSGMeshBVH &bvh, quint32 offset, quint32
     Q_UNREACHABLE();
 }
 
+namespace {
+
+struct PackedBounds
+{
+    QVector3D minimum { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+    QVector3D maximum { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+
+    void include(const QVector3D &v)
+    {
+        minimum = QVector3D(qMin(minimum.x(), v.x()), qMin(minimum.y(), v.y()), qMin(minimum.z(), v.z()));
+        maximum = QVector3D(qMax(maximum.x(), v.x()), qMax(maximum.y(), v.y()), qMax(maximum.z(), v.z()));
+    }
+
+    void include(const PackedBounds &b)
+    {
+        minimum = QVector3D(qMin(minimum.x(), b.minimum.x()), qMin(minimum.y(), b.minimum.y()), qMin(minimum.z(), b.minimum.z()));
+        maximum = QVector3D(qMax(maximum.x(), b.maximum.x()), qMax(maximum.y(), b.maximum.y()), qMax(maximum.z(), b.maximum.z()));
+    }
+
+    [[nodiscard]] bool isEmpty() const { return minimum.x() > maximum.x(); }
+
+    // Half of the surface area, the factor doesn't matter for the cost comparisons
+    [[nodiscard]] float halfArea() const
+    {
+        if (isEmpty())
+            return 0.0f;
+        const QVector3D d = maximum - minimum;
+        return d.x() * d.y() + d.y() * d.z() + d.z() * d.x();
+    }
+};
+
+struct PackedBuildContext
+{
+    const std::vector<PackedBounds> &triangleBounds;
+    const std::vector<QVector3D> &centroids;
+    // Triangles of the subset being built, permuted so that each leaf references a range
+    std::vector<quint32> &order;
+};
+
+struct PackedBin
+{
+    PackedBounds bounds;
+    quint32 count = 0;
+};
+
+}
+
+static inline int packedBinIndex(float centroid, float minimum, float scale)
+{
+    return qBound(0, int((centroid - minimum) * scale), QSSG_SAH_BIN_COUNT - 1);
+}
+
+// Returns the start of the right half after partitioning the range, or begin if making a
+// leaf is cheaper than any split (or no split was found).
+static quint32 sahPartition(const PackedBuildContext &ctx, quint32 begin, quint32 end, const PackedBounds &bounds, const PackedBounds &centroidBounds)
+{
+    const quint32 count = end - begin;
+    const float area = bounds.halfArea();
+    if (!(area > 0.0f) || !qIsFinite(area))
+        return begin;
+
+    // Leaves above the maximum size are only made when there is no split at all
+    float bestCost = count > QSSG_SAH_MAX_LEAF_TRIANGLES ? std::numeric_limits<float>::max() : float(count);
+    int bestAxis = -1;
+    int bestBin = 0;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        const float minimum = centroidBounds.minimum[axis];
+        const float extent = centroidBounds.maximum[axis] - minimum;
+        if (!(extent > 0.0f))
+            continue;
+        const float scale = QSSG_SAH_BIN_COUNT / extent;
+
+        PackedBin bins[QSSG_SAH_BIN_COUNT];
+        for (quint32 i = begin; i < end; ++i) {
+            const quint32 triangle = ctx.order[i];
+            PackedBin &bin = bins[packedBinIndex(ctx.centroids[triangle][axis], minimum, scale)];
+            bin.bounds.include(ctx.triangleBounds[triangle]);
+            ++bin.count;
+        }
+
+        // Sweep from the right to get the cost of everything right of each plane...
+        float rightArea[QSSG_SAH_BIN_COUNT - 1];
+        quint32 rightCount[QSSG_SAH_BIN_COUNT - 1];
+        PackedBounds accumulated;
+        quint32 accumulatedCount = 0;
+        for (int i = QSSG_SAH_BIN_COUNT - 1; i > 0; --i) {
+            accumulated.include(bins[i].bounds);
+            accumulatedCount += bins[i].count;
+            rightArea[i - 1] = accumulated.halfArea();
+            rightCount[i - 1] = accumulatedCount;
+        }
+
+        // ...and from the left to evaluate the planes
+        accumulated = PackedBounds();
+        accumulatedCount = 0;
+        for (int i = 0; i < QSSG_SAH_BIN_COUNT - 1; ++i) {
+            accumulated.include(bins[i].bounds);
+            accumulatedCount += bins[i].count;
+            if (accumulatedCount == 0 || rightCount[i] == 0)
+                continue;
+            const float cost = QSSG_SAH_TRAVERSAL_COST
+                    + (accumulated.halfArea() * accumulatedCount + rightArea[i] * rightCount[i]) / area;
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = i;
+            }
+        }
+    }
+
+    if (bestAxis < 0)
+        return begin;
+
+    const float minimum = centroidBounds.minimum[bestAxis];
+    const float scale = QSSG_SAH_BIN_COUNT / (centroidBounds.maximum[bestAxis] - minimum);
+    const auto first = ctx.order.begin() + begin;
+    const auto middle = std::partition(first, ctx.order.begin() + end, [&](quint32 triangle) {
+        return packedBinIndex(ctx.centroids[triangle][bestAxis], minimum, scale) <= bestBin;
+    });
+    return begin + quint32(middle - first);
+}
+
+// Appends the nodes of a separately built tree. Inner nodes are offset by the position of the
+// tree in the destination, leaves by the position of its triangles.
+static void appendPackedNodes(QSSGMeshBVHPackedNodes &destination, const QSSGMeshBVHPackedNodes &source, quint32 triangleOffset)
+{
+    const quint32 nodeOffset = quint32(destination.size());
+    destination.reserve(destination.size() + source.size());
+    for (QSSGMeshBVHPackedNode node : source) {
+        node.index += node.isLeaf() ? triangleOffset : nodeOffset;
+        destination.push_back(node);
+    }
+}
+
+static void buildPackedNode(const PackedBuildContext &ctx, quint32 begin, quint32 end, quint32 depth, QSSGMeshBVHPackedNodes &nodes)
+{
+    PackedBounds bounds;
+    PackedBounds centroidBounds;
+    for (quint32 i = begin; i < end; ++i) {
+        const quint32 triangle = ctx.order[i];
+        bounds.include(ctx.triangleBounds[triangle]);
+        centroidBounds.include(ctx.centroids[triangle]);
+    }
+
+    const quint32 nodeIndex = quint32(nodes.size());
+    nodes.push_back({ bounds.minimum, begin, bounds.maximum, end - begin });
+
+    const quint32 count = end - begin;
+    if (count <= 1 || depth >= QSSG_MAX_TREE_DEPTH)
+        return;
+
+    quint32 middle = sahPartition(ctx, begin, end, bounds, centroidBounds);
+    if (middle == begin || middle == end) {
+        if (count <= QSSG_SAH_MAX_LEAF_TRIANGLES)
+            return;
+        // All the centroids fall in the same bin (or the bounds are degenerate), split
+        // at the median along the longest axis instead.
+        const QVector3D extent = centroidBounds.maximum - centroidBounds.minimum;
+        const int axis = extent.x() >= extent.y() ? (extent.x() >= extent.z() ? 0 : 2) : (extent.y() >= extent.z() ? 1 : 2);
+        middle = begin + count / 2;
+        std::nth_element(ctx.order.begin() + begin, ctx.order.begin() + middle, ctx.order.begin() + end, [&](quint32 a, quint32 b) {
+            return ctx.centroids[a][axis] < ctx.centroids[b][axis];
+        });
+    }
+
+    // The triangle ranges of the two halves are disjoint, so the right half can be built
+    // concurrently into its own node list and appended afterwards. tryStart() never queues
+    // the job, so waiting for it can't starve the pool.
+    QSSGMeshBVHPackedNodes rightNodes;
+    QSemaphore rightDone;
+    bool rightInParallel = false;
+    if (qMin(middle - begin, end - middle) >= QSSG_SAH_PARALLEL_MIN_TRIANGLES) {
+        rightInParallel = QThreadPool::globalInstance()->tryStart([&ctx, &rightNodes, &rightDone, middle, end, depth] {
+            buildPackedNode(ctx, middle, end, depth + 1, rightNodes);
+            rightDone.release();
+        });
+    }
+
+    buildPackedNode(ctx, begin, middle, depth + 1, nodes);
+    const quint32 rightIndex = quint32(nodes.size());
+    if (rightInParallel) {
+        rightDone.acquire();
+        appendPackedNodes(nodes, rightNodes, 0);
+    } else {
+        buildPackedNode(ctx, middle, end, depth + 1, nodes);
+    }
+
+    QSSGMeshBVHPackedNode &node = nodes[nodeIndex];
+    node.index = rightIndex;
+    node.count = 0;
+}
+
+std::unique_ptr<QSSGMeshBVH> QSSGMeshBVHBuilder::buildPackedTree()
+{
+    // This only works with triangles
+    if (m_mesh.isValid() && m_mesh.drawMode() != QSSGMesh::Mesh::DrawMode::Triangles)
+        return nullptr;
+
+    auto meshBvh = std::make_unique<QSSGMeshBVH>();
+    auto &vertices = meshBvh->m_vertices;
+    auto &uvs = meshBvh->m_uvs;
+
+    const quint32 vertexCount = m_vertexStride > 0 ? quint32(m_vertexBufferData.size() / m_vertexStride) : 0;
+    vertices.resize(vertexCount);
+    if (m_hasPositionData) {
+        for (quint32 i = 0; i < vertexCount; ++i)
+            vertices[i] = getVertexBufferValuePosition(i, m_vertexStride, m_vertexPosOffset, m_vertexBufferData);
+    }
+    if (m_hasUVData) {
+        uvs.resize(vertexCount);
+        for (quint32 i = 0; i < vertexCount; ++i)
+            uvs[i] = getVertexBufferValueUV(i, m_vertexStride, m_vertexUVOffset, m_hasHalfUVData, m_vertexBufferData);
+    }
+
+    quint32 indexCount = 0;
+    if (m_hasIndexBuffer)
+        indexCount = quint32(m_indexBufferData.size() / QSSGBaseTypeHelpers::getSizeOfType(m_indexBufferComponentType));
+    else
+        indexCount = vertexCount;
+    const quint32 triangleCount = vertexCount > 0 ? indexCount / 3 : 0;
+
+    // Vertex indices, bounds and centroid of each triangle in the whole mesh. Triangles
+    // referencing vertices outside of the vertex buffer are collapsed to the first vertex.
+    std::vector<quint32> triangleVertices(size_t(triangleCount) * 3);
+    std::vector<PackedBounds> triangleBounds(triangleCount);
+    std::vector<QVector3D> centroids(triangleCount);
+    const bool shortIndices = m_indexBufferComponentType == QSSGRenderComponentType::UnsignedInt16;
+    for (quint32 i = 0; i < triangleCount; ++i) {
+        quint32 *indices = triangleVertices.data() + size_t(i) * 3;
+        bool valid = true;
+        for (quint32 k = 0; k < 3; ++k) {
+            const quint32 index = i * 3 + k;
+            if (!m_hasIndexBuffer)
+                indices[k] = index;
+            else if (shortIndices)
+                indices[k] = getIndexBufferValue<QSSGRenderComponentType::UnsignedInt16>(index, indexCount, m_indexBufferData);
+            else
+                indices[k] = getIndexBufferValue<QSSGRenderComponentType::UnsignedInt32>(index, indexCount, m_indexBufferData);
+            valid = valid && indices[k] < vertexCount;
+        }
+        if (!valid)
+            indices[0] = indices[1] = indices[2] = 0;
+
+        PackedBounds &bounds = triangleBounds[i];
+        bounds.include(vertices[indices[0]]);
+        bounds.include(vertices[indices[1]]);
+        bounds.include(vertices[indices[2]]);
+        centroids[i] = (bounds.minimum + bounds.maximum) * 0.5f;
+    }
+
+    // Triangle ranges of the subsets, custom geometry only has one subset
+    QVarLengthArray<std::pair<quint32, quint32>, 8> subsetRanges;
+    if (m_mesh.isValid()) {
+        const QVector<QSSGMesh::Mesh::Subset> subsets = m_mesh.subsets();
+        for (const QSSGMesh::Mesh::Subset &source : subsets) {
+            // Offsets provided by subset are for the index buffer
+            const quint32 triangleOffset = qMin(source.offset / 3, triangleCount);
+            subsetRanges.append({ triangleOffset, qMin(source.count / 3, triangleCount - triangleOffset) });
+        }
+    } else {
+        subsetRanges.append({ 0, triangleCount });
+    }
+
+    // Each subset gets its own copy of its triangles so that overlapping subsets work too
+    auto &roots = meshBvh->m_packedRoots;
+    auto &nodes = meshBvh->m_packedNodes;
+    auto &triangleIndices = meshBvh->m_triangleIndices;
+    roots.reserve(subsetRanges.size());
+    for (const auto &range : std::as_const(subsetRanges)) {
+        if (range.second == 0) {
+            roots.push_back(QSSGMeshBVH::InvalidPackedRoot);
+            continue;
+        }
+
+        std::vector<quint32> order(range.second);
+        std::iota(order.begin(), order.end(), range.first);
+        const PackedBuildContext ctx { triangleBounds, centroids, order };
+        QSSGMeshBVHPackedNodes subsetNodes;
+        buildPackedNode(ctx, 0, range.second, 0, subsetNodes);
+
+        roots.push_back(quint32(nodes.size()));
+        appendPackedNodes(nodes, subsetNodes, quint32(triangleIndices.size() / 3));
+        triangleIndices.reserve(triangleIndices.size() + order.size() * 3);
+        for (quint32 triangle : order)
+            triangleIndices.insert(triangleIndices.end(), triangleVertices.begin() + size_t(triangle) * 3, triangleVertices.begin() + size_t(triangle) * 3 + 3);
+    }
+
+    auto &soa = meshBvh->m_triangleSoA;
+    const size_t packedTriangleCount = triangleIndices.size() / 3;
+    for (int axis = 0; axis < 3; ++axis) {
+        soa.vertex0[axis].assign(packedTriangleCount + QSSGMeshBVHTriangleSoA::Padding, 0.0f);
+        soa.edge1[axis].assign(packedTriangleCount + QSSGMeshBVHTriangleSoA::Padding, 0.0f);
+        soa.edge2[axis].assign(packedTriangleCount + QSSGMeshBVHTriangleSoA::Padding, 0.0f);
+    }
+    for (size_t i = 0; i < packedTriangleCount; ++i) {
+        const QVector3D &v0 = vertices[triangleIndices[i * 3]];
+        const QVector3D edge1 = vertices[triangleIndices[i * 3 + 1]] - v0;
+        const QVector3D edge2 = vertices[triangleIndices[i * 3 + 2]] - v0;
+        for (int axis = 0; axis < 3; ++axis) {
+            soa.vertex0[axis][i] = v0[axis];
+            soa.edge1[axis][i] = edge1[axis];
+            soa.edge2[axis][i] = edge2[axis];
+        }
+    }
+
+    return meshBvh;
+}
+
 QT_END_NAMESPACE
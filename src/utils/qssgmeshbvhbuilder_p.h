@@ -34,6 +34,9 @@ public:
                        QSSGRenderComponentType indexBufferType = QSSGRenderComponentType::Int32);
 
     std::unique_ptr<QSSGMeshBVH> buildTree();
+    // Builds the packed layout of the BVH (QSSGMeshBVH::isPacked()) using binned surface
+    // area heuristic splits. Large subtrees are built in parallel on the global thread pool.
+    std::unique_ptr<QSSGMeshBVH> buildPackedTree();
 
 private:
     enum class Axis
@@ -66,6 +69,7 @@ private:
     quint32 m_vertexPosOffset;
     bool m_hasUVData = false;
     quint32 m_vertexUVOffset;
+    bool m_hasHalfUVData = false;
     bool m_hasIndexBuffer = true;
 };
 
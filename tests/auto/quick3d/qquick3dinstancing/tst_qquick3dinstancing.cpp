@@ -0,0 +1,101 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+
+#include <QtQuick3D/qquick3dinstancing.h>
+
+#include <QtQuick3DRuntimeRender/private/qssgrenderinstancetable_p.h>
+
+class tst_QQuick3DInstancing : public QObject
+{
+    Q_OBJECT
+
+    class Instancing : public QQuick3DInstancing
+    {
+    public:
+        explicit Instancing(int count) : m_data(count * sizeof(InstanceTableEntry), '\0') {}
+
+        using QQuick3DInstancing::updateSpatialNode;
+        using QQuick3DInstancing::markDirty;
+        using QQuick3DInstancing::markRangeDirty;
+
+        // Taking the address has to stay unambiguous
+        static constexpr auto markDirtyFunction = &QQuick3DInstancing::markDirty;
+
+    protected:
+        QByteArray getInstanceBuffer(int *instanceCount) override
+        {
+            if (instanceCount)
+                *instanceCount = int(m_data.size() / sizeof(InstanceTableEntry));
+            return m_data;
+        }
+
+    private:
+        QByteArray m_data;
+    };
+
+private slots:
+    void testMergeDirtyRanges();
+    void testRangeDirty();
+};
+
+void tst_QQuick3DInstancing::testMergeDirtyRanges()
+{
+    QSSGRenderInstanceTable::DirtyRanges ranges { { 10, 2 }, { 0, 1 }, { 11, 4 }, { 1, 1 }, { 20, 1 } };
+    QSSGRenderInstanceTable::mergeDirtyRanges(ranges);
+    QCOMPARE(ranges.size(), 3);
+    QCOMPARE(ranges.at(0).offset, 0);
+    QCOMPARE(ranges.at(0).count, 2);
+    QCOMPARE(ranges.at(1).offset, 10);
+    QCOMPARE(ranges.at(1).count, 5);
+    QCOMPARE(ranges.at(2).offset, 20);
+    QCOMPARE(ranges.at(2).count, 1);
+}
+
+void tst_QQuick3DInstancing::testRangeDirty()
+{
+    Instancing instancing(100);
+    auto table = static_cast<QSSGRenderInstanceTable *>(instancing.updateSpatialNode(nullptr));
+    QVERIFY(table);
+    QCOMPARE(table->count(), 100);
+    QVERIFY(table->dirtyRanges().isEmpty());
+    int serial = table->serial();
+
+    // Only the changed instances are reported, merged
+    instancing.markRangeDirty(5, 2);
+    instancing.markRangeDirty(6, 3);
+    instancing.markRangeDirty(50, 1);
+    table = static_cast<QSSGRenderInstanceTable *>(instancing.updateSpatialNode(table));
+    QCOMPARE(table->serial(), ++serial);
+    QCOMPARE(table->dirtyRanges().size(), 2);
+    QCOMPARE(table->dirtyRanges().at(0).offset, 5);
+    QCOMPARE(table->dirtyRanges().at(0).count, 4);
+    QCOMPARE(table->dirtyRanges().at(1).offset, 50);
+    QCOMPARE(table->dirtyRanges().at(1).count, 1);
+
+    // Ranges outside of the table are dropped
+    instancing.markRangeDirty(95, 10);
+    table = static_cast<QSSGRenderInstanceTable *>(instancing.updateSpatialNode(table));
+    QCOMPARE(table->serial(), ++serial);
+    QCOMPARE(table->dirtyRanges().size(), 1);
+    QCOMPARE(table->dirtyRanges().at(0).offset, 95);
+    QCOMPARE(table->dirtyRanges().at(0).count, 5);
+
+    // A full update wins over ranges, before or after it
+    instancing.markRangeDirty(1, 1);
+    instancing.markDirty();
+    instancing.markRangeDirty(2, 1);
+    table = static_cast<QSSGRenderInstanceTable *>(instancing.updateSpatialNode(table));
+    QCOMPARE(table->serial(), ++serial);
+    QVERIFY(table->dirtyRanges().isEmpty());
+
+    // Nothing changed
+    table = static_cast<QSSGRenderInstanceTable *>(instancing.updateSpatialNode(table));
+    QCOMPARE(table->serial(), serial);
+
+    delete table;
+}
+
+QTEST_APPLESS_MAIN(tst_QQuick3DInstancing)
+#include "tst_qquick3dinstancing.moc"
@@ -76,6 +76,16 @@ void tst_QQuick3DModel::testProperties()
     QVERIFY(model.levelOfDetailBias() == 1.0f);
     QVERIFY(node->levelOfDetailBias == 1.0f);
 
+    model.setAsynchronous(true);
+    node = static_cast<QSSGRenderModel *>(model.updateSpatialNode(node));
+    QVERIFY(model.asynchronous());
+    QVERIFY(node->asyncMeshLoading);
+    model.setAsynchronous(false);
+    node = static_cast<QSSGRenderModel *>(model.updateSpatialNode(node));
+    QVERIFY(!model.asynchronous());
+    QVERIFY(!node->asyncMeshLoading);
+    QCOMPARE(model.status(), QQuick3DModel::Null);
+
     // mesh from source
     QUrl cubeUrl("#Cube");
     QSignalSpy spy(&model, SIGNAL(sourceChanged()));
@@ -26,6 +26,7 @@ private slots:
     void testEnums();
     void testPositionMapping();
     void testDirectionMapping();
+    void testDeferredInstanceRoot();
 };
 
 void tst_QQuick3DNode::testProperties()
@@ -256,5 +257,46 @@ void tst_QQuick3DNode::testDirectionMapping()
     }
 }
 
+void tst_QQuick3DNode::testDeferredInstanceRoot()
+{
+    // The instance root of 'instanced' is in another branch of the graph
+    struct Graph
+    {
+        Graph()
+        {
+            root.localTransform.translate(5, 0, 0);
+            branchA.localTransform.rotate(45, 0, 1, 0);
+            branchB.localTransform.translate(1, 2, 3);
+            instanced.localTransform.scale(2);
+            root.addChild(branchA);
+            root.addChild(branchB);
+            branchA.addChild(instanced);
+            branchB.instanceRoot = &branchB;
+            instanced.instanceRoot = &branchB;
+        }
+        QSSGRenderNode root;
+        QSSGRenderNode branchA;
+        QSSGRenderNode branchB;
+        QSSGRenderNode instanced;
+    };
+
+    Graph immediate;
+    immediate.branchB.calculateGlobalVariables();
+    immediate.instanced.calculateGlobalVariables();
+
+    Graph deferred;
+    deferred.instanced.calculateGlobalVariables(QSSGRenderNode::InstanceRootResolution::Deferred);
+    QVERIFY(!deferred.instanced.isDirty(QSSGRenderNode::DirtyFlag::GlobalValuesDirty));
+    QCOMPARE(deferred.instanced.globalTransform, immediate.instanced.globalTransform);
+    deferred.branchB.calculateGlobalVariables(QSSGRenderNode::InstanceRootResolution::Deferred);
+    QVERIFY(deferred.instanced.hasForeignInstanceRoot());
+    QVERIFY(!deferred.branchB.hasForeignInstanceRoot());
+    deferred.instanced.calculateGlobalInstanceTransform();
+
+    QCOMPARE(deferred.branchB.globalInstanceTransform, immediate.branchB.globalInstanceTransform);
+    QCOMPARE(deferred.instanced.globalInstanceTransform, immediate.instanced.globalInstanceTransform);
+    QCOMPARE(deferred.instanced.localInstanceTransform, immediate.instanced.localInstanceTransform);
+}
+
 QTEST_APPLESS_MAIN(tst_QQuick3DNode)
 #include "tst_qquick3dnode.moc"
@@ -27,6 +27,7 @@ private slots:
     void testSamplerFilteringModes();
     void testTransformations();
     void testTextureData();
+    void testAsynchronous();
 };
 
 void tst_QQuick3DTexture::testSetSource()
@@ -200,5 +201,30 @@ void tst_QQuick3DTexture::testTextureData()
     QCOMPARE(spy.size(), 1);
 }
 
+void tst_QQuick3DTexture::testAsynchronous()
+{
+    Texture texture;
+    QCOMPARE(texture.asynchronous(), false);
+    QCOMPARE(texture.status(), QQuick3DTexture::Null);
+
+    texture.setSource(QUrl::fromLocalFile(QString::fromLatin1("path/to/resource")));
+    std::unique_ptr<QSSGRenderImage> node(static_cast<QSSGRenderImage *>(texture.updateSpatialNode(nullptr)));
+    QVERIFY(node);
+    QVERIFY(!node->m_asyncLoading);
+
+    QSignalSpy spy(&texture, SIGNAL(asynchronousChanged()));
+    texture.setAsynchronous(true);
+    QCOMPARE(spy.size(), 1);
+    QCOMPARE(node.get(), texture.updateSpatialNode(node.get()));
+    QVERIFY(node->m_asyncLoading);
+
+    // Same value again
+    texture.setAsynchronous(true);
+    QCOMPARE(spy.size(), 1);
+
+    // The status is only updated by a scene that renders the texture
+    QCOMPARE(texture.status(), QQuick3DTexture::Null);
+}
+
 QTEST_APPLESS_MAIN(tst_QQuick3DTexture)
 #include "tst_qquick3dtexture.moc"
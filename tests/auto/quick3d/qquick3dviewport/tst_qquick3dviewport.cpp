@@ -0,0 +1,103 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QSignalSpy>
+
+#include <QtQml/QQmlComponent>
+#include <QtQml/QQmlEngine>
+
+#include <QtQuick3D/private/qquick3dviewport_p.h>
+
+class tst_QQuick3DViewport : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testPickBatch();
+    void testRayPickBatch();
+};
+
+// Not shown in a window, so nothing is ever rendered and every ray misses
+static const char *pickBatchSource = R"(
+import QtQuick
+import QtQuick3D
+
+View3D {
+    property int finishedRequestId: -1
+    property int resultCount: -1
+    property bool allMissed: false
+
+    onPickBatchFinished: (requestId, results) => {
+        finishedRequestId = requestId
+        resultCount = results.length
+        allMissed = results.every(result => result.hitType === PickResult.Null)
+    }
+
+    function pickPoints() {
+        return requestPickBatch([Qt.point(10, 10), Qt.point(20, 20), Qt.point(30, 30)])
+    }
+    function pickRays(origins, directions) {
+        return requestRayPickBatch(origins, directions)
+    }
+}
+)";
+
+void tst_QQuick3DViewport::testPickBatch()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(pickBatchSource, QUrl());
+    QScopedPointer<QObject> view3D(component.create());
+    QVERIFY2(view3D, qPrintable(component.errorString()));
+
+    QSignalSpy spy(view3D.data(), SIGNAL(pickBatchFinished(int,QList<QQuick3DPickResult>)));
+
+    QVariant requestId;
+    QVERIFY(QMetaObject::invokeMethod(view3D.data(), "pickPoints", Q_RETURN_ARG(QVariant, requestId)));
+    // Delivered asynchronously, even when there is nothing to pick
+    QCOMPARE(spy.size(), 0);
+    QTRY_COMPARE(spy.size(), 1);
+    QCOMPARE(view3D->property("finishedRequestId").toInt(), requestId.toInt());
+    QCOMPARE(view3D->property("resultCount").toInt(), 3);
+    QVERIFY(view3D->property("allMissed").toBool());
+
+    // Every request gets its own id
+    QVariant nextRequestId;
+    QVERIFY(QMetaObject::invokeMethod(view3D.data(), "pickPoints", Q_RETURN_ARG(QVariant, nextRequestId)));
+    QVERIFY(nextRequestId.toInt() != requestId.toInt());
+    QTRY_COMPARE(spy.size(), 2);
+    QCOMPARE(view3D->property("finishedRequestId").toInt(), nextRequestId.toInt());
+}
+
+void tst_QQuick3DViewport::testRayPickBatch()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(pickBatchSource, QUrl());
+    QScopedPointer<QObject> view3D(component.create());
+    QVERIFY2(view3D, qPrintable(component.errorString()));
+
+    QSignalSpy spy(view3D.data(), SIGNAL(pickBatchFinished(int,QList<QQuick3DPickResult>)));
+
+    const QVariantList origins { QVariant::fromValue(QVector3D(0, 0, 100)), QVariant::fromValue(QVector3D(10, 0, 100)) };
+    const QVariantList directions { QVariant::fromValue(QVector3D(0, 0, -1)), QVariant::fromValue(QVector3D(0, 0, -1)) };
+    QVariant requestId;
+    QVERIFY(QMetaObject::invokeMethod(view3D.data(), "pickRays", Q_RETURN_ARG(QVariant, requestId),
+                                      Q_ARG(QVariant, origins), Q_ARG(QVariant, directions)));
+    QTRY_COMPARE(spy.size(), 1);
+    QCOMPARE(view3D->property("finishedRequestId").toInt(), requestId.toInt());
+    QCOMPARE(view3D->property("resultCount").toInt(), 2);
+    QVERIFY(view3D->property("allMissed").toBool());
+
+    // Mismatching lists are rejected, the request still finishes
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("The number of origins and directions passed for picking differ"));
+    QVERIFY(QMetaObject::invokeMethod(view3D.data(), "pickRays", Q_RETURN_ARG(QVariant, requestId),
+                                      Q_ARG(QVariant, origins), Q_ARG(QVariant, directions.mid(1))));
+    QTRY_COMPARE(spy.size(), 2);
+    QCOMPARE(view3D->property("finishedRequestId").toInt(), requestId.toInt());
+    QCOMPARE(view3D->property("resultCount").toInt(), 0);
+}
+
+QTEST_MAIN(tst_QQuick3DViewport)
+#include "tst_qquick3dviewport.moc"
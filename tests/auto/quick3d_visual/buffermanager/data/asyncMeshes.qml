@@ -0,0 +1,48 @@
+import QtQuick
+import QtQuick3D
+
+View3D {
+    width: 640
+    height: 480
+    anchors.fill: parent
+
+    property alias shownModel: shownModel
+    property alias hiddenModel: hiddenModel
+    property alias missingModel: missingModel
+    property alias primitiveModel: primitiveModel
+
+    PerspectiveCamera {
+        z: 600
+    }
+
+    Model {
+        id: shownModel
+        source: "random1.mesh"
+        asynchronous: true
+        materials: DefaultMaterial { }
+    }
+
+    // Never prepared for rendering
+    Model {
+        id: hiddenModel
+        source: "random2.mesh"
+        asynchronous: true
+        visible: false
+        materials: DefaultMaterial { }
+    }
+
+    Model {
+        id: missingModel
+        source: "doesnotexist.mesh"
+        asynchronous: true
+        materials: DefaultMaterial { }
+    }
+
+    // Primitives are always loaded synchronously
+    Model {
+        id: primitiveModel
+        source: "#Cube"
+        asynchronous: true
+        materials: DefaultMaterial { }
+    }
+}
@@ -0,0 +1,51 @@
+import QtQuick
+import QtQuick3D
+
+View3D {
+    width: 640
+    height: 480
+    anchors.fill: parent
+
+    property alias colorTexture: colorTexture
+    property alias normalTexture: normalTexture
+    property alias unusedTexture: unusedTexture
+    property alias unusedSyncTexture: unusedSyncTexture
+    property alias missingTexture: missingTexture
+
+    PerspectiveCamera {
+        z: 600
+    }
+
+    Model {
+        source: "#Cube"
+        materials: PrincipledMaterial {
+            baseColorMap: Texture {
+                id: colorTexture
+                source: "noise1.jpg"
+                asynchronous: true
+            }
+            normalMap: Texture {
+                id: normalTexture
+                source: "noise2.jpg"
+                asynchronous: true
+            }
+            emissiveMap: Texture {
+                id: missingTexture
+                source: "doesnotexist.jpg"
+                asynchronous: true
+            }
+        }
+    }
+
+    // Not sampled by any material
+    Texture {
+        id: unusedTexture
+        source: "noise3.jpg"
+        asynchronous: true
+    }
+
+    Texture {
+        id: unusedSyncTexture
+        source: "noise4.jpg"
+    }
+}
@@ -3,11 +3,13 @@
 
 #include <QTest>
 #include <QQuickView>
+#include <QSignalSpy>
 
 #include <private/qquick3dviewport_p.h>
 #include <ssg/qssgrendercontextcore.h>
 #include <private/qssgrenderbuffermanager_p.h>
 #include <private/qquick3dresourceloader_p.h>
+#include <private/qquick3dtexture_p.h>
 
 #if QT_CONFIG(vulkan)
 #include <QVulkanInstance>
@@ -38,6 +40,8 @@ private slots:
     void staticScene_data();
     void staticScene();
     void dynamicScene();
+    void asyncMeshes();
+    void asyncTextures();
 
 private:
     bool initRenderer(QQuick3DTestOffscreenRenderer *renderer, const QString &filename);
@@ -327,6 +331,108 @@ void tst_BufferManager::dynamicScene()
     QCOMPARE(bufferManager->getCustomMeshMap().size(), 0);
 }
 
+void tst_BufferManager::asyncMeshes()
+{
+    QQuick3DTestOffscreenRenderer renderer;
+    QVERIFY(initRenderer(&renderer, QString("asyncMeshes.qml")));
+
+    bool readCompleted = false;
+    QRhiReadbackResult readResult;
+    QImage result;
+
+    const auto shownModel = renderer.rootItem->property("shownModel").value<QQuick3DModel *>();
+    const auto hiddenModel = renderer.rootItem->property("hiddenModel").value<QQuick3DModel *>();
+    const auto missingModel = renderer.rootItem->property("missingModel").value<QQuick3DModel *>();
+    const auto primitiveModel = renderer.rootItem->property("primitiveModel").value<QQuick3DModel *>();
+    QVERIFY(shownModel && hiddenModel && missingModel && primitiveModel);
+    QVERIFY(shownModel->asynchronous());
+    QVERIFY(primitiveModel->asynchronous());
+
+    const auto renderUntilLoaded = [&](std::initializer_list<QQuick3DModel *> models) {
+        renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+        return std::none_of(models.begin(), models.end(), [](QQuick3DModel *model) {
+            return model->status() == QQuick3DModel::Loading;
+        });
+    };
+    QTRY_VERIFY(renderUntilLoaded({ shownModel, hiddenModel, missingModel, primitiveModel }));
+
+    QCOMPARE(shownModel->status(), QQuick3DModel::Ready);
+    QCOMPARE(missingModel->status(), QQuick3DModel::Error);
+
+    // Not loaded in the background, but still gets a status and bounds
+    QCOMPARE(primitiveModel->status(), QQuick3DModel::Ready);
+    QCOMPARE(primitiveModel->bounds().minimum(), QVector3D(-50, -50, -50));
+    QCOMPARE(primitiveModel->bounds().maximum(), QVector3D(50, 50, 50));
+
+    // Loaded and measured although the model is never rendered
+    QCOMPARE(hiddenModel->status(), QQuick3DModel::Ready);
+    QVERIFY(hiddenModel->bounds().minimum() != hiddenModel->bounds().maximum());
+
+    // A failed path is tried again once it has not been used for a while
+    QSignalSpy statusSpy(missingModel, &QQuick3DModel::statusChanged);
+    missingModel->setSource(QUrl("random1.mesh"));
+    QTRY_VERIFY(renderUntilLoaded({ missingModel }));
+    QCOMPARE(missingModel->status(), QQuick3DModel::Ready);
+    for (int i = 0; i != 3; ++i)
+        renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+
+    statusSpy.clear();
+    missingModel->setSource(QUrl("doesnotexist.mesh"));
+    QTRY_VERIFY(renderUntilLoaded({ missingModel }));
+    QCOMPARE(missingModel->status(), QQuick3DModel::Error);
+    QCOMPARE(statusSpy.size(), 2); // Loading, Error
+}
+
+void tst_BufferManager::asyncTextures()
+{
+    QQuick3DTestOffscreenRenderer renderer;
+    QVERIFY(initRenderer(&renderer, QString("asyncTextures.qml")));
+
+    bool readCompleted = false;
+    QRhiReadbackResult readResult;
+    QImage result;
+
+    const auto texture = [&renderer](const char *name) {
+        return renderer.rootItem->property(name).value<QQuick3DTexture *>();
+    };
+    const auto colorTexture = texture("colorTexture");
+    const auto normalTexture = texture("normalTexture");
+    const auto unusedTexture = texture("unusedTexture");
+    const auto unusedSyncTexture = texture("unusedSyncTexture");
+    const auto missingTexture = texture("missingTexture");
+    QVERIFY(colorTexture && normalTexture && unusedTexture && unusedSyncTexture && missingTexture);
+    QVERIFY(colorTexture->asynchronous());
+    QVERIFY(!unusedSyncTexture->asynchronous());
+
+    const auto renderUntilLoaded = [&](std::initializer_list<QQuick3DTexture *> textures) {
+        renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+        return std::none_of(textures.begin(), textures.end(), [](QQuick3DTexture *texture) {
+            return texture->status() == QQuick3DTexture::Loading;
+        });
+    };
+    QTRY_VERIFY(renderUntilLoaded({ colorTexture, normalTexture, unusedTexture, unusedSyncTexture, missingTexture }));
+
+    QCOMPARE(colorTexture->status(), QQuick3DTexture::Ready);
+    QCOMPARE(normalTexture->status(), QQuick3DTexture::Ready);
+    QCOMPARE(missingTexture->status(), QQuick3DTexture::Error);
+
+    // Resolved although no material samples them
+    QCOMPARE(unusedTexture->status(), QQuick3DTexture::Ready);
+    QCOMPARE(unusedSyncTexture->status(), QQuick3DTexture::Ready);
+
+    // Only the sampled images are uploaded
+    const auto &context = QQuick3DSceneManager::getOrSetWindowAttachment(*renderer.quickWindow)->rci();
+    QVERIFY(context);
+    renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+    QCOMPARE(context->bufferManager()->getImageMap().size(), 3); // Including the failed one
+
+    QSignalSpy statusSpy(unusedTexture, &QQuick3DTexture::statusChanged);
+    unusedTexture->setSource(QUrl("doesnotexist.jpg"));
+    QTRY_VERIFY(renderUntilLoaded({ unusedTexture }));
+    QCOMPARE(unusedTexture->status(), QQuick3DTexture::Error);
+    QCOMPARE(statusSpy.size(), 2); // Loading, Error
+}
+
 bool tst_BufferManager::initRenderer(QQuick3DTestOffscreenRenderer *renderer, const QString &filename)
 {
     const bool initSuccess = renderer->init(testFileUrl(filename),
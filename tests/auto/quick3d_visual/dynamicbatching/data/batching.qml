@@ -0,0 +1,66 @@
+import QtQuick
+import QtQuick3D
+
+View3D {
+    anchors.fill: parent
+    environment: SceneEnvironment {
+        backgroundMode: SceneEnvironment.Color
+        clearColor: "black"
+    }
+    PerspectiveCamera {
+        z: 600
+        frustumCullingEnabled: true
+    }
+
+    PrincipledMaterial {
+        id: red
+        lighting: PrincipledMaterial.NoLighting
+        baseColor: "red"
+    }
+    PrincipledMaterial {
+        id: blue
+        lighting: PrincipledMaterial.NoLighting
+        baseColor: "blue"
+    }
+    PrincipledMaterial {
+        id: transparentGreen
+        lighting: PrincipledMaterial.NoLighting
+        baseColor: "lime"
+        opacity: 0.5
+    }
+
+    // One batch, all visible
+    Repeater3D {
+        model: 4
+        Model {
+            source: "#Cube"
+            x: -300 + index * 150
+            scale: Qt.vector3d(0.5, 0.5, 0.5)
+            materials: blue
+        }
+    }
+
+    // One batch with its center outside of the view, only the first model is visible
+    Repeater3D {
+        model: [ -200, 5000, 6000 ]
+        Model {
+            source: "#Cube"
+            x: modelData
+            y: 100
+            scale: Qt.vector3d(0.5, 0.5, 0.5)
+            materials: red
+        }
+    }
+
+    // Blended, never batched
+    Repeater3D {
+        model: 2
+        Model {
+            source: "#Cube"
+            x: 100 + index * 150
+            y: -100
+            scale: Qt.vector3d(0.5, 0.5, 0.5)
+            materials: transparentGreen
+        }
+    }
+}
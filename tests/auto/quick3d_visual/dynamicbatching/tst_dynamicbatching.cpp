@@ -0,0 +1,65 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QQuickView>
+
+#include "../shared/util.h"
+
+class tst_DynamicBatching : public QQuick3DDataTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase() override;
+    void batches();
+};
+
+void tst_DynamicBatching::initTestCase()
+{
+    // Read once, on the first frame
+    qputenv("QT_QUICK3D_DYNAMIC_BATCHING", "1");
+
+    QQuick3DDataTest::initTestCase();
+    if (!initialized())
+        return;
+}
+
+const int FUZZ = 5;
+
+void tst_DynamicBatching::batches()
+{
+    QScopedPointer<QQuickView> view(createView(QLatin1String("batching.qml"), QSize(640, 480)));
+    QVERIFY(view);
+    QVERIFY(QTest::qWaitForWindowExposed(view.data()));
+
+    QObject *renderStats = qvariant_cast<QObject *>(view->rootObject()->property("renderStats"));
+    QVERIFY(renderStats);
+    renderStats->setProperty("extendedDataCollectionEnabled", true);
+
+    // The blue and the red models are drawn with one draw call per color, the
+    // two transparent green models are drawn one by one.
+    QTRY_COMPARE(renderStats->property("drawCallCount").toULongLong(), quint64(4));
+
+    const QImage result = grab(view.data());
+    if (result.isNull())
+        return; // was QFAIL'ed already
+
+    const qreal dpr = view->devicePixelRatio();
+
+    QVERIFY(comparePixel(result, 10, 10, dpr, Qt::black, FUZZ));
+
+    // All the blue models are at their own positions
+    for (int x : { -300, -150, 0, 150 })
+        QVERIFY(comparePixelNormPos(result, 0.5 + x / 923.8, 0.5, Qt::blue, FUZZ));
+
+    // The visible red model is not culled with the rest of its batch
+    QVERIFY(comparePixelNormPos(result, 0.5 - 200 / 923.8, 0.5 - 100 / 692.8, Qt::red, FUZZ));
+
+    // Blended with the background
+    for (int x : { 100, 250 })
+        QVERIFY(comparePixelNormPos(result, 0.5 + x / 923.8, 0.5 + 100 / 692.8, QColor::fromRgb(0, 128, 0), FUZZ));
+}
+
+QTEST_MAIN(tst_DynamicBatching)
+#include "tst_dynamicbatching.moc"
@@ -0,0 +1,40 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+import QtQuick
+import QtQuick3D
+
+Rectangle {
+    width: 320
+    height: 240
+    color: "black"
+
+    property alias firstModel: firstModel
+    property alias secondModel: secondModel
+
+    View3D {
+        anchors.fill: parent
+
+        PerspectiveCamera {
+            z: 300
+        }
+
+        DirectionalLight {
+        }
+
+        // The sources are set by the test. A bias of 0 always asks for the full detail.
+        Model {
+            id: firstModel
+            x: -60
+            levelOfDetailBias: 0
+            materials: PrincipledMaterial { }
+        }
+
+        Model {
+            id: secondModel
+            x: 60
+            levelOfDetailBias: 0
+            materials: PrincipledMaterial { }
+        }
+    }
+}
@@ -0,0 +1,197 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QTemporaryDir>
+
+#include <functional>
+
+#include <private/qquick3dmodel_p.h>
+#include <private/qquick3dscenemanager_p.h>
+#include <ssg/qssgrendercontextcore.h>
+#include <private/qssgrenderbuffermanager_p.h>
+#include <private/qssgrendermesh_p.h>
+#include <private/qssgrenderoptimizations_p.h>
+#include <QtQuick3DUtils/private/qssgmesh_p.h>
+
+#if QT_CONFIG(vulkan)
+#include <QVulkanInstance>
+#endif
+
+#include "../shared/util.h"
+
+static inline void renderNextFrame(QQuick3DTestOffscreenRenderer *renderer, bool *readCompleted, QRhiReadbackResult *readResult, QImage *result)
+{
+    QGuiApplication::processEvents();
+    renderer->renderControl->polishItems();
+    renderer->renderControl->beginFrame();
+    renderer->renderControl->sync();
+    renderer->renderControl->render();
+    renderer->enqueueReadback(readCompleted, readResult, result);
+    renderer->renderControl->endFrame();
+}
+
+// A grid of 'gridSize' x 'gridSize' vertices. Level 1 has a quarter of the
+// triangles of the full detail, level 2 only two of them.
+static bool writeLodMesh(const QString &path, int gridSize)
+{
+    QByteArray positions;
+    positions.reserve(gridSize * gridSize * 3 * sizeof(float));
+    for (int y = 0; y != gridSize; ++y) {
+        for (int x = 0; x != gridSize; ++x) {
+            const float position[3] = { x * 100.0f / (gridSize - 1) - 50.0f, y * 100.0f / (gridSize - 1) - 50.0f, 0.0f };
+            positions.append(reinterpret_cast<const char *>(position), sizeof(position));
+        }
+    }
+
+    QVector<quint32> indices;
+    for (int y = 0; y != gridSize - 1; ++y) {
+        for (int x = 0; x != gridSize - 1; ++x) {
+            const quint32 i = y * gridSize + x;
+            indices << i << i + 1 << i + gridSize << i + 1 << i + gridSize + 1 << i + gridSize;
+        }
+    }
+    const quint32 fullCount = quint32(indices.size());
+    const quint32 level1Count = fullCount / 12 * 3;
+    indices.append(indices.mid(0, level1Count));
+    indices.append(indices.mid(0, 6));
+
+    QSSGMesh::AssetVertexEntry positionEntry;
+    positionEntry.name = QSSGMesh::MeshInternal::getPositionAttrName();
+    positionEntry.data = positions;
+    positionEntry.componentCount = 3;
+
+    QSSGMesh::AssetMeshSubset subset;
+    subset.count = fullCount;
+    subset.boundsPositionEntryIndex = 0;
+    subset.lods = { { level1Count, fullCount, 1.0f }, { 6, fullCount + level1Count, 2.0f } };
+
+    const QByteArray indexData(reinterpret_cast<const char *>(indices.constData()), indices.size() * sizeof(quint32));
+    QSSGMesh::Mesh mesh = QSSGMesh::Mesh::fromAssetData({ positionEntry }, indexData,
+                                                        QSSGMesh::Mesh::ComponentType::UnsignedInt32, { subset });
+    if (!mesh.isValid() || !mesh.arrangeLevelsOfDetailCoarsestFirst())
+        return false;
+
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && mesh.save(&file) != 0;
+}
+
+class tst_MeshLodStreaming : public QQuick3DDataTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase() override;
+    void budget();
+
+private:
+    QTemporaryDir m_dir;
+#if QT_CONFIG(vulkan)
+    QVulkanInstance vulkanInstance;
+#endif
+};
+
+void tst_MeshLodStreaming::initTestCase()
+{
+    // Read once, when the first mesh is loaded
+    qputenv("QT_QUICK3D_MESH_LOD_STREAMING", "1");
+    qputenv("QT_QUICK3D_MESH_LOD_STREAMING_BUDGET", "1");
+
+    QQuick3DDataTest::initTestCase();
+    if (!initialized())
+        return;
+
+    QVERIFY(m_dir.isValid());
+    // About 0.75 MB of indices at full detail each, so only one of them fits the budget
+    QVERIFY(writeLodMesh(m_dir.filePath(QStringLiteral("first.mesh")), 160));
+    QVERIFY(writeLodMesh(m_dir.filePath(QStringLiteral("second.mesh")), 160));
+
+#if QT_CONFIG(vulkan)
+    vulkanInstance.setLayers({ "VK_LAYER_LUNARG_standard_validation" });
+    vulkanInstance.create(); // may fail, which is fine is Vulkan is not used in the first place
+#endif
+}
+
+void tst_MeshLodStreaming::budget()
+{
+    QQuick3DTestOffscreenRenderer renderer;
+    QVERIFY(renderer.init(testFileUrl("lodstreaming.qml"),
+#if QT_CONFIG(vulkan)
+                          &vulkanInstance
+#else
+                          nullptr
+#endif
+    ));
+
+    bool readCompleted = false;
+    QRhiReadbackResult readResult;
+    QImage result;
+
+    const auto firstModel = renderer.rootItem->property("firstModel").value<QQuick3DModel *>();
+    const auto secondModel = renderer.rootItem->property("secondModel").value<QQuick3DModel *>();
+    QVERIFY(firstModel && secondModel);
+    firstModel->setSource(QUrl::fromLocalFile(m_dir.filePath(QStringLiteral("first.mesh"))));
+    secondModel->setSource(QUrl::fromLocalFile(m_dir.filePath(QStringLiteral("second.mesh"))));
+
+    renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+    const auto &context = QQuick3DSceneManager::getOrSetWindowAttachment(*renderer.quickWindow)->rci();
+    QVERIFY(context);
+    const auto &bufferManager = context->bufferManager();
+    QVERIFY(QSSGRenderOptimizations::isEnabled(QSSGRenderOptimizations::Option::MeshLodStreaming));
+
+    const auto streamingOf = [&bufferManager](const QString &fileName) -> const QSSGRenderMeshLodStreaming * {
+        const auto &meshMap = bufferManager->getMeshMap();
+        for (auto it = meshMap.cbegin(), end = meshMap.cend(); it != end; ++it) {
+            if (it.key().path().endsWith(fileName) && it->mesh)
+                return it->mesh->lodStreaming.get();
+        }
+        return nullptr;
+    };
+    const QSSGRenderMeshLodStreaming *first = streamingOf(QStringLiteral("first.mesh"));
+    const QSSGRenderMeshLodStreaming *second = streamingOf(QStringLiteral("second.mesh"));
+    QVERIFY(first && second);
+    const quint32 coarsestLevel = first->coarsestLevel();
+    QCOMPARE(coarsestLevel, 2u);
+
+    const auto residentSize = [](const QSSGRenderMeshLodStreaming *streaming) {
+        return quint64(streaming->levelIndexCounts.at(streaming->residentLevel)) * streaming->indexSize;
+    };
+    const auto renderUntil = [&](const std::function<bool()> &condition) {
+        for (int i = 0; i != 10 && !condition(); ++i)
+            renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+        return condition();
+    };
+
+    // Both models ask for the full detail, only one of them gets it
+    QVERIFY(renderUntil([&] { return first->residentLevel == 0 || second->residentLevel == 0; }));
+    renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+    const QSSGRenderMeshLodStreaming *fullDetail = first->residentLevel == 0 ? first : second;
+    const QSSGRenderMeshLodStreaming *limited = fullDetail == first ? second : first;
+    QCOMPARE(fullDetail->residentLevel, 0u);
+    QCOMPARE(limited->residentLevel, coarsestLevel);
+    QVERIFY(limited->budgetLimited);
+    QVERIFY(residentSize(first) + residentSize(second) <= 1024 * 1024);
+
+    // The limited one is drawn with what it has
+    const auto &meshMap = bufferManager->getMeshMap();
+    for (const auto &meshData : meshMap) {
+        if (meshData.mesh && meshData.mesh->lodStreaming.get() == limited) {
+            const QSSGRenderSubset &subset = meshData.mesh->subsets.first();
+            QCOMPARE(subset.residentLevelOfDetail, coarsestLevel);
+            QCOMPARE(subset.residentLodCount(0), subset.lodCount(coarsestLevel));
+            QCOMPARE(subset.residentLodOffset(0), subset.lodOffset(coarsestLevel));
+            QCOMPARE(subset.residentLodCount(coarsestLevel), subset.lodCount(coarsestLevel));
+        }
+    }
+
+    // Once the other model settles for its coarsest level, its finer levels make room
+    QQuick3DModel *fullDetailModel = fullDetail == first ? firstModel : secondModel;
+    fullDetailModel->setLevelOfDetailBias(1000.0f);
+    QVERIFY(renderUntil([&] { return limited->residentLevel == 0; }));
+    QCOMPARE(fullDetail->residentLevel, coarsestLevel);
+    QVERIFY(!limited->budgetLimited);
+    QVERIFY(residentSize(first) + residentSize(second) <= 1024 * 1024);
+}
+
+QTEST_MAIN(tst_MeshLodStreaming)
+#include "tst_meshlodstreaming.moc"
@@ -125,6 +125,7 @@ private Q_SLOTS:
     void initTestCase() override;
     void test_view_picking();
     void test_ray_picking();
+    void test_batch_picking();
     void test_object_picking2();
     void test_item_picking();
     void test_picking_QTBUG_111997();
@@ -530,6 +531,60 @@ void tst_Picking::test_ray_picking()
 }
 
 
+void tst_Picking::test_batch_picking()
+{
+    QScopedPointer<QQuickView> view(createView(QLatin1String("picking.qml"), QSize(400, 400)));
+    QVERIFY(view);
+    QVERIFY(QTest::qWaitForWindowExposed(view.data()));
+
+    QQuick3DViewport *view3d = view->findChild<QQuick3DViewport *>(QStringLiteral("view"));
+    QVERIFY(view3d);
+    QQuick3DModel *model1 = view3d->findChild<QQuick3DModel *>(QStringLiteral("model1"));
+    QVERIFY(model1);
+    QQuick3DModel *model2 = view3d->findChild<QQuick3DModel *>(QStringLiteral("model2"));
+    QVERIFY(model2);
+
+    const qreal dpr = view->devicePixelRatio();
+    if (dpr != 1.0) {
+        QSKIP("Test uses window positions to get exact values and those assume DPR of 1.0");
+    }
+
+    QSignalSpy spy(view3d, &QQuick3DViewport::pickBatchFinished);
+
+    // Center of model1, upper right corner of model2 and just outside of it
+    const int requestId = view3d->requestPickBatch({ QPointF(200, 200), QPointF(300, 100), QPointF(301, 99) });
+    QTRY_COMPARE(spy.size(), 1);
+    QCOMPARE(spy.at(0).at(0).toInt(), requestId);
+    auto results = spy.at(0).at(1).value<QList<QQuick3DPickResult>>();
+    QCOMPARE(results.size(), 3);
+    QCOMPARE(results.at(0).objectHit(), model1);
+    QCOMPARE(results.at(0).distance(), 550.0f);
+    QCOMPARE(results.at(1).objectHit(), model2);
+    QCOMPARE(results.at(1).distance(), 600.0f);
+    QCOMPARE(results.at(2).hitType(), QQuick3DPickResultEnums::HitType::Null);
+
+    // Through model1 and then model2
+    const QList<QVector3D> origins { QVector3D(25.0f, 25.0f, 600.0f) };
+    const QList<QVector3D> directions { QVector3D(0.0f, 0.0f, -1.0f) };
+    const int rayRequestId = view3d->requestRayPickBatch(origins, directions);
+    QTRY_COMPARE(spy.size(), 2);
+    QCOMPARE(spy.at(1).at(0).toInt(), rayRequestId);
+    results = spy.at(1).at(1).value<QList<QQuick3DPickResult>>();
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.at(0).objectHit(), model1);
+
+    // The results are delivered after model1 is gone, its hit must not be reported
+    // (nor be mistaken for whatever reuses its backend node)
+    const int laterRequestId = view3d->requestRayPickBatch(origins, directions);
+    delete model1;
+    QTRY_COMPARE(spy.size(), 3);
+    QCOMPARE(spy.at(2).at(0).toInt(), laterRequestId);
+    results = spy.at(2).at(1).value<QList<QQuick3DPickResult>>();
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.at(0).objectHit(), model2);
+    QCOMPARE(results.at(0).distance(), 600.0f);
+}
+
 void tst_Picking::test_object_picking2()
 {
     QScopedPointer<QQuickView> view(createView(QLatin1String("picking2.qml"), QSize(100, 100)));
@@ -0,0 +1,22 @@
+import QtQuick
+import QtQuick3D
+
+View3D {
+    width: 640
+    height: 480
+    anchors.fill: parent
+
+    property alias model: model
+
+    environment: SceneEnvironment {
+        backgroundMode: SceneEnvironment.Color
+        clearColor: "black"
+    }
+    PerspectiveCamera { z: 600 }
+    DirectionalLight { }
+    Model {
+        id: model
+        source: "#Cube"
+        materials: PrincipledMaterial { }
+    }
+}
@@ -0,0 +1,95 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+
+#include <private/qquick3dviewport_p.h>
+#include <private/qquick3dmodel_p.h>
+#include <ssg/qssgrendercontextcore.h>
+#include <private/qssgrendershadercache_p.h>
+#include <private/qssgrhicontext_p.h>
+
+#if QT_CONFIG(vulkan)
+#include <QVulkanInstance>
+#endif
+
+#include "../shared/util.h"
+
+static inline void renderNextFrame(QQuick3DTestOffscreenRenderer *renderer, bool *readCompleted, QRhiReadbackResult *readResult, QImage *result)
+{
+    QGuiApplication::processEvents();
+    renderer->renderControl->polishItems();
+    renderer->renderControl->beginFrame();
+    renderer->renderControl->sync();
+    renderer->renderControl->render();
+    renderer->enqueueReadback(readCompleted, readResult, result);
+    renderer->renderControl->endFrame();
+}
+
+class tst_PipelineWarmup : public QQuick3DDataTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase() override;
+    void warmupPipelines();
+
+private:
+#if QT_CONFIG(vulkan)
+    QVulkanInstance vulkanInstance;
+#endif
+};
+
+void tst_PipelineWarmup::initTestCase()
+{
+    QQuick3DDataTest::initTestCase();
+    if (!initialized())
+        return;
+
+#if QT_CONFIG(vulkan)
+    vulkanInstance.setLayers({ "VK_LAYER_LUNARG_standard_validation" });
+    vulkanInstance.create(); // may fail, which is fine is Vulkan is not used in the first place
+#endif
+}
+
+void tst_PipelineWarmup::warmupPipelines()
+{
+    QQuick3DTestOffscreenRenderer renderer;
+    QVERIFY(renderer.init(testFileUrl("warmup.qml"),
+#if QT_CONFIG(vulkan)
+                          &vulkanInstance
+#else
+                          nullptr
+#endif
+                          ));
+
+    bool readCompleted = false;
+    QRhiReadbackResult readResult;
+    QImage result;
+
+    // Records the pipeline of the model
+    renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+
+    const auto &context = QQuick3DSceneManager::getOrSetWindowAttachment(*renderer.quickWindow)->rci();
+    QVERIFY(context);
+    if (context->shaderCache()->pipelineWarmupCache().entryCount() == 0)
+        QSKIP("Pipeline states are only recorded when the shader disk cache is enabled");
+
+    const auto model = renderer.rootItem->property("model").value<QQuick3DModel *>();
+    QVERIFY(model);
+    model->setVisible(false);
+    context->releaseCachedResources();
+    renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+
+    // Nothing is drawn with a material, so no pipelines are created
+    auto *rhiCtxD = QSSGRhiContextPrivate::get(context->rhiContext().get());
+    QVERIFY(rhiCtxD->m_pipelines.isEmpty());
+
+    // Until they are requested up front
+    QVERIFY(QMetaObject::invokeMethod(renderer.rootItem, "warmupPipelines"));
+    renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+    QVERIFY(!rhiCtxD->m_pipelines.isEmpty());
+}
+
+QTEST_MAIN(tst_PipelineWarmup)
+#include "tst_pipelinewarmup.moc"
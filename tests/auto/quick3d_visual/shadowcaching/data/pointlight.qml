@@ -0,0 +1,62 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+import QtQuick
+import QtQuick3D
+
+Rectangle {
+    width: 320
+    height: 240
+    color: "black"
+
+    property alias light: light
+    property alias caster: caster
+    property alias marker: marker
+
+    // Underlay is rendered with every Qt Quick frame, also when the 3D scene did not change
+    View3D {
+        anchors.fill: parent
+        renderMode: View3D.Underlay
+        renderStats.extendedDataCollectionEnabled: true
+        environment: SceneEnvironment {
+            backgroundMode: SceneEnvironment.Color
+            clearColor: "black"
+        }
+
+        PerspectiveCamera {
+            y: 400
+            z: 600
+            eulerRotation.x: -30
+        }
+
+        PointLight {
+            id: light
+            castsShadow: true
+        }
+
+        // Only in the positive X face of the point light's shadow cube map
+        Model {
+            id: caster
+            source: "#Cube"
+            x: 250
+            materials: PrincipledMaterial { }
+        }
+
+        Model {
+            source: "#Rectangle"
+            y: -100
+            eulerRotation.x: -90
+            scale: Qt.vector3d(10, 10, 1)
+            castsShadows: false
+            materials: PrincipledMaterial { }
+        }
+    }
+
+    // Changed by the test to get frames in which only the 2D content changes
+    Rectangle {
+        id: marker
+        width: 10
+        height: 10
+        color: "white"
+    }
+}
@@ -0,0 +1,124 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+
+#include <private/qquick3dmodel_p.h>
+#include <private/qquick3dnode_p.h>
+#include <private/qquick3dscenemanager_p.h>
+#include <ssg/qssgrendercontextcore.h>
+#include <private/qssgrhicontext_p.h>
+
+#if QT_CONFIG(vulkan)
+#include <QVulkanInstance>
+#endif
+
+#include "../shared/util.h"
+
+static inline void renderNextFrame(QQuick3DTestOffscreenRenderer *renderer, bool *readCompleted, QRhiReadbackResult *readResult, QImage *result)
+{
+    QGuiApplication::processEvents();
+    renderer->renderControl->polishItems();
+    renderer->renderControl->beginFrame();
+    renderer->renderControl->sync();
+    renderer->renderControl->render();
+    renderer->enqueueReadback(readCompleted, readResult, result);
+    renderer->renderControl->endFrame();
+}
+
+class tst_ShadowCaching : public QQuick3DDataTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase() override;
+    void cubeFaces();
+
+private:
+#if QT_CONFIG(vulkan)
+    QVulkanInstance vulkanInstance;
+#endif
+};
+
+void tst_ShadowCaching::initTestCase()
+{
+    // Read once, when the first frame is prepared
+    qputenv("QT_QUICK3D_SHADOW_MAP_CACHING", "1");
+
+    QQuick3DDataTest::initTestCase();
+    if (!initialized())
+        return;
+
+#if QT_CONFIG(vulkan)
+    vulkanInstance.setLayers({ "VK_LAYER_LUNARG_standard_validation" });
+    vulkanInstance.create(); // may fail, which is fine is Vulkan is not used in the first place
+#endif
+}
+
+void tst_ShadowCaching::cubeFaces()
+{
+    QQuick3DTestOffscreenRenderer renderer;
+    QVERIFY(renderer.init(testFileUrl("pointlight.qml"),
+#if QT_CONFIG(vulkan)
+                          &vulkanInstance
+#else
+                          nullptr
+#endif
+    ));
+
+    bool readCompleted = false;
+    QRhiReadbackResult readResult;
+    QImage result;
+
+    const auto light = renderer.rootItem->property("light").value<QQuick3DNode *>();
+    const auto caster = renderer.rootItem->property("caster").value<QQuick3DModel *>();
+    const auto marker = renderer.rootItem->property("marker").value<QQuickItem *>();
+    QVERIFY(light && caster && marker);
+
+    renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+    const auto &context = QQuick3DSceneManager::getOrSetWindowAttachment(*renderer.quickWindow)->rci();
+    QVERIFY(context);
+    const auto &stats = QSSGRhiContextStats::get(*context->rhiContext());
+    QCOMPARE(stats.perLayerInfo.size(), 1);
+    const QSSGRhiContextStats::PerLayerInfo &layerInfo = *stats.perLayerInfo.cbegin();
+
+    // The names of the cube faces that were rendered in the last frame
+    const auto renderedFaces = [&layerInfo] {
+        QList<QByteArray> faces;
+        for (const auto &pass : layerInfo.renderPasses) {
+            if (pass.rtName.contains("shadow cube face"))
+                faces.append(pass.rtName);
+        }
+        return faces;
+    };
+    const auto renderFrame = [&] {
+        readCompleted = false;
+        renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+        return readCompleted && QSSGRhiContextStats::totalDrawCallCountForPass(layerInfo.externalRenderPass) > 0;
+    };
+
+    // Moving the light changes all faces
+    light->setY(10.0f);
+    QVERIFY(renderFrame());
+    QCOMPARE(renderedFaces().size(), 6);
+
+    // Nothing changed for the light, so all faces are kept
+    marker->setProperty("color", QColor(Qt::green));
+    QVERIFY(renderFrame());
+    QVERIFY(renderedFaces().isEmpty());
+
+    // Moving the caster to the other side of the light changes what two of the faces see
+    caster->setX(-250.0f);
+    QVERIFY(renderFrame());
+    const QList<QByteArray> faces = renderedFaces();
+    QCOMPARE(faces.size(), 2);
+    QVERIFY(faces.at(0).endsWith("+X") || faces.at(1).endsWith("+X"));
+    QVERIFY(faces.at(0).endsWith("-X") || faces.at(1).endsWith("-X"));
+
+    marker->setProperty("color", QColor(Qt::blue));
+    QVERIFY(renderFrame());
+    QVERIFY(renderedFaces().isEmpty());
+}
+
+QTEST_MAIN(tst_ShadowCaching)
+#include "tst_shadowcaching.moc"
@@ -0,0 +1,35 @@
+import QtQuick
+import QtQuick3D
+
+View3D {
+    anchors.fill: parent
+    environment: SceneEnvironment {
+        backgroundMode: SceneEnvironment.Color
+        clearColor: "black"
+    }
+    PerspectiveCamera {
+        y: 400
+        z: 600
+        eulerRotation.x: -30
+    }
+
+    PointLight {
+        castsShadow: true
+    }
+
+    // Only in the positive X face of the point light's shadow cube map
+    Model {
+        source: "#Cube"
+        x: 250
+        materials: PrincipledMaterial { }
+    }
+
+    Model {
+        source: "#Rectangle"
+        y: -100
+        eulerRotation.x: -90
+        scale: Qt.vector3d(10, 10, 1)
+        castsShadows: false
+        materials: PrincipledMaterial { }
+    }
+}
@@ -0,0 +1,81 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QQuickView>
+#include <QRegularExpression>
+
+#include "../shared/util.h"
+
+class tst_ShadowCulling : public QQuick3DDataTest
+{
+    Q_OBJECT
+
+private slots:
+    void cubeFaces();
+};
+
+struct RenderPassRow
+{
+    QString name;
+    quint64 drawCalls = 0;
+    QString culled;
+};
+
+// Parses the render pass table of QQuick3DRenderStats::renderPassDetails
+static QList<RenderPassRow> renderPassRows(const QString &renderPassDetails, const QString &nameFilter)
+{
+    static const QRegularExpression sizeColumn(QStringLiteral("^\\d+x\\d+$"));
+    QList<RenderPassRow> rows;
+    for (const QString &line : renderPassDetails.split(QLatin1Char('\n'))) {
+        const QStringList columns = line.split(QLatin1Char('|'));
+        // | Name | Size | Vertices | Draw calls | Culled |, skipping the header
+        if (columns.size() != 7 || !sizeColumn.match(columns.at(2).trimmed()).hasMatch()
+                || !columns.at(1).contains(nameFilter))
+            continue;
+        rows.append({ columns.at(1).trimmed(), columns.at(4).trimmed().toULongLong(), columns.at(5).trimmed() });
+    }
+    return rows;
+}
+
+void tst_ShadowCulling::cubeFaces()
+{
+    QScopedPointer<QQuickView> view(createView(QLatin1String("pointlight.qml"), QSize(320, 240)));
+    QVERIFY(view);
+    QVERIFY(QTest::qWaitForWindowExposed(view.data()));
+
+    QObject *renderStats = qvariant_cast<QObject *>(view->rootObject()->property("renderStats"));
+    QVERIFY(renderStats);
+    renderStats->setProperty("extendedDataCollectionEnabled", true);
+
+    const auto faceRows = [renderStats] {
+        return renderPassRows(renderStats->property("renderPassDetails").toString(), QStringLiteral("shadow cube face"));
+    };
+    QTRY_COMPARE(faceRows().size(), 6);
+
+    // The caster is drawn into the one face that sees it, and culled in all the others
+    quint64 drawCalls = 0;
+    int culledFaces = 0;
+    for (const RenderPassRow &row : faceRows()) {
+        drawCalls += row.drawCalls;
+        if (row.drawCalls == 0) {
+            QCOMPARE(row.culled, QStringLiteral("1"));
+            ++culledFaces;
+        } else {
+            QCOMPARE(row.drawCalls, quint64(1));
+            QCOMPARE(row.culled, QStringLiteral("0"));
+        }
+    }
+    QCOMPARE(drawCalls, quint64(1));
+    QCOMPARE(culledFaces, 5);
+
+    // The main pass does no culling of its own
+    const QList<RenderPassRow> mainRows = renderPassRows(renderStats->property("renderPassDetails").toString(), QString());
+    for (const RenderPassRow &row : mainRows) {
+        if (!row.name.contains(QStringLiteral("shadow")))
+            QVERIFY(row.culled.isEmpty());
+    }
+}
+
+QTEST_MAIN(tst_ShadowCulling)
+#include "tst_shadowculling.moc"
@@ -0,0 +1,50 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+import QtQuick
+import QtQuick3D
+
+Rectangle {
+    width: 320
+    height: 240
+    color: "black"
+
+    property alias cube: cube
+    property alias marker: marker
+
+    // Underlay is rendered with every Qt Quick frame, also when the 3D scene did not change
+    View3D {
+        anchors.fill: parent
+        renderMode: View3D.Underlay
+        renderStats.extendedDataCollectionEnabled: true
+        environment: SceneEnvironment {
+            backgroundMode: SceneEnvironment.Color
+            clearColor: "black"
+        }
+
+        PerspectiveCamera {
+            z: 300
+        }
+
+        DirectionalLight {
+        }
+
+        Model {
+            id: cube
+            source: "#Cube"
+            eulerRotation: Qt.vector3d(30, 30, 0)
+            materials: PrincipledMaterial {
+                baseColor: "red"
+                lighting: PrincipledMaterial.NoLighting
+            }
+        }
+    }
+
+    // Changed by the test to get frames in which only the 2D content changes
+    Rectangle {
+        id: marker
+        width: 10
+        height: 10
+        color: "white"
+    }
+}
@@ -0,0 +1,133 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+
+#include <private/qquick3dmodel_p.h>
+#include <private/qquick3dscenemanager_p.h>
+#include <ssg/qssgrendercontextcore.h>
+#include <private/qssgrhicontext_p.h>
+#include <private/qssgrenderlayer_p.h>
+#include <private/qssglayerrenderdata_p.h>
+
+#if QT_CONFIG(vulkan)
+#include <QVulkanInstance>
+#endif
+
+#include "../shared/util.h"
+
+static inline void renderNextFrame(QQuick3DTestOffscreenRenderer *renderer, bool *readCompleted, QRhiReadbackResult *readResult, QImage *result)
+{
+    QGuiApplication::processEvents();
+    renderer->renderControl->polishItems();
+    renderer->renderControl->beginFrame();
+    renderer->renderControl->sync();
+    renderer->renderControl->render();
+    renderer->enqueueReadback(readCompleted, readResult, result);
+    renderer->renderControl->endFrame();
+}
+
+static bool isRed(const QColor &color)
+{
+    return color.red() > 200 && color.green() < 50 && color.blue() < 50;
+}
+
+class tst_StaticFrameReuse : public QQuick3DDataTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase() override;
+    void reuse();
+
+private:
+#if QT_CONFIG(vulkan)
+    QVulkanInstance vulkanInstance;
+#endif
+};
+
+void tst_StaticFrameReuse::initTestCase()
+{
+    // Read once, when the first frame is prepared
+    qputenv("QT_QUICK3D_REUSE_STATIC_FRAMES", "1");
+
+    QQuick3DDataTest::initTestCase();
+    if (!initialized())
+        return;
+
+#if QT_CONFIG(vulkan)
+    vulkanInstance.setLayers({ "VK_LAYER_LUNARG_standard_validation" });
+    vulkanInstance.create(); // may fail, which is fine is Vulkan is not used in the first place
+#endif
+}
+
+void tst_StaticFrameReuse::reuse()
+{
+    QQuick3DTestOffscreenRenderer renderer;
+    QVERIFY(renderer.init(testFileUrl("staticscene.qml"),
+#if QT_CONFIG(vulkan)
+                          &vulkanInstance
+#else
+                          nullptr
+#endif
+    ));
+
+    bool readCompleted = false;
+    QRhiReadbackResult readResult;
+    QImage result;
+
+    const auto cube = renderer.rootItem->property("cube").value<QQuick3DModel *>();
+    const auto marker = renderer.rootItem->property("marker").value<QQuickItem *>();
+    QVERIFY(cube && marker);
+
+    renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+    QVERIFY(readCompleted);
+    const QPoint center(result.width() / 2, result.height() / 2);
+    QVERIFY(isRed(result.pixelColor(center)));
+
+    // The statistics are collected per layer, which also gives access to the one of the View3D
+    const auto &context = QQuick3DSceneManager::getOrSetWindowAttachment(*renderer.quickWindow)->rci();
+    QVERIFY(context);
+    const auto &stats = QSSGRhiContextStats::get(*context->rhiContext());
+    QCOMPARE(stats.perLayerInfo.size(), 1);
+    QSSGRenderLayer *layer = stats.perLayerInfo.cbegin().key();
+    QVERIFY(layer && layer->renderData);
+    const auto drawCallCount = [&stats, layer] {
+        return QSSGRhiContextStats::totalDrawCallCountForPass(stats.perLayerInfo.value(layer).externalRenderPass);
+    };
+    // Nothing is reused while resources are still being loaded
+    for (int i = 0; i != 10 && !layer->renderData->canReusePreviousFrame(); ++i)
+        renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+    QVERIFY(layer->renderData->canReusePreviousFrame());
+    const quint64 preparedDrawCalls = drawCallCount();
+    QVERIFY(preparedDrawCalls > 0);
+
+    // Only the 2D content changes, so the next frames draw the renderables prepared for the first one
+    for (const QColor &color : { QColor(Qt::green), QColor(Qt::blue) }) {
+        readCompleted = false;
+        marker->setProperty("color", color);
+        renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+        QVERIFY(readCompleted);
+        QVERIFY(isRed(result.pixelColor(center)));
+        QCOMPARE(drawCallCount(), preparedDrawCalls);
+        QVERIFY(layer->renderData->canReusePreviousFrame());
+    }
+
+    // A change in the scene prepares the frame again
+    readCompleted = false;
+    cube->setX(1000.0f);
+    renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+    QVERIFY(readCompleted);
+    QVERIFY(!isRed(result.pixelColor(center)));
+    QVERIFY(layer->renderData->canReusePreviousFrame());
+
+    // And the new state is what gets reused afterwards
+    readCompleted = false;
+    marker->setProperty("color", QColor(Qt::white));
+    renderNextFrame(&renderer, &readCompleted, &readResult, &result);
+    QVERIFY(readCompleted);
+    QVERIFY(!isRed(result.pixelColor(center)));
+}
+
+QTEST_MAIN(tst_StaticFrameReuse)
+#include "tst_staticframereuse.moc"
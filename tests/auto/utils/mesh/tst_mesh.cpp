@@ -0,0 +1,329 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest>
+
+#include <QtQuick3DUtils/private/qssgmesh_p.h>
+
+#include <algorithm>
+#include <array>
+
+using namespace QSSGMesh;
+
+class mesh : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void test_roundTrip_data();
+    void test_roundTrip();
+    void test_dequantize();
+    void test_mappedMatchesStreamed();
+    void test_truncatedFile();
+    void test_compressedRoundTrip();
+    void test_quantizedAttributes();
+
+private:
+    QString writeMesh(const QString &name, Mesh::SaveOptions options = Mesh::NoSaveOptions);
+
+    QTemporaryDir m_dir;
+};
+
+// A grid of quads with positions, normals and UVs
+static Mesh createMesh()
+{
+    constexpr int gridSize = 8;
+    constexpr int stride = 8 * sizeof(float);
+    RuntimeMeshData data;
+    data.m_vertexBuffer.resize(gridSize * gridSize * stride);
+    auto *v = reinterpret_cast<float *>(data.m_vertexBuffer.data());
+    for (int y = 0; y != gridSize; ++y) {
+        for (int x = 0; x != gridSize; ++x) {
+            const float values[8] = { float(x), float(y), 0.0f,
+                                      0.0f, 0.6f, 0.8f,
+                                      x / float(gridSize - 1), y / float(gridSize - 1) };
+            memcpy(v, values, sizeof(values));
+            v += 8;
+        }
+    }
+
+    QVector<quint16> indices;
+    for (int y = 0; y != gridSize - 1; ++y) {
+        for (int x = 0; x != gridSize - 1; ++x) {
+            const quint16 i = quint16(y * gridSize + x);
+            indices << i << quint16(i + 1) << quint16(i + gridSize)
+                    << quint16(i + 1) << quint16(i + gridSize + 1) << quint16(i + gridSize);
+        }
+    }
+    data.m_indexBuffer = QByteArray(reinterpret_cast<const char *>(indices.constData()), indices.size() * sizeof(quint16));
+
+    using Attribute = RuntimeMeshData::Attribute;
+    data.m_attributes[0] = { Attribute::PositionSemantic, Mesh::ComponentType::Float32, 0 };
+    data.m_attributes[1] = { Attribute::NormalSemantic, Mesh::ComponentType::Float32, 12 };
+    data.m_attributes[2] = { Attribute::TexCoord0Semantic, Mesh::ComponentType::Float32, 24 };
+    data.m_attributes[3] = { Attribute::IndexSemantic, Mesh::ComponentType::UnsignedInt16, 0 };
+    data.m_attributeCount = 4;
+    data.m_stride = stride;
+
+    Mesh::Subset subset;
+    subset.count = quint32(indices.size());
+    subset.bounds.min = QVector3D(0.0f, 0.0f, 0.0f);
+    subset.bounds.max = QVector3D(gridSize - 1, gridSize - 1, 0.0f);
+    data.m_subsets.append(subset);
+
+    QString error;
+    return Mesh::fromRuntimeData(data, &error);
+}
+
+static const Mesh::VertexBufferEntry *findEntry(const Mesh::VertexBuffer &vertexBuffer, const char *name)
+{
+    for (const Mesh::VertexBufferEntry &entry : vertexBuffer.entries) {
+        if (entry.name == name)
+            return &entry;
+    }
+    return nullptr;
+}
+
+// The triangles of a 16-bit index buffer, each rotated to start at its smallest index. The
+// index codec keeps the order and winding of the triangles but may rotate their vertices.
+static QVector<std::array<quint16, 3>> normalizedTriangles(const QByteArray &indexData)
+{
+    const auto *indices = reinterpret_cast<const quint16 *>(indexData.constData());
+    const qsizetype triangleCount = indexData.size() / qsizetype(3 * sizeof(quint16));
+    QVector<std::array<quint16, 3>> triangles;
+    triangles.reserve(triangleCount);
+    for (qsizetype i = 0; i != triangleCount; ++i) {
+        std::array<quint16, 3> triangle { indices[3 * i], indices[3 * i + 1], indices[3 * i + 2] };
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.append(triangle);
+    }
+    return triangles;
+}
+
+// Saves 'source' into an in-memory file and loads it again, returning the version the mesh was written with
+static quint16 saveAndLoad(const Mesh &source, Mesh::SaveOptions options, Mesh *loaded)
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    const quint32 id = source.save(&buffer, 0, options);
+    if (!id)
+        return 0;
+
+    buffer.seek(0);
+    const MeshInternal::MultiMeshInfo fileInfo = MeshInternal::readFileHeader(&buffer);
+    if (!fileInfo.isValid() || !fileInfo.meshEntries.contains(id))
+        return 0;
+    MeshInternal::MeshDataHeader header;
+    if (!MeshInternal::readMeshData(&buffer, fileInfo.meshEntries.value(id), loaded, &header))
+        return 0;
+    return header.fileVersion;
+}
+
+QString mesh::writeMesh(const QString &name, Mesh::SaveOptions options)
+{
+    const QString path = m_dir.filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return {};
+    if (!createMesh().save(&file, 0, options))
+        return {};
+    return path;
+}
+
+static Mesh loadFile(const QString &path, bool mapped)
+{
+    QSharedPointer<QIODevice> file(new QFile(path));
+    if (!file->open(QIODevice::ReadOnly))
+        return {};
+    return mapped ? Mesh::loadMeshMapped(file) : Mesh::loadMesh(file.data());
+}
+
+void mesh::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+void mesh::test_roundTrip_data()
+{
+    QTest::addColumn<Mesh::SaveOptions>("options");
+    QTest::addColumn<quint16>("expectedVersion");
+
+    QTest::newRow("plain") << Mesh::SaveOptions(Mesh::NoSaveOptions) << quint16(MeshInternal::MeshDataHeader::UNCOMPRESSED_FILE_VERSION);
+    QTest::newRow("compressed") << Mesh::SaveOptions(Mesh::CompressBuffers) << quint16(MeshInternal::MeshDataHeader::FILE_VERSION);
+    QTest::newRow("quantized") << Mesh::SaveOptions(Mesh::QuantizeAttributes) << quint16(MeshInternal::MeshDataHeader::FILE_VERSION);
+}
+
+void mesh::test_roundTrip()
+{
+    QFETCH(Mesh::SaveOptions, options);
+    QFETCH(quint16, expectedVersion);
+
+    const Mesh source = createMesh();
+    QVERIFY(source.isValid());
+
+    Mesh loaded;
+    QCOMPARE(saveAndLoad(source, options, &loaded), expectedVersion);
+    QVERIFY(loaded.isValid());
+
+    QCOMPARE(loaded.drawMode(), source.drawMode());
+    QCOMPARE(loaded.winding(), source.winding());
+    QCOMPARE(loaded.indexBuffer().componentType, source.indexBuffer().componentType);
+    QCOMPARE(loaded.indexBuffer().data.size(), source.indexBuffer().data.size());
+    QVERIFY(normalizedTriangles(loaded.indexBuffer().data) == normalizedTriangles(source.indexBuffer().data));
+    QCOMPARE(loaded.subsets().size(), source.subsets().size());
+    QCOMPARE(loaded.subsets().first().count, source.subsets().first().count);
+    QCOMPARE(loaded.subsets().first().bounds.max, source.subsets().first().bounds.max);
+
+    if (options.testFlag(Mesh::QuantizeAttributes)) {
+        const Mesh::VertexBufferEntry *normal = findEntry(loaded.vertexBuffer(), MeshInternal::getNormalAttrName());
+        QVERIFY(normal);
+        QCOMPARE(normal->componentType, Mesh::ComponentType::Float16);
+        // Positions are never quantized
+        const Mesh::VertexBufferEntry *position = findEntry(loaded.vertexBuffer(), MeshInternal::getPositionAttrName());
+        QVERIFY(position);
+        QCOMPARE(position->componentType, Mesh::ComponentType::Float32);
+    } else {
+        // The vertex data is stored unchanged
+        QCOMPARE(loaded.vertexBuffer().stride, source.vertexBuffer().stride);
+        QCOMPARE(loaded.vertexBuffer().data, source.vertexBuffer().data);
+        QCOMPARE(loaded.vertexBuffer().entries.size(), source.vertexBuffer().entries.size());
+    }
+}
+
+void mesh::test_dequantize()
+{
+    const Mesh source = createMesh();
+    Mesh loaded;
+    QVERIFY(saveAndLoad(source, Mesh::QuantizeAttributes, &loaded));
+
+    // What lightmap baking needs: float3 normals and float2 UVs
+    QVERIFY(loaded.dequantizeAttributes());
+    QVERIFY(!loaded.dequantizeAttributes());
+    const Mesh::VertexBuffer vertexBuffer = loaded.vertexBuffer();
+    QCOMPARE(vertexBuffer.stride, source.vertexBuffer().stride);
+    for (const Mesh::VertexBufferEntry &sourceEntry : source.vertexBuffer().entries) {
+        const Mesh::VertexBufferEntry *entry = findEntry(vertexBuffer, sourceEntry.name.constData());
+        QVERIFY(entry);
+        QCOMPARE(entry->componentType, Mesh::ComponentType::Float32);
+        QCOMPARE(entry->componentCount, sourceEntry.componentCount);
+        QCOMPARE(entry->offset, sourceEntry.offset);
+    }
+
+    const auto *values = reinterpret_cast<const float *>(vertexBuffer.data.constData());
+    const auto *sourceValues = reinterpret_cast<const float *>(source.vertexBuffer().data.constData());
+    for (qsizetype i = 0, count = vertexBuffer.data.size() / qsizetype(sizeof(float)); i != count; ++i)
+        QVERIFY(qAbs(values[i] - sourceValues[i]) < 1e-3f);
+
+    // The unwrapping reads the attributes as floats as well
+    Mesh unwrapped;
+    QVERIFY(saveAndLoad(source, Mesh::QuantizeAttributes, &unwrapped));
+    QVERIFY(unwrapped.createLightmapUVChannel(64));
+    QVERIFY(unwrapped.hasLightmapUVChannel());
+    const Mesh::VertexBufferEntry *normal = findEntry(unwrapped.vertexBuffer(), MeshInternal::getNormalAttrName());
+    QVERIFY(normal);
+    QCOMPARE(normal->componentType, Mesh::ComponentType::Float32);
+}
+
+void mesh::test_mappedMatchesStreamed()
+{
+    const QString path = writeMesh(QStringLiteral("plain.mesh"));
+    QVERIFY(!path.isEmpty());
+
+    const Mesh streamed = loadFile(path, false);
+    const Mesh mapped = loadFile(path, true);
+    QVERIFY(streamed.isValid());
+    QVERIFY(mapped.isValid());
+    QVERIFY(!streamed.isMapped());
+    QVERIFY(mapped.isMapped());
+
+    QCOMPARE(mapped.vertexBuffer().stride, streamed.vertexBuffer().stride);
+    QCOMPARE(mapped.vertexBuffer().entries.size(), streamed.vertexBuffer().entries.size());
+    QCOMPARE(mapped.vertexBuffer().data, streamed.vertexBuffer().data);
+    QCOMPARE(mapped.indexBuffer().componentType, streamed.indexBuffer().componentType);
+    QCOMPARE(mapped.indexBuffer().data, streamed.indexBuffer().data);
+    QCOMPARE(mapped.subsets().size(), streamed.subsets().size());
+    QCOMPARE(mapped.subsets().first().count, streamed.subsets().first().count);
+    QCOMPARE(mapped.subsets().first().bounds.max, streamed.subsets().first().bounds.max);
+}
+
+void mesh::test_truncatedFile()
+{
+    const QString sourcePath = writeMesh(QStringLiteral("source.mesh"));
+    QVERIFY(!sourcePath.isEmpty());
+    QFile source(sourcePath);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    const QByteArray contents = source.readAll();
+
+    // Keep the file header intact, but cut into the mesh data
+    const QString path = m_dir.filePath(QStringLiteral("truncated.mesh"));
+    QFile truncated(path);
+    QVERIFY(truncated.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    const qsizetype footerSize = 32;
+    truncated.write(contents.first(contents.size() / 2));
+    truncated.write(contents.last(footerSize));
+    truncated.close();
+
+    QTest::ignoreMessage(QtWarningMsg, "Mesh data truncated");
+    QVERIFY(!loadFile(path, true).isValid());
+}
+
+void mesh::test_compressedRoundTrip()
+{
+    const QString plainPath = writeMesh(QStringLiteral("uncompressed.mesh"));
+    const QString path = writeMesh(QStringLiteral("compressed.mesh"), Mesh::CompressBuffers);
+    QVERIFY(!plainPath.isEmpty());
+    QVERIFY(!path.isEmpty());
+    QVERIFY(QFileInfo(path).size() < QFileInfo(plainPath).size());
+
+    const Mesh uncompressed = loadFile(plainPath, false);
+    QVERIFY(uncompressed.isValid());
+    for (bool mapped : { false, true }) {
+        const Mesh compressed = loadFile(path, mapped);
+        QVERIFY(compressed.isValid());
+        QCOMPARE(compressed.vertexBuffer().stride, uncompressed.vertexBuffer().stride);
+        QCOMPARE(compressed.vertexBuffer().data, uncompressed.vertexBuffer().data);
+        QCOMPARE(compressed.indexBuffer().componentType, uncompressed.indexBuffer().componentType);
+        QCOMPARE(compressed.indexBuffer().data.size(), uncompressed.indexBuffer().data.size());
+        QVERIFY(normalizedTriangles(compressed.indexBuffer().data) == normalizedTriangles(uncompressed.indexBuffer().data));
+        QCOMPARE(compressed.subsets().first().count, uncompressed.subsets().first().count);
+    }
+}
+
+void mesh::test_quantizedAttributes()
+{
+    const QString path = writeMesh(QStringLiteral("quantized.mesh"), Mesh::QuantizeAttributes | Mesh::CompressBuffers);
+    QVERIFY(!path.isEmpty());
+
+    const Mesh loaded = loadFile(path, false);
+    QVERIFY(loaded.isValid());
+    const Mesh::VertexBuffer vb = loaded.vertexBuffer();
+    // float3 position, half4 normal, half2 uv
+    QCOMPARE(vb.stride, quint32(24));
+    QCOMPARE(vb.entries.size(), qsizetype(3));
+    QCOMPARE(vb.entries[0].componentType, Mesh::ComponentType::Float32);
+    QCOMPARE(vb.entries[1].componentType, Mesh::ComponentType::Float16);
+    QCOMPARE(vb.entries[1].componentCount, quint32(4));
+    QCOMPARE(vb.entries[2].componentType, Mesh::ComponentType::Float16);
+    QCOMPARE(vb.entries[2].componentCount, quint32(2));
+
+    // The vertex at grid position (3, 5)
+    const quint32 vertexIdx = 5 * 8 + 3;
+    const char *vertex = vb.data.constData() + vertexIdx * vb.stride;
+    float position[3];
+    memcpy(position, vertex + vb.entries[0].offset, sizeof(position));
+    QCOMPARE(position[0], 3.0f);
+    QCOMPARE(position[1], 5.0f);
+    qfloat16 normal[4];
+    memcpy(normal, vertex + vb.entries[1].offset, sizeof(normal));
+    QVERIFY(qAbs(float(normal[1]) - 0.6f) < 1e-3f);
+    QVERIFY(qAbs(float(normal[2]) - 0.8f) < 1e-3f);
+    QCOMPARE(float(normal[3]), 0.0f);
+    qfloat16 uv[2];
+    memcpy(uv, vertex + vb.entries[2].offset, sizeof(uv));
+    QVERIFY(qAbs(float(uv[0]) - 3.0f / 7.0f) < 1e-3f);
+    QVERIFY(qAbs(float(uv[1]) - 5.0f / 7.0f) < 1e-3f);
+}
+
+QTEST_APPLESS_MAIN(mesh)
+#include "tst_mesh.moc"
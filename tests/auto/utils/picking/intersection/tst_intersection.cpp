@@ -4,6 +4,8 @@
 #include <QtTest>
 
 #include <QtQuick3DRuntimeRender/private/qssgrenderray_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrendermesh_p.h>
+#include <QtQuick3DUtils/private/qssgmeshbvhbuilder_p.h>
 
 class intersection : public QObject
 {
@@ -18,6 +20,8 @@ private slots:
     void test_aabbIntersectionScaledv2();
     void test_aabbIntersectionTranslatedv2();
     void test_aabbIntersectionRotatedv2();
+    void test_bvhClosestHit_data();
+    void test_bvhClosestHit();
 
 private:
     static QSSGRenderRay::IntersectionResult intersectWithAABBv2_proxy(const QMatrix4x4 &inGlobalTransform,
@@ -297,6 +301,86 @@ void intersection::aabbIntersectionRotated(const IntersectionFunc &intersectFunc
     }
 }
 
+void intersection::test_bvhClosestHit_data()
+{
+    QTest::addColumn<bool>("packed");
+
+    QTest::newRow("legacy") << false;
+    QTest::newRow("packed") << true;
+}
+
+// The closest-hit traversal has to agree with the nearest of all intersections
+void intersection::test_bvhClosestHit()
+{
+    QFETCH(bool, packed);
+
+    // Two stacked 16x16 grids, at z = 0 and z = 1
+    const int size = 16;
+    const int columns = size + 1;
+    const int layerVertices = columns * columns;
+    QByteArray vertexBuffer(2 * layerVertices * sizeof(QVector3D), Qt::Uninitialized);
+    auto *vertices = reinterpret_cast<QVector3D *>(vertexBuffer.data());
+    QByteArray indexBuffer(2 * size * size * 6 * sizeof(quint32), Qt::Uninitialized);
+    auto *indices = reinterpret_cast<quint32 *>(indexBuffer.data());
+    for (int layer = 0; layer < 2; ++layer) {
+        for (int y = 0; y <= size; ++y) {
+            for (int x = 0; x <= size; ++x)
+                *vertices++ = QVector3D(float(x), float(y), float(layer));
+        }
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                const quint32 v00 = layer * layerVertices + y * columns + x;
+                const quint32 quad[] = { v00, v00 + 1, v00 + columns, v00 + 1, v00 + columns + 1, v00 + columns };
+                indices = std::copy(std::begin(quad), std::end(quad), indices);
+            }
+        }
+    }
+
+    QSSGMeshBVHBuilder builder(vertexBuffer, sizeof(QVector3D), 0, false, -1, true, indexBuffer, QSSGRenderComponentType::UnsignedInt32);
+    QSSGRenderMesh mesh(QSSGRenderDrawMode::Triangles, QSSGRenderWinding::CounterClockwise);
+    mesh.bvh = packed ? builder.buildPackedTree() : builder.buildTree();
+    QVERIFY(mesh.bvh);
+    QCOMPARE(mesh.bvh->isPacked(), packed);
+
+    QMatrix4x4 globalTransform;
+    globalTransform.translate(-8.0f, 3.0f, 0.5f);
+    globalTransform.scale(2.0f);
+
+    QRandomGenerator random(7);
+    for (int i = 0; i < 200; ++i) {
+        // Rays from above, some of them miss the grids
+        const QVector3D origin(float(random.bounded(48.0) - 16.0), float(random.bounded(48.0) - 16.0), 20.0f);
+        const QVector3D direction(float(random.bounded(0.4) - 0.2), float(random.bounded(0.4) - 0.2), -1.0f);
+        const QSSGRenderRay ray(origin, direction.normalized());
+        const auto rayData = QSSGRenderRay::createRayData(globalTransform, ray);
+
+        QVector<QSSGRenderRay::IntersectionResult> results;
+        QSSGRenderRay::IntersectionResult closest;
+        QSSGRenderRay::IntersectionResult any;
+        if (packed) {
+            const quint32 root = mesh.bvh->packedRoots().front();
+            QSSGRenderRay::intersectWithPackedBVH(rayData, *mesh.bvh, root, results);
+            closest = QSSGRenderRay::intersectWithPackedBVHClosest(rayData, *mesh.bvh, root);
+            any = QSSGRenderRay::intersectWithPackedBVHClosest(rayData, *mesh.bvh, root, QSSGRenderRay::HitMode::Any);
+        } else {
+            const auto *root = static_cast<const QSSGMeshBVHNode *>(mesh.bvh->roots().front());
+            QSSGRenderRay::intersectWithBVH(rayData, root, &mesh, results);
+            closest = QSSGRenderRay::intersectWithBVHClosest(rayData, root, *mesh.bvh);
+            any = QSSGRenderRay::intersectWithBVHClosest(rayData, root, *mesh.bvh, QSSGRenderRay::HitMode::Any);
+        }
+
+        QCOMPARE(closest.intersects, !results.isEmpty());
+        QCOMPARE(any.intersects, !results.isEmpty());
+        if (results.isEmpty())
+            continue;
+
+        float nearest = std::numeric_limits<float>::max();
+        for (const auto &result : std::as_const(results))
+            nearest = std::min(nearest, result.rayLengthSquared);
+        QVERIFY(qFuzzyCompare(closest.rayLengthSquared, nearest));
+    }
+}
+
 QTEST_APPLESS_MAIN(intersection)
 
 #include "tst_intersection.moc"
@@ -0,0 +1,99 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest>
+
+#include <QtQuick3DRuntimeRender/private/qssglayerrenderdata_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderableobjects_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderparticles_p.h>
+
+#include <memory>
+#include <vector>
+
+class renderablesort : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_groupsByState();
+    void test_nearestFirstWithinState();
+    void test_logDepthBuckets();
+
+private:
+    // Only the prepared state and the distance take part in the sort
+    QSSGRenderableObjectHandle addRenderable(quintptr pipeline, quintptr srb, float distance)
+    {
+        auto renderable = std::make_unique<QSSGParticlesRenderable>(QSSGRenderableObjectFlags(), QVector3D(), nullptr,
+                                                                    m_particles, nullptr, nullptr, m_lights, 1.0f);
+        renderable->rhiRenderData.mainPass.pipeline = reinterpret_cast<QRhiGraphicsPipeline *>(pipeline);
+        renderable->rhiRenderData.mainPass.srb = reinterpret_cast<QRhiShaderResourceBindings *>(srb);
+        m_renderables.push_back(std::move(renderable));
+        return QSSGRenderableObjectHandle(m_renderables.back().get(), distance * distance);
+    }
+
+    static quintptr pipelineOf(const QSSGRenderableObjectHandle &handle)
+    {
+        return quintptr(static_cast<QSSGParticlesRenderable *>(handle.obj)->rhiRenderData.mainPass.pipeline);
+    }
+
+    static quintptr srbOf(const QSSGRenderableObjectHandle &handle)
+    {
+        return quintptr(static_cast<QSSGParticlesRenderable *>(handle.obj)->rhiRenderData.mainPass.srb);
+    }
+
+    QSSGRenderParticles m_particles;
+    QSSGShaderLightListView m_lights;
+    std::vector<std::unique_ptr<QSSGParticlesRenderable>> m_renderables;
+};
+
+void renderablesort::test_groupsByState()
+{
+    // All at about the same distance, so in the same bucket
+    QSSGRenderableObjectList list;
+    list << addRenderable(0x20, 0x100, 10.0f) << addRenderable(0x10, 0x200, 10.1f) << addRenderable(0x20, 0x200, 10.2f)
+         << addRenderable(0x10, 0x100, 10.3f) << addRenderable(0x20, 0x100, 10.4f) << addRenderable(0x10, 0x200, 10.5f);
+    // Sets the range of the buckets
+    list << addRenderable(0x30, 0x300, 1000.0f);
+
+    QSSGLayerRenderData::sortOpaqueByState(list);
+
+    QCOMPARE(list.size(), 7);
+    const QList<std::pair<quintptr, quintptr>> expected = { { 0x10, 0x100 }, { 0x10, 0x200 }, { 0x10, 0x200 },
+                                                            { 0x20, 0x100 }, { 0x20, 0x100 }, { 0x20, 0x200 },
+                                                            { 0x30, 0x300 } };
+    for (qsizetype i = 0; i != expected.size(); ++i) {
+        QCOMPARE(pipelineOf(list.at(i)), expected.at(i).first);
+        QCOMPARE(srbOf(list.at(i)), expected.at(i).second);
+    }
+}
+
+void renderablesort::test_nearestFirstWithinState()
+{
+    QSSGRenderableObjectList list;
+    list << addRenderable(0x10, 0x100, 5.3f) << addRenderable(0x10, 0x100, 5.1f) << addRenderable(0x10, 0x100, 5.2f)
+         << addRenderable(0x10, 0x100, 5.0f);
+
+    QSSGLayerRenderData::sortOpaqueByState(list);
+
+    for (qsizetype i = 1; i != list.size(); ++i)
+        QVERIFY(list.at(i - 1).cameraDistanceSq <= list.at(i).cameraDistanceSq);
+}
+
+void renderablesort::test_logDepthBuckets()
+{
+    // With buckets on the logarithm of the distance, 1 and 2 are as far apart as 100 and 200.
+    // Bucketing on the (squared) distance would put 1, 2 and 10 together in the first bucket.
+    QSSGRenderableObjectList list;
+    list << addRenderable(0x10, 0x100, 10.0f) << addRenderable(0x20, 0x100, 2.0f) << addRenderable(0x10, 0x100, 1.0f)
+         << addRenderable(0x20, 0x100, 200.0f) << addRenderable(0x10, 0x100, 100.0f);
+
+    QSSGLayerRenderData::sortOpaqueByState(list);
+
+    // Different buckets keep the depth order even though the states differ
+    const QList<float> expected = { 1.0f, 2.0f, 10.0f, 100.0f, 200.0f };
+    for (qsizetype i = 0; i != expected.size(); ++i)
+        QCOMPARE(list.at(i).cameraDistanceSq, expected.at(i) * expected.at(i));
+}
+
+QTEST_APPLESS_MAIN(renderablesort)
+#include "tst_renderablesort.moc"
@@ -22,8 +22,12 @@ private slots:
     void initTestCase();
     void cleanupTestCase();
     void test_frustumCulling();
+    void bench_outputlist_data();
     void bench_outputlist();
+    void bench_inline_data();
     void bench_inline();
+    void bench_batch_data();
+    void bench_batch();
 
 private:
     struct ObjectData
@@ -53,6 +57,38 @@ private:
         }
     }
 
+    QList<ObjectData> createObjectList(quint32 objectCount, quint32 nonCulledItemCount) const
+    {
+        // bounds 10x10x10 all in world coordinates
+        constexpr float widthAndHeight = 10.0f;
+        constexpr QSSGBounds3 bounds { { -widthAndHeight / 2.0f, -widthAndHeight / 2.0f, -widthAndHeight / 2.0f }, { widthAndHeight / 2.0f, widthAndHeight / 2.0f, widthAndHeight / 2.0f } };
+
+        // For simplicity we only do put "cullable" object in front or behind the frustum for now.
+        const float frustumNearBorder = camera.position().z() - camera.clipNear() + widthAndHeight;
+        const float frustumFarBorder = camera.position().z() - camera.clipFar() - widthAndHeight;
+
+        QSet<quint32> replaceIndexes;
+        while (replaceIndexes.size() < nonCulledItemCount)
+            replaceIndexes.insert(QRandomGenerator::global()->bounded(objectCount));
+
+        QList<ObjectData> objects;
+        objects.reserve(objectCount);
+
+        // Fill the list with object data that should be culled
+        for (quint32 i = 0, end = objectCount; i != end; ++i) {
+            if (i % 2)
+                objects.push_back(createRenderableData({0.0f, 0.0f, frustumNearBorder }, QQuaternion::fromEulerAngles({}), bounds));
+            else
+                objects.push_back(createRenderableData({0.0f, 0.0f, frustumFarBorder }, QQuaternion::fromEulerAngles({}), bounds));
+        }
+
+        // Insert items at random positions in the list that should not be culled
+        for (auto v : std::as_const(replaceIndexes))
+            objects.replace(v, createRenderableData({0.0f, 0.0f, 0.0f}, QQuaternion::fromEulerAngles({}), bounds));
+
+        return objects;
+    }
+
     QQuick3DPerspectiveCamera camera;
     QScopedPointer<QSSGRenderCamera> cameraNode;
     QSSGClippingFrustum clipFrustum;
@@ -108,38 +144,26 @@ void BenchFrustumCulling::test_frustumCulling()
 
 }
 
-void BenchFrustumCulling::bench_outputlist()
+static void addObjectCountRows()
 {
-    // bounds 10x10x10 all in world coordinates
-    constexpr float widthAndHeight = 10.0f;
-    constexpr QSSGBounds3 bounds { { -widthAndHeight / 2.0f, -widthAndHeight / 2.0f, -widthAndHeight / 2.0f }, { widthAndHeight / 2.0f, widthAndHeight / 2.0f, widthAndHeight / 2.0f } };
+    QTest::addColumn<quint32>("objectCount");
 
-    // For simplicity we only do put "cullable" object in front or behind the frustum for now.
-    const float frustumNearBorder = camera.position().z() - camera.clipNear() + widthAndHeight;
-    const float frustumFarBorder = camera.position().z() - camera.clipFar() - widthAndHeight;
-
-    const quint32 objectCount = 10000;
-    const quint32 nonCulledItemCount = 3;
-
-    QSet<quint32> replaceIndexes;
-    while (replaceIndexes.size() < nonCulledItemCount)
-        replaceIndexes.insert(QRandomGenerator::global()->bounded(objectCount));
-
-    QList<ObjectData> objects;
-    objects.reserve(objectCount);
+    QTest::newRow("10k") << quint32(10000);
+    QTest::newRow("100k") << quint32(100000);
+    QTest::newRow("1M") << quint32(1000000);
+}
 
-    // Fill the list with object data that should be culled
-    for (quint32 i = 0, end = objectCount; i != end; ++i) {
-        if (i % 2)
-            objects.push_back(createRenderableData({0.0f, 0.0f, frustumNearBorder }, QQuaternion::fromEulerAngles({}), bounds));
-        else
-            objects.push_back(createRenderableData({0.0f, 0.0f, frustumFarBorder }, QQuaternion::fromEulerAngles({}), bounds));
-    }
+void BenchFrustumCulling::bench_outputlist_data()
+{
+    addObjectCountRows();
+}
 
-    // Insert items at random positions in the list that should not be culled
-    for (auto v : std::as_const(replaceIndexes))
-        objects.replace(v, createRenderableData({0.0f, 0.0f, 0.0f}, QQuaternion::fromEulerAngles({}), bounds));
+void BenchFrustumCulling::bench_outputlist()
+{
+    QFETCH(quint32, objectCount);
+    const quint32 nonCulledItemCount = 3;
 
+    const QList<ObjectData> objects = createObjectList(objectCount, nonCulledItemCount);
     QCOMPARE(objects.size(), objectCount);
 
     QList<QSSGRenderableObject> renderableObjects;
@@ -167,38 +191,53 @@ void BenchFrustumCulling::bench_outputlist()
     QCOMPARE(culledrenderables.size(), nonCulledItemCount);
 }
 
+void BenchFrustumCulling::bench_inline_data()
+{
+    addObjectCountRows();
+}
+
 void BenchFrustumCulling::bench_inline()
 {
-    // bounds 10x10x10 all in world coordinates
-    constexpr float widthAndHeight = 10.0f;
-    constexpr QSSGBounds3 bounds { { -widthAndHeight / 2.0f, -widthAndHeight / 2.0f, -widthAndHeight / 2.0f }, { widthAndHeight / 2.0f, widthAndHeight / 2.0f, widthAndHeight / 2.0f } };
+    QFETCH(quint32, objectCount);
+    const quint32 nonCulledItemCount = 3;
 
-    // For simplicity we only do put "cullable" object in front or behind the frustum for now.
-    const float frustumNearBorder = camera.position().z() - camera.clipNear() + widthAndHeight;
-    const float frustumFarBorder = camera.position().z() - camera.clipFar() - widthAndHeight;
+    const QList<ObjectData> objects = createObjectList(objectCount, nonCulledItemCount);
+    QCOMPARE(objects.size(), objectCount);
 
-    const quint32 objectCount = 10000;
-    const quint32 nonCulledItemCount = 3;
+    QList<QSSGRenderableObject> renderableObjects;
 
-    QSet<quint32> replaceIndexes;
-    while (replaceIndexes.size() < nonCulledItemCount)
-        replaceIndexes.insert(QRandomGenerator::global()->bounded(objectCount));
+    // List of renderables
+    populateRenderableList(objects, renderableObjects);
 
-    QList<ObjectData> objects;
-    objects.reserve(objectCount);
+    // Renderable object handle class...
+    QSSGRenderableObjectList renderables;
+    renderables.reserve(objects.size());
 
-    // Fill the list with object data that should be culled
-    for (quint32 i = 0, end = objectCount; i != end; ++i) {
-        if (i % 2)
-            objects.push_back(createRenderableData({0.0f, 0.0f, frustumNearBorder }, QQuaternion::fromEulerAngles({}), bounds));
-        else
-            objects.push_back(createRenderableData({0.0f, 0.0f, frustumFarBorder }, QQuaternion::fromEulerAngles({}), bounds));
+    for (auto &ro : renderableObjects)
+        renderables.push_back({ &ro, 0.0f });
+
+    QVERIFY(!cameraNode->isDirty(QSSGRenderCamera::DirtyFlag::CameraDirty));
+
+    qsizetype ret;
+    QBENCHMARK {
+        ret = QSSGLayerRenderData::frustumCullingInline(clipFrustum, renderables);
     }
 
-    // Insert items at random positions in the list that should not be culled
-    for (auto v : std::as_const(replaceIndexes))
-        objects.replace(v, createRenderableData({0.0f, 0.0f, 0.0f}, QQuaternion::fromEulerAngles({}), bounds));
 
+    QCOMPARE(ret, nonCulledItemCount);
+}
+
+void BenchFrustumCulling::bench_batch_data()
+{
+    addObjectCountRows();
+}
+
+void BenchFrustumCulling::bench_batch()
+{
+    QFETCH(quint32, objectCount);
+    const quint32 nonCulledItemCount = 3;
+
+    const QList<ObjectData> objects = createObjectList(objectCount, nonCulledItemCount);
     QCOMPARE(objects.size(), objectCount);
 
     QList<QSSGRenderableObject> renderableObjects;
@@ -206,7 +245,6 @@ void BenchFrustumCulling::bench_inline()
     // List of renderables
     populateRenderableList(objects, renderableObjects);
 
-    // Renderable object handle class...
     QSSGRenderableObjectList renderables;
     renderables.reserve(objects.size());
 
@@ -215,13 +253,24 @@ void BenchFrustumCulling::bench_inline()
 
     QVERIFY(!cameraNode->isDirty(QSSGRenderCamera::DirtyFlag::CameraDirty));
 
+    // Includes gathering the bounds, which the layer does while adding the renderables to its
+    // lists, and compacting the list, which the inline culling does as it goes.
+    QSSGBoundsSoA bounds;
+    bounds.reserve(objects.size());
+    QSSGRenderableObjectList culled(renderables.size());
     qsizetype ret;
     QBENCHMARK {
-        ret = QSSGLayerRenderData::frustumCullingInline(clipFrustum, renderables);
+        bounds.clear();
+        for (const auto &handle : std::as_const(renderables))
+            bounds.push_back(handle.obj->globalBounds);
+        std::copy(renderables.cbegin(), renderables.cend(), culled.begin());
+        ret = QSSGLayerRenderData::frustumCullingBatch(clipFrustum, bounds, culled);
     }
 
-
+    // The compacted list should match the inline culling result.
     QCOMPARE(ret, nonCulledItemCount);
+    for (qsizetype i = 0; i != ret; ++i)
+        QVERIFY(clipFrustum.intersectsWith(culled.at(i).obj->globalBounds));
 }
 
 QTEST_APPLESS_MAIN(BenchFrustumCulling)
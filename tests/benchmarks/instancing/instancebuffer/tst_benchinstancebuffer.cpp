@@ -0,0 +1,191 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest>
+
+#include <QtQuick3D/qquick3dinstancing.h>
+#include <QtQuick3D/private/qquick3dobject_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderinstancetable_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrendermodel_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderdefaultmaterial_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderableobjects_p.h>
+#include <QtQuick3DRuntimeRender/private/qssglayerrenderdata_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrhicontext_p.h>
+
+// Instance table where a few instances are moved every frame
+class StreamingInstancing : public QQuick3DInstancing
+{
+public:
+    explicit StreamingInstancing(int count)
+    {
+        m_instanceData.resize(count * sizeof(InstanceTableEntry));
+        auto *entries = reinterpret_cast<InstanceTableEntry *>(m_instanceData.data());
+        for (int i = 0; i != count; ++i)
+            entries[i] = calculateTableEntry({ float(i), 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }, {}, Qt::white);
+    }
+
+    void moveInstances(int movedCount, bool useDirtyRanges)
+    {
+        const int count = int(m_instanceData.size() / sizeof(InstanceTableEntry));
+        auto *entries = reinterpret_cast<InstanceTableEntry *>(m_instanceData.data());
+        for (int i = 0; i != movedCount; ++i) {
+            const int index = QRandomGenerator::global()->bounded(count);
+            entries[index].row1[3] += 1.0f;
+            if (useDirtyRanges)
+                markRangeDirty(index, 1);
+        }
+        if (!useDirtyRanges)
+            markDirty();
+    }
+
+    QSSGRenderGraphObject *sync(QSSGRenderGraphObject *node) { return QQuick3DObjectPrivate::updateSpatialNode(this, node); }
+
+protected:
+    QByteArray getInstanceBuffer(int *instanceCount) override
+    {
+        if (instanceCount)
+            *instanceCount = int(m_instanceData.size() / sizeof(InstanceTableEntry));
+        return m_instanceData;
+    }
+
+private:
+    QByteArray m_instanceData;
+};
+
+class BenchInstanceBuffer : public QObject
+{
+    Q_OBJECT
+
+public:
+    BenchInstanceBuffer() = default;
+    ~BenchInstanceBuffer() = default;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void bench_update_data();
+    void bench_update();
+    void bench_uploadedBytes_data();
+    void bench_uploadedBytes();
+
+private:
+    static void addUpdateRows();
+    quint32 updateFrame(StreamingInstancing &instancing, QSSGRenderModel &model, int movedCount, bool useDirtyRanges);
+
+    QRhi *rhi = nullptr;
+    std::unique_ptr<QSSGRhiContext> rhiContext;
+};
+
+void BenchInstanceBuffer::initTestCase()
+{
+    rhi = QRhi::create(QRhi::Null, nullptr);
+    QVERIFY(rhi);
+    rhiContext = std::make_unique<QSSGRhiContext>(rhi);
+}
+
+void BenchInstanceBuffer::cleanupTestCase()
+{
+    rhiContext.reset();
+    delete rhi;
+}
+
+void BenchInstanceBuffer::addUpdateRows()
+{
+    QTest::addColumn<int>("instanceCount");
+    QTest::addColumn<int>("movedCount");
+    QTest::addColumn<bool>("useDirtyRanges");
+
+    QTest::newRow("200k, 300 moved, full") << 200000 << 300 << false;
+    QTest::newRow("200k, 300 moved, dirty ranges") << 200000 << 300 << true;
+    QTest::newRow("200k, 5000 moved, full") << 200000 << 5000 << false;
+    QTest::newRow("200k, 5000 moved, dirty ranges") << 200000 << 5000 << true;
+}
+
+// Syncs the moved instances and prepares the instance buffer the way the renderer does for a
+// model without LOD or culling. Returns the number of bytes uploaded.
+quint32 BenchInstanceBuffer::updateFrame(StreamingInstancing &instancing, QSSGRenderModel &model, int movedCount, bool useDirtyRanges)
+{
+    instancing.moveInstances(movedCount, useDirtyRanges);
+    model.instanceTable = static_cast<QSSGRenderInstanceTable *>(instancing.sync(model.instanceTable));
+
+    const QSSGRenderCameraDataList cameraDatas;
+    const QSSGModelContext modelContext(model, model.globalTransform, cameraDatas);
+    const QSSGRenderSubset subset;
+    const QSSGRenderDefaultMaterial material;
+    QSSGSubsetRenderable renderable(QSSGSubsetRenderable::Type::DefaultMaterialMeshSubset, {}, {}, nullptr, subset, modelContext,
+                                    1.0f, 0, material, nullptr, {}, {});
+
+    QRhiCommandBuffer *cb = nullptr;
+    rhi->beginOffscreenFrame(&cb);
+    auto *rhiCtxD = QSSGRhiContextPrivate::get(rhiContext.get());
+    rhiCtxD->setCommandBuffer(cb);
+    QSSGLayerRenderData::prepareInstancing(rhiContext.get(), &renderable, {}, {}, -1.0f, -1.0f);
+    rhi->endOffscreenFrame();
+
+    return rhiCtxD->instanceBufferData(model.instanceTable).uploadedBytes;
+}
+
+void BenchInstanceBuffer::bench_update_data()
+{
+    addUpdateRows();
+}
+
+void BenchInstanceBuffer::bench_update()
+{
+    QFETCH(int, instanceCount);
+    QFETCH(int, movedCount);
+    QFETCH(bool, useDirtyRanges);
+
+    StreamingInstancing instancing(instanceCount);
+    QSSGRenderModel model;
+    // The first frame creates the buffer and uploads the whole table
+    updateFrame(instancing, model, 0, useDirtyRanges);
+
+    QBENCHMARK {
+        updateFrame(instancing, model, movedCount, useDirtyRanges);
+    }
+
+    QSSGRhiContextPrivate::get(rhiContext.get())->releaseInstanceBuffer(model.instanceTable);
+    delete model.instanceTable;
+    model.instanceTable = nullptr;
+}
+
+void BenchInstanceBuffer::bench_uploadedBytes_data()
+{
+    addUpdateRows();
+}
+
+void BenchInstanceBuffer::bench_uploadedBytes()
+{
+    QFETCH(int, instanceCount);
+    QFETCH(int, movedCount);
+    QFETCH(bool, useDirtyRanges);
+
+    StreamingInstancing instancing(instanceCount);
+    QSSGRenderModel model;
+    // The first frame creates the buffer and uploads the whole table
+    updateFrame(instancing, model, 0, useDirtyRanges);
+    QSSGRenderInstanceTable *table = model.instanceTable;
+
+    constexpr int frameCount = 60;
+    quint64 uploadedBytes = 0;
+    for (int frame = 0; frame != frameCount; ++frame)
+        uploadedBytes += updateFrame(instancing, model, movedCount, useDirtyRanges);
+
+    // With many scattered changes the tracked ranges fall back to uploading the whole table
+    const quint64 tableSize = quint64(table->dataSize());
+    if (useDirtyRanges && movedCount <= 512)
+        QVERIFY(uploadedBytes / frameCount <= quint64(movedCount) * quint64(table->stride()));
+    else
+        QCOMPARE(uploadedBytes / frameCount, tableSize);
+
+    qInfo("%llu bytes uploaded per frame (table size %llu bytes)", uploadedBytes / frameCount, tableSize);
+
+    QSSGRhiContextPrivate::get(rhiContext.get())->releaseInstanceBuffer(table);
+    delete table;
+    model.instanceTable = nullptr;
+}
+
+QTEST_APPLESS_MAIN(BenchInstanceBuffer)
+
+#include "tst_benchinstancebuffer.moc"
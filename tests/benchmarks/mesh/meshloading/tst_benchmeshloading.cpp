@@ -0,0 +1,177 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest>
+
+#include <QtQuick3DUtils/private/qssgmesh_p.h>
+
+class BenchMeshLoading : public QObject
+{
+    Q_OBJECT
+
+public:
+    BenchMeshLoading() = default;
+    ~BenchMeshLoading() = default;
+
+private slots:
+    void initTestCase();
+    void bench_load_data();
+    void bench_load();
+    void bench_loadAndRead_data();
+    void bench_loadAndRead();
+    void bench_loadCompressed_data();
+    void bench_loadCompressed();
+
+private:
+    static void addLoaderRows();
+    QString writeMesh(const QString &name, quint32 vertexCount,
+                      QSSGMesh::Mesh::SaveOptions options = QSSGMesh::Mesh::NoSaveOptions);
+    static QSSGMesh::Mesh load(const QString &path, bool mapped);
+
+    QTemporaryDir m_dir;
+    QString m_largeMeshPath;
+    QString m_largeCompressedMeshPath;
+};
+
+// Position, normal and uv, 32 bytes per vertex
+QString BenchMeshLoading::writeMesh(const QString &name, quint32 vertexCount, QSSGMesh::Mesh::SaveOptions options)
+{
+    constexpr int stride = 8 * sizeof(float);
+    QSSGMesh::RuntimeMeshData data;
+    data.m_vertexBuffer.resize(qsizetype(vertexCount) * stride);
+    auto *vertices = reinterpret_cast<float *>(data.m_vertexBuffer.data());
+    for (quint32 i = 0; i != vertexCount; ++i) {
+        float *v = vertices + i * 8;
+        v[0] = float(i % 1024);
+        v[1] = float(i / 1024);
+        v[2] = 0.0f;
+        v[3] = 0.0f;
+        v[4] = 0.0f;
+        v[5] = 1.0f;
+        v[6] = v[0] / 1024.0f;
+        v[7] = v[1] / 1024.0f;
+    }
+
+    const quint32 indexCount = vertexCount - vertexCount % 3;
+    data.m_indexBuffer.resize(qsizetype(indexCount) * sizeof(quint32));
+    auto *indices = reinterpret_cast<quint32 *>(data.m_indexBuffer.data());
+    for (quint32 i = 0; i != indexCount; ++i)
+        indices[i] = i;
+
+    using Attribute = QSSGMesh::RuntimeMeshData::Attribute;
+    data.m_attributes[0] = { Attribute::PositionSemantic, QSSGMesh::Mesh::ComponentType::Float32, 0 };
+    data.m_attributes[1] = { Attribute::NormalSemantic, QSSGMesh::Mesh::ComponentType::Float32, 12 };
+    data.m_attributes[2] = { Attribute::TexCoord0Semantic, QSSGMesh::Mesh::ComponentType::Float32, 24 };
+    data.m_attributes[3] = { Attribute::IndexSemantic, QSSGMesh::Mesh::ComponentType::UnsignedInt32, 0 };
+    data.m_attributeCount = 4;
+    data.m_stride = stride;
+
+    QSSGMesh::Mesh::Subset subset;
+    subset.count = indexCount;
+    subset.bounds.min = QVector3D(0.0f, 0.0f, 0.0f);
+    subset.bounds.max = QVector3D(1023.0f, float(vertexCount / 1024), 0.0f);
+    data.m_subsets.append(subset);
+
+    QString error;
+    const QSSGMesh::Mesh mesh = QSSGMesh::Mesh::fromRuntimeData(data, &error);
+    if (!mesh.isValid()) {
+        qWarning() << "Failed to create mesh:" << error;
+        return {};
+    }
+
+    const QString path = m_dir.filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate))
+        return {};
+    mesh.save(&file, 0, options);
+    return path;
+}
+
+QSSGMesh::Mesh BenchMeshLoading::load(const QString &path, bool mapped)
+{
+    QSharedPointer<QIODevice> file(new QFile(path));
+    if (!file->open(QIODevice::ReadOnly))
+        return {};
+    return mapped ? QSSGMesh::Mesh::loadMeshMapped(file) : QSSGMesh::Mesh::loadMesh(file.data());
+}
+
+void BenchMeshLoading::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    // ~100MB of vertex data plus ~12MB of indices
+    m_largeMeshPath = writeMesh(QStringLiteral("large.mesh"), 100u * 1024u * 1024u / 32u);
+    QVERIFY(!m_largeMeshPath.isEmpty());
+    m_largeCompressedMeshPath = writeMesh(QStringLiteral("large_compressed.mesh"), 100u * 1024u * 1024u / 32u,
+                                          QSSGMesh::Mesh::CompressBuffers);
+    QVERIFY(!m_largeCompressedMeshPath.isEmpty());
+}
+
+void BenchMeshLoading::addLoaderRows()
+{
+    QTest::addColumn<bool>("mapped");
+
+    QTest::newRow("100MB, QDataStream") << false;
+    QTest::newRow("100MB, mapped") << true;
+}
+
+void BenchMeshLoading::bench_load_data()
+{
+    addLoaderRows();
+}
+
+void BenchMeshLoading::bench_load()
+{
+    QFETCH(bool, mapped);
+
+    QBENCHMARK {
+        const QSSGMesh::Mesh mesh = load(m_largeMeshPath, mapped);
+        QVERIFY(mesh.isValid());
+    }
+}
+
+// Includes reading all vertex and index data once, like a GPU upload would
+void BenchMeshLoading::bench_loadAndRead_data()
+{
+    addLoaderRows();
+}
+
+void BenchMeshLoading::bench_loadAndRead()
+{
+    QFETCH(bool, mapped);
+
+    QBENCHMARK {
+        const QSSGMesh::Mesh mesh = load(m_largeMeshPath, mapped);
+        QVERIFY(mesh.isValid());
+        const QByteArray vertexData = mesh.vertexBuffer().data;
+        const QByteArray indexData = mesh.indexBuffer().data;
+        quint64 sum = 0;
+        for (qsizetype i = 0; i < vertexData.size(); i += sizeof(quint64))
+            sum += *reinterpret_cast<const quint64 *>(vertexData.constData() + i);
+        for (qsizetype i = 0; i < indexData.size(); i += sizeof(quint64))
+            sum += *reinterpret_cast<const quint64 *>(indexData.constData() + i);
+        QVERIFY(sum != 0);
+    }
+}
+
+void BenchMeshLoading::bench_loadCompressed_data()
+{
+    QTest::addColumn<bool>("mapped");
+
+    QTest::newRow("100MB compressed, QDataStream") << false;
+    QTest::newRow("100MB compressed, mapped") << true;
+}
+
+// Compare with bench_load, this is the price of the smaller files
+void BenchMeshLoading::bench_loadCompressed()
+{
+    QFETCH(bool, mapped);
+
+    QBENCHMARK {
+        const QSSGMesh::Mesh mesh = load(m_largeCompressedMeshPath, mapped);
+        QVERIFY(mesh.isValid());
+    }
+}
+
+QTEST_APPLESS_MAIN(BenchMeshLoading)
+
+#include "tst_benchmeshloading.moc"
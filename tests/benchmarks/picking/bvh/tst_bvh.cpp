@@ -9,6 +9,12 @@
 #include <QtQuick3DRuntimeRender/private/qssgrendergeometry_p.h>
 
 #include <QtQuick3DRuntimeRender/private/qssgrenderbuffermanager_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrendermesh_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderray_p.h>
+
+#include <QtCore/qrandom.h>
+
+#include <cmath>
 
 class Bvh : public QObject
 {
@@ -30,13 +36,29 @@ public:
         QVector3D max {};
     };
 
+    enum class Query
+    {
+        AllHits,
+        ClosestHit,
+        AnyHit
+    };
+
 private Q_SLOTS:
     void bench_bvh_small();
     void bench_bvh_medium();
     void bench_bvh_large();
 
+    // Legacy (buildTree()) vs. packed SAH (buildPackedTree()) builder
+    void bench_build_data();
+    void bench_build();
+    void bench_rayThroughput_data();
+    void bench_rayThroughput();
+
 private:
     void prepRenderGeometry(qsizetype width, qsizetype height, QSSGRenderGeometry &renderGeometry);
+    // Indexed, slightly wavy grid of width x height quads
+    static QSSGMeshBVHBuilder gridBuilder(int width, int height);
+    static std::unique_ptr<QSSGMeshBVH> build(QSSGMeshBVHBuilder &builder, bool packed);
 };
 
 void Bvh::bench_bvh_small()
@@ -94,6 +116,141 @@ void Bvh::bench_bvh_large()
          QVERIFY(bvh != nullptr && bvh->nodes().size() > 0);
 }
 
+static void addBuilderRows()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("packed");
+
+    for (int size : { 256, 1024 }) {
+        QTest::addRow("legacy-%d", size) << size << false;
+        QTest::addRow("packed-%d", size) << size << true;
+    }
+}
+
+void Bvh::bench_build_data()
+{
+    addBuilderRows();
+}
+
+void Bvh::bench_build()
+{
+    QFETCH(int, size);
+    QFETCH(bool, packed);
+
+    QSSGMeshBVHBuilder builder = gridBuilder(size, size);
+    std::unique_ptr<QSSGMeshBVH> bvh;
+    QBENCHMARK {
+        bvh = build(builder, packed);
+    }
+
+    QVERIFY(bvh != nullptr);
+    QVERIFY(packed ? !bvh->packedNodes().empty() : !bvh->nodes().empty());
+}
+
+void Bvh::bench_rayThroughput_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("packed");
+    QTest::addColumn<Query>("query");
+
+    const std::pair<Query, const char *> queries[] { { Query::AllHits, "all" },
+                                                     { Query::ClosestHit, "closest" },
+                                                     { Query::AnyHit, "any" } };
+    for (int size : { 256, 1024 }) {
+        for (const auto &[query, name] : queries) {
+            QTest::addRow("legacy-%s-%d", name, size) << size << false << query;
+            QTest::addRow("packed-%s-%d", name, size) << size << true << query;
+        }
+    }
+}
+
+// Each iteration casts the same 4096 rays at the grid, so the reported time per iteration
+// is the inverse of the ray throughput. 'all' collects every intersection like picking used
+// to, 'closest' and 'any' use the closest-hit traversal.
+void Bvh::bench_rayThroughput()
+{
+    QFETCH(int, size);
+    QFETCH(bool, packed);
+    QFETCH(Query, query);
+
+    QSSGMeshBVHBuilder builder = gridBuilder(size, size);
+    QSSGRenderMesh mesh(QSSGRenderDrawMode::Triangles, QSSGRenderWinding::CounterClockwise);
+    mesh.bvh = build(builder, packed);
+    QVERIFY(mesh.bvh != nullptr);
+
+    constexpr int rayCount = 4096;
+    QRandomGenerator random(42);
+    std::vector<QSSGRenderRay> rays;
+    rays.reserve(rayCount);
+    for (int i = 0; i < rayCount; ++i) {
+        const QVector3D origin(float(random.bounded(double(size))), float(random.bounded(double(size))), 10.0f);
+        const QVector3D direction(float(random.bounded(0.2) - 0.1), float(random.bounded(0.2) - 0.1), -1.0f);
+        rays.emplace_back(origin, direction.normalized());
+    }
+
+    const QMatrix4x4 globalTransform;
+    QVector<QSSGRenderRay::IntersectionResult> results;
+    qsizetype hitCount = 0;
+    QBENCHMARK {
+        hitCount = 0;
+        for (const QSSGRenderRay &ray : rays) {
+            const auto rayData = QSSGRenderRay::createRayData(globalTransform, ray);
+            if (query != Query::AllHits) {
+                const auto mode = query == Query::AnyHit ? QSSGRenderRay::HitMode::Any : QSSGRenderRay::HitMode::Closest;
+                const auto result = packed
+                        ? QSSGRenderRay::intersectWithPackedBVHClosest(rayData, *mesh.bvh, mesh.bvh->packedRoots().front(), mode)
+                        : QSSGRenderRay::intersectWithBVHClosest(rayData, static_cast<const QSSGMeshBVHNode *>(mesh.bvh->roots().front()), *mesh.bvh, mode);
+                hitCount += result.intersects ? 1 : 0;
+                continue;
+            }
+            results.clear();
+            if (packed) {
+                QSSGRenderRay::intersectWithPackedBVH(rayData, *mesh.bvh, mesh.bvh->packedRoots().front(), results);
+            } else {
+                const auto *root = static_cast<const QSSGMeshBVHNode *>(mesh.bvh->roots().front());
+                if (QSSGRenderRay::intersectWithAABBv2(rayData, root->boundingData).intersects())
+                    QSSGRenderRay::intersectWithBVH(rayData, root, &mesh, results);
+            }
+            hitCount += results.isEmpty() ? 0 : 1;
+        }
+    }
+
+    // Almost all rays start above the grid and point at it
+    QVERIFY(hitCount > rayCount / 2);
+}
+
+QSSGMeshBVHBuilder Bvh::gridBuilder(int width, int height)
+{
+    const int columns = width + 1;
+    QByteArray vertexBuffer(qsizetype(columns) * (height + 1) * sizeof(QVector3D), Qt::Uninitialized);
+    auto *vertices = reinterpret_cast<QVector3D *>(vertexBuffer.data());
+    for (int y = 0; y <= height; ++y) {
+        for (int x = 0; x <= width; ++x)
+            vertices[y * columns + x] = QVector3D(float(x), float(y), 0.25f * std::sin(x * 0.3f) * std::cos(y * 0.3f));
+    }
+
+    QByteArray indexBuffer(qsizetype(width) * height * 6 * sizeof(quint32), Qt::Uninitialized);
+    auto *indices = reinterpret_cast<quint32 *>(indexBuffer.data());
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const quint32 v00 = y * columns + x;
+            const quint32 v10 = v00 + 1;
+            const quint32 v01 = v00 + columns;
+            const quint32 v11 = v01 + 1;
+            const quint32 quad[] = { v00, v10, v01, v10, v11, v01 };
+            std::copy(std::begin(quad), std::end(quad), indices);
+            indices += 6;
+        }
+    }
+
+    return QSSGMeshBVHBuilder(vertexBuffer, sizeof(QVector3D), 0, false, -1, true, indexBuffer, QSSGRenderComponentType::UnsignedInt32);
+}
+
+std::unique_ptr<QSSGMeshBVH> Bvh::build(QSSGMeshBVHBuilder &builder, bool packed)
+{
+    return packed ? builder.buildPackedTree() : builder.buildTree();
+}
+
 void Bvh::prepRenderGeometry(qsizetype width, qsizetype height, QSSGRenderGeometry &renderGeometry)
 {
     const qsizetype entries = width * height;
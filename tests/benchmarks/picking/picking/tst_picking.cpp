@@ -14,6 +14,11 @@
 #include <QtQuick3DRuntimeRender/private/qssgrenderpickresult_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgrenderbuffermanager_p.h>
 #include <QtQuick3DRuntimeRender/private/qssgrendermodel_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrenderinstancetable_p.h>
+
+#include <QtCore/qmath.h>
+
+#include <cmath>
 
 class picking : public QObject
 {
@@ -29,6 +34,10 @@ private Q_SLOTS:
     void bench_picking1Miss();
     void bench_picking1in1k();
     void bench_picking1in1kMiss();
+    void bench_pickingLargeScene_data();
+    void bench_pickingLargeScene();
+    void bench_pickingInstanced_data();
+    void bench_pickingInstanced();
 
 private:
     std::unique_ptr<QSSGRenderContextInterface> renderCtx;
@@ -118,6 +127,107 @@ void picking::benchImpl(int count, bool hit)
     QVERIFY(res.first().m_hitObject != nullptr);
 }
 
+// Models on a grid, the hitting ray goes through one column of the grid. Run with
+// QT_QUICK3D_PICKING_ACCELERATION=1 to measure the picking with the scene BVH.
+void picking::bench_pickingLargeScene_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("hit");
+    QTest::addColumn<bool>("moving");
+
+    QTest::newRow("30k hit") << 30000 << true << false;
+    QTest::newRow("30k miss") << 30000 << false << false;
+    QTest::newRow("30k hit, one moving model") << 30000 << true << true;
+}
+
+void picking::bench_pickingLargeScene()
+{
+    QFETCH(int, count);
+    QFETCH(bool, hit);
+    QFETCH(bool, moving);
+
+    const auto &bufferManager = renderCtx->bufferManager();
+    QSSGRenderLayer dummyLayer;
+
+    const int side = qCeil(std::cbrt(double(count)));
+    const auto cubeMeshPath = QSSGRenderPath(QStringLiteral("#Cube"));
+    std::unique_ptr<QSSGRenderModel[]> models(new QSSGRenderModel[count]);
+    for (int i = 0; i != count; ++i) {
+        auto &model = models[i];
+        model.meshPath = cubeMeshPath;
+        model.setState(QSSGRenderModel::LocalState::Pickable);
+        model.localTransform.translate(QVector3D(i % side, (i / side) % side, i / (side * side)) * 300.0f);
+        model.markDirty(QSSGRenderNode::DirtyFlag::TransformDirty);
+        model.calculateGlobalVariables();
+        dummyLayer.addChild(model);
+    }
+
+    bufferManager->loadMesh(models.get());
+
+    QVarLengthArray<QSSGRenderPickResult, 20> res;
+    QSSGRenderRay ray = hit ? QSSGRenderRay{ { 0.0f, 0.0f, -1000.0f }, { 0.0f, 0.0f, 1.0f } } : QSSGRenderRay{ { 0.0f, -1000.0f, -1000.0f }, { 1.0f, 0.0f, 0.0f } };
+    auto &movingModel = models[count - 1];
+    QBENCHMARK {
+        if (moving) {
+            movingModel.localTransform(0, 3) += 1.0f;
+            movingModel.markDirty(QSSGRenderNode::DirtyFlag::TransformDirty);
+            movingModel.calculateGlobalVariables();
+        }
+        res = QSSGRendererPrivate::syncPickAll(*renderCtx, dummyLayer, ray);
+    }
+    QCOMPARE(res.isEmpty(), !hit);
+}
+
+// One model with the instances on a grid in the xy plane. Run with
+// QT_QUICK3D_PICKING_ACCELERATION=1 to measure the picking with the instance BVH.
+void picking::bench_pickingInstanced_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("hit");
+
+    QTest::newRow("100k instances hit") << 100000 << true;
+    QTest::newRow("100k instances miss") << 100000 << false;
+}
+
+void picking::bench_pickingInstanced()
+{
+    QFETCH(int, count);
+    QFETCH(bool, hit);
+
+    const auto &bufferManager = renderCtx->bufferManager();
+    QSSGRenderLayer dummyLayer;
+
+    const int side = qCeil(std::sqrt(double(count)));
+    QByteArray instanceData(count * int(sizeof(QSSGRenderInstanceTableEntry)), Qt::Uninitialized);
+    auto *entries = reinterpret_cast<QSSGRenderInstanceTableEntry *>(instanceData.data());
+    for (int i = 0; i != count; ++i) {
+        entries[i].row0 = QVector4D(1.0f, 0.0f, 0.0f, (i % side) * 300.0f);
+        entries[i].row1 = QVector4D(0.0f, 1.0f, 0.0f, (i / side) * 300.0f);
+        entries[i].row2 = QVector4D(0.0f, 0.0f, 1.0f, 0.0f);
+        entries[i].color = QVector4D(1.0f, 1.0f, 1.0f, 1.0f);
+        entries[i].instanceData = QVector4D();
+    }
+    QSSGRenderInstanceTable instanceTable;
+    instanceTable.setData(instanceData, count, int(sizeof(QSSGRenderInstanceTableEntry)));
+
+    QSSGRenderModel model;
+    model.meshPath = QSSGRenderPath(QStringLiteral("#Cube"));
+    model.instanceTable = &instanceTable;
+    model.setState(QSSGRenderModel::LocalState::Pickable);
+    model.markDirty(QSSGRenderNode::DirtyFlag::TransformDirty);
+    model.calculateGlobalVariables();
+    dummyLayer.addChild(model);
+
+    bufferManager->loadMesh(&model);
+
+    QVarLengthArray<QSSGRenderPickResult, 20> res;
+    QSSGRenderRay ray = hit ? QSSGRenderRay{ { 0.0f, 0.0f, -1000.0f }, { 0.0f, 0.0f, 1.0f } } : QSSGRenderRay{ { 0.0f, 0.0f, -1000.0f }, { 1.0f, 0.0f, 0.0f } };
+    QBENCHMARK {
+        res = QSSGRendererPrivate::syncPickAll(*renderCtx, dummyLayer, ray);
+    }
+    QCOMPARE(res.isEmpty(), !hit);
+}
+
 QTEST_APPLESS_MAIN(picking)
 
 #include "tst_picking.moc"
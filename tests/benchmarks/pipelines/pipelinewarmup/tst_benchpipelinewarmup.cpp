@@ -0,0 +1,244 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest>
+
+#include <QtQuick3DRuntimeRender/private/qssgrenderpipelinewarmup_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrendershadercache_p.h>
+#include <QtQuick3DRuntimeRender/private/qssgrhicontext_p.h>
+
+static QShader fakeShader(QShader::Stage stage)
+{
+    QShader shader;
+    shader.setStage(stage);
+    shader.setShaderCode(QShaderKey(QShader::SpirvShader, QShaderVersion(100)), QShaderCode(QByteArrayLiteral("dummy")));
+    return shader;
+}
+
+class BenchPipelineWarmup : public QObject
+{
+    Q_OBJECT
+
+public:
+    BenchPipelineWarmup() = default;
+    ~BenchPipelineWarmup() = default;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void test_recordSaveLoad();
+    void test_replay();
+    void bench_replay_data();
+    void bench_replay();
+
+private:
+    static QByteArray materialKey(int index) { return QByteArrayLiteral("warmup test material ") + QByteArray::number(index); }
+    void addMaterialShaders(int count);
+    void createPipelines(int count);
+    int replay(QSSGPipelineWarmupCache &cache);
+
+    QRhi *rhi = nullptr;
+    std::unique_ptr<QSSGRhiContext> rhiContext;
+    std::unique_ptr<QSSGShaderCache> shaderCache;
+    std::unique_ptr<QRhiTexture> texture;
+    std::unique_ptr<QRhiTextureRenderTarget> rt;
+    std::unique_ptr<QRhiRenderPassDescriptor> rpDesc;
+    std::unique_ptr<QRhiBuffer> ubuf;
+    QSSGShaderFeatures features;
+};
+
+void BenchPipelineWarmup::initTestCase()
+{
+    // No files are read or written by the shader cache itself
+    QtQuick3DEditorHelpers::ShaderCache::setAutomaticDiskCache(false);
+
+    rhi = QRhi::create(QRhi::Null, nullptr);
+    QVERIFY(rhi);
+    rhiContext = std::make_unique<QSSGRhiContext>(rhi);
+    shaderCache = std::make_unique<QSSGShaderCache>(*rhiContext);
+
+    texture.reset(rhi->newTexture(QRhiTexture::RGBA8, QSize(64, 64), 1, QRhiTexture::RenderTarget));
+    QVERIFY(texture->create());
+    rt.reset(rhi->newTextureRenderTarget({ texture.get() }));
+    rpDesc.reset(rt->newCompatibleRenderPassDescriptor());
+    rt->setRenderPassDescriptor(rpDesc.get());
+    QVERIFY(rt->create());
+    QSSGRhiContextPrivate::get(rhiContext.get())->setMainRenderPassDescriptor(rpDesc.get());
+
+    ubuf.reset(rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 256));
+    QVERIFY(ubuf->create());
+
+    features.set(QSSGShaderFeatures::Feature::Ssao, true);
+}
+
+void BenchPipelineWarmup::cleanupTestCase()
+{
+    QSSGRhiContextPrivate::get(rhiContext.get())->releaseCachedResources();
+    shaderCache.reset();
+    ubuf.reset();
+    rt.reset();
+    rpDesc.reset();
+    texture.reset();
+    rhiContext.reset();
+    delete rhi;
+}
+
+// Stores the shaders the way they end up in the persistent (qsbc) cache
+void BenchPipelineWarmup::addMaterialShaders(int count)
+{
+    const QShader vert = fakeShader(QShader::VertexStage);
+    const QShader frag = fakeShader(QShader::FragmentStage);
+    for (int i = 0; i != count; ++i) {
+        const QQsbCollection::EntryDesc entryDesc { materialKey(i), QQsbCollection::toFeatureSet(features), vert, frag };
+        shaderCache->persistentShaderBakingCache().addEntry(entryDesc.generateSha(), entryDesc);
+    }
+}
+
+// Does what the renderer does when the materials are first rendered
+void BenchPipelineWarmup::createPipelines(int count)
+{
+    auto *rhiCtxD = QSSGRhiContextPrivate::get(rhiContext.get());
+    for (int i = 0; i != count; ++i) {
+        const QByteArray key = materialKey(i);
+        auto shaders = shaderCache->tryGetRhiShaderPipeline(key, features);
+        if (!shaders) {
+            const QByteArray qsbcKey = QQsbCollection::EntryDesc::generateSha(key, QQsbCollection::toFeatureSet(features));
+            shaders = shaderCache->tryNewPipelineFromPersistentCache(qsbcKey, key, features);
+        }
+        QVERIFY(shaders);
+        shaders->setWarmupKey(key, features.flags);
+
+        QSSGRhiShaderResourceBindingList bindings;
+        bindings.addUniformBuffer(0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage, ubuf.get());
+        QRhiShaderResourceBindings *srb = rhiCtxD->srb(bindings);
+        QVERIFY(srb);
+
+        QSSGRhiGraphicsPipelineState ps;
+        ps.flags |= QSSGRhiGraphicsPipelineState::Flag::DepthTestEnabled;
+        ps.cullMode = (i % 2) ? QRhiGraphicsPipeline::Back : QRhiGraphicsPipeline::None;
+        ps.viewport = QRhiViewport(0, 0, 64, 64);
+        auto &ia = QSSGRhiInputAssemblerStatePrivate::get(ps);
+        ia.topology = QRhiGraphicsPipeline::Triangles;
+        ia.inputLayout.setBindings({ { quint32(3 * sizeof(float)) } });
+        ia.inputLayout.setAttributes({ { 0, 0, QRhiVertexInputAttribute::Float3, 0 } });
+        QSSGRhiGraphicsPipelineStatePrivate::setShaderPipeline(ps, shaders.get());
+
+        QVERIFY(rhiCtxD->pipeline(ps, rpDesc.get(), srb));
+    }
+}
+
+int BenchPipelineWarmup::replay(QSSGPipelineWarmupCache &cache)
+{
+    QSSGRhiGraphicsPipelineState basePs;
+    basePs.viewport = QRhiViewport(0, 0, 64, 64);
+
+    QRhiCommandBuffer *cb = nullptr;
+    rhi->beginOffscreenFrame(&cb);
+    QSSGRhiContextPrivate::get(rhiContext.get())->setCommandBuffer(cb);
+    const int count = cache.replay(*shaderCache, *rhiContext, basePs, rpDesc.get()).createdCount;
+    rhi->endOffscreenFrame();
+
+    return count;
+}
+
+void BenchPipelineWarmup::test_recordSaveLoad()
+{
+    constexpr int materialCount = 8;
+    addMaterialShaders(materialCount);
+
+    QSSGPipelineWarmupCache recorder;
+    auto *rhiCtxD = QSSGRhiContextPrivate::get(rhiContext.get());
+    rhiCtxD->m_pipelineWarmup = &recorder;
+    createPipelines(materialCount);
+    // Already existing pipelines are not recorded again
+    createPipelines(materialCount);
+    rhiCtxD->m_pipelineWarmup = nullptr;
+    QCOMPARE(recorder.entryCount(), qsizetype(materialCount));
+    QVERIFY(recorder.isDirty());
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QStringLiteral("q3dshadercache.pipelines"));
+    QVERIFY(recorder.save(fileName));
+
+    QSSGPipelineWarmupCache loaded;
+    QVERIFY(loaded.load(fileName));
+    QCOMPARE(loaded.entryCount(), qsizetype(materialCount));
+    QVERIFY(!loaded.isDirty());
+
+    QFile f(fileName);
+    QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    f.write("garbage");
+    f.close();
+    QSSGPipelineWarmupCache invalid;
+    QVERIFY(!invalid.load(fileName));
+    QCOMPARE(invalid.entryCount(), qsizetype(0));
+
+    rhiCtxD->releaseCachedResources();
+    shaderCache->releaseCachedResources();
+}
+
+void BenchPipelineWarmup::test_replay()
+{
+    constexpr int materialCount = 8;
+    addMaterialShaders(materialCount);
+
+    QSSGPipelineWarmupCache cache;
+    auto *rhiCtxD = QSSGRhiContextPrivate::get(rhiContext.get());
+    rhiCtxD->m_pipelineWarmup = &cache;
+    createPipelines(materialCount);
+    rhiCtxD->m_pipelineWarmup = nullptr;
+
+    // Simulates the next run, nothing is created yet
+    rhiCtxD->releaseCachedResources();
+    shaderCache->releaseCachedResources();
+    QCOMPARE(rhiCtxD->m_pipelines.size(), qsizetype(0));
+
+    QCOMPARE(replay(cache), materialCount);
+    const qsizetype pipelineCount = rhiCtxD->m_pipelines.size();
+    QCOMPARE(pipelineCount, qsizetype(materialCount));
+
+    // Rendering the materials now only hits the cached pipelines
+    createPipelines(materialCount);
+    QCOMPARE(rhiCtxD->m_pipelines.size(), pipelineCount);
+
+    // Nothing left to do the second time
+    QCOMPARE(replay(cache), 0);
+
+    rhiCtxD->releaseCachedResources();
+    shaderCache->releaseCachedResources();
+}
+
+void BenchPipelineWarmup::bench_replay_data()
+{
+    QTest::addColumn<int>("materialCount");
+
+    QTest::newRow("100 pipelines") << 100;
+    QTest::newRow("1000 pipelines") << 1000;
+}
+
+void BenchPipelineWarmup::bench_replay()
+{
+    QFETCH(int, materialCount);
+
+    addMaterialShaders(materialCount);
+
+    QSSGPipelineWarmupCache cache;
+    auto *rhiCtxD = QSSGRhiContextPrivate::get(rhiContext.get());
+    rhiCtxD->m_pipelineWarmup = &cache;
+    createPipelines(materialCount);
+    rhiCtxD->m_pipelineWarmup = nullptr;
+
+    QBENCHMARK {
+        rhiCtxD->releaseCachedResources();
+        shaderCache->releaseCachedResources();
+        QCOMPARE(replay(cache), materialCount);
+    }
+
+    rhiCtxD->releaseCachedResources();
+    shaderCache->releaseCachedResources();
+}
+
+QTEST_APPLESS_MAIN(BenchPipelineWarmup)
+
+#include "tst_benchpipelinewarmup.moc"